@@ -7,7 +7,7 @@
 // Approach:
 //    * Take samples in the time domain
 //    * Take FFT to convert to frequency domain
-//    * Manipulate the frequency bins to do the formant shifting
+//    * Find the spectral envelope (the formants) and move it, keeping the pitch where it was
 //    * Take IFFT to convert back to time domain
 //    * Send samples back to the audio interface
 //
@@ -20,7 +20,6 @@
 //
 
 #include <Tympan_Library.h>
-#include "AudioEffectFormantShiftFD_F32.h"  //the local file holding your custom function
 #include "SerialManager.h"
 
 //set the sample rate and block size
@@ -31,7 +30,7 @@ AudioSettings_F32 audio_settings(sample_rate_Hz, audio_block_samples);
 //create audio library objects for handling the audio
 Tympan                        audioHardware(TympanRev::D);     //do TympanRev::C or TympanRev::D
 AudioInputI2S_F32             i2s_in(audio_settings);          //Digital audio *from* the Tympan AIC.
-AudioEffectFormantShiftFD_F32 formantShift(audio_settings);    //create the frequency-domain processing block
+AudioEffectPhaseVocoder_F32   formantShift(audio_settings);    //create the frequency-domain processing block
 AudioEffectGain_F32           gain1;                           //Applies digital gain to audio data.
 AudioOutputI2S_F32            i2s_out(audio_settings);         //Digital audio out *to* the Tympan AIC.
 
@@ -50,7 +49,7 @@ SerialManager serialManager(audioHardware);
 
 //inputs and levels
 float input_gain_dB = 20.0f; //gain on the microphone
-float formant_shift_gain_correction_dB = 0.0;  //will be used to adjust for gain in formant shifter
+float formant_shift_gain_correction_dB = 0.0;  //the phase vocoder has unity gain, so no correction is needed
 float vol_knob_gain_dB = 0.0;      //will be overridden by volume knob
 void switchToPCBMics(void) {
   mySerial.println("Switching to PCB Mics.");
@@ -82,13 +81,8 @@ void setup() {
   // Configure the frequency-domain algorithm
   int overlap_factor = 4;  //set to 4 or 8 or either 75% overlap (4x) or 87.5% overlap (8x)
   int N_FFT = audio_block_samples * overlap_factor;  
-  formantShift.setup(audio_settings, N_FFT); //do after AudioMemory_F32();
-  formantShift.setScaleFactor(1.5); //1.0 is no formant shifting.
-  if (overlap_factor == 4) {
-    formant_shift_gain_correction_dB = -3.0;
-  } else if (overlap_factor == 8) {
-    formant_shift_gain_correction_dB = -9.0;
-  }
+  formantShift.setup(audio_settings, N_FFT, overlap_factor);
+  formantShift.setFormantRatio(1.5); //1.0 is no formant shifting.
 
   //Enable the Tympan to start the audio flowing!
   audioHardware.enable(); // activate AIC
@@ -156,7 +150,7 @@ void servicePotentiometer(unsigned long curTime_millis, const unsigned long upda
       #else
         //set the amount of formant shifting
         float new_scale_fac = powf(2.0,(val-0.5)*2.0);
-        formantShift.setScaleFactor(new_scale_fac);
+        formantShift.setFormantRatio(new_scale_fac);
       #endif
     }
 
@@ -212,8 +206,9 @@ void setVolKnobGain_dB(float gain_dB) {
 }
 
 float incrementFormantShift(float incr_factor) {
-  float cur_scale_factor = formantShift.getScaleFactor();
-  return formantShift.setScaleFactor(cur_scale_factor*incr_factor);
+  float new_scale_factor = max(0.1f, formantShift.getFormantRatio()*incr_factor);
+  formantShift.setFormantRatio(new_scale_factor);
+  return new_scale_factor;
 }
 
 
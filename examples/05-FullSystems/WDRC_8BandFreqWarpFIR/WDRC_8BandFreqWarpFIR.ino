@@ -12,7 +12,6 @@
 
 //Include the needed Libraries and header files
 #include <Tympan_Library.h>
-#include "AudioFilterFreqWarpAllPassFIR_F32.h"
 #include "SerialManager.h"
 
 
@@ -32,7 +31,7 @@ AudioSettings_F32   audio_settings(sample_rate_Hz, audio_block_samples);
 Tympan       					audioHardware(TympanRev::D);   //TympanRev::D or TympanRev::C
 AudioInputI2S_F32               i2s_in(audio_settings);        //Digital audio *from* the Teensy Audio Board ADC.
 AudioTestSignalGenerator_F32    audioTestGenerator(audio_settings); //move this to be *after* the creation of the i2s_in object
-AudioFilterFreqWarpAllPassFIR_F32   freqWarpFilterBank(audio_settings);
+AudioFilterFreqWarpFIRBank_F32  freqWarpFilterBank(audio_settings);  //8 bands by default
 AudioEffectCompWDRC_F32        expCompLim[N_CHAN];     //here are the per-band compressors
 AudioMixer8_F32                 mixer1;
 AudioMixer8_F32                 mixer2;
@@ -285,8 +284,8 @@ void setup() {
   //End of setup
   if (USE_VOLUME_KNOB) servicePotentiometer(millis());
   //delay(200);
-  //freqWarpFilterBank.setFirCoeff_viaFFT(); //prints filter coefficients
-  //freqWarpFilterBank.setFirCoeff(); //prints filter coefficients
+  freqWarpFilterBank.setBands(N_CHAN);  //equally wide on the warped scale (or give the crossover frequencies, too)
+  freqWarpFilterBank.printBands(&Serial);
   printGainSettings();
   Serial.println("Setup complete.");
 
@@ -0,0 +1,133 @@
+/*
+ * beamformer_sim
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop check of StftBeamformer (src/utility/stft_beamformer.h).  A tone arrives from the
+ *    look direction and a spread of tones (the interferer) from elsewhere, as plane waves on a line
+ *    of mics.  For each mode, prints the change in the target's level and the gain in the
+ *    signal-to-interference ratio, measured over the last second, after the adaptive modes settle.
+ *    Returns 1 if any mode changes the target by more than 0.5 dB, or if an adaptive mode (MVDR, GSC)
+ *    gains less than delay-and-sum.
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -Isrc extras/host/beamformer_sim.cpp src/utility/stft_beamformer.cpp src/utility/BTNRH_rfft.cpp -o beamformer_sim
+ *        ./beamformer_sim                       (4 mics 5 cm apart, 24 kHz, N=128, 2x overlap, two targets)
+ *        ./beamformer_sim 1031.25 120 0.05      (target Hz, interferer deg, mic spacing m)
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include "utility/stft_beamformer.h"
+
+#define N_MICS 4
+#define N_INTERF_TONES 48
+#define SIM_SECONDS 6.0f
+#define MEASURE_SECONDS 1.0f
+#define TARGET_TOL_DB 0.5f
+
+static const float fs_Hz = 24000.0f;
+static const int N_FFT = 128, overlap = 2, block = 32;
+
+//one plane-wave tone at the mics: mic c hears it pos/c seconds early (see StftBeamformer::steeringVector)
+struct Tone { double f_Hz, amp, phase; };
+static double toneAt(const Tone &t, double time_sec) { return t.amp * sin(2.0 * M_PI * t.f_Hz * time_sec + t.phase); }
+
+//the level of the tone at f_Hz in y, by least squares, and what's left over
+static void fitTone(const std::vector<float> &y, size_t start, double f_Hz, double *amp, double *resid_pow) {
+	double cc = 0, ss = 0, cs = 0, yc = 0, ys = 0;
+	for (size_t i = start; i < y.size(); i++) {
+		const double c = cos(2.0 * M_PI * f_Hz * i / fs_Hz), s = sin(2.0 * M_PI * f_Hz * i / fs_Hz);
+		cc += c * c;  ss += s * s;  cs += c * s;  yc += y[i] * c;  ys += y[i] * s;
+	}
+	const double det = cc * ss - cs * cs;
+	const double a = (yc * ss - ys * cs) / det, b = (ys * cc - yc * cs) / det;
+	double r = 0.0;
+	for (size_t i = start; i < y.size(); i++) {
+		const double e = y[i] - a * cos(2.0 * M_PI * f_Hz * i / fs_Hz) - b * sin(2.0 * M_PI * f_Hz * i / fs_Hz);
+		r += e * e;
+	}
+	*amp = sqrt(a * a + b * b);
+	*resid_pow = r / (y.size() - start);
+}
+
+static bool runCase(float target_Hz, float interf_deg, float spacing_m) {
+	static const char *names[] = {"DAS", "SUPERDIRECTIVE", "MVDR", "GSC"};
+	const float pos_m[N_MICS] = {0.0f, spacing_m, 2 * spacing_m, 3 * spacing_m};
+	const Tone target = {target_Hz, 0.5, 0.3};
+	std::vector<Tone> interf;
+	srand(1);
+	double interf_pow = 0.0;
+	for (int t = 0; t < N_INTERF_TONES; t++) {
+		Tone it = {200.0 + (9800.0 * rand()) / RAND_MAX, 0.0, (2.0 * M_PI * rand()) / RAND_MAX};
+		if (fabs(it.f_Hz - target_Hz) < 50.0) continue;
+		it.amp = 1.0;
+		interf_pow += 0.5;
+		interf.push_back(it);
+	}
+	for (auto &it : interf) it.amp *= 0.5 / sqrt(2.0 * interf_pow);   //the same power as a 0.5 amplitude tone
+
+	//the mic signals
+	const int n = (int)(SIM_SECONDS * fs_Hz);
+	std::vector<float> mic[N_MICS];
+	const double c_mps = STFT_BEAMFORMER_SPEED_OF_SOUND;
+	const double lead_interf = cos(interf_deg * M_PI / 180.0) / c_mps;
+	for (int m = 0; m < N_MICS; m++) {
+		mic[m].resize(n);
+		for (int i = 0; i < n; i++) {
+			const double t = i / (double)fs_Hz;
+			double x = toneAt(target, t + pos_m[m] / c_mps);   //look direction is 0 deg (endfire)
+			for (auto &it : interf) x += toneAt(it, t + pos_m[m] * lead_interf);
+			mic[m][i] = (float)x;
+		}
+	}
+	const size_t start = (size_t)((SIM_SECONDS - MEASURE_SECONDS) * fs_Hz);
+	double in_amp, in_resid;
+	fitTone(mic[0], start, target_Hz, &in_amp, &in_resid);
+	const double sir_in_dB = 10.0 * log10(0.5 * in_amp * in_amp / in_resid);
+
+	bool pass = true;
+	double das_sir_gain_dB = 0.0;
+	for (int mode = StftBeamformer::DELAY_AND_SUM; mode <= StftBeamformer::GSC; mode++) {
+		static StftBeamformer bf;
+		bf.setLinearArray_m(spacing_m, N_MICS);
+		bf.setLookDirection_deg(0.0f);
+		bf.setup(fs_Hz, N_MICS, N_FFT, overlap);
+		bf.setMode((StftBeamformer::Mode)mode);
+
+		std::vector<float> y(n);
+		for (int i = 0; i < n; i += block) {
+			const float *x[N_MICS];
+			for (int m = 0; m < N_MICS; m++) x[m] = &mic[m][i];
+			bf.process(x, &y[i], block);
+		}
+		double out_amp, out_resid;
+		fitTone(y, start, target_Hz, &out_amp, &out_resid);
+		const double target_dB = 20.0 * log10(out_amp / in_amp);
+		const double sir_gain_dB = 10.0 * log10(0.5 * out_amp * out_amp / out_resid) - sir_in_dB;
+		if (mode == StftBeamformer::DELAY_AND_SUM) das_sir_gain_dB = sir_gain_dB;
+		bool ok = fabs(target_dB) <= TARGET_TOL_DB;
+		if ((mode >= StftBeamformer::MVDR) && (sir_gain_dB < das_sir_gain_dB)) ok = false;
+		if (!ok) pass = false;
+		printf("%.2f,%.0f,%.3f,%s,%.2f,%.1f,%s\n", target_Hz, interf_deg, spacing_m, names[mode], target_dB, sir_gain_dB, ok ? "PASS" : "FAIL");
+	}
+	return pass;
+}
+
+int main(int argc, char *argv[]) {
+	printf("target_Hz,interferer_deg,spacing_m,mode,target_change_dB,sir_gain_dB,result\n");
+	if (argc >= 2) {
+		float interf_deg = (argc >= 3) ? (float)atof(argv[2]) : 120.0f;
+		float spacing_m = (argc >= 4) ? (float)atof(argv[3]) : 0.05f;
+		return runCase((float)atof(argv[1]), interf_deg, spacing_m) ? 0 : 1;
+	}
+	bool pass = true;
+	pass = runCase(1031.25f, 120.0f, 0.05f) && pass;   //between two bins
+	pass = runCase(937.5f, 120.0f, 0.05f) && pass;     //on a bin
+	pass = runCase(2500.0f, 60.0f, 0.05f) && pass;
+	return pass ? 0 : 1;
+}
@@ -0,0 +1,325 @@
+/*
+ * bench_nodes
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop benchmark of the library's audio nodes.  The nodes are built from the library's
+ *    own source, against the small Arduino/Teensy/CMSIS stand-ins in extras/host/shim, and each one
+ *    is fed a block at a time, just as the Teensy's audio interrupt would.  Only the node's update()
+ *    is timed.  Every node is run at each block size (8 to 128) and sample rate (24 to 96 kHz).
+ *
+ *    Prints one CSV line per case, for keeping track of speed from one version of the library to the
+ *    next (run it before and after a change, and compare):
+ *        node,config,block,fs_Hz,ns_per_sample,ns_per_block,host_load_pct
+ *    ns_per_sample is per output sample (for a decimator, per input sample), taken as the median over
+ *    many rounds (so it is steady to a few percent), and
+ *    host_load_pct is the share of real time that the node would take on this PC.  The CMSIS
+ *    functions are plain-C stand-ins here, so compare host numbers only with host numbers.
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -std=c++11 -Iextras/host/shim -Isrc -Isrc/utility extras/host/bench_nodes.cpp extras/host/shim/shim.cpp \
+ *            src/AudioStream_F32.cpp src/AudioFilterFIR_F32.cpp src/AudioFilterBiquad_F32.cpp src/FFT_Overlapped_F32.cpp \
+ *            src/AudioMultirate_F32.cpp src/AudioEffectDelayLong_F32.cpp src/synth_sine_f32.cpp src/synth_oscbank_f32.cpp \
+ *            src/synth_whitenoise_f32.cpp src/synth_pinknoise_f32.cpp src/AudioCalcOctaveBands_F32.cpp src/AudioCalcLevelStats_F32.cpp \
+ *            src/AudioFilterFreqWarpFIRBank_F32.cpp src/AudioEffectPhaseVocoder_F32.cpp \
+ *            src/utility/osc_bank.cpp src/utility/noise_f32.cpp src/utility/delay_line.cpp src/utility/octave_bank.cpp \
+ *            src/utility/level_stats.cpp src/utility/level_meter_bank.cpp src/utility/freq_weighting.cpp \
+ *            src/utility/freq_warp_bank.cpp src/utility/phase_vocoder.cpp src/utility/stft_beamformer.cpp \
+ *            src/utility/BTNRH_rfft.cpp -o bench_nodes
+ *        ./bench_nodes                  (everything, 540 cases: about 20 s)
+ *        ./bench_nodes FIR              (only the nodes whose name contains "FIR")
+ *        ./bench_nodes FIR quick        (only block 128 at 48 kHz)
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "AudioStream_F32.h"
+#include "AudioFilterFIR_F32.h"
+#include "AudioFilterBiquad_F32.h"
+#include "AudioEffectCompWDRC_F32.h"
+#include "AudioEffectCompressor_F32.h"
+#include "FFT_Overlapped_F32.h"
+#include "AudioMixer_F32.h"
+#include "AudioMultirate_F32.h"
+#include "AudioEffectDelayLong_F32.h"
+#include "AudioCalcOctaveBands_F32.h"
+#include "AudioCalcLevelStats_F32.h"
+#include "AudioCalcLevelN_F32.h"
+#include "AudioFilterFreqWarpFIRBank_F32.h"
+#include "AudioEffectPhaseVocoder_F32.h"
+#include "AudioEffectBeamformerN_F32.h"
+#include "synth_sine_f32.h"
+#include "synth_oscbank_f32.h"
+#include "synth_whitenoise_f32.h"
+#include "synth_pinknoise_f32.h"
+
+#define BENCH_POOL_BLOCKS 192   //the most that AudioStream_F32 allows
+#define BENCH_MAX_IN 32
+#define BENCH_MAX_OUT 8
+
+// ///////////////////////////////////////// the harness's own nodes
+
+//sends a new block of test audio (a few sines plus a little noise, around -20 dBFS) on every update
+class BenchSource : public AudioStream_F32 {
+	public:
+		BenchSource(const AudioSettings_F32 &settings, int seed, int _length) : AudioStream_F32(0, NULL),
+			fs_Hz(settings.sample_rate_Hz), length(_length) {
+			state = 12345u + 7919u * seed;
+			phase = 0.1 * seed;
+		}
+		void update(void) {
+			audio_block_f32_t *block = allocate_f32();
+			if (!block) return;
+			block->length = length;
+			for (int i = 0; i < length; i++) {
+				state = state * 1664525u + 1013904223u;
+				const float noise = ((int32_t)state) * (0.01f / 2147483648.0f);
+				block->data[i] = (float)(0.1 * sin(phase) + 0.03 * sin(7.3 * phase)) + noise;
+				phase += 2.0 * M_PI * 440.0 / fs_Hz;
+			}
+			block->fs_Hz = fs_Hz;
+			transmit(block);
+			release(block);
+		}
+	private:
+		float fs_Hz;
+		int length;
+		uint32_t state;
+		double phase;
+};
+
+//takes (and releases) whatever arrives on its inputs
+class BenchSink : public AudioStream_F32 {
+	public:
+		BenchSink(void) : AudioStream_F32(BENCH_MAX_OUT, inputQueueArray) {}
+		void update(void) {
+			for (int i = 0; i < BENCH_MAX_OUT; i++) {
+				audio_block_f32_t *block = receiveReadOnly_f32(i);
+				if (block) { n_blocks++; release(block); }
+			}
+		}
+		unsigned long n_blocks = 0;
+	private:
+		audio_block_f32_t *inputQueueArray[BENCH_MAX_OUT];
+};
+
+//FFT_Overlapped_F32 and IFFT_Overlapped_F32 are building blocks, not nodes, so wrap them the way
+//the FFT-based examples use them: analyze, then resynthesize
+class BenchFFTRoundTrip : public AudioStream_F32 {
+	public:
+		BenchFFTRoundTrip(const AudioSettings_F32 &settings, int N_FFT) : AudioStream_F32(1, inputQueueArray) {
+			N = fft.setup(settings, N_FFT);
+			ifft.setup(settings, N_FFT);
+			buffer = new float[2 * N];
+		}
+		~BenchFFTRoundTrip(void) { delete[] buffer; }
+		void update(void) {
+			audio_block_f32_t *in = receiveReadOnly_f32();
+			if (!in) return;
+			fft.execute(in, buffer);
+			fft.rebuildNegativeFrequencySpace(buffer);
+			audio_block_f32_t *out = ifft.execute(buffer);
+			release(in);
+			transmit(out);
+		}
+	private:
+		audio_block_f32_t *inputQueueArray[1];
+		FFT_Overlapped_F32 fft;
+		IFFT_Overlapped_F32 ifft;
+		int N = 0;
+		float *buffer;
+};
+
+// ///////////////////////////////////////// the nodes to time
+
+struct Bench {
+	AudioStream_F32 *node;                 //for making the connections
+	std::function<void(void)> update;      //the node's update() (it's private to AudioStream_F32)
+	std::function<void(void)> destroy;
+	int n_in, n_out;
+	int in_div;   //the inputs get blocks this many times shorter than the outputs (for interpolators)
+};
+
+struct BenchCase {
+	const char *name;
+	const char *config;
+	std::function<Bench(const AudioSettings_F32 &)> make;
+};
+
+template <typename T> Bench wrap(T *node, int n_in, int n_out) {
+	Bench b;
+	b.node = node;
+	b.update = [node]() { node->update(); };
+	b.destroy = [node]() { delete node; };
+	b.n_in = n_in;
+	b.n_out = n_out;
+	b.in_div = 1;
+	return b;
+}
+
+static std::vector<float> lowpassFIR(int n_taps) {
+	std::vector<float> h(n_taps);
+	for (int i = 0; i < n_taps; i++) {
+		double t = i - 0.5 * (n_taps - 1), x = 2.0 * M_PI * 0.2 * t;
+		double win = 0.54 - 0.46 * cos(2.0 * M_PI * i / (n_taps - 1));
+		h[i] = (float)(0.4 * ((fabs(x) < 1.0e-9) ? 1.0 : sin(x) / x) * win);
+	}
+	return h;
+}
+
+static std::vector<BenchCase> buildCases(void) {
+	static std::vector<float> fir32 = lowpassFIR(32), fir128 = lowpassFIR(128);
+	std::vector<BenchCase> c;
+
+	c.push_back({"AudioFilterFIR_F32", "taps=32", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioFilterFIR_F32(s); n->begin(fir32.data(), 32, s.audio_block_samples); return wrap(n, 1, 1); }});
+	c.push_back({"AudioFilterFIR_F32", "taps=128", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioFilterFIR_F32(s); n->begin(fir128.data(), 128, s.audio_block_samples); return wrap(n, 1, 1); }});
+	c.push_back({"AudioFilterBiquad_F32", "stages=1", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioFilterBiquad_F32(s); n->setLowpass(0, 1000.0f); return wrap(n, 1, 1); }});
+	c.push_back({"AudioEffectCompWDRC_F32", "default", [](const AudioSettings_F32 &s) {
+		return wrap(new AudioEffectCompWDRC_F32(s), 1, 1); }});
+	c.push_back({"AudioEffectCompressor_F32", "default", [](const AudioSettings_F32 &s) {
+		return wrap(new AudioEffectCompressor_F32(s), 1, 1); }});
+	c.push_back({"FFT_Overlapped_F32", "N_FFT=256,fft+ifft", [](const AudioSettings_F32 &s) {
+		return wrap(new BenchFFTRoundTrip(s, 256), 1, 1); }});
+	c.push_back({"AudioMixer4_F32", "inputs=4", [](const AudioSettings_F32 &s) {
+		return wrap(new AudioMixer4_F32(s), 4, 1); }});
+	c.push_back({"AudioMixer8_F32", "inputs=8", [](const AudioSettings_F32 &s) {
+		return wrap(new AudioMixer8_F32(s), 8, 1); }});
+	c.push_back({"AudioMixerN_F32", "inputs=32,half_muted", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioMixerN_F32<32>(s); for (int i = 16; i < 32; i++) n->gain(i, 0.0f); return wrap(n, 32, 1); }});
+	c.push_back({"AudioDecimate_F32", "factor=4", [](const AudioSettings_F32 &s) {
+		return wrap(new AudioDecimate_F32(s, 4), 1, 1); }});
+	c.push_back({"AudioInterpolate_F32", "factor=4", [](const AudioSettings_F32 &s) {
+		Bench b = wrap(new AudioInterpolate_F32(s, 4), 1, 1); b.in_div = 4; return b; }});
+	c.push_back({"AudioEffectDelayLong_F32", "taps=8,cubic,2sec", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioEffectDelayLong_F32(s); n->begin(2000.0f);
+		for (int t = 0; t < 8; t++) n->delay(t, 100.0f + 200.0f * t + 0.37f);
+		return wrap(n, 1, 8); }});
+	c.push_back({"AudioCalcOctaveBands_F32", "third-octave,25Hz-20kHz", [](const AudioSettings_F32 &s) {
+		return wrap(new AudioCalcOctaveBands_F32(s), 1, 0); }});
+	c.push_back({"AudioCalcOctaveBands_F32", "octave,31.5Hz-16kHz", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioCalcOctaveBands_F32(s); n->setBandsPerOctave(1); n->setFreqRange_Hz(31.5f, 16000.0f); return wrap(n, 1, 0); }});
+	c.push_back({"AudioCalcLevelStats_F32", "interval=60s", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioCalcLevelStats_F32(s); n->setInterval_sec(60.0f); return wrap(n, 1, 0); }});
+	c.push_back({"AudioCalcLevelN_F32", "channels=8,A,FAST", [](const AudioSettings_F32 &s) {
+		return wrap(new AudioCalcLevelN_F32<8>(s), 8, 0); }});
+	c.push_back({"AudioCalcLevelN_F32", "channels=16,A,IMPULSE", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioCalcLevelN_F32<16>(s); n->setTimeWeighting(LevelMeterBank::IMPULSE); return wrap(n, 16, 0); }});
+	c.push_back({"AudioFilterFreqWarpFIRBank_F32", "bands=8,taps=33", [](const AudioSettings_F32 &s) {
+		return wrap(new AudioFilterFreqWarpFIRBank_F32(s), 1, 8); }});
+	c.push_back({"AudioFilterFreqWarpFIRBank_F32", "bands=16,taps=49", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioFilterFreqWarpFIRBank_F32(s); n->setNumTaps(49); n->setBands(16); return wrap(n, 1, 16); }});
+	c.push_back({"AudioEffectPhaseVocoder_F32", "N_FFT=512,formant=1.5", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioEffectPhaseVocoder_F32(s); n->setFormantRatio(1.5f); return wrap(n, 1, 1); }});
+	c.push_back({"AudioEffectPhaseVocoder_F32", "N_FFT=512,pitch=1.5,keep formants", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioEffectPhaseVocoder_F32(s); n->setPitchRatio(1.5f); n->setFormantRatio(1.0f); return wrap(n, 1, 1); }});
+	c.push_back({"AudioEffectBeamformerN_F32", "mics=2,SUPERDIRECTIVE", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioEffectBeamformerN_F32<2>(s); n->setMode(StftBeamformer::SUPERDIRECTIVE); return wrap(n, 2, 1); }});
+	c.push_back({"AudioEffectBeamformerN_F32", "mics=4,MVDR", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioEffectBeamformerN_F32<4>(s); n->setLinearArray_m(0.05f); n->setMode(StftBeamformer::MVDR); return wrap(n, 4, 1); }});
+	c.push_back({"AudioEffectBeamformerN_F32", "mics=4,GSC", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioEffectBeamformerN_F32<4>(s); n->setLinearArray_m(0.05f); n->setMode(StftBeamformer::GSC); return wrap(n, 4, 1); }});
+	c.push_back({"AudioSynthWaveformSine_F32", "default", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioSynthWaveformSine_F32(s); n->frequency(1000.0f); n->amplitude(0.5f); return wrap(n, 0, 1); }});
+	c.push_back({"AudioSynthOscillatorBank_F32", "tones=8", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioSynthOscillatorBank_F32(s); for (int i = 0; i < 8; i++) n->addTone(250.0f * (i + 1), 0.05f);
+		return wrap(n, 0, 1); }});
+	c.push_back({"AudioSynthNoiseWhite_F32", "uniform", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioSynthNoiseWhite_F32(s); n->amplitude(0.5f); return wrap(n, 0, 1); }});
+	c.push_back({"AudioSynthNoisePink_F32", "default", [](const AudioSettings_F32 &s) {
+		auto *n = new AudioSynthNoisePink_F32(s); n->amplitude(0.5f); return wrap(n, 0, 1); }});
+	return c;
+}
+
+// ///////////////////////////////////////// timing
+
+static double nowNs(void) {
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//the cost of reading the clock twice, which is taken off of every timed update()
+static double timerOverheadNs(void) {
+	std::vector<double> t;
+	for (int r = 0; r < 15; r++) {
+		double total = 0.0;
+		for (int i = 0; i < 10000; i++) { double t0 = nowNs(); double t1 = nowNs(); total += t1 - t0; }
+		t.push_back(total / 10000);
+	}
+	std::sort(t.begin(), t.end());
+	return t[t.size() / 2];
+}
+static double timer_overhead_ns = 0.0;
+
+static void runCase(const BenchCase &bc, int block, float fs_Hz) {
+	AudioSettings_F32 settings(fs_Hz, block);
+	AudioMemory_F32(BENCH_POOL_BLOCKS, settings);
+
+	Bench b = bc.make(settings);
+	std::vector<BenchSource *> sources;
+	std::vector<AudioConnection_F32 *> patch;
+	BenchSink *sink = new BenchSink();
+	for (int i = 0; i < b.n_in; i++) {
+		sources.push_back(new BenchSource(settings, i, block / b.in_div));
+		patch.push_back(new AudioConnection_F32(*sources.back(), 0, *b.node, i));
+	}
+	for (int i = 0; i < b.n_out; i++) patch.push_back(new AudioConnection_F32(*b.node, i, *sink, i));
+
+	//time the node's update() by itself, a block at a time.  Each round covers at least 16k samples.
+	auto one = [&](void) {
+		for (auto *src : sources) src->update();
+		double t0 = nowNs();
+		b.update();
+		double t1 = nowNs();
+		sink->update();
+		return t1 - t0 - timer_overhead_ns;
+	};
+	const int per_round = std::max(16, 16384 / block);
+	for (int i = 0; i < per_round; i++) one();    //warm up
+	const int n_rounds = 15;
+	std::vector<double> ns_per_sample;
+	for (int r = 0; r < n_rounds; r++) {
+		double total = 0.0;
+		for (int i = 0; i < per_round; i++) total += one();
+		ns_per_sample.push_back(total / ((double)per_round * block));
+	}
+	std::sort(ns_per_sample.begin(), ns_per_sample.end());
+	const double med = ns_per_sample[n_rounds / 2];
+	if ((b.n_out > 0) && (sink->n_blocks == 0)) fprintf(stderr, "bench_nodes: %s (%s) made no output at block %d, %.0f Hz\n", bc.name, bc.config, block, fs_Hz);
+
+	printf("%s,\"%s\",%d,%.0f,%.3f,%.1f,%.4f\n", bc.name, bc.config, block, fs_Hz, med, med * block, med * fs_Hz * 1.0e-7);
+
+	for (auto *p : patch) delete p;
+	for (auto *src : sources) delete src;
+	delete sink;
+	b.destroy();
+}
+
+int main(int argc, char *argv[]) {
+	const char *filter = (argc > 1) ? argv[1] : "";
+	const bool quick = (argc > 2) && (strcmp(argv[2], "quick") == 0);
+
+	std::vector<int> blocks = {8, 16, 32, 64, 128};
+	std::vector<float> rates = {24000.0f, 44100.0f, 48000.0f, 96000.0f};
+	if (quick) { blocks = {128}; rates = {48000.0f}; }
+
+	timer_overhead_ns = timerOverheadNs();
+	printf("node,config,block,fs_Hz,ns_per_sample,ns_per_block,host_load_pct\n");
+	for (const BenchCase &bc : buildCases()) {
+		if (!strstr(bc.name, filter)) continue;
+		for (int block : blocks) {
+			for (float fs : rates) runCase(bc, block, fs);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * convert_f32_check
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop check that the fast (SSE2) versions of the conversion kernels in
+ *    src/utility/convert_f32.h give bit-for-bit the same results as the plain C loops, which are what
+ *    every other target runs.  The plain C loops are the same source, built a second time here (in
+ *    their own namespace) with CONVERT_F32_PLAIN_C.  Every kernel is run on:
+ *      - random samples, from well inside full scale to well past it (so that they saturate);
+ *      - the edges: +/-1.0, one step either side of full scale, +/-0.0, denormals, +/-1e30 and +/-inf;
+ *      - every int16 value, and random 32-bit slots at 32, 24 and 16 data bits;
+ *    at every length from 0 to 40, and 127, 128 and 129, with the buffers also one sample out of line.
+ *    Prints one line per kernel and returns 1 if any result differs.  (The Teensy's __SSAT/__PKHBT
+ *    versions can't be run here.)
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -Iextras/host/shim -Isrc extras/host/convert_f32_check.cpp src/utility/convert_f32.cpp -o convert_f32_check
+ *        ./convert_f32_check
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include "utility/convert_f32.h"
+
+#if !defined(__SSE2__)
+	#error "convert_f32_check compares the SSE2 versions against the plain C ones, so it needs SSE2"
+#endif
+
+//the same kernels, with only their plain C loops
+namespace plain_c {
+	#define CONVERT_F32_PLAIN_C
+	#include "utility/convert_f32.cpp"
+	#undef CONVERT_F32_PLAIN_C
+}
+
+#define MAX_CHAN 4
+#define MAX_LEN 130
+static const int lengths[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28,
+	29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 127, 128, 129};
+
+//float samples: the edges first (repeated through the buffer), then random ones up to +/-2.0
+static void fillFloat(float *x, const int n, const int seed) {
+	static const float edges[] = {1.0f, -1.0f, 0.0f, -0.0f, 32767.0f / 32767.0f, 32766.5f / 32767.0f, 32767.5f / 32767.0f,
+		-32767.5f / 32767.0f, -32768.0f / 32767.0f, -32768.5f / 32767.0f, 1.0f + 1.0f / 32767.0f, -1.0f - 1.0f / 32767.0f,
+		1.0e-40f, -1.0e-40f, 1.0e-45f, -1.0e-45f, 1.17549435e-38f, 1.0e30f, -1.0e30f, INFINITY, -INFINITY,
+		0.99999994f, -0.99999994f, 1.00000012f, -1.00000012f, 0.5f / 32767.0f, -0.5f / 32767.0f, 2.0f, -2.0f};
+	const int n_edges = sizeof(edges) / sizeof(edges[0]);
+	srand(seed);
+	for (int i = 0; i < n; i++) {
+		if ((seed & 1) && (i < n_edges)) x[i] = edges[(i + seed) % n_edges];
+		else x[i] = 4.0f * rand() / (float)RAND_MAX - 2.0f;
+	}
+}
+
+static void fillI16(int16_t *x, const int n, const int seed) {
+	srand(seed);
+	for (int i = 0; i < n; i++) x[i] = (int16_t)(rand() & 0xFFFF);
+	if (n > 0) x[0] = -32768;
+	if (n > 1) x[n - 1] = 32767;
+}
+
+static void fillI32(int32_t *x, const int n, const int seed) {
+	srand(seed);
+	for (int i = 0; i < n; i++) x[i] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand() ^ ((uint32_t)rand() << 31));
+	if (n > 0) x[0] = (int32_t)0x80000000;
+	if (n > 1) x[n - 1] = 0x7FFFFFFF;
+}
+
+//run the fast and the plain versions of one kernel over every length, alignment, and input, and compare
+//their outputs bit for bit.  run(fast, in_offset, out_offset, n, seed) fills the inputs, runs one version,
+//and returns a pointer to (and the size of) its output.
+struct Output { const void *p; size_t bytes; };
+template <class Run>
+static bool check(const char *name, Run run) {
+	long n_runs = 0, n_bad = 0;
+	for (int len : lengths) {
+		for (int off = 0; off < 2; off++) {
+			for (int seed = 1; seed <= 8; seed++) {
+				std::vector<unsigned char> fast_out, plain_out;
+				Output o = run(true, off, len, seed);
+				fast_out.assign((const unsigned char *)o.p, (const unsigned char *)o.p + o.bytes);
+				o = run(false, off, len, seed);
+				plain_out.assign((const unsigned char *)o.p, (const unsigned char *)o.p + o.bytes);
+				n_runs++;
+				if (fast_out != plain_out) {
+					if (n_bad == 0) printf("  %s differs: length %d, offset %d, seed %d\n", name, len, off, seed);
+					n_bad++;
+				}
+			}
+		}
+	}
+	printf("%s: %ld runs, %ld differ: %s\n", name, n_runs, n_bad, (n_bad == 0) ? "PASS" : "FAIL");
+	return n_bad == 0;
+}
+
+int main(void) {
+	static float f_in[MAX_CHAN][MAX_LEN + 1], f_out[MAX_CHAN][MAX_LEN + 1];
+	static int16_t i16_in[MAX_CHAN * MAX_LEN + 1], i16_out[MAX_CHAN * MAX_LEN + 1];
+	static int32_t i32_in[MAX_CHAN * MAX_LEN + 1], i32_out[MAX_CHAN * MAX_LEN + 1];
+	bool pass = true;
+
+	//float to int16
+	pass = check("f32_to_i16_sat", [&](bool fast, int off, int n, int seed) {
+		fillFloat(f_in[0] + off, n, seed);
+		memset(i16_out, 0x55, sizeof(i16_out));
+		(fast ? f32_to_i16_sat : plain_c::f32_to_i16_sat)(f_in[0] + off, i16_out + off, n);
+		return Output{i16_out, sizeof(i16_out)}; }) && pass;
+	for (int nchan : {2, 3, 4}) {
+		char name[48];
+		snprintf(name, sizeof(name), "interleave_f32_to_i16, %d chan", nchan);
+		pass = check(name, [&](bool fast, int off, int n, int seed) {
+			float *p[MAX_CHAN];
+			for (int c = 0; c < nchan; c++) { p[c] = f_in[c] + off;  fillFloat(p[c], n, seed + 16 * c); }
+			memset(i16_out, 0x55, sizeof(i16_out));
+			(fast ? interleave_f32_to_i16 : plain_c::interleave_f32_to_i16)(p, i16_out + off, n, nchan);
+			return Output{i16_out, sizeof(i16_out)}; }) && pass;
+	}
+
+	//int16 to float
+	pass = check("i16_to_f32_scaled", [&](bool fast, int off, int n, int seed) {
+		fillI16(i16_in + off, n, seed);
+		memset(f_out, 0x55, sizeof(f_out));
+		(fast ? i16_to_f32_scaled : plain_c::i16_to_f32_scaled)(i16_in + off, f_out[0] + off, n);
+		return Output{f_out, sizeof(f_out)}; }) && pass;
+	for (int nchan : {2, 3, 4}) {
+		char name[48];
+		snprintf(name, sizeof(name), "deinterleave_i16_to_f32, %d chan", nchan);
+		pass = check(name, [&](bool fast, int off, int n, int seed) {
+			float *p[MAX_CHAN];
+			for (int c = 0; c < nchan; c++) p[c] = f_out[c] + off;
+			fillI16(i16_in + off, n * nchan, seed);
+			memset(f_out, 0x55, sizeof(f_out));
+			(fast ? deinterleave_i16_to_f32 : plain_c::deinterleave_i16_to_f32)(i16_in + off, p, n, nchan);
+			return Output{f_out, sizeof(f_out)}; }) && pass;
+	}
+	{
+		//every int16 value, once
+		static int16_t all[65536];
+		static float fast_f[65536], plain_f[65536];
+		for (int i = 0; i < 65536; i++) all[i] = (int16_t)(i - 32768);
+		i16_to_f32_scaled(all, fast_f, 65536);
+		plain_c::i16_to_f32_scaled(all, plain_f, 65536);
+		const bool ok = (memcmp(fast_f, plain_f, sizeof(fast_f)) == 0);
+		printf("i16_to_f32_scaled, every int16 value: %s\n", ok ? "PASS" : "FAIL");
+		pass = pass && ok;
+	}
+
+	//32-bit I2S slots to float
+	for (int bits : {32, 24, 16}) {
+		for (int nchan : {2, 3, 4}) {
+			char name[64];
+			snprintf(name, sizeof(name), "deinterleave_i32_to_f32, %d chan, %d bits", nchan, bits);
+			pass = check(name, [&](bool fast, int off, int n, int seed) {
+				float *p[MAX_CHAN];
+				for (int c = 0; c < nchan; c++) p[c] = f_out[c] + off;
+				fillI32(i32_in + off, n * nchan, seed);
+				memset(f_out, 0x55, sizeof(f_out));
+				(fast ? deinterleave_i32_to_f32 : plain_c::deinterleave_i32_to_f32)(i32_in + off, p, n, nchan, bits);
+				return Output{f_out, sizeof(f_out)}; }) && pass;
+		}
+	}
+
+	//float to 32-bit I2S slots
+	for (int nchan : {2, 3}) {
+		char name[48];
+		snprintf(name, sizeof(name), "interleave_f32_to_i32, %d chan", nchan);
+		pass = check(name, [&](bool fast, int off, int n, int seed) {
+			float *p[MAX_CHAN];
+			for (int c = 0; c < nchan; c++) { p[c] = f_in[c] + off;  fillFloat(p[c], n, seed + 16 * c); }
+			memset(i32_out, 0x55, sizeof(i32_out));
+			(fast ? interleave_f32_to_i32 : plain_c::interleave_f32_to_i32)(p, i32_out + off, n, nchan);
+			return Output{i32_out, sizeof(i32_out)}; }) && pass;
+	}
+
+	printf("%s\n", pass ? "PASS" : "FAIL");
+	return pass ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+/*
+ * delay_line_sim
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop test of DelayLine (src/utility/delay_line.h).  A sine goes into the delay line
+ *    and each tap's output is compared with the ideal delayed sine.  Prints one CSV line per case:
+ *    the error (in dB re: the signal) for whole-sample and fractional delays, for each kind of
+ *    interpolation and storage, and the cost in ns per output sample per tap.  Also checks that a
+ *    delay of many seconds comes out sample-exact, and that a jump in delay doesn't click.
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -Isrc extras/host/delay_line_sim.cpp src/utility/delay_line.cpp -o delay_line_sim
+ *        ./delay_line_sim
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+#include "utility/delay_line.h"
+
+static const char *interpName(DelayLine::Interp i) { return (i == DelayLine::NONE) ? "none" : ((i == DelayLine::LINEAR) ? "linear" : "cubic"); }
+
+//error of one tap against the ideal delayed sine, in dB re: the sine
+static void runCase(DelayLine::Storage storage, DelayLine::Interp interp, float delay, float f_norm, int block) {
+	const float seconds_equiv = 4.0f;                       //a 4 s ring at 48 kHz
+	std::vector<float> mem_f(DelayLine::samplesNeeded((uint32_t)(seconds_equiv * 48000), block));
+	DelayLine dl;
+	dl.setBuffer(mem_f.data(), mem_f.size(), storage, block);  //(an int16 ring just uses half of the memory)
+	dl.setInterpolation(interp);
+	for (int t = 0; t < DELAY_LINE_MAX_TAPS; t++) dl.setDelay_samples(t, delay + t * 0.125f);
+
+	std::vector<float> in(block), out(block), scratch(block);
+	double sig = 0.0, err = 0.0;
+	long n = 0;
+	const long n_total = (long)(delay + 40 * 48000.0 / 10.0);
+	double read_ns = 0.0;
+	long n_read = 0;
+	while (n < n_total) {
+		for (int i = 0; i < block; i++) in[i] = (float)(0.5 * sin(2.0 * M_PI * f_norm * (n + i)));
+		dl.write(in.data(), block);
+		auto t0 = std::chrono::steady_clock::now();
+		dl.readTap(0, out.data());
+		for (int t = 1; t < DELAY_LINE_MAX_TAPS; t++) dl.readTap(t, scratch.data());
+		auto t1 = std::chrono::steady_clock::now();
+		read_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+		for (int i = 0; i < block; i++) {
+			double tt = (double)(n + i) - dl.getDelay_samples(0);
+			if (tt < 4.0) continue;
+			double ideal = 0.5 * sin(2.0 * M_PI * f_norm * tt);
+			sig += ideal * ideal;
+			err += (out[i] - ideal) * (out[i] - ideal);
+		}
+		n_read += DELAY_LINE_MAX_TAPS * block;
+		n += block;
+	}
+	printf("%s,%s,%d,%.3f,%.4f,%.1f,%.2f\n", (storage == DelayLine::INT16) ? "int16" : "float", interpName(interp),
+		block, delay, f_norm, 10.0 * log10((err + 1.0e-30) / sig), read_ns / n_read);
+}
+
+//a 10 s delay, sample exact, with an int16 ring in less memory than the float queue of AudioEffectDelay_F32
+static void longDelayCheck(void) {
+	const int block = 128;
+	const uint32_t delay = 10 * 48000 + 17;
+	std::vector<int16_t> mem(DelayLine::samplesNeeded(delay, block));
+	DelayLine dl;
+	dl.setBuffer(mem.data(), mem.size(), DelayLine::INT16, block);
+	dl.setDelay_samples(0, (float)delay);
+	std::vector<float> in(block), out(block);
+	long n = 0, n_bad = 0;
+	while (n < (long)delay + 3 * 48000) {
+		for (int i = 0; i < block; i++) in[i] = (float)(((n + i) % 997) - 498) / 512.0f;
+		dl.write(in.data(), block);
+		dl.readTap(0, out.data());
+		for (int i = 0; i < block; i++) {
+			long src = n + i - (long)delay;
+			float ideal = (src < 0) ? 0.0f : (float)((src % 997) - 498) / 512.0f;
+			if (fabsf(out[i] - ideal) > 1.0f / 32767.0f) n_bad++;
+		}
+		n += block;
+	}
+	printf("\nlong_delay_sec,memory_kB,max_delay_sec,bad_samples\n");
+	printf("%.3f,%.0f,%.3f,%ld\n", delay / 48000.0, mem.size() * 2 / 1024.0, dl.getMaxDelay_samples() / 48000.0, n_bad);
+}
+
+//step the delay by a large amount while a sine plays.  The largest jump from one sample to the next
+//shows whether there was a click (a sine at 0.5 amplitude moves at most 0.5*2*pi*f_norm per sample).
+static void jumpCheck(void) {
+	const int block = 32;
+	const float f_norm = 1000.0f / 48000.0f;
+	std::vector<float> mem(DelayLine::samplesNeeded(48000, block));
+	DelayLine dl;
+	dl.setBuffer(mem.data(), mem.size(), DelayLine::FLOAT32, block);
+	dl.setDelay_samples(0, 100.0f);
+	std::vector<float> in(block), out(block);
+	float prev = 0.0f, max_step = 0.0f;
+	for (long n = 0; n < 48000; n += block) {
+		if (n == 24000) dl.setDelay_samples(0, 30000.3f);
+		for (int i = 0; i < block; i++) in[i] = (float)(0.5 * sin(2.0 * M_PI * f_norm * (n + i)));
+		dl.write(in.data(), block);
+		dl.readTap(0, out.data());
+		for (int i = 0; i < block; i++) {
+			if ((n + i > 200) && (fabsf(out[i] - prev) > max_step)) max_step = fabsf(out[i] - prev);
+			prev = out[i];
+		}
+	}
+	printf("\njump_max_step,sine_max_step\n%.4f,%.4f\n", max_step, 0.5 * 2.0 * M_PI * f_norm);
+}
+
+int main(void) {
+	printf("storage,interp,block,delay_samples,f_norm,error_dB,ns_per_sample_per_tap\n");
+	const DelayLine::Storage storages[] = {DelayLine::FLOAT32, DelayLine::INT16};
+	const DelayLine::Interp interps[] = {DelayLine::NONE, DelayLine::LINEAR, DelayLine::CUBIC};
+	const float delays[] = {1000.0f, 1000.5f, 96000.25f};
+	const float freqs[] = {1000.0f / 48000.0f, 4000.0f / 48000.0f};
+	for (auto s : storages) for (auto in : interps) for (float d : delays) for (float f : freqs) runCase(s, in, d, f, 128);
+	for (int block : {8, 16, 32, 64}) runCase(DelayLine::FLOAT32, DelayLine::CUBIC, 1000.5f, 1000.0f / 48000.0f, block);
+	longDelayCheck();
+	jumpCheck();
+	return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * dma_ring_sim
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop model of the I2S DMA ring in src/utility/dma_ring.h.  Runs the I2S DMA
+ *    ring + interrupt + audio update schedule for a set of block sizes, periods, period counts,
+ *    and CPU loads, and prints one CSV line per case.  Use it to pick the dma_period_samples and
+ *    dma_num_periods for AudioSettings_F32 before trying them on the hardware.
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -Isrc extras/host/dma_ring_sim.cpp src/utility/dma_ring.cpp -o dma_ring_sim
+ *        ./dma_ring_sim                      (sweep of common settings)
+ *        ./dma_ring_sim 32 64 4 0.8 44100    (block, period, n_periods, cpu_load, sample rate)
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "utility/dma_ring.h"
+
+//Desktop model of the I2S DMA + interrupt + audio-update schedule.  It drives two AudioDMARings
+//(input and output) in exactly the way the I2S classes do, while checking every block against the
+//simulated DMA positions.  Time is measured in frames (sample periods).
+class AudioDMARingSim {
+	public:
+		struct Config {
+			int block_frames = 128;
+			int period_frames = 0;         //0 is one block per period
+			int n_periods = 2;
+			int max_ring_frames = 1024;
+			float cpu_load = 0.5f;         //time for one pass of the audio graph, as a fraction of a block
+			float isr_latency_frames = 0.1f; //delay from the end of a DMA period to its interrupt running
+			float tx_offset_frames = 0.5f; //the output DMA starts this much later than the input DMA
+			bool input_has_responsibility = true;
+			uint32_t duration_frames = 48000;
+		};
+		struct Result {
+			bool config_ok;
+			int period_frames, n_periods, ring_frames;
+			unsigned long n_interrupts;      //both DMA channels
+			unsigned long n_updates;         //passes of the audio graph
+			unsigned long n_blocks_checked;  //blocks that made it from input to output
+			int latency_target_frames;
+			int latency_min_frames, latency_max_frames;
+			unsigned long n_input_underrun, n_input_overrun, n_output_underrun, n_output_overrun;
+			unsigned long n_skipped_updates, n_starved;
+			unsigned long n_read_errors;     //block read before the DMA wrote it, or after the DMA overwrote it
+			unsigned long n_write_errors;    //block finished after the DMA had started sending it
+		};
+		static Result run(const Config &cfg);
+};
+
+AudioDMARingSim::Result AudioDMARingSim::run(const Config &cfg) {
+	Result res = {};
+	AudioDMARing rx, tx;
+	res.config_ok = rx.configure(cfg.block_frames, cfg.period_frames, cfg.n_periods, cfg.max_ring_frames);
+	tx.configure(cfg.block_frames, cfg.period_frames, cfg.n_periods, cfg.max_ring_frames);
+	res.period_frames = rx.getPeriodFrames();
+	res.n_periods = rx.getNumPeriods();
+	res.ring_frames = rx.getRingFrames();
+	res.latency_target_frames = tx.getLatencyFrames();
+	res.latency_min_frames = 0x7FFFFFFF;
+	res.latency_max_frames = -1;
+	if (!res.config_ok) { res.latency_min_frames = -1; return res; }
+
+	const int B = rx.getBlockFrames(), P = rx.getPeriodFrames(), R = rx.getRingFrames();
+	const int tx_off = (int)cfg.tx_offset_frames;  //the SAI starts both sides on a frame boundary
+	const double pass_time = cfg.cpu_load * B;
+	const double never = 1.0e30;
+
+	//the DMA positions at time t.  Frame f is captured during [f, f+1) and written to the ring at f+1.
+	//The output DMA fetches frame f at time tx_off + f.
+	#define RX_ABS(t) ((uint32_t)(t))
+	#define TX_ABS(t) ((uint32_t)(((t) > tx_off) ? ((t) - tx_off) : 0))
+
+	double t = 0.0;
+	double next_rx_isr = P + cfg.isr_latency_frames;
+	double next_tx_isr = tx_off + P + cfg.isr_latency_frames;
+	double pass_start = 0.0, pass_end = never;
+	bool sw_pending = false, running = false;
+	bool have_input_block = false;
+	uint32_t input_start = 0;
+
+	while (t < cfg.duration_frames) {
+		if (sw_pending && !running) {
+			//start a pass of the audio graph.  The input's update() runs first.
+			running = true; sw_pending = false;
+			pass_start = t;  pass_end = t + pass_time;
+			res.n_updates++;
+			if (rx.updateStarted() && cfg.input_has_responsibility) sw_pending = true;
+			uint32_t rx_abs = RX_ABS(t);
+			int idx = rx.startRead(rx.framesNow(rx_abs % R));
+			have_input_block = (idx >= 0);
+			if (have_input_block) {
+				input_start = rx.getLastBlockStart();
+				if ((input_start + B > rx_abs) || (rx_abs + 1 > input_start + R)) res.n_read_errors++;
+			}
+			continue;
+		}
+
+		double next = next_rx_isr;
+		if (next_tx_isr < next) next = next_tx_isr;
+		if (running && (pass_end < next)) next = pass_end;
+		t = next;
+
+		if (t == next_rx_isr) {
+			res.n_interrupts++;
+			if ((rx.periodDone() > 0) && cfg.input_has_responsibility) sw_pending = true;
+			next_rx_isr += P;
+		} else if (t == next_tx_isr) {
+			res.n_interrupts++;
+			if ((tx.periodDone() > 0) && !cfg.input_has_responsibility) sw_pending = true;
+			if (tx.isStarved()) res.n_starved++;
+			next_tx_isr += P;
+		} else {
+			//end of the pass.  The output's update() runs last.
+			running = false;  pass_end = never;
+			if (tx.updateStarted() && !cfg.input_has_responsibility) sw_pending = true;
+			uint32_t tx_abs = TX_ABS(t);
+			int lead = tx.getOutputLead(&rx, rx.framesNow(RX_ABS(t) % R));
+			tx.startWrite(tx.framesNow(tx_abs % R), lead, rx.isStarted());
+			uint32_t w = tx.getLastBlockStart();
+			bool ok = true;
+			if ((double)(tx_off + w) < t) ok = false;   //the DMA had already started sending it
+			if ((int32_t)(w + B - R - TX_ABS(pass_start)) > 0) ok = false;  //it overwrote frames that weren't sent yet
+			if (!ok) res.n_write_errors++;
+			if (have_input_block && ok) {
+				int lat = (int)(tx_off + w - input_start);
+				if (lat < res.latency_min_frames) res.latency_min_frames = lat;
+				if (lat > res.latency_max_frames) res.latency_max_frames = lat;
+				res.n_blocks_checked++;
+			}
+		}
+	}
+	#undef RX_ABS
+	#undef TX_ABS
+
+	if (res.latency_max_frames < 0) res.latency_min_frames = -1;
+	res.n_input_underrun = rx.getUnderrunCount();
+	res.n_input_overrun = rx.getOverrunCount();
+	res.n_output_underrun = tx.getUnderrunCount();
+	res.n_output_overrun = tx.getOverrunCount();
+	res.n_skipped_updates = rx.getSkippedUpdateCount() + tx.getSkippedUpdateCount();
+	return res;
+}
+
+static void printHeader(void) {
+	printf("block,period,n_periods,ring,fs_Hz,cpu_load,responsibility,config_ok,"
+		"interrupts_per_sec,latency_target,latency_min,latency_max,latency_msec,"
+		"in_underrun,in_overrun,out_underrun,out_overrun,skipped,starved,read_errors,write_errors\n");
+}
+
+static void runCase(int block, int period, int nper, float load, float fs_Hz, bool input_resp) {
+	AudioDMARingSim::Config cfg;
+	cfg.block_frames = block;
+	cfg.period_frames = period;
+	cfg.n_periods = nper;
+	cfg.max_ring_frames = 4096;
+	cfg.cpu_load = load;
+	cfg.input_has_responsibility = input_resp;
+	cfg.duration_frames = (uint32_t)fs_Hz;  //one second
+	AudioDMARingSim::Result res = AudioDMARingSim::run(cfg);
+
+	printf("%d,%d,%d,%d,%.0f,%.2f,%s,%d,%.1f,%d,%d,%d,%.3f,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n",
+		block, res.period_frames, res.n_periods, res.ring_frames, fs_Hz, load,
+		input_resp ? "input" : "output", res.config_ok ? 1 : 0,
+		0.5f * res.n_interrupts * fs_Hz / cfg.duration_frames,  //per DMA channel
+		res.latency_target_frames, res.latency_min_frames, res.latency_max_frames,
+		1000.0f * res.latency_target_frames / fs_Hz,
+		res.n_input_underrun, res.n_input_overrun, res.n_output_underrun, res.n_output_overrun,
+		res.n_skipped_updates, res.n_starved, res.n_read_errors, res.n_write_errors);
+}
+
+int main(int argc, char *argv[]) {
+	printHeader();
+	if (argc >= 4) {
+		float load = (argc >= 5) ? (float)atof(argv[4]) : 0.5f;
+		float fs_Hz = (argc >= 6) ? (float)atof(argv[5]) : 44100.0f;
+		runCase(atoi(argv[1]), atoi(argv[2]), atoi(argv[3]), load, fs_Hz, true);
+		runCase(atoi(argv[1]), atoi(argv[2]), atoi(argv[3]), load, fs_Hz, false);
+		return 0;
+	}
+
+	const int blocks[] = {8, 16, 32, 64, 128};
+	const int periods[] = {0, 32, 64, 128, 256};
+	const int nperiods[] = {2, 4, 8};
+	const float loads[] = {0.3f, 0.9f};
+	for (int block : blocks) {
+		for (int period : periods) {
+			for (int nper : nperiods) {
+				if (!AudioDMARing::isValid(block, period, nper, 4096)) continue;
+				for (float load : loads) runCase(block, period, nper, load, 44100.0f, true);
+			}
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * fast_sweep
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop run of AudioControlTestFastSweep_F32: a full gain-vs-frequency-and-level
+ *    characterization of the WDRC_8BandFIR example's fit (its 8-band FIR filterbank and per-band
+ *    WDRC compressors, with that example's settings), driven offline as fast as the PC will go.  The
+ *    graph is the same one the Tympan uses for its sweeps: AudioTestSignalGenerator_F32 into the
+ *    filterbank, and AudioTestSignalMeasurementMulti_F32 taking the generator's output plus the 8
+ *    bands.  Prints one CSV line per level and frequency:
+ *        stimulus,level_dBFS,freq_Hz,input_dBFS,band1_dBFS,...,band8_dBFS,total_gain_dB,h2_dB,h3_dB
+ *    where total_gain_dB is the gain of the 8 bands summed (as by the example's mixer) and h2_dB and
+ *    h3_dB are the 2nd and 3rd harmonics relative to the fundamental (log sweep only).  The last line
+ *    says how long the audio was and how long it took.
+ *
+ *    "check" runs the filterbank alone (no compressors), which is linear, and compares the measured
+ *    gain of the summed bands with the gain computed from the FIR coefficients.  Both test signals
+ *    should agree with it to a small fraction of a dB.
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -std=c++11 -Iextras/host/shim -Isrc -Isrc/utility extras/host/fast_sweep.cpp extras/host/shim/shim.cpp \
+ *            src/AudioStream_F32.cpp src/AudioFilterFIR_F32.cpp src/AudioConfigFIRFilterBank_F32.cpp src/AudioControlTester.cpp \
+ *            src/synth_sine_f32.cpp src/record_queue_f32.cpp src/utility/BTNRH_rfft.cpp src/utility/osc_bank.cpp \
+ *            src/utility/sweep_measure.cpp -o fast_sweep
+ *        ./fast_sweep                 (multitone, -80 to 0 dBFS in 10 dB steps)
+ *        ./fast_sweep sweep           (log sweep)
+ *        ./fast_sweep check           (both, on the filterbank alone)
+ *    The library's own table of results goes to stderr.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+
+#include "AudioStream_F32.h"
+#include "AudioFilterFIR_F32.h"
+#include "AudioEffectCompWDRC_F32.h"
+#include "AudioConfigFIRFilterBank_F32.h"
+#include "AudioControlTester.h"
+
+//the example's own settings
+namespace fir_example {
+	#include "../../examples/05-FullSystems/WDRC_8BandFIR/GHA_Constants.h"
+}
+
+#define N_CHAN 8
+#define N_FIR 96
+
+static const float sample_rate_Hz = 24000.0f;
+static const int audio_block_samples = 16;
+
+// ///////////////////////////////////////// the graph, as in the example
+
+static AudioSettings_F32 audio_settings(sample_rate_Hz, audio_block_samples);
+static AudioTestSignalGenerator_F32 *testGenerator;
+static AudioFilterFIR_F32 *firFilt[N_CHAN];
+static AudioEffectCompWDRC_F32 *expCompLim[N_CHAN];
+static AudioTestSignalMeasurementMulti_F32 *testMeasurement;
+static std::vector<AudioConnection_F32 *> patchCords;
+static bool with_wdrc = true;
+static float firCoeff[N_CHAN][N_FIR];
+
+static void buildGraph(void) {
+	using namespace fir_example;
+	AudioMemory_F32(192, audio_settings);
+	testGenerator = new AudioTestSignalGenerator_F32(audio_settings);
+	testMeasurement = new AudioTestSignalMeasurementMulti_F32(audio_settings);
+	AudioConfigFIRFilterBank_F32 makeFIRcoeffs(N_CHAN, N_FIR, sample_rate_Hz, (float *)dsl.cross_freq, (float *)firCoeff);
+	patchCords.push_back(new AudioConnection_F32(*testGenerator, 0, *testMeasurement, 0));
+	for (int i = 0; i < N_CHAN; i++) {
+		firFilt[i] = new AudioFilterFIR_F32();
+		firFilt[i]->begin(firCoeff[i], N_FIR, audio_block_samples);
+		expCompLim[i] = new AudioEffectCompWDRC_F32();
+		patchCords.push_back(new AudioConnection_F32(*testGenerator, 0, *firFilt[i], 0));
+
+		//as configurePerBandWDRCs() in the example
+		float bolt = dsl.bolt[i], tkgain = dsl.tkgain[i];
+		if (bolt > gha.tk) bolt = gha.tk;
+		if (tkgain < 0) bolt = bolt + tkgain;
+		expCompLim[i]->setSampleRate_Hz(sample_rate_Hz);
+		expCompLim[i]->setParams(dsl.attack, dsl.release, dsl.maxdB, dsl.exp_cr[i], dsl.exp_end_knee[i], tkgain, dsl.cr[i], dsl.tk[i], bolt);
+		if (with_wdrc) {
+			patchCords.push_back(new AudioConnection_F32(*firFilt[i], 0, *expCompLim[i], 0));
+			patchCords.push_back(new AudioConnection_F32(*expCompLim[i], 0, *testMeasurement, 1 + i));
+		} else {
+			patchCords.push_back(new AudioConnection_F32(*firFilt[i], 0, *testMeasurement, 1 + i));
+		}
+	}
+}
+
+static void destroyGraph(void) {
+	for (auto *p : patchCords) delete p;
+	patchCords.clear();
+	for (int i = 0; i < N_CHAN; i++) { delete firFilt[i]; delete expCompLim[i]; }
+	delete testGenerator;
+	delete testMeasurement;
+}
+
+//one pass of the audio interrupt, in the order the nodes are connected
+static void updateGraph(void) {
+	testGenerator->update();
+	for (int i = 0; i < N_CHAN; i++) firFilt[i]->update();
+	if (with_wdrc) for (int i = 0; i < N_CHAN; i++) expCompLim[i]->update();
+	testMeasurement->update();
+}
+
+// ///////////////////////////////////////// running it
+
+//gain of the summed FIR filters at f_Hz, from their coefficients
+static float filterbankGain_dB(float f_Hz) {
+	double re = 0.0, im = 0.0;
+	for (int k = 0; k < N_FIR; k++) {
+		double h = 0.0;
+		for (int i = 0; i < N_CHAN; i++) h += firCoeff[i][k];
+		re += h * cos(2.0 * M_PI * f_Hz * k / sample_rate_Hz);
+		im -= h * sin(2.0 * M_PI * f_Hz * k / sample_rate_Hz);
+	}
+	return (float)(10.0 * log10(re * re + im * im));
+}
+
+//returns the largest error vs the filterbank's computed gain (only meaningful without the compressors)
+static float runSweep(SweepMeasure::Stimulus stimulus, bool print_csv) {
+	buildGraph();
+	AudioControlTestFastSweep_F32 tester(audio_settings, *testGenerator, *testMeasurement);
+	tester.setStimulus(stimulus);
+	tester.setNumChannels(N_CHAN);
+	tester.setFreqRange_Hz(125.f, 10000.f);
+	tester.setNumFrequencies(16);
+	tester.setStepPattern(-80.f, 0.f, 10.f);
+	tester.setTargetDurPerStep_sec(0.5);   //let the compressors settle
+	tester.setMeasureDur_sec((stimulus == SweepMeasure::LOG_SWEEP) ? 0.5f : 0.1f);
+
+	auto t0 = std::chrono::steady_clock::now();
+	bool ok = tester.runOffline(updateGraph);
+	double wall_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+	SweepMeasure &m = tester.getMeasurement();
+	const char *name = (stimulus == SweepMeasure::LOG_SWEEP) ? "log_sweep" : "multitone";
+	float max_err_dB = 0.0f;
+	for (int L = 0; ok && (L < m.getNumLevels()); L++) {
+		for (int f = 0; f < m.getNumFreqs(); f++) {
+			if (print_csv) {
+				printf("%s,%.1f,%.1f,%.2f", name, m.getLevel_dBFS(L), m.getFreq_Hz(f), m.getInput_dBFS(L, f));
+				for (int c = 0; c < N_CHAN; c++) printf(",%.2f", m.getOutput_dBFS(L, f, c));
+				printf(",%.2f,%.1f,%.1f\n", m.getTotalGain_dB(L, f), m.getHarmonic_dB(L, f, 2), m.getHarmonic_dB(L, f, 3));
+			}
+			float err = fabsf(m.getTotalGain_dB(L, f) - filterbankGain_dB(m.getFreq_Hz(f)));
+			if (err > max_err_dB) max_err_dB = err;
+		}
+	}
+	const double audio_sec = m.getTotalSamples() / sample_rate_Hz;
+	printf("# %s: %s, %.1f sec of audio in %.3f sec (%.0fx real time)\n", name, ok ? "done" : "FAILED", audio_sec, wall_sec, audio_sec / wall_sec);
+	destroyGraph();
+	return ok ? max_err_dB : 999.0f;
+}
+
+int main(int argc, char *argv[]) {
+	const bool check = (argc > 1) && !strcmp(argv[1], "check");
+	const bool sweep = (argc > 1) && !strcmp(argv[1], "sweep");
+	if (check) {
+		with_wdrc = false;
+		float err_mt = runSweep(SweepMeasure::MULTITONE, false);
+		float err_ls = runSweep(SweepMeasure::LOG_SWEEP, false);
+		printf("stimulus,max_err_dB\nmultitone,%.4f\nlog_sweep,%.4f\n", err_mt, err_ls);
+		return ((err_mt < 0.1f) && (err_ls < 0.1f)) ? 0 : 1;
+	}
+	printf("stimulus,level_dBFS,freq_Hz,input_dBFS");
+	for (int c = 0; c < N_CHAN; c++) printf(",band%d_dBFS", c + 1);
+	printf(",total_gain_dB,h2_dB,h3_dB\n");
+	runSweep(sweep ? SweepMeasure::LOG_SWEEP : SweepMeasure::MULTITONE, true);
+	return 0;
+}
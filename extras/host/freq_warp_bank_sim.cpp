@@ -0,0 +1,188 @@
+/*
+ * freq_warp_bank_sim
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop check of FreqWarpFilterBank (src/utility/freq_warp_bank.h), the filterbank behind
+ *    AudioFilterFreqWarpFIRBank_F32.  Plays steady sines through process() and fits each band's output
+ *    (and all the bands added together) by least squares.  Checks:
+ *      - the bands add up to 0.000 dB (within 0.0005 dB) at every frequency from 50 Hz to 0.45*fs;
+ *      - at every crossover, each of the two bands that meet there is at -6.02 dB (within 0.15 dB: the
+ *        other bands' skirts leave them at -5.92 dB with 8 bands and 33 taps, and -6.13 dB with 16 and 49).
+ *    Then it times the bank against the per-band loop of the WDRC_8BandFreqWarpFIR example's old
+ *    AudioFilterFreqWarpAllPassFIR_F32 (31 allpass objects, then a 32-tap dot product per band), copied
+ *    here, on the same input.  Prints the ratio and fails if the bank is not faster.  Returns 1 if any
+ *    check fails.
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -Isrc extras/host/freq_warp_bank_sim.cpp src/utility/freq_warp_bank.cpp -o freq_warp_bank_sim
+ *        ./freq_warp_bank_sim              (8 bands, 33 taps, at 24 kHz, as in the example)
+ *        ./freq_warp_bank_sim 16 49 44100  (bands, taps, sample rate)
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include <chrono>
+#include "utility/freq_warp_bank.h"
+
+#define SUM_TOL_DB 0.0005
+#define XOVER_DB -6.0206
+#define XOVER_TOL_DB 0.15
+#define SETTLE_SEC 0.2
+#define MEASURE_SEC 0.2
+#define N_FREQS 120
+#define BENCH_SEC 20.0
+
+static const int block = 16;   //as in the example
+
+//the amplitude of the sine at f_Hz in y[start..], by least squares
+static double fitAmp(const std::vector<float> &y, const long start, const double f_Hz, const double fs_Hz) {
+	double cc = 0, ss = 0, cs = 0, yc = 0, ys = 0;
+	for (size_t i = start; i < y.size(); i++) {
+		const double c = cos(2.0 * M_PI * f_Hz * i / fs_Hz), s = sin(2.0 * M_PI * f_Hz * i / fs_Hz);
+		cc += c * c;  ss += s * s;  cs += c * s;  yc += y[i] * c;  ys += y[i] * s;
+	}
+	const double det = cc * ss - cs * cs;
+	const double a = (yc * ss - ys * cs) / det, b = (ys * cc - yc * cs) / det;
+	return sqrt(a * a + b * b);
+}
+
+//play a sine (amplitude 1) and give back each band's gain, and the sum's, in dB
+static void bandGains_dB(FreqWarpFilterBank &bank, const double fs_Hz, const double f_Hz, std::vector<double> &gain_dB, double *sum_dB) {
+	const int nb = bank.getNumBands();
+	const long n_total = block * (long)((SETTLE_SEC + MEASURE_SEC) * fs_Hz / block), start = (long)(SETTLE_SEC * fs_Hz);
+	std::vector<std::vector<float> > y(nb, std::vector<float>(n_total));
+	std::vector<float> x(block), sum(n_total, 0.0f);
+	std::vector<float *> yp(nb);
+	bank.clearStates();
+	for (long n = 0; n + block <= n_total; n += block) {
+		for (int i = 0; i < block; i++) x[i] = (float)sin(2.0 * M_PI * f_Hz * (n + i) / fs_Hz);
+		for (int b = 0; b < nb; b++) yp[b] = &y[b][n];
+		bank.process(x.data(), yp.data(), block);
+	}
+	gain_dB.resize(nb);
+	for (int b = 0; b < nb; b++) {
+		gain_dB[b] = 20.0 * log10(fitAmp(y[b], start, f_Hz, fs_Hz) + 1.0e-30);
+		for (long i = 0; i < n_total; i++) sum[i] += y[b][i];
+	}
+	*sum_dB = 20.0 * log10(fitAmp(sum, start, f_Hz, fs_Hz));
+}
+
+// ///////////////////////////////// the example's old filterbank (its per-sample work, as it was)
+
+#define N_FREQWARP_SAMP (32)
+#define N_FREQWARP_ALLPASS (31)
+#define N_FREQWARP_FIR (8)
+
+class FreqWarpAllPass {
+	public:
+		void setSampleRate_Hz(float fs_Hz) { rho = FreqWarpFilterBank::barkRho(fs_Hz); }
+		float update(const float &in_val) {
+			float out_val = ((-rho)*in_val) + prev_in + (rho*prev_out);
+			prev_in = in_val; prev_out = out_val;
+			return out_val;
+		}
+		float rho;
+	protected:
+		float prev_in = 0.0f, prev_out = 0.0f;
+};
+
+class OldFreqWarpBank {
+	public:
+		OldFreqWarpBank(const float fs_Hz) {
+			for (int I = 0; I < N_FREQWARP_ALLPASS; I++) freqWarpAllPass[I].setSampleRate_Hz(fs_Hz);
+			for (int I = 0; I < N_FREQWARP_SAMP; I++) delay_line[I] = 0.0f;
+			for (int F = 0; F < N_FREQWARP_FIR; F++) for (int I = 0; I < N_FREQWARP_SAMP; I++) all_FIR_coeff[F][I] = 0.01f * (F + I);
+		}
+		void process(const float *x, float * const *y, const int n) {
+			for (int Isamp = 0; Isamp < n; Isamp++) {
+				delay_line[0] = x[Isamp];
+				for (int Idelay = 1; Idelay < N_FREQWARP_SAMP; Idelay++) delay_line[Idelay] = freqWarpAllPass[Idelay-1].update(delay_line[Idelay-1]);
+				for (int I_fir = 0; I_fir < N_FREQWARP_FIR; I_fir++) {
+					float s = 0.0f;   //arm_dot_prod_f32()
+					for (int I = 0; I < N_FREQWARP_SAMP; I++) s += delay_line[I] * all_FIR_coeff[I_fir][I];
+					y[I_fir][Isamp] = s;
+				}
+			}
+		}
+	private:
+		FreqWarpAllPass freqWarpAllPass[N_FREQWARP_ALLPASS];
+		float delay_line[N_FREQWARP_SAMP];
+		float all_FIR_coeff[N_FREQWARP_FIR][N_FREQWARP_SAMP];
+};
+
+//seconds to run BENCH_SEC of noise through a bank with n_out outputs
+template <class Bank>
+static double timeBank(Bank &bank, const double fs_Hz, const int n_out, float *checksum) {
+	const long n_blocks = (long)(BENCH_SEC * fs_Hz / block);
+	std::vector<float> x(n_blocks * block);
+	std::vector<std::vector<float> > y(n_out, std::vector<float>(block));
+	std::vector<float *> yp(n_out);
+	for (int b = 0; b < n_out; b++) yp[b] = y[b].data();
+	srand(1);
+	for (size_t i = 0; i < x.size(); i++) x[i] = (2.0f * rand()) / RAND_MAX - 1.0f;
+	float s = 0.0f;
+	const auto t0 = std::chrono::steady_clock::now();
+	for (long k = 0; k < n_blocks; k++) {
+		bank.process(&x[k * block], yp.data(), block);
+		s += y[0][0];   //so that none of it is optimized away
+	}
+	const auto t1 = std::chrono::steady_clock::now();
+	*checksum = s;
+	return std::chrono::duration<double>(t1 - t0).count();
+}
+
+int main(int argc, char *argv[]) {
+	const int n_bands = (argc >= 2) ? atoi(argv[1]) : 8;
+	const int n_taps = (argc >= 3) ? atoi(argv[2]) : 33;
+	const double fs_Hz = (argc >= 4) ? atof(argv[3]) : 24000.0;
+	static FreqWarpFilterBank bank;
+	if (!bank.setup((float)fs_Hz, n_bands, NULL, n_taps)) {
+		fprintf(stderr, "freq_warp_bank_sim: bad settings\n");
+		return 1;
+	}
+	bool pass = true;
+	std::vector<double> g;
+	double sum_dB;
+
+	//the sum, from 50 Hz to 0.45*fs
+	double worst_sum_dB = 0.0, worst_sum_Hz = 0.0;
+	for (int k = 0; k < N_FREQS; k++) {
+		const double f = 50.0 * pow(0.45 * fs_Hz / 50.0, k / (double)(N_FREQS - 1));
+		bandGains_dB(bank, fs_Hz, f, g, &sum_dB);
+		if (fabs(sum_dB) > fabs(worst_sum_dB)) { worst_sum_dB = sum_dB;  worst_sum_Hz = f; }
+	}
+	bool ok = (fabs(worst_sum_dB) <= SUM_TOL_DB);
+	printf("%d bands, %d taps, rho %.4f, at %.0f Hz\n", n_bands, n_taps, bank.getRho(), fs_Hz);
+	printf("sum of the bands, 50 Hz to %.0f Hz: worst %+.4f dB at %.0f Hz: %s\n", 0.45 * fs_Hz, worst_sum_dB, worst_sum_Hz, ok ? "PASS" : "FAIL");
+	pass = pass && ok;
+
+	//each crossover
+	printf("crossover,Hz,lower_band_dB,upper_band_dB,sum_dB,result\n");
+	for (int i = 0; i < n_bands - 1; i++) {
+		const double f = bank.getCrossover_Hz(i);
+		bandGains_dB(bank, fs_Hz, f, g, &sum_dB);
+		ok = (fabs(g[i] - XOVER_DB) <= XOVER_TOL_DB) && (fabs(g[i+1] - XOVER_DB) <= XOVER_TOL_DB);
+		printf("%d,%.1f,%.3f,%.3f,%.4f,%s\n", i, f, g[i], g[i+1], sum_dB, ok ? "PASS" : "FAIL");
+		pass = pass && ok;
+	}
+
+	//against the example's old per-band loop (which was always 8 bands and 32 taps)
+	if ((n_bands == N_FREQWARP_FIR) && (n_taps == 33)) {
+		static OldFreqWarpBank old_bank((float)fs_Hz);
+		float c1, c2;
+		const double t_old = timeBank(old_bank, fs_Hz, N_FREQWARP_FIR, &c1);
+		const double t_new = timeBank(bank, fs_Hz, n_bands, &c2);
+		ok = (t_new < t_old);
+		printf("%.0f s of audio: old per-band loop %.3f s, FreqWarpFilterBank %.3f s, %.2fx faster (%g %g): %s\n",
+			BENCH_SEC, t_old, t_new, t_old / t_new, c1, c2, ok ? "PASS" : "FAIL");
+		pass = pass && ok;
+	}
+
+	printf("%s\n", pass ? "PASS" : "FAIL");
+	return pass ? 0 : 1;
+}
@@ -0,0 +1,478 @@
+/*
+ * golden_chains
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Regression check of whole processing chains, for making sure that an optimization (SIMD,
+ *    fast math, multirate, a new filter structure...) hasn't changed what the user hears.  Four
+ *    reference chains are built on the desktop from the library's own nodes (through the stand-ins
+ *    in extras/host/shim), set up exactly as in these examples, using the examples' own settings
+ *    and filter coefficients:
+ *        wdrc_fir      WDRC_8BandFIR: 8-band FIR filterbank, per-band WDRC, mixer, broadband limiter
+ *                      (24 kHz, blocks of 16)
+ *        wdrc_iir_afc  WDRC_8BandIIR_wBT_wAFC: adaptive feedback canceller, 8-band IIR filterbank with
+ *                      alignment delays, per-band WDRC, mixer, broadband limiter, loop back to the AFC
+ *                      (22.05 kHz, blocks of 16)
+ *        slm           SoundLevelMeter: A-weighting and Slow time weighting (44.117 kHz, blocks of 128)
+ *        decim_fanout  a decimator (by 4) feeding two biquad band filters, mixed and interpolated back up,
+ *                      which checks that blocks shared by in-place nodes keep their short length and low
+ *                      rate (24 kHz, blocks of 128)
+ *
+ *    Every chain is run over every mono WAV in an input folder (16-bit, 24-bit, or float; only the
+ *    first channel is used, and its samples are taken to be at the chain's own rate).  "record" saves
+ *    the outputs (32-bit float WAVs) as the golden reference.  "check" runs them again and compares
+ *    with the golden outputs.  For each chain and input, it prints a CSV line:
+ *        chain,input,bit_exact,max_abs_err,snr_dB,gain_dev_dB,pass
+ *    where snr_dB is the golden output's energy over the energy of the difference, and gain_dev_dB is
+ *    the largest change in level (in dB, over 10 msec frames louder than -90 dBFS; for the slm chain, whose
+ *    output is already a mean-square level, this is the change in the reported level).  That last one
+ *    shows any change to the fitted gain curve, even when the waveforms differ a bit more (as they
+ *    will when the order of float operations changes).  A case passes if it is within all three
+ *    tolerances.  The exit code is the number of cases that failed.
+ *
+ *    Note that the feedback canceller in wdrc_iir_afc is adaptive.  With tones at its input, even a
+ *    change in rounding sends its filter down a different path, so that case can fail on the waveform
+ *    (and on the level of single 10 msec frames) while sounding the same.  Look at its levels over
+ *    longer stretches before blaming the change.
+ *
+ *    Typical use: make the inputs and record the golden outputs with the library as it is, make your
+ *    change, then check.
+ *        g++ -O2 -std=c++11 -Iextras/host/shim -Isrc -Isrc/utility extras/host/golden_chains.cpp extras/host/shim/shim.cpp \
+ *            src/AudioStream_F32.cpp src/AudioFilterFIR_F32.cpp src/AudioFilterBiquad_F32.cpp src/AudioEffectDelay_f32.cpp \
+ *            src/AudioConfigFIRFilterBank_F32.cpp src/utility/BTNRH_rfft.cpp src/AudioFilterTimeWeighting_F32.cpp \
+ *            src/AudioCalcLevel_F32.cpp src/AudioMultirate_F32.cpp src/utility/noise_f32.cpp src/utility/freq_weighting.cpp \
+ *            -o golden_chains
+ *        ./golden_chains make-inputs golden_in
+ *        ./golden_chains record golden_in golden_ref
+ *        ... make your change, rebuild ...
+ *        ./golden_chains check golden_in golden_ref               (default tolerances)
+ *        ./golden_chains check golden_in golden_ref 0 999 0       (require bit-exact results)
+ *        ./golden_chains check golden_in golden_ref 1e-3 60 0.1   (max_abs_err, min snr_dB, max gain_dev_dB)
+ *
+ *    The inputs from make-inputs are made the same way on every machine: pink noise stepped in
+ *    level from -80 to -10 dBFS and back (to walk every compressor through its expansion, linear,
+ *    compression, and limiting regions, with attack and release), and a log sweep followed by
+ *    tone bursts.  Your own recordings can be added to the input folder, too.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "AudioStream_F32.h"
+#include "AudioFilterFIR_F32.h"
+#include "AudioFilterBiquad_F32.h"
+#include "AudioEffectDelay_f32.h"
+#include "AudioEffectCompWDRC_F32.h"
+#include "AudioMixer_F32.h"
+#include "AudioConfigFIRFilterBank_F32.h"
+#include "AudioFilterFreqWeighting_F32.h"
+#include "AudioCalcLevel_F32.h"
+#include "AudioMultirate_F32.h"
+#include "utility/noise_f32.h"
+
+//the examples' own settings and coefficients
+namespace fir_example {
+	#include "../../examples/05-FullSystems/WDRC_8BandFIR/GHA_Constants.h"
+}
+namespace iir_example {
+	#include "../../examples/05-FullSystems/WDRC_8BandIIR_wBT_wAFC/GHA_Constants.h"
+	#include "../../examples/05-FullSystems/WDRC_8BandIIR_wBT_wAFC/filter_coeff_sos.h"
+}
+#include "../../examples/05-FullSystems/WDRC_8BandIIR_wBT_wAFC/AudioEffectFeedbackCancel_F32.h"
+
+#define GOLDEN_POOL_BLOCKS 192
+#define GOLDEN_INPUT_FS_HZ 24000
+
+// ///////////////////////////////////////// WAV files
+
+static bool readWav(const std::string &fname, std::vector<float> &x, int &fs_Hz) {
+	FILE *f = fopen(fname.c_str(), "rb");
+	if (!f) return false;
+	char id[4];
+	uint32_t size;
+	uint16_t format = 0, n_chan = 0, bits = 0;
+	bool ok = (fread(id, 1, 4, f) == 4) && !memcmp(id, "RIFF", 4) && (fread(&size, 4, 1, f) == 1) &&
+		(fread(id, 1, 4, f) == 4) && !memcmp(id, "WAVE", 4);
+	while (ok && (fread(id, 1, 4, f) == 4) && (fread(&size, 4, 1, f) == 1)) {
+		if (!memcmp(id, "fmt ", 4)) {
+			uint8_t fmt[40] = {0};
+			if (fread(fmt, 1, std::min<uint32_t>(size, 40), f) < 16) { ok = false; break; }
+			if (size > 40) fseek(f, size - 40, SEEK_CUR);
+			format = fmt[0] | (fmt[1] << 8);
+			n_chan = fmt[2] | (fmt[3] << 8);
+			fs_Hz = fmt[4] | (fmt[5] << 8) | (fmt[6] << 16) | (fmt[7] << 24);
+			bits = fmt[14] | (fmt[15] << 8);
+			if ((format == 0xFFFE) && (size >= 26)) format = fmt[24] | (fmt[25] << 8);  //WAVE_FORMAT_EXTENSIBLE
+		} else if (!memcmp(id, "data", 4)) {
+			if ((n_chan == 0) || !(((format == 1) && ((bits == 16) || (bits == 24))) || ((format == 3) && (bits == 32)))) { ok = false; break; }
+			const int bytes = bits / 8, frame = bytes * n_chan;
+			std::vector<uint8_t> raw(size);
+			size_t n_read = fread(raw.data(), 1, size, f);
+			x.resize(n_read / frame);
+			for (size_t i = 0; i < x.size(); i++) {
+				const uint8_t *p = &raw[i * frame];   //first channel only
+				if (format == 3) { memcpy(&x[i], p, 4); }
+				else if (bits == 16) { x[i] = (int16_t)(p[0] | (p[1] << 8)) / 32768.0f; }
+				else { x[i] = ((int32_t)((p[0] << 8) | (p[1] << 16) | (p[2] << 24)) >> 8) / 8388608.0f; }
+			}
+			fclose(f);
+			return true;
+		} else {
+			fseek(f, size + (size & 1), SEEK_CUR);
+		}
+	}
+	fclose(f);
+	return false;
+}
+
+static bool writeWav(const std::string &fname, const std::vector<float> &x, int fs_Hz) {
+	FILE *f = fopen(fname.c_str(), "wb");
+	if (!f) return false;
+	const uint32_t data_bytes = x.size() * 4, riff_bytes = 4 + 8 + 16 + 8 + data_bytes;
+	const uint16_t format = 3, n_chan = 1, block_align = 4, bits = 32;
+	const uint32_t fmt_bytes = 16, rate = fs_Hz, byte_rate = fs_Hz * 4;
+	fwrite("RIFF", 1, 4, f); fwrite(&riff_bytes, 4, 1, f); fwrite("WAVE", 1, 4, f);
+	fwrite("fmt ", 1, 4, f); fwrite(&fmt_bytes, 4, 1, f); fwrite(&format, 2, 1, f); fwrite(&n_chan, 2, 1, f);
+	fwrite(&rate, 4, 1, f); fwrite(&byte_rate, 4, 1, f); fwrite(&block_align, 2, 1, f); fwrite(&bits, 2, 1, f);
+	fwrite("data", 1, 4, f); fwrite(&data_bytes, 4, 1, f); fwrite(x.data(), 4, x.size(), f);
+	fclose(f);
+	return true;
+}
+
+static std::vector<std::string> listWavs(const std::string &dir) {
+	std::vector<std::string> names;
+	DIR *d = opendir(dir.c_str());
+	if (!d) return names;
+	while (struct dirent *e = readdir(d)) {
+		std::string name = e->d_name;
+		if ((name.size() > 4) && (name.substr(name.size() - 4) == ".wav")) names.push_back(name);
+	}
+	closedir(d);
+	std::sort(names.begin(), names.end());
+	return names;
+}
+
+// ///////////////////////////////////////// test inputs
+
+static void makeInputs(const std::string &dir) {
+	mkdir(dir.c_str(), 0755);
+	const double fs = GOLDEN_INPUT_FS_HZ;
+
+	//pink noise, stepped from -80 to -10 dBFS (RMS) and back, 0.5 sec per step
+	{
+		NoiseGenerator noise;  noise.setSeed(20261018);
+		PinkFilter pink;  pink.setup((float)fs);
+		const int n_step = (int)(0.5 * fs);
+		std::vector<float> x;
+		std::vector<float> seg(n_step);
+		for (int k = 0; k < 15; k++) {
+			const float level_dB = (k <= 7) ? (-80.0f + 10.0f * k) : (-10.0f - 10.0f * (k - 7));
+			noise.generate(seg.data(), n_step, sqrtf(3.0f) * powf(10.0f, 0.05f * level_dB));
+			pink.process(seg.data(), n_step);
+			x.insert(x.end(), seg.begin(), seg.end());
+		}
+		writeWav(dir + "/level_steps.wav", x, (int)fs);
+	}
+
+	//log sweep (100 Hz to 10 kHz over 4 sec at -25 dBFS), then 1 kHz + 3 kHz bursts alternating -60 and -20 dBFS
+	{
+		std::vector<float> x;
+		const double f0 = 100.0, f1 = 10000.0, T = 4.0, L = T / log(f1 / f0);
+		for (int i = 0; i < (int)(T * fs); i++) {
+			const double t = i / fs;
+			x.push_back((float)(0.0562 * sin(2.0 * M_PI * f0 * L * (exp(t / L) - 1.0))));
+		}
+		for (int k = 0; k < 8; k++) {
+			const double amp = (k & 1) ? 0.1 : 0.001;
+			for (int i = 0; i < (int)(0.25 * fs); i++) {
+				const double t = i / fs;
+				x.push_back((float)(amp * (sin(2.0 * M_PI * 1000.0 * t) + sin(2.0 * M_PI * 3000.0 * t))));
+			}
+		}
+		writeWav(dir + "/tone_sweep.wav", x, (int)fs);
+	}
+}
+
+// ///////////////////////////////////////// running a chain
+
+//plays the input, one block per update()
+class GoldenSource : public AudioStream_F32 {
+	public:
+		GoldenSource(const std::vector<float> &_x) : AudioStream_F32(0, NULL), x(_x) {}
+		void update(void) {
+			audio_block_f32_t *block = allocate_f32();
+			if (!block) return;
+			for (int i = 0; i < block->length; i++, pos++) block->data[i] = (pos < x.size()) ? x[pos] : 0.0f;
+			transmit(block);
+			release(block);
+		}
+	private:
+		const std::vector<float> &x;
+		size_t pos = 0;
+};
+
+//records the output
+class GoldenSink : public AudioStream_F32 {
+	public:
+		GoldenSink(void) : AudioStream_F32(1, inputQueueArray) {}
+		void update(void) {
+			audio_block_f32_t *block = receiveReadOnly_f32();
+			if (!block) return;
+			y.insert(y.end(), block->data, block->data + block->length);
+			release(block);
+		}
+		std::vector<float> y;
+	private:
+		audio_block_f32_t *inputQueueArray[1];
+};
+
+//the nodes of one chain, and the order in which to update them (the order they'd be declared in the sketch)
+struct ChainRig {
+	std::vector<std::function<void(void)>> updates;
+	std::vector<std::function<void(void)>> deleters;
+	std::vector<AudioConnection_F32 *> patch;
+	template <typename T> T *add(T *node) {
+		updates.push_back([node]() { node->update(); });
+		deleters.push_back([node]() { delete node; });
+		return node;
+	}
+	void connect(AudioStream_F32 &a, int a_out, AudioStream_F32 &b, int b_in) { patch.push_back(new AudioConnection_F32(a, a_out, b, b_in)); }
+	~ChainRig(void) {
+		for (auto *p : patch) delete p;
+		for (auto it = deleters.rbegin(); it != deleters.rend(); ++it) (*it)();
+	}
+};
+
+struct Chain {
+	const char *name;
+	float fs_Hz;
+	int block;
+	bool output_is_power;   //the output is a mean-square level (as from AudioCalcLevel_F32), not audio
+	//makes the nodes between the source and the sink
+	std::function<AudioStream_F32 *(ChainRig &, AudioStream_F32 &, const AudioSettings_F32 &)> build;
+};
+
+//as configurePerBandWDRCs() and configureBroadbandWDRCs() in the WDRC examples
+static void configureBandWDRC(AudioEffectCompWDRC_F32 &wdrc, float fs_Hz, const BTNRH_WDRC::CHA_DSL &dsl, const BTNRH_WDRC::CHA_WDRC &gha, int i) {
+	float bolt = dsl.bolt[i], tkgain = dsl.tkgain[i];
+	if (bolt > gha.tk) bolt = gha.tk;
+	if (tkgain < 0) bolt = bolt + tkgain;
+	wdrc.setSampleRate_Hz(fs_Hz);
+	wdrc.setParams(dsl.attack, dsl.release, dsl.maxdB, dsl.exp_cr[i], dsl.exp_end_knee[i], tkgain, dsl.cr[i], dsl.tk[i], bolt);
+}
+static void configureBroadbandWDRC(AudioEffectCompWDRC_F32 &wdrc, float fs_Hz, const BTNRH_WDRC::CHA_WDRC &gha) {
+	const float vol_knob_gain_dB = 0.0f;
+	wdrc.setSampleRate_Hz(fs_Hz);
+	wdrc.setParams(gha.attack, gha.release, gha.maxdB, gha.exp_cr, gha.exp_end_knee, gha.tkgain + vol_knob_gain_dB, gha.cr, gha.tk, gha.bolt);
+}
+
+static std::vector<Chain> buildChains(void) {
+	std::vector<Chain> chains;
+
+	chains.push_back({"wdrc_fir", 24000.0f, 16, false, [](ChainRig &rig, AudioStream_F32 &in, const AudioSettings_F32 &s) -> AudioStream_F32 * {
+		using namespace fir_example;
+		const int N_CHAN = 8, N_FIR = 96;
+		static float firCoeff[N_CHAN][N_FIR];
+		AudioConfigFIRFilterBank_F32 makeFIRcoeffs(N_CHAN, N_FIR, s.sample_rate_Hz, (float *)dsl.cross_freq, (float *)firCoeff);
+		AudioFilterFIR_F32 *fir[N_CHAN];
+		AudioEffectCompWDRC_F32 *wdrc[N_CHAN];
+		for (int i = 0; i < N_CHAN; i++) fir[i] = rig.add(new AudioFilterFIR_F32());
+		for (int i = 0; i < N_CHAN; i++) wdrc[i] = rig.add(new AudioEffectCompWDRC_F32());
+		AudioMixer8_F32 *mixer = rig.add(new AudioMixer8_F32());
+		AudioEffectCompWDRC_F32 *broadband = rig.add(new AudioEffectCompWDRC_F32());
+		for (int i = 0; i < N_CHAN; i++) {
+			rig.connect(in, 0, *fir[i], 0);
+			rig.connect(*fir[i], 0, *wdrc[i], 0);
+			rig.connect(*wdrc[i], 0, *mixer, i);
+			fir[i]->begin(firCoeff[i], N_FIR, s.audio_block_samples);
+			configureBandWDRC(*wdrc[i], s.sample_rate_Hz, dsl, gha, i);
+		}
+		rig.connect(*mixer, 0, *broadband, 0);
+		configureBroadbandWDRC(*broadband, s.sample_rate_Hz, gha);
+		return broadband;
+	}});
+
+	chains.push_back({"wdrc_iir_afc", 22050.0f, 16, false, [](ChainRig &rig, AudioStream_F32 &in, const AudioSettings_F32 &s) -> AudioStream_F32 * {
+		using namespace iir_example;
+		const int N_CHAN_MAX = 8;
+		const int N_CHAN = std::max(1, std::min(N_CHAN_MAX, dsl.nchannel));
+		AudioEffectFeedbackCancel_F32 *afc_node = rig.add(new AudioEffectFeedbackCancel_F32(s));
+		AudioFilterBiquad_F32 *bp[N_CHAN_MAX];
+		AudioEffectDelay_F32 *dly[N_CHAN_MAX];
+		AudioEffectCompWDRC_F32 *wdrc[N_CHAN_MAX];
+		for (int i = 0; i < N_CHAN_MAX; i++) bp[i] = rig.add(new AudioFilterBiquad_F32());
+		for (int i = 0; i < N_CHAN_MAX; i++) dly[i] = rig.add(new AudioEffectDelay_F32());
+		for (int i = 0; i < N_CHAN_MAX; i++) wdrc[i] = rig.add(new AudioEffectCompWDRC_F32());
+		AudioMixer8_F32 *mixer = rig.add(new AudioMixer8_F32());
+		AudioEffectCompWDRC_F32 *broadband = rig.add(new AudioEffectCompWDRC_F32());
+		AudioEffectFeedbackCancel_LoopBack_F32 *loopback = rig.add(new AudioEffectFeedbackCancel_LoopBack_F32(s));
+
+		rig.connect(in, 0, *afc_node, 0);
+		for (int i = 0; i < N_CHAN_MAX; i++) {
+			rig.connect(*afc_node, 0, *bp[i], 0);
+			rig.connect(*bp[i], 0, *dly[i], 0);
+			rig.connect(*dly[i], 0, *wdrc[i], 0);
+			rig.connect(*wdrc[i], 0, *mixer, i);
+		}
+		rig.connect(*mixer, 0, *broadband, 0);
+		loopback->setTargetAFC(afc_node);
+		rig.connect(*broadband, 0, *loopback, 0);
+
+		//as setupFromDSLandGHAandAFC() in the example
+		for (int i = 0; i < N_CHAN_MAX; i++) {
+			if (i < N_CHAN) { bp[i]->setFilterCoeff_Matlab_sos(&(all_matlab_sos[i][0]), SOS_N_BIQUADS_PER_FILTER); } else { bp[i]->end(); }
+			dly[i]->setSampleRate_Hz(s.sample_rate_Hz);
+			dly[i]->delay(0, (i < N_CHAN) ? all_matlab_sos_delay_msec[i] : 0.0f);
+		}
+		afc_node->setParams(afc);
+		for (int i = 0; i < N_CHAN; i++) configureBandWDRC(*wdrc[i], s.sample_rate_Hz, dsl, gha, i);
+		configureBroadbandWDRC(*broadband, s.sample_rate_Hz, gha);
+		return broadband;
+	}});
+
+	chains.push_back({"slm", 44117.0f, 128, true, [](ChainRig &rig, AudioStream_F32 &in, const AudioSettings_F32 &s) -> AudioStream_F32 * {
+		AudioFilterFreqWeighting_F32 *weight = rig.add(new AudioFilterFreqWeighting_F32(s));
+		AudioCalcLevel_F32 *level = rig.add(new AudioCalcLevel_F32(s));
+		rig.connect(in, 0, *weight, 0);
+		rig.connect(*weight, 0, *level, 0);
+		weight->setWeightingType(A_WEIGHT);
+		level->setTimeConst_sec(TIME_CONST_SLOW);
+		return level;
+	}});
+
+	chains.push_back({"decim_fanout", 24000.0f, 128, false, [](ChainRig &rig, AudioStream_F32 &in, const AudioSettings_F32 &s) -> AudioStream_F32 * {
+		const int factor = 4;
+		const float fs_low_Hz = s.sample_rate_Hz / factor;
+		AudioDecimate_F32 *decim = rig.add(new AudioDecimate_F32(s, factor));
+		AudioFilterBiquad_F32 *low = rig.add(new AudioFilterBiquad_F32());
+		AudioFilterBiquad_F32 *band = rig.add(new AudioFilterBiquad_F32());
+		AudioMixer4_F32 *mixer = rig.add(new AudioMixer4_F32());
+		AudioInterpolate_F32 *interp = rig.add(new AudioInterpolate_F32(s, factor));
+		rig.connect(in, 0, *decim, 0);
+		rig.connect(*decim, 0, *low, 0);    //both filters work in place on the one decimated block
+		rig.connect(*decim, 0, *band, 0);
+		rig.connect(*low, 0, *mixer, 0);
+		rig.connect(*band, 0, *mixer, 1);
+		rig.connect(*mixer, 0, *interp, 0);
+		low->setSampleRate_Hz(fs_low_Hz);   low->setLowpass(0, 500.0f);
+		band->setSampleRate_Hz(fs_low_Hz);  band->setBandpass(0, 1500.0f, 2.0f);
+		mixer->gain(0, 0.5f);  mixer->gain(1, 0.5f);
+		return interp;
+	}});
+	return chains;
+}
+
+static std::vector<float> runChain(const Chain &chain, const std::vector<float> &x) {
+	AudioSettings_F32 settings(chain.fs_Hz, chain.block);
+	AudioMemory_F32(GOLDEN_POOL_BLOCKS, settings);
+	std::vector<float> y;
+	{
+		ChainRig rig;
+		GoldenSource *source = new GoldenSource(x);
+		GoldenSink *sink = new GoldenSink();
+		rig.updates.push_back([source]() { source->update(); });
+		AudioStream_F32 *last = chain.build(rig, *source, settings);
+		rig.updates.push_back([sink]() { sink->update(); });
+		rig.connect(*last, 0, *sink, 0);
+
+		const size_t n_blocks = (x.size() + chain.block - 1) / chain.block;
+		for (size_t b = 0; b < n_blocks; b++) {
+			for (auto &u : rig.updates) u();
+		}
+		y = sink->y;
+		y.resize(x.size(), 0.0f);
+		rig.deleters.push_back([source, sink]() { delete source; delete sink; });
+	}
+	return y;
+}
+
+// ///////////////////////////////////////// comparing
+
+struct Diff { bool bit_exact; double max_abs_err, snr_dB, gain_dev_dB; };
+
+static Diff compare(const std::vector<float> &ref, const std::vector<float> &y, float fs_Hz, bool is_power) {
+	Diff d = {true, 0.0, 999.0, 0.0};
+	double sig = 0.0, err = 0.0;
+	const size_t n = std::min(ref.size(), y.size());
+	if (ref.size() != y.size()) d.bit_exact = false;
+	for (size_t i = 0; i < n; i++) {
+		const double e = (double)y[i] - ref[i];
+		if (memcmp(&y[i], &ref[i], sizeof(float))) d.bit_exact = false;
+		d.max_abs_err = std::max(d.max_abs_err, fabs(e));
+		sig += (double)ref[i] * ref[i];
+		err += e * e;
+	}
+	if (err > 0.0) d.snr_dB = std::min(999.0, 10.0 * log10((sig + 1.0e-30) / err));
+
+	//level, frame by frame
+	const size_t frame = (size_t)(0.010 * fs_Hz);
+	for (size_t start = 0; start + frame <= n; start += frame) {
+		double p_ref = 0.0, p_y = 0.0;
+		for (size_t i = start; i < start + frame; i++) {
+			if (is_power) { p_ref += ref[i]; p_y += y[i]; } else { p_ref += (double)ref[i] * ref[i]; p_y += (double)y[i] * y[i]; }
+		}
+		const double db_ref = 10.0 * log10(p_ref / frame + 1.0e-30), db_y = 10.0 * log10(p_y / frame + 1.0e-30);
+		if (db_ref > -90.0) d.gain_dev_dB = std::max(d.gain_dev_dB, fabs(db_y - db_ref));
+	}
+	return d;
+}
+
+// ///////////////////////////////////////// main
+
+static void usage(void) {
+	fprintf(stderr, "usage: golden_chains make-inputs <input_dir>\n"
+		"       golden_chains record <input_dir> <golden_dir>\n"
+		"       golden_chains check <input_dir> <golden_dir> [max_abs_err] [min_snr_dB] [max_gain_dev_dB]\n");
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 3) { usage(); return -1; }
+	const std::string mode = argv[1], in_dir = argv[2];
+	if (mode == "make-inputs") { makeInputs(in_dir); return 0; }
+	if (argc < 4) { usage(); return -1; }
+	const std::string golden_dir = argv[3];
+	const bool record = (mode == "record");
+	if (!record && (mode != "check")) { usage(); return -1; }
+	const double tol_abs = (argc > 4) ? atof(argv[4]) : 1.0e-3;
+	const double tol_snr = (argc > 5) ? atof(argv[5]) : 60.0;
+	const double tol_gain = (argc > 6) ? atof(argv[6]) : 0.1;
+	if (record) mkdir(golden_dir.c_str(), 0755);
+
+	std::vector<std::string> inputs = listWavs(in_dir);
+	if (inputs.empty()) { fprintf(stderr, "golden_chains: no WAV files in %s\n", in_dir.c_str()); return -1; }
+
+	int n_fail = 0;
+	if (!record) printf("chain,input,bit_exact,max_abs_err,snr_dB,gain_dev_dB,pass\n");
+	for (const Chain &chain : buildChains()) {
+		for (const std::string &input : inputs) {
+			std::vector<float> x;
+			int fs_in = 0;
+			if (!readWav(in_dir + "/" + input, x, fs_in)) { fprintf(stderr, "golden_chains: can't read %s\n", input.c_str()); n_fail++; continue; }
+			const std::vector<float> y = runChain(chain, x);
+			const std::string golden_name = golden_dir + "/" + chain.name + "__" + input;
+			if (record) {
+				if (!writeWav(golden_name, y, (int)chain.fs_Hz)) { fprintf(stderr, "golden_chains: can't write %s\n", golden_name.c_str()); n_fail++; }
+				else fprintf(stderr, "golden_chains: recorded %s\n", golden_name.c_str());
+				continue;
+			}
+			std::vector<float> ref;
+			int fs_ref = 0;
+			if (!readWav(golden_name, ref, fs_ref)) { fprintf(stderr, "golden_chains: no golden output %s\n", golden_name.c_str()); n_fail++; continue; }
+			const Diff d = compare(ref, y, chain.fs_Hz, chain.output_is_power);
+			const bool pass = d.bit_exact || ((d.max_abs_err <= tol_abs) && (d.snr_dB >= tol_snr) && (d.gain_dev_dB <= tol_gain));
+			if (!pass) n_fail++;
+			printf("%s,%s,%d,%.3g,%.1f,%.4f,%d\n", chain.name, input.c_str(), d.bit_exact, d.max_abs_err, d.snr_dB, d.gain_dev_dB, pass);
+		}
+	}
+	return n_fail;
+}
@@ -0,0 +1,142 @@
+/*
+ * level_meter_bank_sim
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop check that AudioCalcLevelN_F32 (run by LevelMeterBank, src/utility/level_meter_bank.h)
+ *    reads the same as the chain it replaces, an AudioFilterFreqWeighting_F32 into an AudioCalcLevel_F32,
+ *    for each channel.  Both are built from the library's nodes (through the stand-ins in extras/host/shim)
+ *    and fed the same audio: noise on one channel and a few tones on the other.  A third meter takes the
+ *    chain's weighted signal and time weights it in double precision, as the reference.  For A, C and Z
+ *    weighting, with FAST and SLOW time weighting, it compares the levels after every block (once they
+ *    are past -100 dB) and prints the largest differences.  Returns 1 if the node is more than 0.0005 dB
+ *    from the reference, or differs from the chain by more than the chain's own error plus 0.0005 dB.
+ *    (The chain rounds alpha to a float, which at SLOW and 44.1 kHz or more costs it up to 0.006 dB.)
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -std=c++11 -Iextras/host/shim -Isrc -Isrc/utility extras/host/level_meter_bank_sim.cpp extras/host/shim/shim.cpp \
+ *            src/AudioStream_F32.cpp src/AudioFilterBiquad_F32.cpp src/AudioFilterTimeWeighting_F32.cpp src/AudioCalcLevel_F32.cpp \
+ *            src/utility/freq_weighting.cpp src/utility/level_meter_bank.cpp -o level_meter_bank_sim
+ *        ./level_meter_bank_sim            (44.1 kHz)
+ *        ./level_meter_bank_sim 24000      (sample rate)
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "Arduino.h"
+#include "AudioStream_F32.h"
+#include "AudioFilterBiquad_F32.h"
+#include "AudioFilterFreqWeighting_F32.h"
+#include "AudioCalcLevel_F32.h"
+#include "AudioCalcLevelN_F32.h"
+
+#define N_CHAN 2
+#define SECONDS 5.0f
+#define TOL_DB 0.0005
+
+//noise on channel 0, three tones on channel 1
+class TestSource : public AudioStream_F32 {
+	public:
+		TestSource(const float _fs_Hz) : AudioStream_F32(0, NULL), fs_Hz(_fs_Hz) { srand(1); }
+		void update(void) {
+			audio_block_f32_t *block[N_CHAN];
+			for (int c = 0; c < N_CHAN; c++) {
+				block[c] = allocate_f32();
+				if (!block[c]) { for (int j = 0; j < c; j++) release(block[j]); return; }
+			}
+			for (int i = 0; i < block[0]->length; i++, n++) {
+				block[0]->data[i] = 0.3f * (2.0f * rand() / (float)RAND_MAX - 1.0f);
+				const double t = n / (double)fs_Hz;
+				block[1]->data[i] = (float)(0.2 * sin(2.0 * M_PI * 50.0 * t) + 0.1 * sin(2.0 * M_PI * 1000.0 * t) + 0.05 * sin(2.0 * M_PI * 8000.0 * t));
+			}
+			for (int c = 0; c < N_CHAN; c++) { transmit(block[c], c); release(block[c]); }
+		}
+	private:
+		float fs_Hz;
+		long n = 0;
+};
+
+//the time weighting of AudioCalcLevel_F32, in double precision, on whatever arrives
+class ReferenceLevel : public AudioStream_F32 {
+	public:
+		ReferenceLevel(const float fs_Hz, const float tau_sec) : AudioStream_F32(1, inputQueueArray), alpha(exp(-1.0 / (fs_Hz * (double)tau_sec))) {}
+		void update(void) {
+			audio_block_f32_t *block = receiveReadOnly_f32();
+			if (!block) return;
+			for (int i = 0; i < block->length; i++) ms = (1.0 - alpha) * block->data[i] * block->data[i] + alpha * ms;
+			release(block);
+		}
+		double ms = 0.0;
+	private:
+		audio_block_f32_t *inputQueueArray[1];
+		double alpha;
+};
+
+//the largest differences, in dB, of AudioCalcLevelN_F32 from the reference and from the two-node chain,
+//and of the chain from the reference
+struct Diffs { double node_ref, node_chain, chain_ref; };
+
+static Diffs worstDiffs_dB(const float fs_Hz, const int weighting, const float tau_sec) {
+	AudioSettings_F32 settings(fs_Hz, AUDIO_BLOCK_SAMPLES);
+	TestSource source(fs_Hz);
+	AudioFilterFreqWeighting_F32 *weight[N_CHAN];
+	AudioCalcLevel_F32 *level[N_CHAN];
+	ReferenceLevel *ref[N_CHAN];
+	AudioConnection_F32 *patch[4 * N_CHAN];
+	AudioCalcLevelN_F32<N_CHAN> levelN(settings);
+	for (int c = 0; c < N_CHAN; c++) {
+		weight[c] = new AudioFilterFreqWeighting_F32(settings);
+		level[c] = new AudioCalcLevel_F32(settings);
+		ref[c] = new ReferenceLevel(fs_Hz, tau_sec);
+		weight[c]->setWeightingType(weighting);
+		level[c]->setTimeConst_sec(tau_sec);
+		patch[4 * c] = new AudioConnection_F32(source, c, *weight[c], 0);
+		patch[4 * c + 1] = new AudioConnection_F32(*weight[c], 0, *level[c], 0);
+		patch[4 * c + 2] = new AudioConnection_F32(*weight[c], 0, *ref[c], 0);
+		patch[4 * c + 3] = new AudioConnection_F32(source, c, levelN, c);
+	}
+	levelN.setWeightingType(weighting);
+	levelN.setTimeConst_sec(tau_sec);
+
+	Diffs worst = { 0.0, 0.0, 0.0 };
+	const long n_updates = (long)(SECONDS * fs_Hz / AUDIO_BLOCK_SAMPLES);
+	for (long u = 0; u < n_updates; u++) {
+		source.update();
+		for (int c = 0; c < N_CHAN; c++) { weight[c]->update(); level[c]->update(); ref[c]->update(); }
+		levelN.update();
+		for (int c = 0; c < N_CHAN; c++) {
+			const double ref_dB = 10.0 * log10(ref[c]->ms + 1.0e-30);
+			const double chain_dB = 10.0 * log10(level[c]->getCurrentLevel() + 1.0e-30);
+			const double node_dB = levelN.getCurrentLevel_dB(c);
+			if (ref_dB < -100.0) continue;
+			worst.node_ref = fmax(worst.node_ref, fabs(node_dB - ref_dB));
+			worst.node_chain = fmax(worst.node_chain, fabs(node_dB - chain_dB));
+			worst.chain_ref = fmax(worst.chain_ref, fabs(chain_dB - ref_dB));
+		}
+	}
+	for (int c = 0; c < 4 * N_CHAN; c++) delete patch[c];
+	for (int c = 0; c < N_CHAN; c++) { delete weight[c]; delete level[c]; delete ref[c]; }   //never deleted through a base pointer
+	return worst;
+}
+
+int main(int argc, char *argv[]) {
+	const float fs_Hz = (argc >= 2) ? (float)atof(argv[1]) : 44100.0f;
+	AudioMemory_F32(40, AudioSettings_F32(fs_Hz, AUDIO_BLOCK_SAMPLES));
+	const int weightings[] = { A_WEIGHT, C_WEIGHT, Z_WEIGHT };
+	const char *names[] = { "A", "C", "Z" };
+	const float taus[] = { 0.125f, 1.0f };
+	bool pass = true;
+	printf("fs_Hz,weighting,tau_sec,node_vs_ref_dB,node_vs_chain_dB,chain_vs_ref_dB,result\n");
+	for (int w = 0; w < 3; w++) {
+		for (float tau : taus) {
+			const Diffs d = worstDiffs_dB(fs_Hz, weightings[w], tau);
+			const bool ok = (d.node_ref <= TOL_DB) && (d.node_chain <= d.chain_ref + TOL_DB);
+			if (!ok) pass = false;
+			printf("%.0f,%s,%.3f,%.6f,%.6f,%.6f,%s\n", fs_Hz, names[w], tau, d.node_ref, d.node_chain, d.chain_ref, ok ? "PASS" : "FAIL");
+		}
+	}
+	return pass ? 0 : 1;
+}
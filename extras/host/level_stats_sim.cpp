@@ -0,0 +1,127 @@
+/*
+ * level_stats_sim
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop check of LevelStats (src/utility/level_stats.h), the core of AudioCalcLevelStats_F32.
+ *      - A steady sine: Leq and Lmax must be within 0.01 dB of its level.  L10, L50 and L90 come from a
+ *        0.5 dB histogram (spread evenly within each bin), so they must be within the sine's bin.
+ *      - True peak: sines from 1 to 20 kHz, each at many phases against the sample clock.  At frequencies
+ *        whose waveform doesn't repeat every few samples, Lpeak must be within 0.06 dB of the sine's peak.
+ *        At fs/6, fs/4, fs/3 and 5fs/12, the peak can sit between the 4x points every time.  There,
+ *        Lpeak may read low, but no lower than 4x oversampling allows: cos(pi*f/(4*fs)).
+ *      - A sine at fs/4, sampled 45 deg off its peaks, so that every sample is 3 dB below the true peak.
+ *        Lpeak must find at least 2.8 dB of that.
+ *    Prints the results and returns 1 if any check fails.
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -Isrc extras/host/level_stats_sim.cpp src/utility/level_stats.cpp -o level_stats_sim
+ *        ./level_stats_sim            (at 48 kHz)
+ *        ./level_stats_sim 44100      (sample rate)
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include "utility/level_stats.h"
+
+#define LEVEL_TOL_DB 0.01
+#define PEAK_TOL_DB 0.06
+#define N_PHASES 32
+
+static const int block = 128;
+static const double amp = 0.5;
+
+//play a sine (amplitude amp) for the given time, and give back the run's results.  The sine starts a
+//block early, so that its onset (which does overshoot) isn't counted.
+static void playSine(LevelStats &ls, const double fs_Hz, const double f_Hz, const double phase_rad, const double seconds, LevelStatsResult *r) {
+	ls.setSampleRate_Hz((float)fs_Hz);
+	std::vector<float> x(block);
+	const long n_total = (long)(seconds * fs_Hz);
+	for (long n = -block; n < n_total; n += block) {
+		if (n == 0) ls.reset();
+		for (int i = 0; i < block; i++) x[i] = (float)(amp * sin(2.0 * M_PI * f_Hz * (n + i) / fs_Hz + phase_rad));
+		ls.process(x.data(), NULL, block);
+	}
+	ls.getRun(r);
+}
+
+int main(int argc, char *argv[]) {
+	const double fs_Hz = (argc >= 2) ? atof(argv[1]) : 48000.0;
+	static LevelStats ls;
+	LevelStatsResult r;
+	bool pass = true;
+	const double level_dB = 20.0 * log10(amp / sqrt(2.0)), peak_dB = 20.0 * log10(amp);
+
+	//a steady sine.  The time weighting starts from silence, so let it settle before the run starts.
+	ls.setSampleRate_Hz((float)fs_Hz);
+	ls.setTimeConst_sec(0.125f);
+	{
+		std::vector<float> x(block);
+		long n = 0;
+		for (; n < (long)(2.0 * fs_Hz); n += block) {
+			for (int i = 0; i < block; i++) x[i] = (float)(amp * sin(2.0 * M_PI * 1000.0 * (n + i) / fs_Hz));
+			ls.process(x.data(), NULL, block);
+		}
+		ls.reset();
+		for (const long n_end = n + (long)(10.0 * fs_Hz); n < n_end; n += block) {
+			for (int i = 0; i < block; i++) x[i] = (float)(amp * sin(2.0 * M_PI * 1000.0 * (n + i) / fs_Hz));
+			ls.process(x.data(), NULL, block);
+		}
+		ls.getRun(&r);
+	}
+	const double err[5] = { r.leq_dB - level_dB, r.lmax_dB - level_dB, r.L10_dB - level_dB, r.L50_dB - level_dB, r.L90_dB - level_dB };
+	const double bin_lo_dB = LEVEL_STATS_HIST_LO_DB + LEVEL_STATS_HIST_STEP_DB * floor((level_dB - LEVEL_STATS_HIST_LO_DB) / LEVEL_STATS_HIST_STEP_DB);
+	bool ok = (fabs(err[0]) <= LEVEL_TOL_DB) && (fabs(err[1]) <= LEVEL_TOL_DB);
+	for (int i = 2; i < 5; i++) {
+		if ((err[i] + level_dB < bin_lo_dB) || (err[i] + level_dB > bin_lo_dB + LEVEL_STATS_HIST_STEP_DB)) ok = false;
+	}
+	printf("sine 1 kHz at %.2f dB: Leq %+.4f, Lmax %+.4f, L10 %+.4f, L50 %+.4f, L90 %+.4f dB: %s\n",
+		level_dB, err[0], err[1], err[2], err[3], err[4], ok ? "PASS" : "FAIL");
+	pass = pass && ok;
+
+	//true peak, from 1 to 20 kHz (below the Nyquist frequency), at many phases.  The 37 Hz keeps the
+	//waveforms from repeating every few samples.
+	double worst_err = 0.0, worst_Hz = 0.0;
+	ok = true;
+	for (double f = 1037.0; (f <= 20000.0) && (f < 0.45 * fs_Hz); f += 250.0) {
+		for (int p = 0; p < N_PHASES; p++) {
+			playSine(ls, fs_Hz, f, 2.0 * M_PI * p / N_PHASES, 0.05, &r);
+			const double e = r.lpeak_dB - peak_dB;
+			if (fabs(e) > fabs(worst_err)) { worst_err = e;  worst_Hz = f; }
+			if (fabs(e) > PEAK_TOL_DB) ok = false;
+		}
+	}
+	printf("true peak, 1 to 20 kHz: worst %+.3f dB at %.0f Hz: %s\n", worst_err, worst_Hz, ok ? "PASS" : "FAIL");
+	pass = pass && ok;
+
+	//at simple fractions of fs, the same few points of the waveform come round every time
+	const double fracs[] = { 1.0 / 6.0, 1.0 / 4.0, 1.0 / 3.0, 5.0 / 12.0 };
+	for (double frac : fracs) {
+		const double f = frac * fs_Hz;
+		double lo = 0.0, hi = -100.0;
+		for (int p = 0; p < N_PHASES; p++) {
+			playSine(ls, fs_Hz, f, 2.0 * M_PI * p / N_PHASES, 0.05, &r);
+			const double e = r.lpeak_dB - peak_dB;
+			if (e < lo) lo = e;
+			if (e > hi) hi = e;
+		}
+		const double bound_dB = 20.0 * log10(cos(M_PI * frac / LEVEL_STATS_TP_FACTOR));
+		ok = (lo >= bound_dB - 0.02) && (hi <= PEAK_TOL_DB);
+		printf("true peak at %.0f Hz: %+.3f to %+.3f dB (4x bound %+.3f dB): %s\n", f, lo, hi, bound_dB, ok ? "PASS" : "FAIL");
+		pass = pass && ok;
+	}
+
+	//fs/4, with every sample 3 dB below the peak
+	playSine(ls, fs_Hz, fs_Hz / 4.0, M_PI / 4.0, 0.05, &r);
+	const double sample_peak_dB = 20.0 * log10(amp * sqrt(0.5));
+	ok = (r.lpeak_dB - sample_peak_dB >= 2.8);
+	printf("fs/4 at 45 deg: sample peak %+.3f dB, Lpeak %+.3f dB: %s\n", sample_peak_dB - peak_dB, r.lpeak_dB - peak_dB, ok ? "PASS" : "FAIL");
+	pass = pass && ok;
+
+	printf("%s\n", pass ? "PASS" : "FAIL");
+	return pass ? 0 : 1;
+}
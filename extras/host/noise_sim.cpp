@@ -0,0 +1,98 @@
+/*
+ * noise_sim
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop check of NoiseGenerator and PinkFilter (src/utility/noise_f32.h).  Prints CSV:
+ *    first, the statistics of the white noise (with the Philox known-answer check and a check that
+ *    starting partway gives the same samples), then, for several sample rates, how far the pink
+ *    filter's response strays from a true -3 dB/octave line, and the level of the pink noise itself.
+ *    The noise for a given seed is the same here as on the Teensy, so a host run can also be used to
+ *    make reference signals.
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -Isrc extras/host/noise_sim.cpp src/utility/noise_f32.cpp -o noise_sim
+ *        ./noise_sim
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <math.h>
+#include <complex>
+#include <vector>
+#include "utility/noise_f32.h"
+
+static void whiteStats(void) {
+	uint32_t w[4];
+	NoiseGenerator::philox4x32(0, 0, 0, w);   //Random123's known answer for counter 0, key 0
+	bool kat_ok = (w[0] == 0x6627e8d5) && (w[1] == 0xe169c58d) && (w[2] == 0xbc57ac4c) && (w[3] == 0x9b00dbd8);
+
+	printf("distribution,kat_ok,seek_ok,mean,rms,peak\n");
+	const int N = 1 << 20;
+	std::vector<float> x(N), y(N);
+	for (int d = 0; d < 2; d++) {
+		NoiseGenerator a, b;
+		a.setSeed(1234);  a.setDistribution((NoiseGenerator::Distribution)d);
+		b.setSeed(1234);  b.setDistribution((NoiseGenerator::Distribution)d);
+		a.generate(x.data(), N, 1.0f);
+		//the same noise in odd-sized pieces, and from a jump into the middle
+		int k = 0, piece = 3;
+		while (k < N) { int m = (N - k < piece) ? (N - k) : piece; b.generate(&y[k], m, 1.0f); k += m; piece = (piece * 7) % 129 + 1; }
+		b.setPosition(N / 2 + 1);
+		float z[10];
+		b.generate(z, 10, 1.0f);
+		bool seek_ok = true;
+		for (int i = 0; i < N; i++) if (x[i] != y[i]) seek_ok = false;
+		for (int i = 0; i < 10; i++) if (z[i] != x[N/2 + 1 + i]) seek_ok = false;
+
+		double s = 0.0, s2 = 0.0, pk = 0.0;
+		for (int i = 0; i < N; i++) { s += x[i]; s2 += x[i]*x[i]; if (fabs(x[i]) > pk) pk = fabs(x[i]); }
+		printf("%s,%d,%d,%.5f,%.5f,%.4f\n", (d == 0) ? "uniform" : "gaussian", kat_ok, seek_ok, s/N, sqrt(s2/N), pk);
+	}
+}
+
+static void pinkResponse(float fs_Hz) {
+	PinkFilter pink;
+	pink.setup(fs_Hz);
+
+	//impulse response, then its spectrum at 1/6-octave steps, relative to the -3 dB/oct line through 1 kHz
+	const int N = (int)(4.0f * fs_Hz);
+	std::vector<float> h(N, 0.0f);
+	h[0] = 1.0f;
+	pink.process(h.data(), N);
+	auto mag_dB = [&](double f) {
+		std::complex<double> H = 0.0;
+		for (int i = 0; i < N; i++) H += (double)h[i] * std::polar(1.0, -2.0 * M_PI * f * i / fs_Hz);
+		return 20.0 * log10(std::abs(H));
+	};
+	const double ref_dB = mag_dB(1000.0);
+	double dev_min = 0.0, dev_max = 0.0;
+	for (double f = 40.0; f < 0.45 * fs_Hz; f *= pow(2.0, 1.0/6.0)) {
+		double dev = mag_dB(f) - ref_dB + 10.0 * log10(f / 1000.0);
+		if (dev < dev_min) dev_min = dev;
+		if (dev > dev_max) dev_max = dev;
+	}
+
+	//and the noise itself
+	NoiseGenerator noise;
+	noise.setSeed(1);
+	pink.reset();
+	const int M = (int)(10.0f * fs_Hz);
+	std::vector<float> x(M);
+	noise.generate(x.data(), M, 1.0f);
+	pink.process(x.data(), M);
+	double s2 = 0.0, pk = 0.0;
+	for (int i = M / 10; i < M; i++) { s2 += x[i]*x[i]; if (fabs(x[i]) > pk) pk = fabs(x[i]); }
+	const double rms = sqrt(s2 / (M - M / 10));
+
+	printf("%.0f,%d,%.2f,%.2f,%.4f,%.2f\n", fs_Hz, pink.getNumSections(), dev_min, dev_max, rms / 0.57735, pk / rms);
+}
+
+int main(void) {
+	whiteStats();
+	printf("\nfs_Hz,sections,slope_dev_min_dB,slope_dev_max_dB,rms_out_per_rms_in,crest_factor\n");
+	const float rates[] = {16000.0f, 24000.0f, 44100.0f, 48000.0f, 96000.0f};
+	for (float fs : rates) pinkResponse(fs);
+	return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * octave_bank_sim
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop check of OctaveFilterBank (src/utility/octave_bank.h), the filterbank behind
+ *    AudioCalcOctaveBands_F32.  Plays steady sines and reads every band's Leq.  Checks, for each band:
+ *      - the gain at its exact mid-band frequency is within 0.01 dB of 0 dB;
+ *      - the gain at each of its exact band edges is within 0.02 dB of -3.01 dB;
+ *      - for a band at a decimated stage, no sine above that stage's Nyquist frequency (which can only
+ *        reach the band by aliasing through the half-band decimators) gets through any more than the
+ *        band's own skirt lets through a sine 2 octaves from its mid-band frequency.
+ *    Prints one CSV line per band and returns 1 if any check fails.
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -Isrc extras/host/octave_bank_sim.cpp src/utility/octave_bank.cpp -o octave_bank_sim
+ *        ./octave_bank_sim            (1/3-octave bands, 25 Hz to 20 kHz, at 48 kHz)
+ *        ./octave_bank_sim 1 44100    (bands per octave, sample rate)
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include "utility/octave_bank.h"
+
+#define SETTLE_SEC 1.0
+#define MEASURE_SEC 2.0
+#define MID_TOL_DB 0.01
+#define EDGE_TOL_DB 0.02
+#define EDGE_DB -3.0103
+
+static const int block = 128;
+
+//Play a sine at f_Hz (amplitude 1) and return every band's Leq, in dB re: the sine's own mean square.
+//Leq is taken over a whole number of the sine's periods, after the filters have settled.
+static void bandGains_dB(OctaveFilterBank &bank, const double fs_Hz, const double f_Hz, std::vector<double> &gain_dB) {
+	bank.setup((float)fs_Hz, bank.getBandsPerOctave(), 25.0f, 20000.0f);   //start from rest
+	std::vector<float> x(block);
+	long n = 0;
+	const long n_settle = (long)(SETTLE_SEC * fs_Hz);
+	while (n < n_settle) {
+		for (int i = 0; i < block; i++, n++) x[i] = (float)sin(2.0 * M_PI * f_Hz * n / fs_Hz);
+		bank.process(x.data(), block);
+	}
+	bank.reset();
+	const long n_end = n + (long)(floor(MEASURE_SEC * f_Hz) * fs_Hz / f_Hz + 0.5);
+	while (n < n_end) {
+		const int len = (n_end - n < block) ? (int)(n_end - n) : block;
+		for (int i = 0; i < len; i++, n++) x[i] = (float)sin(2.0 * M_PI * f_Hz * n / fs_Hz);
+		bank.process(x.data(), len);
+	}
+	gain_dB.resize(bank.getNumBands());
+	for (int i = 0; i < bank.getNumBands(); i++) gain_dB[i] = 10.0 * log10(bank.getMeanSquare(i) / 0.5 + 1.0e-30);
+}
+
+int main(int argc, char *argv[]) {
+	const int bands_per_octave = (argc >= 2) ? atoi(argv[1]) : 3;
+	const double fs_Hz = (argc >= 3) ? atof(argv[2]) : 48000.0;
+	static OctaveFilterBank bank;   //big, so keep it off the stack
+	if (!bank.setup((float)fs_Hz, bands_per_octave, 25.0f, 20000.0f)) {
+		fprintf(stderr, "octave_bank_sim: no bands\n");
+		return 1;
+	}
+	const int n_bands = bank.getNumBands();
+	std::vector<double> fm(n_bands), lo(n_bands), hi(n_bands), mid_dB(n_bands), lo_dB(n_bands), hi_dB(n_bands);
+	std::vector<double> skirt_dB(n_bands, -300.0), alias_dB(n_bands, -300.0), alias_Hz(n_bands, 0.0);
+	std::vector<int> stage(n_bands);
+	for (int i = 0; i < n_bands; i++) {
+		fm[i] = bank.getCenter_Hz(i);  lo[i] = bank.getLowerEdge_Hz(i);  hi[i] = bank.getUpperEdge_Hz(i);
+		stage[i] = bank.getStage(i);
+	}
+
+	//each band at its own mid-band and edge frequencies, and 2 octaves either side
+	std::vector<double> g;
+	for (int i = 0; i < n_bands; i++) {
+		bandGains_dB(bank, fs_Hz, fm[i], g);  mid_dB[i] = g[i];
+		bandGains_dB(bank, fs_Hz, lo[i], g);  lo_dB[i] = g[i];
+		bandGains_dB(bank, fs_Hz, hi[i], g);  hi_dB[i] = g[i];
+		for (double ratio : {0.25, 4.0}) {
+			if (fm[i] * ratio > 0.45 * fs_Hz) continue;
+			bandGains_dB(bank, fs_Hz, fm[i] * ratio, g);
+			if (g[i] > skirt_dB[i]) skirt_dB[i] = g[i];
+		}
+	}
+
+	//a sweep of sines from the slowest stage's Nyquist frequency up to near fs/2, at 1/24 octave steps
+	//(every band hears all of them at once)
+	const double f_start = 0.5 * fs_Hz / (1 << (bank.getNumStages() - 1));
+	for (double f = f_start; f < 0.48 * fs_Hz; f *= pow(2.0, 1.0 / 24.0)) {
+		bandGains_dB(bank, fs_Hz, f, g);
+		for (int i = 0; i < n_bands; i++) {
+			if ((stage[i] > 0) && (f > 0.5 * fs_Hz / (1 << stage[i])) && (g[i] > alias_dB[i])) { alias_dB[i] = g[i];  alias_Hz[i] = f; }
+		}
+	}
+
+	bool pass = true;
+	printf("band,nominal_Hz,stage,mid_dB,lower_edge_dB,upper_edge_dB,skirt_2oct_dB,worst_alias_dB,worst_alias_Hz,result\n");
+	for (int i = 0; i < n_bands; i++) {
+		bool ok = (fabs(mid_dB[i]) <= MID_TOL_DB) && (fabs(lo_dB[i] - EDGE_DB) <= EDGE_TOL_DB) && (fabs(hi_dB[i] - EDGE_DB) <= EDGE_TOL_DB);
+		if ((stage[i] > 0) && (alias_dB[i] >= skirt_dB[i])) ok = false;
+		if (!ok) pass = false;
+		printf("%d,%.1f,%d,%.4f,%.3f,%.3f,%.1f,%.1f,%.0f,%s\n", i, bank.getNominal_Hz(i), stage[i], mid_dB[i], lo_dB[i], hi_dB[i],
+			skirt_dB[i], (stage[i] > 0) ? alias_dB[i] : 0.0, alias_Hz[i], ok ? "PASS" : "FAIL");
+	}
+	printf("%s\n", pass ? "PASS" : "FAIL");
+	return pass ? 0 : 1;
+}
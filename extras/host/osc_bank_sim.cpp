@@ -0,0 +1,162 @@
+/*
+ * osc_bank_sim
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop check of OscillatorBank (src/utility/osc_bank.h).  Runs a bank of tones for a
+ *    while (with small amplitude steps and, optionally, log sweeps on every tone) and compares it against
+ *    the same tones computed in double precision.  Prints one CSV line per case: the worst error
+ *    (in dB relative to the total amplitude of the tones) and the speed.  Also checks that a
+ *    default-constructed AudioSynthOscillatorBank_F32 runs at AUDIO_SAMPLE_RATE_EXACT, in both the
+ *    frequency of its tones and the fs_Hz of its blocks, and returns 1 if not.
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -std=c++11 -Iextras/host/shim -Isrc -Isrc/utility extras/host/osc_bank_sim.cpp extras/host/shim/shim.cpp \
+ *            src/AudioStream_F32.cpp src/synth_oscbank_f32.cpp src/utility/osc_bank.cpp -o osc_bank_sim
+ *        ./osc_bank_sim                        (the node check, then a sweep of common settings)
+ *        ./osc_bank_sim 8 128 44100 1 60       (n_tones, block, fs_Hz, sweep [0 or 1], seconds)
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <vector>
+#include "utility/osc_bank.h"
+#include "AudioStream_F32.h"
+#include "synth_oscbank_f32.h"
+
+static void printHeader(void) {
+	printf("n_tones,block,fs_Hz,sweep,seconds,worst_err_dB,ns_per_sample,ns_per_tone_sample\n");
+}
+
+static double nowSec(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + 1.0e-9 * ts.tv_nsec;
+}
+
+static void runCase(int n_tones, int block, float fs_Hz, bool do_sweep, float seconds) {
+	static OscillatorBank bank;
+	bank.clear();
+	bank.setSampleRate_Hz(fs_Hz);
+
+	//the double-precision reference follows the same schedule: frequency changes linearly within each block
+	std::vector<double> ref_phase(n_tones), ref_freq(n_tones), ref_amp(n_tones);
+	double amp_total = 0.0;
+	for (int t = 0; t < n_tones; t++) {
+		float f = 100.0f * powf(2.0f, 0.37f * t);
+		while (f > 0.45f * fs_Hz) f *= 0.25f;
+		float a = 0.9f / n_tones;
+		float ph = 37.0f * t;
+		bank.addTone(f, a, ph);
+		ref_freq[t] = f;  ref_amp[t] = a;  ref_phase[t] = ph * M_PI / 180.0;
+		amp_total += a;
+		if (do_sweep) bank.sweep(t, (t & 1) ? 0.5f*f : 2.0f*f, 0.5f*seconds, OscillatorBank::LOG);
+	}
+
+	std::vector<float> out(block);
+	const long n_blocks = (long)(seconds * fs_Hz / block);
+	double worst_err = 0.0;
+	srand(1);
+	for (long b = 0; b < n_blocks; b++) {
+		//now and then, move each amplitude to within +/-3 dB of where it started, in 0.1 dB steps
+		if ((b % 50) == 49) {
+			for (int t = 0; t < n_tones; t++) bank.setAmplitude_dB(t, 20.0f * log10f(0.9f / n_tones) + 0.1f * ((rand() % 61) - 30));
+		}
+		std::vector<double> f_start(n_tones), a_start(n_tones);
+		for (int t = 0; t < n_tones; t++) { f_start[t] = bank.getFrequency_Hz(t); a_start[t] = ref_amp[t]; ref_amp[t] = bank.getAmplitude(t); }
+
+		bank.synthesize(out.data(), block);
+
+		for (int t = 0; t < n_tones; t++) ref_freq[t] = bank.getFrequency_Hz(t);
+		for (int k = 0; k < block; k++) {
+			double y = 0.0;
+			for (int t = 0; t < n_tones; t++) {
+				double a = a_start[t] + (ref_amp[t] - a_start[t]) * k / block;
+				y += a * sin(ref_phase[t]);
+				double f = f_start[t] + (ref_freq[t] - f_start[t]) * k / block;
+				ref_phase[t] += 2.0 * M_PI * f / fs_Hz;
+			}
+			double err = fabs(out[k] - y);
+			if (err > worst_err) worst_err = err;
+		}
+	}
+
+	//speed, without the reference
+	const int n_time = 2000;
+	double t0 = nowSec();
+	for (int b = 0; b < n_time; b++) bank.synthesize(out.data(), block);
+	double ns = 1.0e9 * (nowSec() - t0) / ((double)n_time * block);
+
+	printf("%d,%d,%.0f,%d,%.0f,%.1f,%.2f,%.3f\n", n_tones, block, fs_Hz, do_sweep ? 1 : 0, seconds,
+		20.0 * log10(worst_err / amp_total + 1.0e-30), ns, ns / n_tones);
+}
+
+//records the node's output and the sample rate stamped on each block
+class OscBankSink : public AudioStream_F32 {
+	public:
+		OscBankSink(void) : AudioStream_F32(1, inputQueueArray) {}
+		void update(void) {
+			audio_block_f32_t *block = receiveReadOnly_f32();
+			if (!block) return;
+			y.insert(y.end(), block->data, block->data + block->length);
+			if (block->fs_Hz != AUDIO_SAMPLE_RATE_EXACT) n_bad_fs++;
+			last_fs_Hz = block->fs_Hz;
+			release(block);
+		}
+		std::vector<float> y;
+		int n_bad_fs = 0;
+		float last_fs_Hz = 0.0f;
+	private:
+		audio_block_f32_t *inputQueueArray[1];
+};
+
+//A default-constructed node must run at the Teensy's true rate, AUDIO_SAMPLE_RATE_EXACT, not 44100 Hz
+static bool checkDefaultNode(void) {
+	const float freq_Hz = 1000.0f;
+	AudioMemory_F32(8);
+	AudioSynthOscillatorBank_F32 osc;
+	OscBankSink sink;
+	AudioConnection_F32 patchCord(osc, 0, sink, 0);
+	osc.addTone(freq_Hz, 0.5f);
+	const int n_blocks = (int)(2.0f * AUDIO_SAMPLE_RATE_EXACT / AUDIO_BLOCK_SAMPLES);
+	for (int b = 0; b < n_blocks; b++) { osc.update(); sink.update(); }
+
+	//measure the frequency from the first and last rising zero crossings (interpolated)
+	double first = -1.0, last = -1.0;
+	int n_cross = 0;
+	for (size_t i = 1; i < sink.y.size(); i++) {
+		if ((sink.y[i-1] < 0.0f) && (sink.y[i] >= 0.0f)) {
+			double t = (i - 1) + sink.y[i-1] / (double)(sink.y[i-1] - sink.y[i]);
+			if (first < 0.0) first = t;
+			last = t;
+			n_cross++;
+		}
+	}
+	double meas_Hz = (n_cross > 1) ? (n_cross - 1) * (double)AUDIO_SAMPLE_RATE_EXACT / (last - first) : 0.0;
+	double err_ppm = 1.0e6 * (meas_Hz / freq_Hz - 1.0);
+	bool pass = (fabs(err_ppm) < 5.0) && (sink.n_bad_fs == 0);
+	printf("default node: fs_Hz stamped %.3f (expected %.3f), %d bad blocks, %.0f Hz tone measured %.4f Hz (%+.2f ppm): %s\n",
+		sink.last_fs_Hz, AUDIO_SAMPLE_RATE_EXACT, sink.n_bad_fs, freq_Hz, meas_Hz, err_ppm, pass ? "PASS" : "FAIL");
+	return pass;
+}
+
+int main(int argc, char *argv[]) {
+	if (!checkDefaultNode()) return 1;
+	printHeader();
+	if (argc >= 6) {
+		runCase(atoi(argv[1]), atoi(argv[2]), (float)atof(argv[3]), atoi(argv[4]) != 0, (float)atof(argv[5]));
+		return 0;
+	}
+	const int tones[] = {1, 4, 8, 32};
+	const int blocks[] = {16, 128};
+	for (int n : tones) {
+		for (int block : blocks) {
+			for (int sw = 0; sw < 2; sw++) runCase(n, block, 44100.0f, sw != 0, 60.0f);
+		}
+	}
+	return 0;
+}
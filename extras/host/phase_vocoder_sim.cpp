@@ -0,0 +1,215 @@
+/*
+ * phase_vocoder_sim
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop check of PhaseVocoder (src/utility/phase_vocoder.h), the engine behind
+ *    AudioEffectPhaseVocoder_F32.  Checks:
+ *      - with no changes, the output is the input (full-scale noise), N samples later, to within 5e-7
+ *        (4 steps of a float at 1.0);
+ *      - a 440 Hz sine, pitch shifted by 0.7, 1.5 and 2, comes out at 308, 660 and 880 Hz (within 0.01 Hz,
+ *        by a least-squares fit, with at least 99% of the output's power in that tone);
+ *      - frequency lowering above 2 kHz at 2:1 takes a 4 kHz sine to 2828 Hz (the same way);
+ *      - a 1 kHz formant (harmonics of 200 Hz, shaped by a resonance) moves to 1.5 kHz with a formant
+ *        ratio of 1.5, stays at 1 kHz under a 1.5 pitch shift with a formant ratio of 1, and moves to
+ *        1.5 kHz under the same pitch shift with no envelope (within 30 Hz, from the shape of the output
+ *        harmonics' levels).  These need bins of 50 Hz or less, so that each harmonic is a peak of its own,
+ *        and are skipped otherwise.
+ *    Prints the results and returns 1 if any check fails.
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -Isrc extras/host/phase_vocoder_sim.cpp src/utility/phase_vocoder.cpp src/utility/BTNRH_rfft.cpp -o phase_vocoder_sim
+ *        ./phase_vocoder_sim              (24 kHz, N=512, 4x overlap, as AudioEffectPhaseVocoder_F32 defaults to)
+ *        ./phase_vocoder_sim 44100 1024 8 (sample rate, N, overlap)
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include "utility/phase_vocoder.h"
+
+#define PASS_TOL 5.0e-7
+#define FREQ_TOL_HZ 0.01
+#define MIN_PURITY 0.99
+#define FORMANT_TOL_HZ 30.0
+#define SETTLE_SEC 0.5
+#define MEASURE_SEC 1.0
+
+static const int block = 128;
+
+//the amplitude of the sine at f_Hz in y[start..], by least squares
+static double fitAmp(const std::vector<float> &y, const long start, const double f_Hz, const double fs_Hz) {
+	double cc = 0, ss = 0, cs = 0, yc = 0, ys = 0;
+	for (size_t i = start; i < y.size(); i++) {
+		const double c = cos(2.0 * M_PI * f_Hz * i / fs_Hz), s = sin(2.0 * M_PI * f_Hz * i / fs_Hz);
+		cc += c * c;  ss += s * s;  cs += c * s;  yc += y[i] * c;  ys += y[i] * s;
+	}
+	const double det = cc * ss - cs * cs;
+	const double a = (yc * ss - ys * cs) / det, b = (ys * cc - yc * cs) / det;
+	return sqrt(a * a + b * b);
+}
+
+//the frequency (within lo_Hz to hi_Hz) of the sine that best fits y[start..]: on a grid finer than the
+//fit's main lobe, then by golden-section search around the best of the grid
+static double fitFreq(const std::vector<float> &y, const long start, double lo_Hz, double hi_Hz, const double fs_Hz) {
+	const double step_Hz = 0.25 * fs_Hz / (y.size() - start);
+	double best_Hz = lo_Hz, best = 0.0;
+	for (double f = lo_Hz; f <= hi_Hz; f += step_Hz) {
+		const double a = fitAmp(y, start, f, fs_Hz);
+		if (a > best) { best = a;  best_Hz = f; }
+	}
+	lo_Hz = best_Hz - step_Hz;  hi_Hz = best_Hz + step_Hz;
+	const double g = 0.5 * (sqrt(5.0) - 1.0);
+	double a = hi_Hz - g * (hi_Hz - lo_Hz), b = lo_Hz + g * (hi_Hz - lo_Hz);
+	double fa = fitAmp(y, start, a, fs_Hz), fb = fitAmp(y, start, b, fs_Hz);
+	while (hi_Hz - lo_Hz > 1.0e-5) {
+		if (fa > fb) { hi_Hz = b;  b = a;  fb = fa;  a = hi_Hz - g * (hi_Hz - lo_Hz);  fa = fitAmp(y, start, a, fs_Hz); }
+		else         { lo_Hz = a;  a = b;  fa = fb;  b = lo_Hz + g * (hi_Hz - lo_Hz);  fb = fitAmp(y, start, b, fs_Hz); }
+	}
+	return 0.5 * (lo_Hz + hi_Hz);
+}
+
+static double meanSquare(const std::vector<float> &y, const long start) {
+	double s = 0.0;
+	for (size_t i = start; i < y.size(); i++) s += (double)y[i] * y[i];
+	return s / (y.size() - start);
+}
+
+//run x through pv, a block at a time (from reset)
+static void run(PhaseVocoder &pv, const std::vector<float> &x, std::vector<float> &y) {
+	pv.reset();
+	y.resize(x.size());
+	for (size_t n = 0; n < x.size(); n += block) {
+		const int len = (x.size() - n < (size_t)block) ? (int)(x.size() - n) : block;
+		pv.process(&x[n], &y[n], len);
+	}
+}
+
+//a sine in, and where it comes out
+static bool checkTone(PhaseVocoder &pv, const double fs_Hz, const double f_in, const double f_expect, const char *what) {
+	std::vector<float> x((long)((SETTLE_SEC + MEASURE_SEC) * fs_Hz)), y;
+	for (size_t i = 0; i < x.size(); i++) x[i] = (float)(0.5 * sin(2.0 * M_PI * f_in * i / fs_Hz));
+	run(pv, x, y);
+	const long start = (long)(SETTLE_SEC * fs_Hz);
+	const double bin_Hz = fs_Hz / pv.getNFFT();
+	const double f = fitFreq(y, start, f_expect - bin_Hz, f_expect + bin_Hz, fs_Hz);
+	const double amp = fitAmp(y, start, f, fs_Hz);
+	const double purity = 0.5 * amp * amp / meanSquare(y, start);
+	const bool ok = (fabs(f - f_expect) <= FREQ_TOL_HZ) && (purity >= MIN_PURITY);
+	printf("%s: %.0f Hz in, %.3f Hz out (expected %.3f Hz), %.2f%% of the power: %s\n", what, f_in, f, f_expect, 100.0 * purity, ok ? "PASS" : "FAIL");
+	return ok;
+}
+
+//the input for the formant checks: harmonics of 200 Hz (4 bins apart at N=512 and 24 kHz, so that
+//each is a peak of its own), shaped by a two-pole resonance at 1 kHz
+#define FORMANT_F0_HZ 200.0
+#define FORMANT_HZ 1000.0
+#define FORMANT_Q 4.0
+#define MAX_FORMANT_BIN_HZ 50.0
+static double formant_dB(const double f_Hz) {
+	const double r = f_Hz / FORMANT_HZ;
+	return -10.0 * log10((1.0 - r * r) * (1.0 - r * r) + (r / FORMANT_Q) * (r / FORMANT_Q));
+}
+
+//where the formant ends up: the output's harmonics (of out_f0_Hz, up to 3 kHz) are matched, in dB, to
+//the input's resonance moved by s (its shape at f/s, at any gain), and the best s, times 1 kHz, is returned
+static double formantPeak_Hz(PhaseVocoder &pv, const double fs_Hz, const double out_f0_Hz) {
+	std::vector<float> x((long)((SETTLE_SEC + MEASURE_SEC) * fs_Hz)), y;
+	std::vector<double> amp, ph;
+	for (double f = FORMANT_F0_HZ; f < 0.45 * fs_Hz; f += FORMANT_F0_HZ) {
+		amp.push_back(0.02 * pow(10.0, formant_dB(f) / 20.0));
+		ph.push_back((2.0 * M_PI * rand()) / RAND_MAX);
+	}
+	for (size_t i = 0; i < x.size(); i++) {
+		double v = 0.0;
+		for (size_t h = 0; h < amp.size(); h++) v += amp[h] * sin(2.0 * M_PI * FORMANT_F0_HZ * (h + 1) * i / fs_Hz + ph[h]);
+		x[i] = (float)v;
+	}
+	run(pv, x, y);
+	const long start = (long)(SETTLE_SEC * fs_Hz);
+
+	std::vector<double> f_out, level_dB;
+	for (double f = out_f0_Hz; f <= 3000.0; f += out_f0_Hz) {
+		f_out.push_back(f);
+		level_dB.push_back(20.0 * log10(fitAmp(y, start, f, fs_Hz) + 1.0e-30));
+	}
+	double best_s = 0.0, best_err = 1.0e30;
+	for (double s = 0.5; s <= 2.5; s += 0.001) {
+		double mean = 0.0, err = 0.0;
+		for (size_t h = 0; h < f_out.size(); h++) mean += level_dB[h] - formant_dB(f_out[h] / s);
+		mean /= f_out.size();
+		for (size_t h = 0; h < f_out.size(); h++) { const double e = level_dB[h] - formant_dB(f_out[h] / s) - mean;  err += e * e; }
+		if (err < best_err) { best_err = err;  best_s = s; }
+	}
+	return best_s * FORMANT_HZ;
+}
+
+int main(int argc, char *argv[]) {
+	const double fs_Hz = (argc >= 2) ? atof(argv[1]) : 24000.0;
+	const int N = (argc >= 3) ? atoi(argv[2]) : 512;
+	const int overlap = (argc >= 4) ? atoi(argv[3]) : 4;
+	static PhaseVocoder pv;
+	if (!pv.setup((float)fs_Hz, N, overlap)) {
+		fprintf(stderr, "phase_vocoder_sim: bad settings\n");
+		return 1;
+	}
+	printf("%.0f Hz, N=%d, %dx overlap\n", fs_Hz, N, overlap);
+	bool pass = true;
+
+	//pass-through
+	{
+		srand(1);
+		std::vector<float> x((long)(2.0 * fs_Hz)), y;
+		for (size_t i = 0; i < x.size(); i++) x[i] = (2.0f * rand()) / RAND_MAX - 1.0f;
+		run(pv, x, y);
+		const int delay = pv.getLatency_samples();
+		double worst = 0.0;
+		for (size_t i = 0; i + delay < x.size(); i++) worst = fmax(worst, fabs((double)y[i + delay] - x[i]));
+		const bool ok = (worst <= PASS_TOL);
+		printf("pass-through, %d samples late: worst error %.2e: %s\n", delay, worst, ok ? "PASS" : "FAIL");
+		pass = pass && ok;
+	}
+
+	//pitch shifts
+	for (double ratio : {0.7, 1.5, 2.0}) {
+		pv.setPitchRatio((float)ratio);
+		char what[40];
+		snprintf(what, sizeof(what), "pitch x%.1f", ratio);
+		pass = checkTone(pv, fs_Hz, 440.0, 440.0 * ratio, what) && pass;
+	}
+	pv.setPitchRatio(1.0f);
+
+	//frequency lowering
+	pv.setFreqLowering(2000.0f, 2.0f);
+	pass = checkTone(pv, fs_Hz, 4000.0, 2000.0 * sqrt(2.0), "lowering above 2 kHz, 2:1") && pass;
+	pv.setFreqLowering(2000.0f, 1.0f);
+
+	//formants
+	if (fs_Hz / N > MAX_FORMANT_BIN_HZ) {
+		printf("formants: skipped (bins of %.1f Hz are too wide for harmonics %.0f Hz apart)\n", fs_Hz / N, FORMANT_F0_HZ);
+	} else {
+		srand(2);
+		pv.setFormantRatio(1.5f);
+		const double moved = formantPeak_Hz(pv, fs_Hz, FORMANT_F0_HZ);
+		pv.setPitchRatio(1.5f);  pv.setFormantRatio(1.0f);
+		const double kept = formantPeak_Hz(pv, fs_Hz, 1.5 * FORMANT_F0_HZ);
+		pv.setFormantRatio(0.0f);
+		const double with_pitch = formantPeak_Hz(pv, fs_Hz, 1.5 * FORMANT_F0_HZ);
+		pv.setPitchRatio(1.0f);  pv.setFormantRatio(0.0f);
+		bool ok = (fabs(moved - 1500.0) <= FORMANT_TOL_HZ);
+		printf("formant at 1 kHz, formant ratio 1.5: peak at %.0f Hz (expected 1500 Hz): %s\n", moved, ok ? "PASS" : "FAIL");
+		pass = pass && ok;
+		ok = (fabs(kept - 1000.0) <= FORMANT_TOL_HZ);
+		printf("formant at 1 kHz, pitch x1.5, formant ratio 1: peak at %.0f Hz (expected 1000 Hz): %s\n", kept, ok ? "PASS" : "FAIL");
+		pass = pass && ok;
+		ok = (fabs(with_pitch - 1500.0) <= FORMANT_TOL_HZ);
+		printf("formant at 1 kHz, pitch x1.5, no envelope: peak at %.0f Hz (expected 1500 Hz): %s\n", with_pitch, ok ? "PASS" : "FAIL");
+		pass = pass && ok;
+	}
+
+	printf("%s\n", pass ? "PASS" : "FAIL");
+	return pass ? 0 : 1;
+}
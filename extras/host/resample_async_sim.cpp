@@ -0,0 +1,184 @@
+/*
+ * resample_async_sim
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop test of AudioResampleAsync (src/utility/resample_async.h).  A producer pushes
+ *    blocks of a sine wave on its own (drifting, jittery) clock and a consumer pulls blocks on the
+ *    other clock, like USB audio feeding the I2S.  Prints one CSV line per case: whether the FIFO
+ *    ever ran dry or overflowed after locking, how well the controller found the drift, how much
+ *    the ratio wobbles once locked, and the SINAD of the output against an ideal sine (in the worst
+ *    of many short windows, so that slow and harmless latency wander doesn't count).  A case fails if,
+ *    over the second half of the run, the FIFO ran dry or overflowed or the correction strayed more
+ *    than 3 ppm from the drift.  Returns 1 if any case failed.
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -Isrc extras/host/resample_async_sim.cpp src/utility/resample_async.cpp -o resample_async_sim
+ *        ./resample_async_sim                             (sweep of common settings)
+ *        ./resample_async_sim 44100 44117.647 128 128 250 0 (fs_in, fs_out, block_in, block_out, drift_ppm, mode [, seconds])
+ *
+ *    mode is 0 for QUALITY and 1 for CHEAP.  With blocks over 32 samples, the loop is slower (see
+ *    resample_async.cpp), so by default a case runs for 120 seconds per 32 samples of block.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include "utility/resample_async.h"
+
+#define MAX_CORRECTION_ERR_PPM 3.0f
+
+static void printHeader(void) {
+	printf("fs_in,fs_out,block_in,block_out,drift_ppm,mode,seconds,lock_sec,underruns,overruns,"
+		"correction_ppm,correction_ripple_ppm,fill_target,fill_min,fill_max,worst_sinad_dB,result\n");
+}
+
+//Least-squares fit of a sine (plus DC) near a known frequency.  The n*sin and n*cos terms let the fit follow
+//a small offset in frequency (or amplitude), so that only noise, distortion, and glitches count as error.
+//Returns the SINAD in dB.
+static double sinad_dB(const float *y, size_t len, double f_norm) {
+	const int N = 5;
+	double s[N][N] = {{0}}, b[N] = {0};
+	const double half = 0.5 * len;
+	#define BASIS(n, v) { double w = 2.0*M_PI*f_norm*(n), t = ((n) - half) / half; \
+		v[0] = sin(w); v[1] = cos(w); v[2] = t*sin(w); v[3] = t*cos(w); v[4] = 1.0; }
+	for (size_t n = 0; n < len; n++) {
+		double v[N];
+		BASIS((double)n, v);
+		for (int i = 0; i < N; i++) { b[i] += v[i]*y[n]; for (int j = 0; j < N; j++) s[i][j] += v[i]*v[j]; }
+	}
+	//solve the normal equations (Gaussian elimination)
+	for (int i = 0; i < N; i++) {
+		for (int k = i+1; k < N; k++) {
+			double f = s[k][i] / s[i][i];
+			for (int j = 0; j < N; j++) s[k][j] -= f*s[i][j];
+			b[k] -= f*b[i];
+		}
+	}
+	double c[N];
+	for (int i = N-1; i >= 0; i--) {
+		double acc = b[i];
+		for (int j = i+1; j < N; j++) acc -= s[i][j]*c[j];
+		c[i] = acc / s[i][i];
+	}
+	double sig = 0.0, err = 0.0;
+	for (size_t n = 0; n < len; n++) {
+		double v[N], fit = 0.0;
+		BASIS((double)n, v);
+		for (int i = 0; i < N; i++) fit += c[i]*v[i];
+		sig += fit*fit;
+		err += (y[n]-fit)*(y[n]-fit);
+	}
+	#undef BASIS
+	return 10.0*log10(sig / (err + 1.0e-30));
+}
+
+//The SINAD of the worst short window.  Slow wander of the latency or of the ratio (which is inaudible) doesn't
+//count against it, but any fast wobble of the pitch or any glitch does.
+static double worstSinad_dB(const std::vector<float> &y, double f_norm) {
+	const size_t win = 4096;
+	double worst = 1.0e9;
+	for (size_t start = 0; start + win <= y.size(); start += win) {
+		double val = sinad_dB(&y[start], win, f_norm);
+		if (val < worst) worst = val;
+	}
+	return worst;
+}
+
+static bool runCase(float fs_in, float fs_out, int block_in, int block_out, float drift_ppm, int mode, float seconds) {
+	static AudioResampleAsync rs;  //big (FIFO and filter), so keep it off the stack
+	rs.configure(fs_in, fs_out, block_out, 1, (mode == 1) ? AudioResampleAsync::CHEAP : AudioResampleAsync::QUALITY);
+
+	const double f0 = 1000.0;                            //test tone, at the producer's nominal rate
+	const double t_push = block_in / (fs_in * (1.0 + drift_ppm*1.0e-6));  //the producer's real clock
+	const double t_pull = block_out / (double)fs_out;
+	srand(1);
+
+	std::vector<float> in(block_in), out(block_out), y;
+	std::vector<float> corr;
+	double t = 0.0, push_clock = 0.0, next_push = 0.0, next_pull = 0.5*t_pull;
+	long n_in = 0;
+	double lock_sec = -1.0;
+	unsigned long under_at_lock = 0, over_at_lock = 0, under_at_half = 0, over_at_half = 0;
+	bool past_half = false;
+	float fill_min = 1.0e9f, fill_max = -1.0e9f;
+	while (t < seconds) {
+		if (next_push <= next_pull) {
+			t = next_push;
+			for (int i = 0; i < block_in; i++, n_in++) in[i] = (float)(0.5*sin(2.0*M_PI*f0*n_in/fs_in));
+			const float *p_in[1] = { in.data() };
+			rs.push(p_in, block_in);
+			//USB-style arrival jitter: up to a quarter block early or late (around the producer's steady clock)
+			push_clock += t_push;
+			next_push = push_clock + 0.25 * t_push * (2.0*rand()/(double)RAND_MAX - 1.0);
+			if (next_push < t) next_push = t;
+		} else {
+			t = next_pull;
+			float *p_out[1] = { out.data() };
+			rs.pull(p_out);
+			next_pull += t_pull;
+			if ((lock_sec < 0.0) && rs.isLocked() && (fabsf(rs.getCorrection_ppm() - drift_ppm) < 0.1f*fabsf(drift_ppm) + 2.0f)) {
+				lock_sec = t;
+				under_at_lock = rs.getUnderrunCount();
+				over_at_lock = rs.getOverrunCount();
+			}
+			if (t > 0.5*seconds) {
+				if (!past_half) { past_half = true; under_at_half = rs.getUnderrunCount(); over_at_half = rs.getOverrunCount(); }
+				y.insert(y.end(), out.begin(), out.end());
+				corr.push_back(rs.getCorrection_ppm());
+				float fill = rs.getFill();
+				if (fill < fill_min) fill_min = fill;
+				if (fill > fill_max) fill_max = fill;
+			}
+		}
+	}
+
+	float c_min = 1.0e9f, c_max = -1.0e9f, c_mean = 0.0f;
+	for (float c : corr) { if (c < c_min) c_min = c; if (c > c_max) c_max = c; c_mean += c; }
+	if (!corr.empty()) c_mean /= corr.size();
+	double sinad = worstSinad_dB(y, f0 * (1.0 + drift_ppm*1.0e-6) / fs_out);
+
+	const bool pass = (rs.getUnderrunCount() == under_at_half) && (rs.getOverrunCount() == over_at_half) &&
+		(fabsf(c_max - drift_ppm) <= MAX_CORRECTION_ERR_PPM) && (fabsf(c_min - drift_ppm) <= MAX_CORRECTION_ERR_PPM);
+
+	printf("%.3f,%.3f,%d,%d,%.1f,%s,%.0f,%.2f,%lu,%lu,%.1f,%.2f,%.0f,%.0f,%.0f,%.1f,%s\n",
+		fs_in, fs_out, block_in, block_out, drift_ppm, (mode == 1) ? "cheap" : "quality", seconds, lock_sec,
+		rs.getUnderrunCount() - under_at_lock, rs.getOverrunCount() - over_at_lock,
+		c_mean, c_max - c_min, rs.getTargetFill(), fill_min, fill_max, sinad, pass ? "PASS" : "FAIL");
+	return pass;
+}
+
+//long enough for the loop to settle by half way.  It slows down in proportion to blocks over 32 samples.
+static float defaultSeconds(int block_in, int block_out, float fs_in, float fs_out) {
+	float block = block_in;
+	if (block < block_out * fs_in / fs_out) block = block_out * fs_in / fs_out;
+	return 120.0f * ((block > 32.0f) ? (block / 32.0f) : 1.0f);
+}
+
+int main(int argc, char *argv[]) {
+	printHeader();
+	if (argc >= 7) {
+		float fs_in = (float)atof(argv[1]), fs_out = (float)atof(argv[2]);
+		int block_in = atoi(argv[3]), block_out = atoi(argv[4]);
+		float seconds = (argc >= 8) ? (float)atof(argv[7]) : defaultSeconds(block_in, block_out, fs_in, fs_out);
+		return runCase(fs_in, fs_out, block_in, block_out, (float)atof(argv[5]), atoi(argv[6]), seconds) ? 0 : 1;
+	}
+
+	struct { float fs_in, fs_out; } rates[] = { {44100.0f, 44117.647f}, {48000.0f, 48000.0f}, {48000.0f, 24000.0f}, {44100.0f, 24000.0f}, {24000.0f, 44100.0f} };
+	const int blocks[] = {16, 128};
+	const float drifts[] = {-300.0f, 0.0f, 150.0f};
+	bool pass = true;
+	for (auto r : rates) {
+		for (int block : blocks) {
+			for (float drift : drifts) {
+				for (int mode = 0; mode < 2; mode++) {
+					pass = runCase(r.fs_in, r.fs_out, block, block, drift, mode, defaultSeconds(block, block, r.fs_in, r.fs_out)) && pass;
+				}
+			}
+		}
+	}
+	return pass ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+/*
+ * sd_writer_sim
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop model of SD recording.  Runs BufferedSDWriter (src/SDWriter.h) on a FAT disk image
+ *    through FileImageDriver, which gives each write an SD-card-like delay and, now and then, a long
+ *    stall.  The audio blocks arrive on a simulated clock, just as the audio interrupt delivers them,
+ *    including during a slow write.  Prints one CSV line per case with the overruns (lost audio) and
+ *    the peak buffer fill.  Use it to choose the buffer size (allocateBuffer) for a given card.
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -std=c++11 -Iextras/host/shim -Isrc -Isrc/utility extras/host/sd_writer_sim.cpp extras/host/shim/shim.cpp \
+ *            src/utility/convert_f32.cpp src/SdFat_Gre_SdCard/FileImageDriver.cpp src/SdFat_Gre_FatLib/FatVolume.cpp \
+ *            src/SdFat_Gre_FatLib/FatFile.cpp src/SdFat_Gre_FatLib/FatFileLFN.cpp src/SdFat_Gre_FatLib/FatFileSFN.cpp \
+ *            -o sd_writer_sim
+ *        ./sd_writer_sim                       (sweep of buffer sizes and stall rates)
+ *        ./sd_writer_sim 32768 2000 250 20     (buffer bytes, stalls per million writes, longest stall msec, seconds)
+ *
+ *    The disk image (sd_writer_sim.img, 64 MB) is made and formatted FAT16 in the current directory.
+ *    Time is simulated, so a case runs much faster than real time.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "Arduino.h"
+#include "SDWriter.h"
+
+#define IMAGE_FNAME "sd_writer_sim.img"
+#define IMAGE_BLOCKS 131072   //64 MB
+#define REC_FNAME "AUDIO001.WAV"
+
+static const float fs_Hz = 44100.0f;
+static const int block_samples = 128;
+static const int n_chan = 2;
+
+//Lay down an empty FAT16 volume with no partition table, as "mkfs.vfat -F 16" would
+static bool formatImage(FileImageDriver *drv) {
+	const uint32_t n_blocks = drv->cardSize();
+	const uint8_t blocks_per_cluster = 4;
+	const uint16_t root_entries = 512;
+	const uint16_t root_blocks = root_entries * sizeof(dir_t) / 512;
+	const uint16_t blocks_per_fat = (2*(n_blocks / blocks_per_cluster + 2) + 511) / 512;
+
+	uint8_t buf[512];
+	memset(buf, 0, sizeof(buf));
+	fat_boot_t *fbs = (fat_boot_t *)buf;
+	fbs->jump[0] = 0xEB;  fbs->jump[1] = 0x3C;  fbs->jump[2] = 0x90;
+	memcpy(fbs->oemId, "OPENAUD ", 8);
+	fbs->bytesPerSector = 512;
+	fbs->sectorsPerCluster = blocks_per_cluster;
+	fbs->reservedSectorCount = 1;
+	fbs->fatCount = 2;
+	fbs->rootDirEntryCount = root_entries;
+	fbs->mediaType = 0xF8;
+	fbs->sectorsPerFat16 = blocks_per_fat;
+	fbs->sectorsPerTrack = 32;
+	fbs->headCount = 64;
+	fbs->totalSectors32 = n_blocks;
+	fbs->driveNumber = 0x80;
+	fbs->bootSignature = EXTENDED_BOOT_SIG;
+	fbs->volumeSerialNumber = 0x20261018;
+	memcpy(fbs->volumeLabel, "NO NAME    ", 11);
+	memcpy(fbs->fileSystemType, "FAT16   ", 8);
+	fbs->bootSectorSig0 = BOOTSIG0;
+	fbs->bootSectorSig1 = BOOTSIG1;
+	if (!drv->writeBlock(0, buf)) return false;
+
+	//both FATs (the first two entries are reserved) and then the empty root directory
+	for (uint32_t block = 1; block < 1 + 2*(uint32_t)blocks_per_fat + root_blocks; block++) {
+		memset(buf, 0, sizeof(buf));
+		if ((block < 1 + 2*(uint32_t)blocks_per_fat) && (((block - 1) % blocks_per_fat) == 0)) {
+			buf[0] = 0xF8;  buf[1] = 0xFF;  buf[2] = 0xFF;  buf[3] = 0xFF;
+		}
+		if (!drv->writeBlock(block, buf)) return false;
+	}
+	return true;
+}
+
+//BufferedSDWriter, with the audio interrupt modelled on a simulated clock.  The blocks that fall
+//due while an SD write is under way are handed over before that write returns, as the interrupt would.
+class SimSDWriter : public BufferedSDWriter {
+	public:
+		SimSDWriter(FatFileSystem *fs, FileImageDriver *_drv) : BufferedSDWriter(fs, &Serial), drv(_drv) {
+			for (int Ichan = 0; Ichan < n_chan; Ichan++) ptr_audio[Ichan] = audio[Ichan];
+		}
+
+		size_t write(const uint8_t *buff, int nbytes) {
+			uint64_t start_usec = drv->virtualTimeMicros();
+			size_t return_val = BufferedSDWriter::write(buff, nbytes);
+			uint32_t dt_usec = (uint32_t)(drv->virtualTimeMicros() - start_usec);
+			hostAdvanceMicros(dt_usec);  //so that the writer's own timing sees the simulated write
+			now_usec += dt_usec;
+			serviceAudio();
+			return return_val;
+		}
+
+		//the audio interrupt: deliver every block that is due by now
+		void serviceAudio(void) {
+			while (next_block_usec <= now_usec) {
+				for (int Ichan = 0; Ichan < n_chan; Ichan++) {
+					for (int i = 0; i < block_samples; i++) {
+						audio[Ichan][i] = 0.5f * sinf(2.0f * (float)M_PI * (440.0f * (Ichan+1)) * (n_samples + i) / fs_Hz);
+					}
+				}
+				copyToWriteBuffer(ptr_audio, block_samples, n_chan);
+				n_samples += block_samples;
+				n_blocks++;
+				next_block_usec += 1.0e6 * block_samples / fs_Hz;
+			}
+		}
+
+		//the loop() found nothing to write, so wait for the next audio block
+		void idle(void) {
+			if (next_block_usec > now_usec) {
+				uint32_t dt_usec = (uint32_t)ceil(next_block_usec - now_usec);
+				hostAdvanceMicros(dt_usec);
+				now_usec += dt_usec;
+			}
+			serviceAudio();
+		}
+
+		FileImageDriver *drv;
+		double now_usec = 0.0, next_block_usec = 0.0;
+		unsigned long n_blocks = 0, n_samples = 0;
+	private:
+		float32_t audio[n_chan][block_samples];
+		float32_t *ptr_audio[n_chan];
+};
+
+static void printHeader(void) {
+	printf("buffer_bytes,stall_per_million,stall_max_msec,seconds,blocks,sd_writes,stalls,max_write_msec,"
+		"peak_fill_bytes,overruns,recorded_sec,lost_sec\n");
+}
+
+static bool runCase(int buffer_bytes, uint32_t stall_per_million, uint32_t stall_max_msec, float seconds) {
+	FileImageDriver drv;
+	if (!drv.begin(IMAGE_FNAME, IMAGE_BLOCKS) || !formatImage(&drv)) {
+		fprintf(stderr, "sd_writer_sim: could not make %s\n", IMAGE_FNAME);
+		return false;
+	}
+	FatFileSystem fs;
+	if (!fs.begin(&drv)) {
+		fprintf(stderr, "sd_writer_sim: could not mount %s\n", IMAGE_FNAME);
+		return false;
+	}
+
+	//a fair SD card: about 0.3 msec per 512 byte write, plus the occasional long stall
+	drv.setSleep(false);
+	drv.setSeed(1);
+	drv.setWriteLatency(250, 40, 100);
+	drv.setStall(stall_per_million, stall_max_msec * 1000 / 2, stall_max_msec * 1000);
+	drv.resetStats();
+
+	SimSDWriter writer(&fs, &drv);
+	writer.setNChanWAV(n_chan);
+	writer.setSampleRateWAV(fs_Hz);
+	writer.allocateBuffer(buffer_bytes);
+	char fname[] = REC_FNAME;
+	if (!writer.openAsWAV(fname)) {
+		fprintf(stderr, "sd_writer_sim: could not open %s\n", fname);
+		return false;
+	}
+	writer.resetStats();
+
+	//the loop(): write whenever there is enough data
+	while (writer.now_usec < 1.0e6 * seconds) {
+		if (writer.writeBufferedData() <= 0) writer.idle();
+	}
+
+	SDWriterStats stats;
+	writer.getStats(&stats);
+	writer.close();
+
+	FatFile file;
+	uint32_t file_bytes = file.open(fs.vwd(), fname, O_READ) ? file.fileSize() : 0;
+	file.close();
+	float recorded_sec = (file_bytes > 44) ? (file_bytes - 44) / (2.0f * n_chan * fs_Hz) : 0.0f;
+	float delivered_sec = writer.n_samples / fs_Hz;
+
+	printf("%d,%lu,%lu,%.1f,%lu,%lu,%lu,%.1f,%lu,%lu,%.3f,%.3f\n",
+		buffer_bytes, (unsigned long)stall_per_million, (unsigned long)stall_max_msec, seconds,
+		writer.n_blocks, (unsigned long)drv.writeCount(), (unsigned long)drv.stallCount(),
+		0.001f * stats.maxWriteLatency_usec, (unsigned long)stats.peakBufferFill_bytes,
+		(unsigned long)stats.droppedBlocks, recorded_sec, delivered_sec - recorded_sec);
+	return true;
+}
+
+int main(int argc, char *argv[]) {
+	printHeader();
+	if (argc >= 2) {
+		int buffer_bytes = atoi(argv[1]);
+		uint32_t stall_per_million = (argc >= 3) ? (uint32_t)atol(argv[2]) : 2000;
+		uint32_t stall_max_msec = (argc >= 4) ? (uint32_t)atol(argv[3]) : 250;
+		float seconds = (argc >= 5) ? (float)atof(argv[4]) : 20.0f;
+		return runCase(buffer_bytes, stall_per_million, stall_max_msec, seconds) ? 0 : 1;
+	}
+
+	const int buffers[] = {8192, 32768, 65536, maxBufferLengthBytes};
+	const uint32_t stall_rates[] = {0, 500, 2000};
+	for (int buffer_bytes : buffers) {
+		for (uint32_t stall_per_million : stall_rates) {
+			if (!runCase(buffer_bytes, stall_per_million, 250, 20.0f)) return 1;
+		}
+	}
+	return 0;
+}
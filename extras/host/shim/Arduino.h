@@ -0,0 +1,78 @@
+/*
+ * Arduino.h (host shim)
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Just enough of the Arduino/Teensy core for the library's DSP nodes to build and run on a
+ *    desktop PC, for extras/host/bench_nodes.cpp and the other host tools.  Serial prints go to
+ *    stderr.  Interrupts are no-ops, as there is only the one thread.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _host_shim_Arduino_h
+#define _host_shim_Arduino_h
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+
+typedef bool boolean;
+typedef uint8_t byte;
+//like the Teensy core's macros, these take arguments of mixed types
+template <class A, class B> static inline auto min(A a, B b) -> decltype(a + b) { return (a < b) ? a : b; }
+template <class A, class B> static inline auto max(A a, B b) -> decltype(a + b) { return (a > b) ? a : b; }
+static inline unsigned long abs(unsigned long x) { return x; }   //the Teensy core's abs() is a macro, so it takes these too
+
+#define F(s) (s)
+#define DMAMEM
+#define FASTRUN
+#define PROGMEM
+#define constrain(a,lo,hi) ((a)<(lo)?(lo):((a)>(hi)?(hi):(a)))
+
+static inline void __disable_irq(void) {}
+static inline void __enable_irq(void) {}
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long msec);
+void hostAdvanceMicros(unsigned long usec);  //moves millis() and micros() ahead, for simulated delays that don't really sleep
+
+class elapsedMicros {
+	public:
+		elapsedMicros(void) { start = micros(); }
+		operator unsigned long() const { return micros() - start; }
+		elapsedMicros & operator = (unsigned long val) { start = micros() - val; return *this; }
+	private:
+		unsigned long start;
+};
+
+class Print {
+	public:
+		size_t print(const char *s) { return fprintf(stderr, "%s", s); }
+		size_t print(char c) { return fprintf(stderr, "%c", c); }
+		size_t print(int v, int base = 10) { return fprintf(stderr, (base == 16) ? "%x" : "%d", v); }
+		size_t print(unsigned int v, int base = 10) { return fprintf(stderr, (base == 16) ? "%x" : "%u", v); }
+		size_t print(long v, int base = 10) { return fprintf(stderr, (base == 16) ? "%lx" : "%ld", v); }
+		size_t print(unsigned long v, int base = 10) { return fprintf(stderr, (base == 16) ? "%lx" : "%lu", v); }
+		size_t print(double v, int digits = 2) { return fprintf(stderr, "%.*f", digits, v); }
+		template <typename T> size_t println(T v) { size_t n = print(v); return n + println(); }
+		template <typename T> size_t println(T v, int fmt) { size_t n = print(v, fmt); return n + println(); }
+		size_t println(void) { return fprintf(stderr, "\n"); }
+		size_t printf(const char *fmt, ...);
+		void flush(void) { fflush(stderr); }
+};
+class Stream : public Print {};
+class HostSerial : public Stream {
+	public:
+		void begin(unsigned long) {}
+		operator bool() { return true; }
+		int available(void) { return 0; }
+		int read(void) { return -1; }
+};
+extern HostSerial Serial;
+
+#endif
@@ -0,0 +1,43 @@
+/*
+ * AudioStream.h (host shim)
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Stand-in for the Teensy core's AudioStream, which AudioStream_F32 is built on.  Only the
+ *    parts that the F32 nodes use are here.  The int16 audio blocks are never used on the host.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _host_shim_AudioStream_h
+#define _host_shim_AudioStream_h
+
+#include "Arduino.h"
+
+#define AUDIO_BLOCK_SAMPLES 128
+#define AUDIO_SAMPLE_RATE 44117.64706
+#define AUDIO_SAMPLE_RATE_EXACT 44117.64706f
+
+typedef struct audio_block_struct {
+	uint8_t ref_count;
+	uint8_t reserved1;
+	uint16_t memory_pool_index;
+	int16_t data[AUDIO_BLOCK_SAMPLES];
+} audio_block_t;
+
+class AudioStream {
+	public:
+		AudioStream(unsigned char n_input, audio_block_t **iqueue) { (void)n_input; (void)iqueue; }
+		virtual ~AudioStream(void) {}
+		bool active = true;
+		static uint16_t cpu_cycles_total, cpu_cycles_total_max;
+	protected:
+		static audio_block_t *allocate(void) { return NULL; }
+		static void release(audio_block_t *block) { (void)block; }
+		void transmit(audio_block_t *block, unsigned char index = 0) { (void)block; (void)index; }
+		audio_block_t *receiveReadOnly(unsigned int index = 0) { (void)index; return NULL; }
+		audio_block_t *receiveWritable(unsigned int index = 0) { (void)index; return NULL; }
+		virtual void update(void) = 0;
+};
+
+#endif
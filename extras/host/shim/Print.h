@@ -0,0 +1,11 @@
+/*
+ * Print.h (host shim)
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: The Teensy core has Print in its own header.  Here it is in Arduino.h.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include "Arduino.h"
@@ -0,0 +1,199 @@
+/*
+ * arm_math.h (host shim)
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Plain C++ versions of the CMSIS-DSP functions that the library uses, so that its nodes
+ *    can be built and run on a desktop PC (see extras/host/bench_nodes.cpp).  Each one follows the
+ *    CMSIS definition (argument order, coefficient order, state layout, and scaling), so the
+ *    results match the Teensy's to within rounding.  They are written simply, not for speed: a
+ *    host benchmark measures the library's own code plus a plain-C stand-in for CMSIS, and is
+ *    meant for comparing one version of the library against another, not for predicting the
+ *    Teensy's exact CPU load.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _host_shim_arm_math_h
+#define _host_shim_arm_math_h
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+typedef float float32_t;
+typedef int8_t q7_t;
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+typedef enum { ARM_MATH_SUCCESS = 0, ARM_MATH_ARGUMENT_ERROR = -1, ARM_MATH_LENGTH_ERROR = -2 } arm_status;
+
+#ifndef PI
+#define PI 3.14159265358979f
+#endif
+
+// ///////////////////////////////////////// basic vector math
+
+static inline void arm_add_f32(const float32_t *a, const float32_t *b, float32_t *out, uint32_t n) { for (uint32_t i = 0; i < n; i++) out[i] = a[i] + b[i]; }
+static inline void arm_sub_f32(const float32_t *a, const float32_t *b, float32_t *out, uint32_t n) { for (uint32_t i = 0; i < n; i++) out[i] = a[i] - b[i]; }
+static inline void arm_mult_f32(const float32_t *a, const float32_t *b, float32_t *out, uint32_t n) { for (uint32_t i = 0; i < n; i++) out[i] = a[i] * b[i]; }
+static inline void arm_scale_f32(const float32_t *a, float32_t s, float32_t *out, uint32_t n) { for (uint32_t i = 0; i < n; i++) out[i] = a[i] * s; }
+static inline void arm_offset_f32(const float32_t *a, float32_t s, float32_t *out, uint32_t n) { for (uint32_t i = 0; i < n; i++) out[i] = a[i] + s; }
+static inline void arm_abs_f32(const float32_t *a, float32_t *out, uint32_t n) { for (uint32_t i = 0; i < n; i++) out[i] = fabsf(a[i]); }
+static inline void arm_copy_f32(const float32_t *a, float32_t *out, uint32_t n) { memmove(out, a, n * sizeof(float32_t)); }
+static inline void arm_fill_f32(float32_t v, float32_t *out, uint32_t n) { for (uint32_t i = 0; i < n; i++) out[i] = v; }
+static inline void arm_mean_f32(const float32_t *a, uint32_t n, float32_t *result) { float32_t s = 0.0f; for (uint32_t i = 0; i < n; i++) s += a[i]; *result = s / n; }
+static inline void arm_power_f32(const float32_t *a, uint32_t n, float32_t *result) { float32_t s = 0.0f; for (uint32_t i = 0; i < n; i++) s += a[i]*a[i]; *result = s; }
+static inline void arm_rms_f32(const float32_t *a, uint32_t n, float32_t *result) { float32_t s; arm_power_f32(a, n, &s); *result = sqrtf(s / n); }
+static inline void arm_dot_prod_f32(const float32_t *a, const float32_t *b, uint32_t n, float32_t *result) { float32_t s = 0.0f; for (uint32_t i = 0; i < n; i++) s += a[i]*b[i]; *result = s; }
+static inline void arm_max_f32(const float32_t *a, uint32_t n, float32_t *result, uint32_t *index) {
+	float32_t m = a[0]; uint32_t k = 0;
+	for (uint32_t i = 1; i < n; i++) if (a[i] > m) { m = a[i]; k = i; }
+	*result = m; *index = k;
+}
+static inline void arm_cmplx_mag_f32(const float32_t *a, float32_t *out, uint32_t n) { for (uint32_t i = 0; i < n; i++) out[i] = sqrtf(a[2*i]*a[2*i] + a[2*i+1]*a[2*i+1]); }
+static inline void arm_cmplx_mag_squared_f32(const float32_t *a, float32_t *out, uint32_t n) { for (uint32_t i = 0; i < n; i++) out[i] = a[2*i]*a[2*i] + a[2*i+1]*a[2*i+1]; }
+static inline arm_status arm_sqrt_f32(float32_t in, float32_t *out) { if (in < 0.0f) { *out = 0.0f; return ARM_MATH_ARGUMENT_ERROR; } *out = sqrtf(in); return ARM_MATH_SUCCESS; }
+static inline float32_t arm_sin_f32(float32_t x) { return sinf(x); }
+static inline float32_t arm_cos_f32(float32_t x) { return cosf(x); }
+static inline q31_t arm_sin_q31(q31_t x) {   //x of 0 to 2^31 is 0 to 2*pi
+	double v = sin(2.0 * M_PI * ((uint32_t)x & 0x7FFFFFFF) / 2147483648.0) * 2147483648.0;
+	return (v >= 2147483647.0) ? 0x7FFFFFFF : (q31_t)v;
+}
+static inline void arm_float_to_q15(const float32_t *a, q15_t *out, uint32_t n) {
+	for (uint32_t i = 0; i < n; i++) {
+		float v = a[i] * 32768.0f;
+		v += (v > 0.0f) ? 0.5f : -0.5f;
+		out[i] = (v >= 32767.0f) ? 32767 : ((v <= -32768.0f) ? -32768 : (q15_t)v);
+	}
+}
+static inline void arm_q15_to_float(const q15_t *a, float32_t *out, uint32_t n) { for (uint32_t i = 0; i < n; i++) out[i] = a[i] / 32768.0f; }
+
+// ///////////////////////////////////////// FIR (coefficients in time-reversed order, as in CMSIS)
+
+typedef struct { uint16_t numTaps; float32_t *pState; const float32_t *pCoeffs; } arm_fir_instance_f32;
+static inline void arm_fir_init_f32(arm_fir_instance_f32 *S, uint16_t numTaps, const float32_t *pCoeffs, float32_t *pState, uint32_t blockSize) {
+	S->numTaps = numTaps; S->pCoeffs = pCoeffs; S->pState = pState;
+	memset(pState, 0, (numTaps + blockSize - 1) * sizeof(float32_t));
+}
+static inline void arm_fir_f32(const arm_fir_instance_f32 *S, const float32_t *in, float32_t *out, uint32_t n) {
+	const int N = S->numTaps;
+	float32_t *st = S->pState;
+	memcpy(st + N - 1, in, n * sizeof(float32_t));
+	for (uint32_t i = 0; i < n; i++) {
+		float32_t acc = 0.0f;
+		for (int k = 0; k < N; k++) acc += S->pCoeffs[k] * st[i + k];
+		out[i] = acc;
+	}
+	memmove(st, st + n, (N - 1) * sizeof(float32_t));
+}
+
+typedef struct { uint8_t M; uint16_t numTaps; const float32_t *pCoeffs; float32_t *pState; } arm_fir_decimate_instance_f32;
+static inline arm_status arm_fir_decimate_init_f32(arm_fir_decimate_instance_f32 *S, uint16_t numTaps, uint8_t M, const float32_t *pCoeffs, float32_t *pState, uint32_t blockSize) {
+	if ((M == 0) || (blockSize % M)) return ARM_MATH_LENGTH_ERROR;
+	S->M = M; S->numTaps = numTaps; S->pCoeffs = pCoeffs; S->pState = pState;
+	memset(pState, 0, (numTaps + blockSize - 1) * sizeof(float32_t));
+	return ARM_MATH_SUCCESS;
+}
+static inline void arm_fir_decimate_f32(const arm_fir_decimate_instance_f32 *S, const float32_t *in, float32_t *out, uint32_t n) {
+	const int N = S->numTaps;
+	float32_t *st = S->pState;
+	memcpy(st + N - 1, in, n * sizeof(float32_t));
+	for (uint32_t o = 0; o < n / S->M; o++) {
+		float32_t acc = 0.0f;
+		const float32_t *x = st + o * S->M;
+		for (int k = 0; k < N; k++) acc += S->pCoeffs[k] * x[k];
+		out[o] = acc;
+	}
+	memmove(st, st + n, (N - 1) * sizeof(float32_t));
+}
+
+typedef struct { uint8_t L; uint16_t phaseLength; const float32_t *pCoeffs; float32_t *pState; } arm_fir_interpolate_instance_f32;
+static inline arm_status arm_fir_interpolate_init_f32(arm_fir_interpolate_instance_f32 *S, uint8_t L, uint16_t numTaps, const float32_t *pCoeffs, float32_t *pState, uint32_t blockSize) {
+	if ((L == 0) || (numTaps % L)) return ARM_MATH_LENGTH_ERROR;
+	S->L = L; S->phaseLength = numTaps / L; S->pCoeffs = pCoeffs; S->pState = pState;
+	memset(pState, 0, (S->phaseLength + blockSize - 1) * sizeof(float32_t));
+	return ARM_MATH_SUCCESS;
+}
+static inline void arm_fir_interpolate_f32(const arm_fir_interpolate_instance_f32 *S, const float32_t *in, float32_t *out, uint32_t n) {
+	const int P = S->phaseLength, L = S->L;
+	float32_t *st = S->pState;
+	memcpy(st + P - 1, in, n * sizeof(float32_t));
+	for (uint32_t i = 0; i < n; i++) {
+		for (int j = 1; j <= L; j++) {
+			float32_t acc = 0.0f;
+			for (int p = 0; p < P; p++) acc += st[i + p] * S->pCoeffs[(L - j) + p * L];
+			out[i * L + (j - 1)] = acc;
+		}
+	}
+	memmove(st, st + n, (P - 1) * sizeof(float32_t));
+}
+
+// ///////////////////////////////////////// biquads (Direct Form I, {b0, b1, b2, a1, a2} with CMSIS's sign on a1, a2)
+
+typedef struct { uint32_t numStages; float32_t *pState; const float32_t *pCoeffs; } arm_biquad_casd_df1_inst_f32;
+static inline void arm_biquad_cascade_df1_init_f32(arm_biquad_casd_df1_inst_f32 *S, uint8_t numStages, const float32_t *pCoeffs, float32_t *pState) {
+	S->numStages = numStages; S->pCoeffs = pCoeffs; S->pState = pState;
+	memset(pState, 0, 4 * numStages * sizeof(float32_t));
+}
+static inline void arm_biquad_cascade_df1_f32(const arm_biquad_casd_df1_inst_f32 *S, const float32_t *in, float32_t *out, uint32_t n) {
+	const float32_t *src = in;
+	for (uint32_t s = 0; s < S->numStages; s++) {
+		const float32_t *c = S->pCoeffs + 5 * s;
+		float32_t *st = S->pState + 4 * s;
+		float32_t x1 = st[0], x2 = st[1], y1 = st[2], y2 = st[3];
+		for (uint32_t i = 0; i < n; i++) {
+			const float32_t x0 = src[i];
+			const float32_t y0 = c[0]*x0 + c[1]*x1 + c[2]*x2 + c[3]*y1 + c[4]*y2;
+			x2 = x1; x1 = x0; y2 = y1; y1 = y0;
+			out[i] = y0;
+		}
+		st[0] = x1; st[1] = x2; st[2] = y1; st[3] = y2;
+		src = out;
+	}
+}
+
+// ///////////////////////////////////////// complex FFT (interleaved, in place; the inverse is scaled by 1/N)
+
+typedef struct { uint16_t fftLen; uint8_t ifftFlag; uint8_t bitReverseFlag; } arm_cfft_radix4_instance_f32;
+typedef arm_cfft_radix4_instance_f32 arm_cfft_radix2_instance_f32;
+
+static inline void host_shim_cfft_f32(float32_t *x, const int N, const bool inverse, const bool bit_reverse) {
+	//iterative radix-2, decimation in time
+	if (bit_reverse) {
+		for (int i = 1, j = 0; i < N; i++) {
+			int bit = N >> 1;
+			for ( ; j & bit; bit >>= 1) j ^= bit;
+			j ^= bit;
+			if (i < j) { float32_t t = x[2*i]; x[2*i] = x[2*j]; x[2*j] = t; t = x[2*i+1]; x[2*i+1] = x[2*j+1]; x[2*j+1] = t; }
+		}
+	}
+	const double sign = inverse ? 1.0 : -1.0;
+	for (int len = 2; len <= N; len <<= 1) {
+		const double ang = sign * 2.0 * M_PI / len;
+		const float32_t wr = (float32_t)cos(ang), wi = (float32_t)sin(ang);
+		for (int i = 0; i < N; i += len) {
+			float32_t cr = 1.0f, ci = 0.0f;
+			for (int k = 0; k < len / 2; k++) {
+				float32_t *a = &x[2*(i + k)], *b = &x[2*(i + k + len/2)];
+				const float32_t tr = b[0]*cr - b[1]*ci, ti = b[0]*ci + b[1]*cr;
+				b[0] = a[0] - tr;  b[1] = a[1] - ti;
+				a[0] += tr;        a[1] += ti;
+				const float32_t cr_new = cr*wr - ci*wi;
+				ci = cr*wi + ci*wr;  cr = cr_new;
+			}
+		}
+	}
+	if (inverse) { const float32_t s = 1.0f / N; for (int i = 0; i < 2*N; i++) x[i] *= s; }
+}
+static inline arm_status arm_cfft_radix4_init_f32(arm_cfft_radix4_instance_f32 *S, uint16_t fftLen, uint8_t ifftFlag, uint8_t bitReverseFlag) {
+	S->fftLen = fftLen; S->ifftFlag = ifftFlag; S->bitReverseFlag = bitReverseFlag;
+	return ((fftLen == 16) || (fftLen == 64) || (fftLen == 256) || (fftLen == 1024) || (fftLen == 4096)) ? ARM_MATH_SUCCESS : ARM_MATH_ARGUMENT_ERROR;
+}
+static inline arm_status arm_cfft_radix2_init_f32(arm_cfft_radix2_instance_f32 *S, uint16_t fftLen, uint8_t ifftFlag, uint8_t bitReverseFlag) {
+	S->fftLen = fftLen; S->ifftFlag = ifftFlag; S->bitReverseFlag = bitReverseFlag;
+	return ((fftLen >= 16) && !(fftLen & (fftLen - 1))) ? ARM_MATH_SUCCESS : ARM_MATH_ARGUMENT_ERROR;
+}
+static inline void arm_cfft_radix4_f32(const arm_cfft_radix4_instance_f32 *S, float32_t *p) { host_shim_cfft_f32(p, S->fftLen, S->ifftFlag, S->bitReverseFlag); }
+static inline void arm_cfft_radix2_f32(const arm_cfft_radix2_instance_f32 *S, float32_t *p) { host_shim_cfft_f32(p, S->fftLen, S->ifftFlag, S->bitReverseFlag); }
+
+#endif
@@ -0,0 +1,34 @@
+/*
+ * shim.cpp (host shim)
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: The few definitions behind the host shim's Arduino.h and AudioStream.h.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdarg.h>
+#include <chrono>
+#include <thread>
+#include "Arduino.h"
+#include "AudioStream.h"
+
+HostSerial Serial;
+uint16_t AudioStream::cpu_cycles_total = 0;
+uint16_t AudioStream::cpu_cycles_total_max = 0;
+
+static const std::chrono::steady_clock::time_point host_start = std::chrono::steady_clock::now();
+static unsigned long long host_extra_usec = 0;
+unsigned long micros(void) { return (unsigned long)(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - host_start).count() + host_extra_usec); }
+unsigned long millis(void) { return (unsigned long)((std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - host_start).count() + host_extra_usec) / 1000); }
+void hostAdvanceMicros(unsigned long usec) { host_extra_usec += usec; }
+void delay(unsigned long msec) { std::this_thread::sleep_for(std::chrono::milliseconds(msec)); }
+
+size_t Print::printf(const char *fmt, ...) {
+	va_list args;
+	va_start(args, fmt);
+	int n = vfprintf(stderr, fmt, args);
+	va_end(args);
+	return (n > 0) ? n : 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * weighting_check
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Desktop check of the A- and C-weighting filters that FreqWeightingDesign makes at run time
+ *    (utility/freq_weighting.h), against the class 1 acceptance limits of IEC 61672-1:2013 (Table 3),
+ *    at many sample rates.  For each type, sample rate, and design (with and without the correction
+ *    of the top section), it finds the response of the float coefficients at every nominal third-
+ *    octave frequency from 10 Hz to 20 kHz that is below 0.45*fs, and compares it with the standard's
+ *    weighting.  Prints one CSV line per case:
+ *        type,fs_Hz,hf_correction,top_band_Hz,max_err_dB,worst_band_Hz,class1_pass
+ *    then, for the sample rate given (default 48000), the whole table:
+ *        type,band_Hz,goal_dB,response_dB,err_dB,lower_limit_dB,upper_limit_dB
+ *    Bands above 0.45*fs can't be checked (or met), so a sample rate below 44.1 kHz only covers the
+ *    standard's range as far as it goes.  Exits with the number of corrected designs that failed.
+ *
+ *    It also runs a 1 kHz sine and a sine at the top band through LevelMeterBank (float, Direct
+ *    Form I, as on the Tympan) to make sure that the filters really do what their coefficients say.
+ *
+ *    Build and run from the top of the library:
+ *        g++ -O2 -std=c++11 -Isrc/utility extras/host/weighting_check.cpp src/utility/freq_weighting.cpp \
+ *            src/utility/level_meter_bank.cpp -o weighting_check
+ *        ./weighting_check              (the summary, and the table at 48 kHz)
+ *        ./weighting_check 24000        (the summary, and the table at 24 kHz)
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "freq_weighting.h"
+#include "level_meter_bank.h"
+
+#define N_BANDS 34
+#define NO_LIMIT 99.0
+
+//IEC 61672-1:2013, Table 3: the nominal frequencies and the class 1 acceptance limits (dB)
+static const double band_Hz[N_BANDS] = { 10, 12.5, 16, 20, 25, 31.5, 40, 50, 63, 80, 100, 125, 160, 200, 250, 315, 400,
+	500, 630, 800, 1000, 1250, 1600, 2000, 2500, 3150, 4000, 5000, 6300, 8000, 10000, 12500, 16000, 20000 };
+static const double upper_dB[N_BANDS] = { 3.5, 3.0, 2.5, 2.5, 2.0, 1.5, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
+	1.0, 1.0, 1.0, 0.7, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.5, 1.5, 1.5, 2.0, 2.0, 2.5, 3.0 };
+static const double lower_dB[N_BANDS] = { NO_LIMIT, NO_LIMIT, 4.5, 2.5, 2.0, 1.5, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
+	1.0, 1.0, 1.0, 0.7, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.5, 2.0, 2.5, 3.0, 5.0, 16.0, NO_LIMIT };
+
+//the exact (base-ten) frequency of a band, which is what the standard's weightings are given at
+static double exactFreq_Hz(const int i) { return 1000.0 * pow(10.0, 0.1 * (i - 20)); }
+static const char *typeName(const int type) { return (type == A_WEIGHT) ? "A" : "C"; }
+
+struct CheckResult {
+	int top_band = -1, worst_band = -1;
+	double max_err_dB = 0.0;
+	bool pass = true;
+};
+
+static CheckResult check(const int type, const float fs_Hz, const bool hf_correction, const bool print_table) {
+	CheckResult r;
+	float sos[6 * FREQ_WEIGHTING_MAX_SOS];
+	const int n_sos = FreqWeightingDesign::design(type, fs_Hz, sos, hf_correction);
+	for (int i = 0; i < N_BANDS; i++) {
+		const double f = exactFreq_Hz(i);
+		if (f > 0.45 * fs_Hz) break;
+		const double goal = FreqWeightingDesign::goal_dB(type, f);
+		const double resp = FreqWeightingDesign::response_dB(sos, n_sos, f, fs_Hz);
+		const double err = resp - goal;
+		r.top_band = i;
+		if (fabs(err) > fabs(r.max_err_dB)) { r.max_err_dB = err; r.worst_band = i; }
+		if ((err > upper_dB[i]) || (-err > lower_dB[i])) r.pass = false;
+		if (print_table) {
+			printf("%s,%g,%.3f,%.3f,%.3f,", typeName(type), band_Hz[i], goal, resp, err);
+			if (lower_dB[i] < NO_LIMIT) printf("%.1f,", -lower_dB[i]); else printf("-inf,");
+			printf("%.1f\n", upper_dB[i]);
+		}
+	}
+	return r;
+}
+
+//the level of a sine, in dB re: its unweighted level, through LevelMeterBank with the designed filter
+static double measure_dB(const int type, const float fs_Hz, const double f_Hz) {
+	float sos[6 * FREQ_WEIGHTING_MAX_SOS];
+	const int n_sos = FreqWeightingDesign::design(type, fs_Hz, sos);
+	LevelMeterBank bank;
+	bank.setup(fs_Hz, 1);
+	bank.setFreqWeighting(sos, n_sos);
+	bank.setTimeConst_sec(1.0f);
+	const int n = (int)(20.0f * fs_Hz);     //long enough for the time weighting to settle, and to smooth the ripple to well under 0.01 dB
+	std::vector<float> x(n);
+	for (int i = 0; i < n; i++) x[i] = (float)sin(2.0 * M_PI * f_Hz * i / fs_Hz);
+	const float *xp[1] = { x.data() };
+	bank.process(xp, NULL, n);
+	return 10.0 * log10(bank.getMeanSquare(0) / 0.5);
+}
+
+int main(int argc, char **argv) {
+	const float table_fs_Hz = (argc > 1) ? (float)atof(argv[1]) : 48000.0f;
+	static const float all_fs_Hz[] = { 16000.0f, 22050.0f, 24000.0f, 32000.0f, 44100.0f, 44117.647f, 48000.0f, 88200.0f, 96000.0f };
+	static const int types[] = { A_WEIGHT, C_WEIGHT };
+	int n_fail = 0;
+
+	printf("type,fs_Hz,hf_correction,top_band_Hz,max_err_dB,worst_band_Hz,class1_pass\n");
+	for (int t = 0; t < 2; t++) {
+		for (const float fs_Hz : all_fs_Hz) {
+			for (int corr = 1; corr >= 0; corr--) {
+				CheckResult r = check(types[t], fs_Hz, corr == 1, false);
+				printf("%s,%g,%d,%g,%.3f,%g,%s\n", typeName(types[t]), fs_Hz, corr, band_Hz[r.top_band], r.max_err_dB,
+					(r.worst_band >= 0) ? band_Hz[r.worst_band] : 0.0, r.pass ? "yes" : "NO");
+				if (corr && !r.pass) n_fail++;
+			}
+		}
+	}
+
+	printf("\ntype,band_Hz,goal_dB,response_dB,err_dB,lower_limit_dB,upper_limit_dB   (fs = %g Hz, corrected)\n", table_fs_Hz);
+	for (int t = 0; t < 2; t++) check(types[t], table_fs_Hz, true, true);
+
+	printf("\nmeasured through LevelMeterBank (fs = %g Hz):\n", table_fs_Hz);
+	for (int t = 0; t < 2; t++) {
+		const CheckResult r = check(types[t], table_fs_Hz, true, false);
+		const double f_hi = exactFreq_Hz(r.top_band);
+		printf("  %s: 1 kHz: %.3f dB (goal 0.000);  %.0f Hz: %.3f dB (goal %.3f)\n", typeName(types[t]),
+			measure_dB(types[t], table_fs_Hz, 1000.0), f_hi, measure_dB(types[t], table_fs_Hz, f_hi),
+			FreqWeightingDesign::goal_dB(types[t], f_hi));
+	}
+	return n_fail;
+}
@@ -104,6 +104,7 @@ class AudioCalcEnvelope_F32 : public AudioStream_F32
 		//change params that follow sample rate
 		
 		sample_rate_Hz = fs_Hz;
+		setAttackRelease_msec(given_attack_msec, given_release_msec);  //the time constants are in samples
 	}
 	
 	void resetStates(void) { state_ppk = 1.0; }
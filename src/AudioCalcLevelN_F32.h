@@ -0,0 +1,158 @@
+/*
+ * AudioCalcLevelN_F32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Sound levels for any number of channels (such as all 8 or 16 microphones of an array),
+ *     as a template:  AudioCalcLevelN_F32<8> levels8;  Each channel gets the frequency weighting
+ *     (A_WEIGHT, C_WEIGHT, or Z_WEIGHT) and the time weighting (FAST, SLOW, or IMPULSE) of a sound
+ *     level meter, which used to take an AudioFilterFreqWeighting_F32 and an AudioCalcLevel_F32 per
+ *     channel (as in the SoundLevelMeter_2Chan example).  Here, all channels are run together by
+ *     LevelMeterBank (see utility/level_meter_bank.h), with shared coefficients and the channels'
+ *     states side by side, so that one more channel costs only a few multiply-adds per sample.
+ *
+ *     The present level and the largest level since resetMax() are read from the loop(), any time,
+ *     without stopping the audio.  The dB values are re: full scale, plus each channel's calibration
+ *     (setCalibration_dB(), such as the cal_factor_dB of the SoundLevelMeter example, to get dB SPL).
+ *     To get every channel from the same update, use getLevels_dB().
+ *
+ *     Like AudioCalcLevel_F32, each output can carry its channel's time-weighted mean square, sample by
+ *     sample, but only after enableOutputs(true).  They are off by default, so that metering N
+ *     channels doesn't take N audio blocks.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _AudioCalcLevelN_F32_h
+#define _AudioCalcLevelN_F32_h
+
+#include "Arduino.h"
+#include "AudioStream_F32.h"
+#include "arm_math.h"
+#include "utility/FreqWeighting_IEC1672.h"
+#include "utility/level_meter_bank.h"
+
+template <int N>
+class AudioCalcLevelN_F32 : public AudioStream_F32
+{
+//GUI: inputs:N, outputs:N  //this line used for automatic generation of GUI node
+//GUI: shortName:calcLevelN
+	static_assert((N >= 1) && (N <= LEVEL_METER_BANK_MAX_CHAN), "AudioCalcLevelN_F32: N must be from 1 to LEVEL_METER_BANK_MAX_CHAN");
+	public:
+		AudioCalcLevelN_F32(void) : AudioStream_F32(N, inputQueueArray) { setup(AUDIO_SAMPLE_RATE_EXACT); }
+		AudioCalcLevelN_F32(const AudioSettings_F32 &settings) : AudioStream_F32(N, inputQueueArray) { setup(settings.sample_rate_Hz); }
+
+		void setWeightingType(const int type) { weighting_type = type; setup(sample_rate_Hz); }   //A_WEIGHT, C_WEIGHT, or Z_WEIGHT
+		int getWeightingType(void) { return weighting_type; }
+		void setTimeWeighting(const LevelMeterBank::TimeWeighting type) { __disable_irq(); bank.setTimeWeighting(type); __enable_irq(); }  //FAST, SLOW, or IMPULSE
+		LevelMeterBank::TimeWeighting getTimeWeighting(void) { return bank.getTimeWeighting(); }
+		void setTimeConst_sec(const float tau_sec) { __disable_irq(); bank.setTimeConst_sec(tau_sec); __enable_irq(); }  //any other
+		float getTimeConst_sec(void) { return bank.getTimeConst_sec(); }
+		void setSampleRate_Hz(const float fs_Hz) { setup(fs_Hz); }
+		void setCalibration_dB(const float cal_dB) { for (int c = 0; c < N; c++) calibration_dB[c] = cal_dB; }
+		void setCalibration_dB(const int c, const float cal_dB) { if (validChan(c)) calibration_dB[c] = cal_dB; }
+		float getCalibration_dB(const int c) { return validChan(c) ? calibration_dB[c] : 0.0f; }
+		void enableOutputs(const bool enable) { outputs_enabled = enable; }
+
+		//Results, from the loop()
+		float getCurrentLevel(const int c) { return validChan(c) ? pub_cur[c] : 0.0f; }     //linear mean square, as AudioCalcLevel_F32
+		float getCurrentLevel_dB(const int c) { return validChan(c) ? to_dB(pub_cur[c], c) : to_dB(0.0f, 0); }
+		float getMaxLevel_dB(const int c) { return validChan(c) ? to_dB(pub_max[c], c) : to_dB(0.0f, 0); }  //since resetMax()
+		int getLevels_dB(float *cur_dB, float *max_dB, const int n);   //all channels from one update.  Either can be NULL.  Returns the number of channels.
+		uint32_t getUpdateCount(void) { return pub_count; }            //changes every time new results are in
+		void resetMax(void) { reset_request++; }                       //at the next update
+
+		virtual void update(void);
+
+	protected:
+		audio_block_f32_t *inputQueueArray[N];
+		LevelMeterBank bank;
+		float sample_rate_Hz = AUDIO_SAMPLE_RATE_EXACT;
+		int weighting_type = A_WEIGHT;
+		float calibration_dB[N] = {};
+		bool outputs_enabled = false;
+
+		//the results, written only by update()
+		volatile float pub_cur[N], pub_max[N];
+		volatile uint32_t pub_count = 0;
+		volatile uint32_t reset_request = 0, reset_ack = 0;
+
+		void setup(const float fs_Hz) { __disable_irq(); configure(fs_Hz); __enable_irq(); }
+		void configure(const float fs_Hz);
+		bool validChan(const int c) { return (c >= 0) && (c < N); }
+		float to_dB(const float ms, const int c) { return 10.0f * log10f(ms + 1.0e-20f) + calibration_dB[c]; }
+};
+
+//the weighting filters for this sample rate, and everything cleared.  The audio must not be running (or this is the audio).
+template <int N>
+void AudioCalcLevelN_F32<N>::configure(const float fs_Hz) {
+	if (fs_Hz > 0.0f) sample_rate_Hz = fs_Hz;
+	bank.setup(sample_rate_Hz, N);
+	if (weighting_type == Z_WEIGHT) {
+		bank.setFreqWeighting(NULL, 0);
+	} else {
+		FreqWeighting_IEC1672 IEC_coefficients;
+		bank.setFreqWeighting(IEC_coefficients.get_filter_matlab_sos(weighting_type, sample_rate_Hz),
+			IEC_coefficients.get_N_sos_per_filter(weighting_type));
+	}
+	for (int c = 0; c < N; c++) { pub_cur[c] = 0.0f; pub_max[c] = 0.0f; }
+	pub_count += 2;   //new results (and still even)
+}
+
+template <int N>
+void AudioCalcLevelN_F32<N>::update(void) {
+	audio_block_f32_t *in[N], *out[N];
+	const float *x[N];
+	float *y[N];
+	audio_block_f32_t *first = NULL;
+	int n = 0;
+	for (int c = 0; c < N; c++) {
+		in[c] = receiveReadOnly_f32(c);
+		x[c] = in[c] ? in[c]->data : NULL;   //a missing input is silence
+		if (in[c] && (!first || (in[c]->length < n))) { if (!first) first = in[c]; n = in[c]->length; }
+	}
+	if (!first) return;  //there was no data available.  so exit.
+
+	//follow the sample rate of the audio, if it isn't what we were set up for
+	if ((first->fs_Hz > 0.0f) && (first->fs_Hz != sample_rate_Hz)) configure(first->fs_Hz);
+
+	uint32_t request = reset_request;
+	if (request != reset_ack) { bank.reset(); reset_ack = request; }
+
+	for (int c = 0; c < N; c++) {
+		out[c] = outputs_enabled ? allocate_f32() : NULL;
+		y[c] = NULL;
+		if (out[c]) { out[c]->length = n; out[c]->fs_Hz = first->fs_Hz; out[c]->id = first->id; y[c] = out[c]->data; }
+	}
+	bank.process(x, y, n);
+
+	//publish.  pub_count is odd while the results are being changed.
+	pub_count++;
+	for (int c = 0; c < N; c++) { pub_cur[c] = bank.getMeanSquare(c); pub_max[c] = bank.getMaxMeanSquare(c); }
+	pub_count++;
+
+	for (int c = 0; c < N; c++) {
+		if (in[c]) AudioStream_F32::release(in[c]);
+		if (out[c]) { AudioStream_F32::transmit(out[c], c); AudioStream_F32::release(out[c]); }
+	}
+}
+
+template <int N>
+int AudioCalcLevelN_F32<N>::getLevels_dB(float *cur_dB, float *max_dB, const int n_max) {
+	const int n = (n_max < N) ? n_max : N;
+	uint32_t count;
+	do {   //if an update came in while copying (or was under way), copy again
+		count = pub_count;
+		for (int c = 0; c < n; c++) {
+			if (cur_dB) cur_dB[c] = pub_cur[c];
+			if (max_dB) max_dB[c] = pub_max[c];
+		}
+	} while ((count & 1) || (count != pub_count));
+	for (int c = 0; c < n; c++) {
+		if (cur_dB) cur_dB[c] = to_dB(cur_dB[c], c);
+		if (max_dB) max_dB[c] = to_dB(max_dB[c], c);
+	}
+	return n;
+}
+
+#endif
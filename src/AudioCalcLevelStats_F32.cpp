@@ -0,0 +1,75 @@
+/*
+ * AudioCalcLevelStats_F32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include "AudioCalcLevelStats_F32.h"
+
+void AudioCalcLevelStats_F32::update(void) {
+	audio_block_f32_t *block = AudioStream_F32::receiveReadOnly_f32(0);
+	audio_block_f32_t *peak_block = AudioStream_F32::receiveReadOnly_f32(1);
+	if (!block) {
+		if (peak_block) AudioStream_F32::release(peak_block);
+		return;
+	}
+	if ((peak_block) && (peak_block->length != block->length)) {
+		AudioStream_F32::release(peak_block);
+		peak_block = NULL;
+	}
+
+	uint32_t request = reset_request;
+	if (request != reset_ack) { stats.reset(); reset_ack = request; }
+
+	const uint32_t n_intervals = stats.getNumIntervals();
+	stats.process(block->data, (peak_block) ? peak_block->data : NULL, block->length);
+	AudioStream_F32::release(block);
+	if (peak_block) AudioStream_F32::release(peak_block);
+
+	publish(stats.getNumIntervals() != n_intervals);
+}
+
+//copy the results to where the loop() reads them.  The dB are only taken here, once per block.
+void AudioCalcLevelStats_F32::publish(const bool new_interval) {
+	LevelStatsResult run, interval;
+	stats.getRun(&run);
+	if (new_interval) stats.getLastInterval(&interval);
+
+	pub_count++;
+	pub_run.leq_dB = run.leq_dB;  pub_run.lmax_dB = run.lmax_dB;  pub_run.lpeak_dB = run.lpeak_dB;
+	pub_run.L10_dB = run.L10_dB;  pub_run.L50_dB = run.L50_dB;  pub_run.L90_dB = run.L90_dB;
+	pub_run.duration_sec = run.duration_sec;  pub_run.index = 0;
+	if (new_interval) {
+		pub_interval.leq_dB = interval.leq_dB;  pub_interval.lmax_dB = interval.lmax_dB;  pub_interval.lpeak_dB = interval.lpeak_dB;
+		pub_interval.L10_dB = interval.L10_dB;  pub_interval.L50_dB = interval.L50_dB;  pub_interval.L90_dB = interval.L90_dB;
+		pub_interval.duration_sec = interval.duration_sec;  pub_interval.index = interval.index;
+	}
+	pub_current_dB = stats.getCurrentLevel_dB();
+	pub_count++;
+}
+
+void AudioCalcLevelStats_F32::copyResult(volatile LevelStatsResult &from, LevelStatsResult *to) {
+	uint32_t count;
+	do {   //if an update came in while copying (or was under way), copy again
+		count = pub_count;
+		to->leq_dB = from.leq_dB;  to->lmax_dB = from.lmax_dB;  to->lpeak_dB = from.lpeak_dB;
+		to->L10_dB = from.L10_dB;  to->L50_dB = from.L50_dB;  to->L90_dB = from.L90_dB;
+		to->duration_sec = from.duration_sec;  to->index = from.index;
+	} while ((count & 1) || (count != pub_count));
+	to->leq_dB = calibrate(to->leq_dB);  to->lmax_dB = calibrate(to->lmax_dB);  to->lpeak_dB = calibrate(to->lpeak_dB);
+	to->L10_dB = calibrate(to->L10_dB);  to->L50_dB = calibrate(to->L50_dB);  to->L90_dB = calibrate(to->L90_dB);
+}
+
+void AudioCalcLevelStats_F32::printResult(Print *p, const LevelStatsResult &r) {
+	if (!p) return;
+	if (r.index > 0) { p->print("Interval "); p->print(r.index); } else { p->print("Run"); }
+	p->print(" ("); p->print(r.duration_sec, 1); p->print(" sec): Leq = "); p->print(r.leq_dB, 1);
+	p->print(", Lmax = "); p->print(r.lmax_dB, 1);
+	p->print(", Lpeak = "); p->print(r.lpeak_dB, 1);
+	p->print(", L10 = "); p->print(r.L10_dB, 1);
+	p->print(", L50 = "); p->print(r.L50_dB, 1);
+	p->print(", L90 = "); p->print(r.L90_dB, 1);
+	p->println(" dB");
+}
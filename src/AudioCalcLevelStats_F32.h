@@ -0,0 +1,72 @@
+/*
+ * AudioCalcLevelStats_F32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: An integrating sound level meter, for reporting over hours.  Keeps the Leq, Lmax, Lpeak
+ *     (true peak), and the L10, L50, and L90 percentiles, for the whole run and for each interval
+ *     (such as every minute, set by setInterval_sec()).  See utility/level_stats.h for how.
+ *
+ *     Input 0 is the signal for the levels (put AudioFilterFreqWeighting_F32 in front for dBA).  Input
+ *     1, if connected, is the signal for the peak (such as C-weighted or unweighted); otherwise the
+ *     peak is taken from input 0.  Both must come from the same update.
+ *
+ *     The results are read from the loop() any time, without stopping the audio.  After each update,
+ *     the audio side writes a new copy of the run's results (and, when an interval ends, of that
+ *     interval's), which getRun() and getLastInterval() read, trying again if an update came in
+ *     while reading.  The dB values are re: full scale plus whatever was given to setCalibration_dB()
+ *     (such as the cal_factor_dB of the SoundLevelMeter example, to get dB SPL).
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _AudioCalcLevelStats_F32_h
+#define _AudioCalcLevelStats_F32_h
+
+#include "Arduino.h"
+#include "AudioStream_F32.h"
+#include "utility/level_stats.h"
+
+class AudioCalcLevelStats_F32 : public AudioStream_F32
+{
+//GUI: inputs:2, outputs:0  //this line used for automatic generation of GUI node
+//GUI: shortName:levelStats
+	public:
+		AudioCalcLevelStats_F32(void) : AudioStream_F32(2, inputQueueArray) { setSampleRate_Hz(AUDIO_SAMPLE_RATE_EXACT); }
+		AudioCalcLevelStats_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray) { setSampleRate_Hz(settings.sample_rate_Hz); }
+
+		void setSampleRate_Hz(const float fs_Hz) { __disable_irq(); stats.setSampleRate_Hz(fs_Hz); publish(true); __enable_irq(); }
+		void setTimeConst_sec(const float tau_sec) { __disable_irq(); stats.setTimeConst_sec(tau_sec); __enable_irq(); }  //TIME_CONST_FAST or TIME_CONST_SLOW
+		float getTimeConst_sec(void) { return stats.getTimeConst_sec(); }
+		void setInterval_sec(const float sec) { __disable_irq(); stats.setInterval_sec(sec); __enable_irq(); }   //0 for none.  Starts a new interval.
+		float getInterval_sec(void) { return stats.getInterval_sec(); }
+		void setCalibration_dB(const float cal_dB) { calibration_dB = cal_dB; }
+		float getCalibration_dB(void) { return calibration_dB; }
+
+		//Results, from the loop()
+		void getRun(LevelStatsResult *r) { copyResult(pub_run, r); }
+		bool getLastInterval(LevelStatsResult *r) { copyResult(pub_interval, r); return r->index > 0; }
+		uint32_t getNumIntervals(void) { return pub_interval.index; }    //watch this to know when a new interval is in
+		float getCurrentLevel_dB(void) { return calibrate(pub_current_dB); }     //time weighted
+		void resetStats(void) { reset_request++; }   //start the run over, at the next update
+		void printResult(Print *p, const LevelStatsResult &r);
+
+		virtual void update(void);
+
+	protected:
+		audio_block_f32_t *inputQueueArray[2];
+		LevelStats stats;
+		float calibration_dB = 0.0f;
+
+		//the results, written only by update().  pub_count is odd while they are being changed.
+		volatile LevelStatsResult pub_run, pub_interval;
+		volatile float pub_current_dB = LEVEL_STATS_NO_LEVEL;
+		volatile uint32_t pub_count = 0;
+		volatile uint32_t reset_request = 0, reset_ack = 0;
+
+		void publish(const bool new_interval);
+		void copyResult(volatile LevelStatsResult &from, LevelStatsResult *to);
+		float calibrate(const float dB) { return (dB <= LEVEL_STATS_NO_LEVEL) ? dB : (dB + calibration_dB); }
+};
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * AudioCalcOctaveBands_F32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include "AudioCalcOctaveBands_F32.h"
+
+bool AudioCalcOctaveBands_F32::setup(const float fs_Hz) {
+	__disable_irq();
+	bool ok = configure(fs_Hz);
+	__enable_irq();
+	if (!ok) {
+		Serial.print("AudioCalcOctaveBands_F32: *** WARNING ***: No bands from "); Serial.print(freq_lo_Hz);
+		Serial.print(" to "); Serial.print(freq_hi_Hz); Serial.print(" Hz at fs = "); Serial.println(sample_rate_Hz);
+	}
+	return ok;
+}
+
+//design the bands and clear the results.  The audio must not be running (or this is the audio).
+bool AudioCalcOctaveBands_F32::configure(const float fs_Hz) {
+	if (fs_Hz > 0.0f) sample_rate_Hz = fs_Hz;
+	bool ok = bank.setup(sample_rate_Hz, bands_per_octave, freq_lo_Hz, freq_hi_Hz);
+	for (int i = 0; i < OCTAVE_BANK_MAX_BANDS; i++) { pub_leq[i] = 0.0f; pub_max[i] = 0.0f; pub_cur[i] = 0.0f; }
+	pub_duration_sec = 0.0f;
+	pub_count += 2;   //new results (and still even)
+	return ok;
+}
+
+void AudioCalcOctaveBands_F32::update(void) {
+	audio_block_f32_t *block = AudioStream_F32::receiveReadOnly_f32();
+	if (!block) return;
+
+	//follow the sample rate of the audio, if it isn't what we were set up for
+	if ((block->fs_Hz > 0.0f) && (block->fs_Hz != sample_rate_Hz)) configure(block->fs_Hz);
+
+	uint32_t request = reset_request;
+	if (request != reset_ack) { bank.reset(); reset_ack = request; }
+
+	bank.process(block->data, block->length);
+	AudioStream_F32::release(block);
+
+	//publish.  pub_count is odd while the results are being changed.
+	pub_count++;
+	const int n = bank.getNumBands();
+	for (int i = 0; i < n; i++) {
+		pub_leq[i] = bank.getMeanSquare(i);
+		pub_max[i] = bank.getMaxMeanSquare(i);
+		pub_cur[i] = bank.getCurrentMeanSquare(i);
+	}
+	pub_duration_sec = bank.getDuration_sec();
+	pub_count++;
+}
+
+int AudioCalcOctaveBands_F32::getLevels_dB(float *leq_dB, float *lmax_dB, const int n_max) {
+	const int n = min(n_max, bank.getNumBands());
+	uint32_t count;
+	do {   //if an update came in while copying (or was under way), copy again
+		count = pub_count;
+		for (int i = 0; i < n; i++) {
+			if (leq_dB) leq_dB[i] = pub_leq[i];
+			if (lmax_dB) lmax_dB[i] = pub_max[i];
+		}
+	} while ((count & 1) || (count != pub_count));
+	for (int i = 0; i < n; i++) {
+		if (leq_dB) leq_dB[i] = to_dB(leq_dB[i]);
+		if (lmax_dB) lmax_dB[i] = to_dB(lmax_dB[i]);
+	}
+	return n;
+}
+
+void AudioCalcOctaveBands_F32::printLevels(Print *p) {
+	if (!p) return;
+	float leq[OCTAVE_BANK_MAX_BANDS], lmax[OCTAVE_BANK_MAX_BANDS];
+	const int n = getLevels_dB(leq, lmax, OCTAVE_BANK_MAX_BANDS);
+	p->print("AudioCalcOctaveBands_F32: "); p->print(getDuration_sec()); p->println(" sec.  Band (Hz), Leq (dB), Lmax (dB):");
+	for (int i = 0; i < n; i++) {
+		p->print("  "); p->print(getBandFreq_Hz(i), 1);
+		p->print(", "); p->print(leq[i], 1);
+		p->print(", "); p->println(lmax[i], 1);
+	}
+}
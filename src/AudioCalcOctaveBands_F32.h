@@ -0,0 +1,90 @@
+/*
+ * AudioCalcOctaveBands_F32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Octave or third-octave band levels (IEC 61260), for sound level meters and noise surveys,
+ *     where one broadband (A-weighted) level doesn't say enough.  For every band, it keeps the Leq
+ *     (the average level since the last resetStats()), the Lmax (the largest time-weighted level
+ *     since then), and the present time-weighted level.  Time weighting is FAST (0.125 s) by default.
+ *
+ *     The bands are computed by OctaveFilterBank (see utility/octave_bank.h), which is multirate: each
+ *     band is filtered at the slowest rate that has room for it, so the low bands cost almost nothing.
+ *     All 30 third-octave bands from 25 Hz to 20 kHz at 48 kHz cost about as much as 10 full-rate
+ *     band-pass filters.
+ *
+ *     The levels are read from the loop(), any time, without stopping the audio.  After each update,
+ *     the audio side copies its results to a set that only it writes.  Each value is a single 32-bit
+ *     read, so no locking is needed.  To get all of the bands from the same update, use getLevels_dB().
+ *     The dB values are re: full scale, plus whatever was given to setCalibration_dB() (such as the
+ *     cal_factor_dB of the SoundLevelMeter example, to get dB SPL).
+ *
+ *     Put AudioFilterFreqWeighting_F32 in front for A- or C-weighted band levels, or use the raw input
+ *     for Z (unweighted) band levels.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _AudioCalcOctaveBands_F32_h
+#define _AudioCalcOctaveBands_F32_h
+
+#include "Arduino.h"
+#include "AudioStream_F32.h"
+#include "utility/octave_bank.h"
+
+class AudioCalcOctaveBands_F32 : public AudioStream_F32
+{
+//GUI: inputs:1, outputs:0  //this line used for automatic generation of GUI node
+//GUI: shortName:octaveBands
+	public:
+		AudioCalcOctaveBands_F32(void) : AudioStream_F32(1, inputQueueArray) { setup(AUDIO_SAMPLE_RATE_EXACT); }
+		AudioCalcOctaveBands_F32(const AudioSettings_F32 &settings) : AudioStream_F32(1, inputQueueArray) { setup(settings.sample_rate_Hz); }
+
+		//The bands: 1 or 3 per octave, with nominal frequencies from lo_Hz to hi_Hz (bands too close to
+		//Nyquist are left out).  Defaults to third-octaves from 25 Hz to 20 kHz.  Each of these starts over.
+		bool setBandsPerOctave(const int b) { bands_per_octave = b; return setup(sample_rate_Hz); }
+		bool setFreqRange_Hz(const float lo_Hz, const float hi_Hz) { freq_lo_Hz = lo_Hz; freq_hi_Hz = hi_Hz; return setup(sample_rate_Hz); }
+		bool setSampleRate_Hz(const float fs_Hz) { return setup(fs_Hz); }
+		void setTimeConst_sec(const float tau_sec) { __disable_irq(); bank.setTimeConst_sec(tau_sec); __enable_irq(); }  //TIME_CONST_FAST or TIME_CONST_SLOW
+		float getTimeConst_sec(void) { return bank.getTimeConst_sec(); }
+		void setCalibration_dB(const float cal_dB) { calibration_dB = cal_dB; }
+		float getCalibration_dB(void) { return calibration_dB; }
+
+		int getNumBands(void) { return bank.getNumBands(); }
+		int getBandsPerOctave(void) { return bank.getBandsPerOctave(); }
+		float getBandFreq_Hz(const int i) { return bank.getNominal_Hz(i); }   //the nominal mid-band frequency
+		float getBandCenter_Hz(const int i) { return bank.getCenter_Hz(i); }  //the exact one
+
+		//Results, from the loop()
+		float getLeq_dB(const int i) { return validBand(i) ? to_dB(pub_leq[i]) : to_dB(0.0f); }
+		float getLmax_dB(const int i) { return validBand(i) ? to_dB(pub_max[i]) : to_dB(0.0f); }
+		float getLevel_dB(const int i) { return validBand(i) ? to_dB(pub_cur[i]) : to_dB(0.0f); }   //time weighted, right now
+		float getDuration_sec(void) { return pub_duration_sec; }    //of the Leq and Lmax
+		uint32_t getUpdateCount(void) { return pub_count; }        //changes every time new results are in
+		int getLevels_dB(float *leq_dB, float *lmax_dB, const int n);  //all bands from one update.  Either can be NULL.  Returns the number of bands.
+		void resetStats(void) { reset_request++; }                  //start the Leq and Lmax over, at the next update
+		void printLevels(Print *p);
+
+		virtual void update(void);
+
+	protected:
+		audio_block_f32_t *inputQueueArray[1];
+		OctaveFilterBank bank;
+		float sample_rate_Hz = AUDIO_SAMPLE_RATE_EXACT;
+		int bands_per_octave = 3;
+		float freq_lo_Hz = 25.0f, freq_hi_Hz = 20000.0f;
+		float calibration_dB = 0.0f;
+
+		//the results, written only by update()
+		volatile float pub_leq[OCTAVE_BANK_MAX_BANDS], pub_max[OCTAVE_BANK_MAX_BANDS], pub_cur[OCTAVE_BANK_MAX_BANDS];
+		volatile float pub_duration_sec = 0.0f;
+		volatile uint32_t pub_count = 0;
+		volatile uint32_t reset_request = 0, reset_ack = 0;
+
+		bool setup(const float fs_Hz);
+		bool configure(const float fs_Hz);
+		bool validBand(const int i) { return (i >= 0) && (i < bank.getNumBands()); }
+		float to_dB(const float ms) { return 10.0f * log10f(ms + 1.0e-20f) + calibration_dB; }
+};
+
+#endif
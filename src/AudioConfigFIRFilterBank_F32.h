@@ -12,7 +12,8 @@
 #ifndef AudioConfigFIRFilterBank_F32_h
 #define AudioConfigFIRFilterBank_F32_h
 
-#include <Tympan_Library.h>
+#include <Arduino.h>
+#include "AudioSettings_F32.h"
 
 #define fmove(x,y,n)    memmove(x,y,(n)*sizeof(float))
 #define fcopy(x,y,n)    memcpy(x,y,(n)*sizeof(float))
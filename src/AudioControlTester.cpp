@@ -4,6 +4,17 @@
 void AudioTestSignalGenerator_F32::update(void) {
   //receive the input audio data
   audio_block_f32_t *in_block = AudioStream_F32::receiveReadOnly_f32();
+
+  //if a tester gives the test signal, the input isn't needed (and needn't be there)
+  if (is_testing && (signal_source != NULL)) {
+    if (in_block) AudioStream_F32::release(in_block);
+    audio_block_f32_t *out_block = allocate_f32();
+    if (!out_block) return;
+    signal_source->generate(out_block->data, out_block->length);
+    AudioStream_F32::transmit(out_block);
+    AudioStream_F32::release(out_block);
+    return;
+  }
   if (!in_block) return;
 
   //if we're not testing, just transmit the block
@@ -54,6 +65,15 @@ void AudioTestSignalMeasurement_F32::update(void) {
     return;
   }
 
+  //give the audio itself to testers that want it
+  if ((testController != NULL) && testController->wantsAudio()) {
+    const float *test_data[1] = { in_block_test->data };
+    testController->transferAudio(in_block_baseline->data, test_data, 1, in_block_baseline->length);
+    AudioStream_F32::release(in_block_baseline);
+    AudioStream_F32::release(in_block_test);
+    return;
+  }
+
   //compute the rms of both signals
   float baseline_rms = computeRMS(in_block_baseline->data, in_block_baseline->length);
   float test_rms = computeRMS(in_block_test->data, in_block_test->length);
@@ -76,6 +96,25 @@ void AudioTestSignalMeasurementMulti_F32::update(void) {
   //receive the input audio data...the baseline and the test
   audio_block_f32_t *in_block_baseline = AudioStream_F32::receiveReadOnly_f32(0);
   if (in_block_baseline==NULL) return;
+
+  //give the audio itself to testers that want it
+  if ((testController != NULL) && testController->wantsAudio()) {
+    audio_block_f32_t *in_block_test[max_num_chan];
+    const float *test_data[max_num_chan];
+    int n_with_data = 0;
+    for (int Ichan=0; Ichan < num_test_values; Ichan++) {
+      in_block_test[Ichan] = AudioStream_F32::receiveReadOnly_f32(1+Ichan);
+      test_data[Ichan] = (in_block_test[Ichan] == NULL) ? NULL : in_block_test[Ichan]->data;
+      if (in_block_test[Ichan] != NULL) n_with_data = Ichan+1;
+    }
+    testController->transferAudio(in_block_baseline->data, test_data, n_with_data, in_block_baseline->length);
+    AudioStream_F32::release(in_block_baseline);
+    for (int Ichan=0; Ichan < num_test_values; Ichan++) {
+      if (in_block_test[Ichan] != NULL) AudioStream_F32::release(in_block_test[Ichan]);
+    }
+    return;
+  }
+
   float baseline_rms = computeRMS(in_block_baseline->data, in_block_baseline->length);
   AudioStream_F32::release(in_block_baseline);
   
@@ -99,3 +138,107 @@ void AudioTestSignalMeasurementMulti_F32::update(void) {
   //notify controller
   if (testController != NULL) testController->transferRMSValues(baseline_rms, test_rms, n_with_data);
 }
+
+
+// //////////////////////////////////////////////////////////////////////////
+#if defined(ARDUINO_TEENSY41)
+extern "C" uint8_t external_psram_size;   //MB of PSRAM fitted, from the Teensy 4 core
+#endif
+
+void AudioControlTestFastSweep_F32::begin(void) {
+  sweep.setSampleRate_Hz(sample_rate_Hz);
+  sweep.setLevels_dBFS(start_val, end_val, step_val);  //start_val, end_val, and step_val are in parent class
+  sweep.setSettle_sec(target_dur_per_step_sec);
+  if (!prepareBuffer() || !sweep.start()) {
+    Serial.println(F("AudioControlTestFastSweep_F32: begin: *** WARNING ***: could not start the test (not enough memory for the sweep?)"));
+    return;
+  }
+  Serial.print(F("AudioControlTestFastSweep_F32: begin(): ")); Serial.print(sweep.getNumLevels());
+  Serial.print(F(" levels of ")); Serial.print(sweep.getSamplesPerLevel() / sample_rate_Hz, 2);
+  Serial.println(F(" sec each"));
+
+  //activate the instrumentation
+  resetState();
+  sig_gen.setSignalSource(&sweep);
+  sig_gen.begin();
+  sig_meas.begin(this);
+}
+
+bool AudioControlTestFastSweep_F32::runOffline(void (*updateGraph)(void)) {
+  begin();
+  if (!sweep.isRunning()) return false;
+
+  //run the graph until the measurement has seen it all (allowing for it to be a few blocks behind the generator)
+  const unsigned long max_updates = sweep.getTotalSamples() / max(1, audio_block_samples) + 1000;
+  for (unsigned long i=0; (i < max_updates) && !isDataAvailable; i++) updateGraph();
+  if (!isDataAvailable) {
+    Serial.println(F("AudioControlTestFastSweep_F32: runOffline: *** WARNING ***: the measurement isn't getting the test signal.  Stopping."));
+    end();
+    return false;
+  }
+  return true;
+}
+
+bool AudioControlTestFastSweep_F32::prepareBuffer(void) {
+  if (sweep.getStimulus() != SweepMeasure::LOG_SWEEP) return true;
+  if (user_buffer != NULL) { sweep.setBuffer(user_buffer, user_buffer_len); return true; }
+
+  //allocate, trying shorter sweeps if need be (start() fits the sweep to what it gets)
+  freeBuffer();
+  uint32_t n = sweep.floatsNeeded();
+  while ((allocated == NULL) && (n > 0)) {
+#if defined(ARDUINO_TEENSY41)
+    if (external_psram_size > 0) { allocated = (float *)extmem_malloc(n * sizeof(float)); allocated_extmem = (allocated != NULL); }
+#endif
+    if (allocated == NULL) allocated = (float *)malloc(n * sizeof(float));
+    if (allocated == NULL) n /= 2;
+  }
+  sweep.setBuffer(allocated, n);
+  return (allocated != NULL);
+}
+
+void AudioControlTestFastSweep_F32::freeBuffer(void) {
+  if (allocated != NULL) {
+#if defined(ARDUINO_TEENSY41)
+    if (allocated_extmem) { extmem_free(allocated); } else { free(allocated); }
+#else
+    free(allocated);
+#endif
+    allocated = NULL;
+  }
+  allocated_extmem = false;
+  sweep.setBuffer(user_buffer, user_buffer_len);
+}
+
+void AudioControlTestFastSweep_F32::printTableOfResults(Stream *s) {
+  const bool is_sweep = (sweep.getStimulus() == SweepMeasure::LOG_SWEEP);
+  const int n_chan = sweep.getNumChannels();
+  s->println("AudioControlTestFastSweep_F32: Start Table of Results...");
+  s->print("  : Level (dBFS), Freq (Hz), Input (dBFS), Per-Chan Output (dBFS), Total Gain (inc) (dB), Total Gain (coh) (dB)");
+  if (is_sweep) s->print(", 2nd Harmonic (dB), 3rd Harmonic (dB)");
+  s->println();
+  for (int L=0; L < sweep.getNumLevels(); L++) {
+    for (int f=0; f < sweep.getNumFreqs(); f++) {
+      const float in_dBFS = sweep.getInput_dBFS(L,f);
+      s->print("     ");  s->print(sweep.getLevel_dBFS(L),1);
+      s->print(",       ");  s->print(sweep.getFreq_Hz(f),0);
+      s->print(",       ");  s->print(in_dBFS,1);
+
+      float total_pow = 0.0f;
+      for (int Ichan=0; Ichan < n_chan; Ichan++) {
+        const float out_dBFS = sweep.getOutput_dBFS(L,f,Ichan);
+        s->print((Ichan==0) ? ",       " : ", ");
+        s->print(out_dBFS,1);
+        total_pow += powf(10.0f,0.1f*out_dBFS);  //sum as if it's noise being recombined incoherently
+      }
+      s->print(",       ");  s->print(10.f*log10f(total_pow) - in_dBFS,2);
+      s->print(",       ");  s->print(sweep.getTotalGain_dB(L,f),2);  //the outputs' responses, summed
+      if (is_sweep) {
+        s->print(",       ");  s->print(sweep.getHarmonic_dB(L,f,2),1);
+        s->print(", ");  s->print(sweep.getHarmonic_dB(L,f,3),1);
+      }
+      s->println();
+    }
+  }
+  s->println("AudioControlTestFastSweep_F32: End Table of Results...");
+}
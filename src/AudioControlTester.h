@@ -2,7 +2,13 @@
 #ifndef _AudioControlTester_h
 #define _AudioControlTester_h
 
-#include <Tympan_Library.h>
+#include <Arduino.h>
+#include <arm_math.h>
+#include "AudioStream_F32.h"
+#include "AudioEffectGain_F32.h"
+#include "synth_sine_f32.h"
+#include "record_queue_f32.h"
+#include "utility/sweep_measure.h"
 
 #define max_steps 128
 #define max_num_chan 16   //max number of test signal inputs to the AudioTestSignalMeasurementMulti_F32
@@ -16,6 +22,7 @@ class AudioControlSignalTesterInterface_F32;
 class AudioControlSignalTester_F32;
 class AudioControlTestAmpSweep_F32;
 class AudioControlTestFreqSweep_F32;
+class AudioControlTestFastSweep_F32;
 
 // class definitions
 class AudioTestSignalGenerator_F32 : public AudioStream_F32
@@ -54,6 +61,10 @@ class AudioTestSignalGenerator_F32 : public AudioStream_F32
       //if (Serial) Serial.println("AudioTestSignalGenerator_F32: begin(): ...");
     }
     void end(void) { is_testing = false; }
+
+    //While testing, take the test signal from here instead of from the sine (used by AudioControlTestFastSweep_F32).
+    //The input isn't needed then, so the graph can be run without any audio input.  Give NULL to go back to the sine.
+    void setSignalSource(SweepMeasure *source) { signal_source = source; }
     
     AudioSynthWaveformSine_F32 sine_gen;
     AudioEffectGain_F32 gain_alg;
@@ -78,6 +89,7 @@ class AudioTestSignalGenerator_F32 : public AudioStream_F32
 	
   private:
     bool is_testing = false;
+    SweepMeasure *signal_source = NULL;
     audio_block_f32_t *inputQueueArray[1];
 
     void setDefaultValues(void) {
@@ -101,7 +113,7 @@ class AudioTestSignalMeasurementInterface_F32 {
 		void setSampleRate_Hz(const float _fs_Hz) {
 		  //pass this data on to its components that care.  None care right now.
 		}
-		virtual void update(void);
+		virtual void update(void) = 0;
 	    virtual float computeRMS(float data[], int n) {
 			float rms_value;
 			arm_rms_f32 (data, n, &rms_value);
@@ -276,6 +288,11 @@ class AudioControlSignalTester_F32 : public AudioControlSignalTesterInterface_F3
       }
     }
 	
+	//Testers that analyze the audio itself (instead of its RMS per block) say so here, and then the
+	//measurement nodes give them every block through transferAudio().  Missing test channels are NULL.
+	virtual bool wantsAudio(void) { return false; }
+	virtual void transferAudio(const float * /*baseline*/, const float * const * /*test*/, int /*num_chan*/, int /*n_samples*/) {}
+
 	virtual void setSignalFrequency_Hz(float freq_Hz) {
       signal_frequency_Hz = freq_Hz;
       sig_gen.setSignalFrequency_Hz(signal_frequency_Hz);
@@ -532,5 +549,72 @@ class AudioControlTestFreqSweep_F32 : public AudioControlSignalTester_F32
 };
 
 
+// //////////////////////////////////////////////////////////////////////////
+// Measures the gain at many frequencies and levels at once, with a multitone or a log sweep (see
+// utility/sweep_measure.h), through the same generator and measurement nodes as the testers above.
+// The levels (dBFS) come from setStepPattern() and the settling time at each level from
+// setTargetDurPerStep_sec().  Give setNumChannels() the number of measurement inputs in use.
+//
+// To run faster than real time, don't start the audio (or stop it) and call runOffline() with a
+// function that updates every node of the graph once, in order: the generator, the system under
+// test, and then the measurement.  Otherwise, call begin() and let the audio run as usual.
+class AudioControlTestFastSweep_F32 : public AudioControlSignalTester_F32
+{
+  //GUI: inputs:0, outputs:0  //this line used for automatic generation of GUI node
+  //GUI: shortName: fastSweepTester
+  public:
+    AudioControlTestFastSweep_F32(AudioSettings_F32 &settings, AudioTestSignalGenerator_F32 &_sig_gen, AudioTestSignalMeasurementInterface_F32 &_sig_meas) 
+      : AudioControlSignalTester_F32(settings, _sig_gen,_sig_meas)
+    {
+      float start_amp_dB = -80.0f, end_amp_dB = 0.0f, step_amp_dB = 10.0f;
+      setStepPattern(start_amp_dB, end_amp_dB, step_amp_dB);
+      setTargetDurPerStep_sec(0.5);
+      resetState();
+    }
+    ~AudioControlTestFastSweep_F32(void) { freeBuffer(); }
+
+    void setStimulus(SweepMeasure::Stimulus stimulus) { sweep.setStimulus(stimulus); }
+    void setFreqRange_Hz(float lo_Hz, float hi_Hz) { sweep.setFreqRange_Hz(lo_Hz, hi_Hz); }
+    void setNumFrequencies(int n) { sweep.setNumFreqs(n); }
+    void setMeasureDur_sec(float sec) { sweep.setMeasure_sec(sec); }  //multitone: averaging time.  log sweep: sweep length.
+    void setNumChannels(int n) { sweep.setNumChannels(n); }
+    
+    //The log sweep needs memory (see SweepMeasure::floatsNeeded()).  By default, it is allocated by begin()
+    //(in the external PSRAM of a Teensy 4.1, if it has some).  Or, give your own here.
+    void setBuffer(float *buf, uint32_t n_floats) { freeBuffer(); user_buffer = buf; user_buffer_len = n_floats; }
+
+    void begin(void);
+    bool runOffline(void (*updateGraph)(void));
+    
+    void printTableOfResults(Stream *s);
+    SweepMeasure &getMeasurement(void) { return sweep; }  //for the results, one by one
+
+    bool wantsAudio(void) { return true; }
+    void transferAudio(const float *baseline, const float * const *test, int num_chan, int n_samples) {
+      sweep.analyze(baseline, test, num_chan, n_samples);
+      if (sweep.isDone() && !isDataAvailable) finishTest();
+    }
+
+  protected:
+    SweepMeasure sweep;
+    float *user_buffer = NULL;
+    uint32_t user_buffer_len = 0;
+    float *allocated = NULL;
+    bool allocated_extmem = false;
+
+    bool prepareBuffer(void);
+    void freeBuffer(void);
+    void finishTest(void) {
+      sweep.stop();
+      sig_gen.setSignalSource(NULL);
+
+      //do all of the common actions
+      AudioControlSignalTester_F32::finishTest();
+
+      //print results
+      printTableOfResults(&Serial);
+    }
+};
+
 
 #endif
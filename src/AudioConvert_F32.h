@@ -4,6 +4,7 @@
 
 #include <Arduino.h>
 #include <AudioStream_F32.h>
+#include "utility/convert_f32.h"
 
 class AudioConvert_I16toF32 : public AudioStream_F32 //receive Int and transmits Float
 {
@@ -36,15 +37,11 @@ class AudioConvert_I16toF32 : public AudioStream_F32 //receive Int and transmits
     };
     
     static void convertAudio_I16toF32(audio_block_t *in, audio_block_f32_t *out, int len) {
-      //WEA Method.  Should look at CMSIS arm_q15_to_float instead: https://www.keil.com/pack/doc/CMSIS/DSP/html/group__q15__to__x.html#gaf8b0d2324de273fc430b0e61ad4e9eb2
-      const float MAX_INT = 32767.0;
-      for (int i = 0; i < len; i++) out->data[i] = (float)(in->data[i]);
-      arm_scale_f32(out->data, 1.0/MAX_INT, out->data, out->length); //divide by 32678 to get -1.0 to +1.0
+      i16_to_f32_scaled(in->data, out->data, len); //single pass: convert and divide by 32767 to get -1.0 to +1.0
     }  
 
 	static void convert_i16_to_f32( int16_t *p_i16, float32_t *p_f32, int len) {
-		const float I16_TO_F32_NORM_FACTOR = 3.051850947599719e-05;   //should be 1/32767
-		for (int i=0; i<len; i++) { *p_f32++ = ((float32_t)(*p_i16++)) * I16_TO_F32_NORM_FACTOR; }
+		i16_to_f32_scaled(p_i16, p_f32, len);  //see utility/convert_f32.h
 	}
     
   private:
@@ -82,11 +79,7 @@ class AudioConvert_F32toI16 : public AudioStream_F32 //receive Float and transmi
     };
 
    static void convertAudio_F32toI16(audio_block_f32_t *in, audio_block_t *out, int len) {
-      //WEA Method.  Should look at CMSIS arm_float_to_q15 instead: https://www.keil.com/pack/doc/CMSIS/DSP/html/group__float__to__x.html#ga215456e35a18db86882e1d3f0d24e1f2	
-      const float MAX_INT = 32767.0;
-      for (int i = 0; i < len; i++) {
-        out->data[i] = (int16_t)(max(min( (in->data[i] * MAX_INT), MAX_INT), -MAX_INT));
-      }
+      f32_to_i16_sat(in->data, out->data, len);  //scale by 32767 and saturate, like arm_float_to_q15.  See utility/convert_f32.h
     }    
     
   private:
@@ -0,0 +1,119 @@
+/*
+ * AudioEffectBeamformerN_F32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Directional processing for a microphone array: N mic inputs (up to STFT_BEAMFORMER_MAX_CHAN,
+ *     such as the four of AudioInputI2SQuad_F32), one output, which keeps the sound from the look
+ *     direction and turns down sound from elsewhere.  As a template:  AudioEffectBeamformerN_F32<4> beam;
+ *     This takes the place of mixing the mics by hand with AudioMixer4_F32.  The beam is made in the
+ *     STFT domain by StftBeamformer (see utility/stft_beamformer.h), with one of these modes:
+ *         DELAY_AND_SUM    fixed, for arrays that are wide for the frequencies of interest
+ *         SUPERDIRECTIVE   fixed, for small arrays (such as a hearing aid's front and back mics); low cost
+ *         MVDR             adaptive: each bin's covariance is averaged every hop, and the weights follow
+ *         GSC              adaptive: the same goal, by NLMS, for less work per bin
+ *     Give the mics' positions (setMicPositions_m(), or setLinearArray_m() for a line of them along x,
+ *     at 0, spacing, 2*spacing, and so on; the default is 12 mm apart) and the look direction
+ *     (setLookDirection_deg(): 0 deg is from +x, beyond the last mic of a line; 90 deg is from +y).
+ *
+ *     The delay is N_FFT samples (default 128).  Nothing is allocated.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _AudioEffectBeamformerN_F32_h
+#define _AudioEffectBeamformerN_F32_h
+
+#include "Arduino.h"
+#include "AudioStream_F32.h"
+#include "utility/stft_beamformer.h"
+
+#define BEAMFORMER_DEFAULT_FFT 128
+
+template <int N>
+class AudioEffectBeamformerN_F32 : public AudioStream_F32
+{
+//GUI: inputs:N, outputs:1  //this line used for automatic generation of GUI node
+//GUI: shortName:beamformerN
+	static_assert((N >= 1) && (N <= STFT_BEAMFORMER_MAX_CHAN), "AudioEffectBeamformerN_F32: N must be from 1 to STFT_BEAMFORMER_MAX_CHAN");
+	public:
+		AudioEffectBeamformerN_F32(void) : AudioStream_F32(N, inputQueueArray) { setup(AUDIO_SAMPLE_RATE_EXACT); }
+		AudioEffectBeamformerN_F32(const AudioSettings_F32 &settings) : AudioStream_F32(N, inputQueueArray) { setup(settings.sample_rate_Hz); }
+
+		//N_FFT: a power of 2, up to STFT_BEAMFORMER_MAX_FFT.  overlap: 2 or 4.  Returns N_FFT (or -1 if no good).
+		int setup(const AudioSettings_F32 &settings, const int _N_FFT, const int _overlap = 2) {
+			N_FFT = _N_FFT;  overlap = _overlap;
+			return setup(settings.sample_rate_Hz) ? N_FFT : -1;
+		}
+
+		void setMode(const StftBeamformer::Mode m) { __disable_irq(); bf.setMode(m); __enable_irq(); }
+		StftBeamformer::Mode getMode(void) { return bf.getMode(); }
+		void setMicPositions_m(const float *x_m, const float *y_m) { __disable_irq(); bf.setMicPositions_m(x_m, y_m, N); __enable_irq(); }  //N each (y_m can be NULL)
+		void setLinearArray_m(const float spacing_m) { __disable_irq(); bf.setLinearArray_m(spacing_m, N); __enable_irq(); }
+		void setLookDirection_deg(const float az_deg) { __disable_irq(); bf.setLookDirection_deg(az_deg); __enable_irq(); }
+		float getLookDirection_deg(void) { return bf.getLookDirection_deg(); }
+		void setTimeConst_sec(const float tau_sec) { __disable_irq(); bf.setTimeConst_sec(tau_sec); __enable_irq(); }
+		void setDiagonalLoading(const float loading) { __disable_irq(); bf.setDiagonalLoading(loading); __enable_irq(); }
+		void setSuperdirectiveLoading(const float loading) { __disable_irq(); bf.setSuperdirectiveLoading(loading); __enable_irq(); }
+		void setAdaptRate(const float mu) { __disable_irq(); bf.setAdaptRate(mu); __enable_irq(); }
+		void enableAdaptation(const bool enable) { bf.enableAdaptation(enable); }   //false holds the adaptive weights (such as while the target talks)
+		void resetAdaptation(void) { __disable_irq(); bf.reset(); __enable_irq(); }
+		void setSampleRate_Hz(const float fs_Hz) { setup(fs_Hz); }
+		int getNFFT(void) { return bf.getNFFT(); }
+		float getLatency_msec(void) { return 1000.0f * bf.getLatency_samples() / sample_rate_Hz; }
+
+		//the beam's present response to sound from az_deg at f_Hz, for checking the beam from the loop()
+		float getResponse_dB(const float az_deg, const float f_Hz) {
+			__disable_irq(); float r = bf.getResponse_dB(az_deg, f_Hz); __enable_irq();
+			return r;
+		}
+
+		virtual void update(void);
+
+	protected:
+		audio_block_f32_t *inputQueueArray[N];
+		StftBeamformer bf;
+		float sample_rate_Hz = AUDIO_SAMPLE_RATE_EXACT;
+		int N_FFT = BEAMFORMER_DEFAULT_FFT, overlap = 2;
+
+		bool setup(const float fs_Hz) {
+			__disable_irq(); bool ok = configure(fs_Hz); __enable_irq();
+			if (!ok) {
+				Serial.print("AudioEffectBeamformerN_F32: *** WARNING ***: N_FFT = "); Serial.print(N_FFT);
+				Serial.print(" with overlap "); Serial.print(overlap); Serial.print(" is not allowed.  Use a power of 2 from ");
+				Serial.print(STFT_BEAMFORMER_MIN_FFT); Serial.print(" to "); Serial.print(STFT_BEAMFORMER_MAX_FFT); Serial.println(", and overlap 2 or 4.");
+			}
+			return ok;
+		}
+		bool configure(const float fs_Hz) {   //the audio must not be running (or this is the audio)
+			if (fs_Hz > 0.0f) sample_rate_Hz = fs_Hz;
+			return bf.setup(sample_rate_Hz, N, N_FFT, overlap);
+		}
+};
+
+template <int N>
+void AudioEffectBeamformerN_F32<N>::update(void) {
+	audio_block_f32_t *in[N];
+	const float *x[N];
+	audio_block_f32_t *first = NULL;
+	int n = 0;
+	for (int c = 0; c < N; c++) {
+		in[c] = receiveReadOnly_f32(c);
+		x[c] = in[c] ? in[c]->data : NULL;   //a missing input is silence
+		if (in[c] && (!first || (in[c]->length < n))) { if (!first) first = in[c]; n = in[c]->length; }
+	}
+	if (!first) return;  //there was no data available.  so exit.
+
+	//follow the sample rate of the audio, if it isn't what we were set up for
+	if ((first->fs_Hz > 0.0f) && (first->fs_Hz != sample_rate_Hz)) configure(first->fs_Hz);
+
+	audio_block_f32_t *out = allocate_f32();
+	if (out) {
+		bf.process(x, out->data, n);
+		out->length = n;  out->fs_Hz = first->fs_Hz;  out->id = first->id;
+	}
+	for (int c = 0; c < N; c++) if (in[c]) AudioStream_F32::release(in[c]);
+	if (out) { AudioStream_F32::transmit(out); AudioStream_F32::release(out); }
+}
+
+#endif
@@ -42,13 +42,17 @@ class AudioEffectCompWDRC_F32 : public AudioStream_F32
       //receive the input audio data
       audio_block_f32_t *block = AudioStream_F32::receiveReadOnly_f32();
       if (!block) return;
+
+      //follow the data's sample rate (such as after a decimator), so that the time constants stay right
+      if (block->fs_Hz != given_sample_rate_Hz) setSampleRate_Hz(block->fs_Hz);
       
       //allocate memory for the output of our algorithm
       audio_block_f32_t *out_block = AudioStream_F32::allocate_f32();
-      if (!out_block) return;
+      if (!out_block) { AudioStream_F32::release(block); return; }
       
       //do the algorithm
       cha_agc_channel(block->data, out_block->data, block->length);
+      out_block->length = block->length; out_block->fs_Hz = block->fs_Hz;
       
       // transmit the block and release memory
       AudioStream_F32::transmit(out_block); // send the FIR output
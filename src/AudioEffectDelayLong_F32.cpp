@@ -0,0 +1,103 @@
+/*
+ * AudioEffectDelayLong_F32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * MIT License.  use at your own risk.
+ */
+
+#include "AudioEffectDelayLong_F32.h"
+#include <stdlib.h>
+
+#if defined(ARDUINO_TEENSY41)
+extern "C" uint8_t external_psram_size;   //MB of PSRAM fitted, from the Teensy 4 core
+#endif
+
+bool AudioEffectDelayLong_F32::begin(float max_delay_msec, DelayLine::Storage storage) {
+	end();
+	if (max_delay_msec < 0.0f) max_delay_msec = 0.0f;
+	const uint32_t n = DelayLine::samplesNeeded((uint32_t)(max_delay_msec * 0.001f * sample_rate_Hz + 1.0f), AUDIO_BLOCK_SAMPLES);
+	const size_t bytes = n * ((storage == DelayLine::INT16) ? sizeof(int16_t) : sizeof(float));
+
+	void *mem = NULL;
+	bool extmem = false;
+#if defined(ARDUINO_TEENSY41)
+	if (external_psram_size > 0) { mem = extmem_malloc(bytes); extmem = (mem != NULL); }
+#endif
+	if (mem == NULL) mem = malloc(bytes);
+	if (mem == NULL) {
+		Serial.print("AudioEffectDelayLong_F32: *** WARNING ***: could not allocate ");
+		Serial.print(bytes); Serial.println(" bytes for the delay.");
+		return false;
+	}
+	allocated_extmem = extmem;
+	return useBuffer(mem, n, storage, true);
+}
+
+bool AudioEffectDelayLong_F32::useBuffer(void *mem, uint32_t n_samples, DelayLine::Storage storage, bool owned) {
+	if (!owned) end();
+	__disable_irq();
+	bool ok = delay_line.setBuffer(mem, n_samples, storage, AUDIO_BLOCK_SAMPLES);
+	__enable_irq();
+	if (owned) allocated = mem;
+	if (!ok) {
+		Serial.println("AudioEffectDelayLong_F32: *** WARNING ***: the delay buffer is too small.");
+		end();
+	}
+	return ok;
+}
+
+void AudioEffectDelayLong_F32::end(void) {
+	__disable_irq();
+	delay_line.setBuffer(NULL, 0, DelayLine::FLOAT32, AUDIO_BLOCK_SAMPLES);   //detach the ring
+	__enable_irq();
+	if (allocated != NULL) {
+#if defined(ARDUINO_TEENSY41)
+		if (allocated_extmem) { extmem_free(allocated); } else { free(allocated); }
+#else
+		free(allocated);
+#endif
+		allocated = NULL;
+	}
+	allocated_extmem = false;
+}
+
+void AudioEffectDelayLong_F32::update(void) {
+	audio_block_f32_t *in_block = receiveReadOnly_f32();
+	if (!delay_line.isReady()) {
+		if (in_block) AudioStream_F32::release(in_block);
+		return;
+	}
+
+	//write the new audio into the ring (or, with no input, silence, so that what is there still comes out on time)
+	int n = AudioStream_F32::f32_default_length;
+	float fs_Hz = sample_rate_Hz;
+	unsigned long id = 0;
+	if (in_block) {
+		n = in_block->length;
+		fs_Hz = in_block->fs_Hz;
+		id = in_block->id;
+		if (n > AUDIO_BLOCK_SAMPLES) {
+			if (!warned) { Serial.println("AudioEffectDelayLong_F32: *** WARNING ***: block is longer than AUDIO_BLOCK_SAMPLES.  Dropping it."); warned = true; }
+			AudioStream_F32::release(in_block);
+			return;
+		}
+		delay_line.write(in_block->data, n);
+		AudioStream_F32::release(in_block);
+	} else {
+		delay_line.writeSilence(n);
+	}
+
+	//read out each tap that is in use
+	for (int tap = 0; tap < DELAY_LINE_MAX_TAPS; tap++) {
+		if (!delay_line.isEnabled(tap)) continue;
+		audio_block_f32_t *out_block = allocate_f32();
+		if (!out_block) return;
+		delay_line.readTap(tap, out_block->data);
+		out_block->length = n;
+		out_block->fs_Hz = fs_Hz;
+		out_block->id = id;
+		AudioStream_F32::transmit(out_block, tap);
+		AudioStream_F32::release(out_block);
+	}
+}
@@ -0,0 +1,80 @@
+/*
+ * AudioEffectDelayLong_F32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Long delay (many seconds) with up to 8 taps, each with its own fractional delay.  Unlike
+ *     AudioEffectDelay_F32, which keeps the delayed audio in a queue of audio blocks (and so, for a
+ *     long delay, uses up the blocks that every other node needs), this keeps its audio in its own
+ *     contiguous ring buffer.  The ring can be
+ *        - allocated by begin(max_delay_msec), on the heap (or in the external PSRAM of a Teensy 4.1,
+ *          when it has some), or
+ *        - any memory that you give to begin(buffer, n_samples), such as a global array (or, on a
+ *          Teensy 4.1, an array declared EXTMEM).
+ *     The ring can hold float samples or, for twice the delay in the same memory, int16 samples
+ *     (about 90 dB of dynamic range, plenty for delayed auditory feedback).  Each tap interpolates
+ *     (cubic, by default) for delays between samples.  See utility/delay_line.h for the details.
+ *
+ *     Output channel N is tap N.  Changing a tap's delay crossfades to the new delay over one block.
+ *
+ * MIT License.  use at your own risk.
+ */
+
+#ifndef _AudioEffectDelayLong_F32_h
+#define _AudioEffectDelayLong_F32_h
+
+#include "Arduino.h"
+#include "AudioStream_F32.h"
+#include "utility/delay_line.h"
+
+class AudioEffectDelayLong_F32 : public AudioStream_F32
+{
+//GUI: inputs:1, outputs:8 //this line used for automatic generation of GUI node
+//GUI: shortName:delayLong  //this line used for automatic generation of GUI node
+public:
+	AudioEffectDelayLong_F32(void) : AudioStream_F32(1, inputQueueArray) { }
+	AudioEffectDelayLong_F32(const AudioSettings_F32 &settings) : AudioStream_F32(1, inputQueueArray) {
+		setSampleRate_Hz(settings.sample_rate_Hz);
+	}
+	~AudioEffectDelayLong_F32(void) { end(); }
+
+	//Get the ring buffer, long enough for max_delay_msec (at the present sample rate).  Returns false if
+	//the memory couldn't be had.
+	bool begin(float max_delay_msec, DelayLine::Storage storage = DelayLine::FLOAT32);
+	//...or use your own memory, of n_samples floats or int16s
+	bool begin(float *buffer, uint32_t n_samples) { return useBuffer(buffer, n_samples, DelayLine::FLOAT32, false); }
+	bool begin(int16_t *buffer, uint32_t n_samples) { return useBuffer(buffer, n_samples, DelayLine::INT16, false); }
+	void end(void);   //stop, and free any memory that begin(max_delay_msec) allocated
+
+	void setSampleRate_Hz(float fs_Hz) { if (fs_Hz > 0.0f) sample_rate_Hz = fs_Hz; }
+
+	//set the delay of a tap (0-7), which also enables it.  Returns the delay that it got.
+	float delay(int tap, float milliseconds) {
+		__disable_irq(); delay_line.setDelay_samples(tap, milliseconds * 0.001f * sample_rate_Hz); __enable_irq();
+		return getDelay_msec(tap);
+	}
+	float setDelay_samples(int tap, float samples) {
+		__disable_irq(); delay_line.setDelay_samples(tap, samples); __enable_irq();
+		return delay_line.getDelay_samples(tap);
+	}
+	void disable(int tap) { __disable_irq(); delay_line.disable(tap); __enable_irq(); }
+	float getDelay_msec(int tap) { return delay_line.getDelay_samples(tap) / sample_rate_Hz * 1000.0f; }
+	float getMaxDelay_msec(void) { return delay_line.getMaxDelay_samples() / sample_rate_Hz * 1000.0f; }
+
+	void setInterpolation(DelayLine::Interp type) { __disable_irq(); delay_line.setInterpolation(type); __enable_irq(); }
+	void clear(void) { __disable_irq(); delay_line.clear(); __enable_irq(); }   //silence everything in the ring
+
+	virtual void update(void);
+
+	DelayLine delay_line;
+
+private:
+	audio_block_f32_t *inputQueueArray[1];
+	float sample_rate_Hz = AUDIO_SAMPLE_RATE_EXACT;
+	void *allocated = NULL;    //memory that we allocated (and so must free)
+	bool allocated_extmem = false;
+	bool warned = false;
+	bool useBuffer(void *mem, uint32_t n_samples, DelayLine::Storage storage, bool owned);
+};
+
+#endif
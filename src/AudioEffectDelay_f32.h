@@ -58,6 +58,7 @@ public:
 		headindex = 0;
 		tailindex = 0;
 		maxblocks = 0;
+		writeposition = 0;
 		memset(queue, 0, sizeof(queue));
 	}
 	AudioEffectDelay_F32(const AudioSettings_F32 &settings) : 
@@ -66,6 +67,7 @@ public:
 			headindex = 0;
 			tailindex = 0;
 			maxblocks = 0;
+			writeposition = 0;
 			memset(queue, 0, sizeof(queue));
 			setSampleRate_Hz(settings.sample_rate_Hz);
 	}	
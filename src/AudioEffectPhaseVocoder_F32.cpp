@@ -0,0 +1,45 @@
+/*
+ * AudioEffectPhaseVocoder_F32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include "AudioEffectPhaseVocoder_F32.h"
+
+bool AudioEffectPhaseVocoder_F32::setup(const float fs_Hz) {
+	__disable_irq();
+	bool ok = configure(fs_Hz);
+	__enable_irq();
+	if (!ok) {
+		Serial.print("AudioEffectPhaseVocoder_F32: *** WARNING ***: N_FFT = "); Serial.print(N_FFT);
+		Serial.print(" with overlap "); Serial.print(overlap); Serial.print(" is not allowed.  Use a power of 2 from ");
+		Serial.print(PHASE_VOCODER_MIN_FFT); Serial.print(" to "); Serial.print(PHASE_VOCODER_MAX_FFT); Serial.println(", and overlap 4 or 8.");
+	}
+	return ok;
+}
+
+//the FFT for this sample rate, and everything cleared.  The audio must not be running (or this is the audio).
+bool AudioEffectPhaseVocoder_F32::configure(const float fs_Hz) {
+	if (fs_Hz > 0.0f) sample_rate_Hz = fs_Hz;
+	return pv.setup(sample_rate_Hz, N_FFT, overlap);
+}
+
+void AudioEffectPhaseVocoder_F32::update(void) {
+	audio_block_f32_t *in_block = AudioStream_F32::receiveReadOnly_f32();
+	if (!in_block) return;
+
+	//follow the sample rate of the audio, if it isn't what we were set up for
+	if ((in_block->fs_Hz > 0.0f) && (in_block->fs_Hz != sample_rate_Hz)) configure(in_block->fs_Hz);
+
+	audio_block_f32_t *out_block = AudioStream_F32::allocate_f32();
+	if (!out_block) { AudioStream_F32::release(in_block); return; }
+
+	pv.process(in_block->data, out_block->data, in_block->length);
+	out_block->length = in_block->length;  out_block->fs_Hz = in_block->fs_Hz;  out_block->id = in_block->id;
+	AudioStream_F32::release(in_block);
+
+	AudioStream_F32::transmit(out_block);
+	AudioStream_F32::release(out_block);
+}
@@ -0,0 +1,72 @@
+/*
+ * AudioEffectPhaseVocoder_F32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Pitch shifting, frequency lowering, and formant shifting, in the frequency domain, with a
+ *     phase vocoder (see utility/phase_vocoder.h).  The spectral peaks are moved with their phases
+ *     kept going from frame to frame, and the bins around each peak are phase locked to it, so that
+ *     tones come out at exactly the new frequency.  The formants (the spectral envelope, by cepstral
+ *     smoothing) can be moved on their own, or kept where they are while the pitch moves.
+ *         setPitchRatio(1.5)          everything up by a fifth (and the formants, too)
+ *         setFormantRatio(1.0)        ...but keep the formants where they were
+ *         setFreqLowering(2000, 2.0)  above 2 kHz, compress the frequencies 2:1 (on a log scale)
+ *         setFormantRatio(1.2)        (by itself) move only the formants, up by 20%
+ *     With none of these (the default), the audio comes through unchanged, one FFT later.
+ *
+ *     Any block size works.  The delay is N_FFT samples.  Nothing is allocated: the FFT can be up to
+ *     PHASE_VOCODER_MAX_FFT long.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _AudioEffectPhaseVocoder_F32_h
+#define _AudioEffectPhaseVocoder_F32_h
+
+#include "Arduino.h"
+#include "AudioStream_F32.h"
+#include "utility/phase_vocoder.h"
+
+#define PHASE_VOCODER_DEFAULT_FFT 512
+
+class AudioEffectPhaseVocoder_F32 : public AudioStream_F32
+{
+//GUI: inputs:1, outputs:1  //this line used for automatic generation of GUI node
+//GUI: shortName:phaseVocoder
+	public:
+		AudioEffectPhaseVocoder_F32(void) : AudioStream_F32(1, inputQueueArray) { setup(AUDIO_SAMPLE_RATE_EXACT); }
+		AudioEffectPhaseVocoder_F32(const AudioSettings_F32 &settings) : AudioStream_F32(1, inputQueueArray) { setup(settings.sample_rate_Hz); }
+		AudioEffectPhaseVocoder_F32(const AudioSettings_F32 &settings, const int _N_FFT) : AudioStream_F32(1, inputQueueArray) { setup(settings, _N_FFT); }
+
+		//N_FFT: a power of 2, up to PHASE_VOCODER_MAX_FFT.  overlap: 4 or 8.  Returns N_FFT (or -1 if no good).
+		int setup(const AudioSettings_F32 &settings, const int _N_FFT, const int _overlap = 4) {
+			N_FFT = _N_FFT;  overlap = _overlap;
+			return setup(settings.sample_rate_Hz) ? N_FFT : -1;
+		}
+
+		void setPitchRatio(const float ratio) { __disable_irq(); pv.setPitchRatio(ratio); __enable_irq(); }
+		void setFreqLowering(const float start_Hz, const float ratio) { __disable_irq(); pv.setFreqLowering(start_Hz, ratio); __enable_irq(); }
+		void setFormantRatio(const float ratio) { __disable_irq(); pv.setFormantRatio(ratio); __enable_irq(); }  //0: the formants move with the pitch
+		void setEnvelopeQuefrency_msec(const float msec) { __disable_irq(); pv.setEnvelopeQuefrency_msec(msec); __enable_irq(); }
+		float getPitchRatio(void) { return pv.getPitchRatio(); }
+		float getFreqLoweringStart_Hz(void) { return pv.getFreqLoweringStart_Hz(); }
+		float getFreqLoweringRatio(void) { return pv.getFreqLoweringRatio(); }
+		float getFormantRatio(void) { return pv.getFormantRatio(); }
+		float getMappedFreq_Hz(const float f_Hz) { return pv.getMappedFreq_Hz(f_Hz); }
+		int getNFFT(void) { return pv.getNFFT(); }
+		float getLatency_msec(void) { return 1000.0f * pv.getLatency_samples() / sample_rate_Hz; }
+		void setSampleRate_Hz(const float fs_Hz) { setup(fs_Hz); }
+
+		virtual void update(void);
+
+	protected:
+		audio_block_f32_t *inputQueueArray[1];
+		PhaseVocoder pv;
+		float sample_rate_Hz = AUDIO_SAMPLE_RATE_EXACT;
+		int N_FFT = PHASE_VOCODER_DEFAULT_FFT, overlap = 4;
+
+		bool setup(const float fs_Hz);
+		bool configure(const float fs_Hz);
+};
+
+#endif
@@ -46,6 +46,7 @@ void AudioFilterFIR_F32::update(void)
 		//apply the FIR
 		arm_fir_f32(&fir_inst, block->data, block_new->data, block->length);
 		block_new->length = block->length;
+		block_new->fs_Hz = block->fs_Hz;
 
 		//transmit the data
 		AudioStream_F32::transmit(block_new); // send the FIR output
@@ -0,0 +1,82 @@
+/*
+ * AudioFilterFreqWarpFIRBank_F32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include "AudioFilterFreqWarpFIRBank_F32.h"
+
+bool AudioFilterFreqWarpFIRBank_F32::setBands(const int _n_bands, const float *_crossover_Hz) {
+	if ((_n_bands < 1) || (_n_bands > FREQ_WARP_BANK_MAX_BANDS)) {
+		Serial.print("AudioFilterFreqWarpFIRBank_F32: *** WARNING ***: n_bands must be from 1 to "); Serial.println(FREQ_WARP_BANK_MAX_BANDS);
+		return false;
+	}
+	n_bands = _n_bands;
+	use_crossovers = (_crossover_Hz != NULL);
+	if (use_crossovers) for (int i = 0; i < n_bands - 1; i++) crossover_Hz[i] = _crossover_Hz[i];
+	return setup(sample_rate_Hz);
+}
+
+bool AudioFilterFreqWarpFIRBank_F32::setup(const float fs_Hz) {
+	__disable_irq();
+	bool ok = configure(fs_Hz);
+	__enable_irq();
+	if (!ok) {
+		Serial.print("AudioFilterFreqWarpFIRBank_F32: *** WARNING ***: Could not make "); Serial.print(n_bands);
+		Serial.print(" bands with "); Serial.print(n_taps); Serial.print(" taps at fs = "); Serial.println(sample_rate_Hz);
+	}
+	return ok;
+}
+
+//design the bands and clear the states.  The audio must not be running (or this is the audio).
+bool AudioFilterFreqWarpFIRBank_F32::configure(const float fs_Hz) {
+	if (fs_Hz > 0.0f) sample_rate_Hz = fs_Hz;
+	return bank.setup(sample_rate_Hz, n_bands, use_crossovers ? crossover_Hz : NULL, n_taps, rho);
+}
+
+void AudioFilterFreqWarpFIRBank_F32::update(void) {
+	audio_block_f32_t *block = AudioStream_F32::receiveReadOnly_f32();
+	if (!block) return;
+
+	//follow the sample rate of the audio, if it isn't what we were set up for
+	if ((block->fs_Hz > 0.0f) && (block->fs_Hz != sample_rate_Hz)) configure(block->fs_Hz);
+
+	const int n = bank.getNumBands();
+	audio_block_f32_t *out[FREQ_WARP_BANK_MAX_BANDS];
+	float *y[FREQ_WARP_BANK_MAX_BANDS];
+	for (int b = 0; b < n; b++) {
+		out[b] = AudioStream_F32::allocate_f32();
+		if (!out[b]) {
+			//release the ones that we did get, and skip this block
+			for (int j = 0; j < b; j++) AudioStream_F32::release(out[j]);
+			AudioStream_F32::release(block);
+			if (Serial) { Serial.print("AudioFilterFreqWarpFIRBank_F32: *** WARNING ***: could only allocate "); Serial.print(b); Serial.println(" output blocks."); }
+			return;
+		}
+		out[b]->length = block->length;  out[b]->fs_Hz = block->fs_Hz;  out[b]->id = block->id;
+		y[b] = out[b]->data;
+	}
+
+	bank.process(block->data, y, block->length);
+	AudioStream_F32::release(block);
+
+	for (int b = 0; b < n; b++) {
+		AudioStream_F32::transmit(out[b], b);
+		AudioStream_F32::release(out[b]);
+	}
+}
+
+void AudioFilterFreqWarpFIRBank_F32::printBands(Print *p) {
+	if (!p) return;
+	const int n = bank.getNumBands();
+	p->print("AudioFilterFreqWarpFIRBank_F32: "); p->print(n); p->print(" bands, "); p->print(bank.getNumTaps());
+	p->print(" taps, rho = "); p->println(bank.getRho(), 4);
+	for (int b = 0; b < n; b++) {
+		const float lo_Hz = (b > 0) ? bank.getCrossover_Hz(b - 1) : 0.0f;
+		const float hi_Hz = (b < n - 1) ? bank.getCrossover_Hz(b) : 0.5f * sample_rate_Hz;
+		p->print("  Band "); p->print(b); p->print(": "); p->print(lo_Hz, 0); p->print(" to "); p->print(hi_Hz, 0);
+		p->print(" Hz, delay "); p->print(getGroupDelay_msec(0.5f * (lo_Hz + hi_Hz)), 2); p->println(" msec");
+	}
+}
@@ -0,0 +1,72 @@
+/*
+ * AudioFilterFreqWarpFIRBank_F32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Splits the audio into bands (up to 16, one per output) with a frequency-warped FIR
+ *     filterbank, as in Kates, "Digital Hearing Aids", Chapter 8, for multiband compression with low
+ *     delay.  This is the filterbank of the WDRC_8BandFreqWarpFIR example, made into a library node:
+ *     the allpass chain is run once per sample for all of the bands, the bands are found together
+ *     (see utility/freq_warp_bank.h), and the bands are designed when set up, for any crossovers.
+ *
+ *     By default, there are 8 bands, equally wide on the warped (roughly Bark) scale, with 33 taps.
+ *     Or, give the crossover frequencies:
+ *         float crossover_Hz[] = { 500.f, 1000.f, 2000.f, 4000.f };
+ *         filterBank.setBands(5, crossover_Hz);
+ *     The bands add back up to the input, with a flat magnitude, and are -6 dB at each crossover.
+ *     More taps give sharper bands, and more delay: the delay is about (n_taps-1)/2 samples, times
+ *     what each allpass adds, which is more at low frequencies than at high ones (see
+ *     getGroupDelay_msec()).
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _AudioFilterFreqWarpFIRBank_F32_h
+#define _AudioFilterFreqWarpFIRBank_F32_h
+
+#include "Arduino.h"
+#include "AudioStream_F32.h"
+#include "utility/freq_warp_bank.h"
+
+#define FREQ_WARP_FIR_BANK_DEFAULT_BANDS 8
+#define FREQ_WARP_FIR_BANK_DEFAULT_TAPS 33
+
+class AudioFilterFreqWarpFIRBank_F32 : public AudioStream_F32
+{
+//GUI: inputs:1, outputs:16  //this line used for automatic generation of GUI node
+//GUI: shortName:freqWarpBank
+	public:
+		AudioFilterFreqWarpFIRBank_F32(void) : AudioStream_F32(1, inputQueueArray) { setup(AUDIO_SAMPLE_RATE_EXACT); }
+		AudioFilterFreqWarpFIRBank_F32(const AudioSettings_F32 &settings) : AudioStream_F32(1, inputQueueArray) { setup(settings.sample_rate_Hz); }
+
+		//n_bands bands, split at the n_bands-1 crossover frequencies (rising), or equally on the warped
+		//scale if crossover_Hz is NULL.  Each of these starts over.
+		bool setBands(const int n_bands, const float *crossover_Hz = NULL);
+		bool setNumTaps(const int n) { n_taps = n; return setup(sample_rate_Hz); }      //odd, up to FREQ_WARP_BANK_MAX_TAPS
+		bool setRho(const float r) { rho = r; return setup(sample_rate_Hz); }           //the warping (0 to 1).  Less than 0 fits the Bark scale (the default).
+		bool setSampleRate_Hz(const float fs_Hz) { return setup(fs_Hz); }
+
+		int getNumBands(void) { return bank.getNumBands(); }
+		int getNumTaps(void) { return bank.getNumTaps(); }
+		float getRho(void) { return bank.getRho(); }
+		float getCrossover_Hz(const int i) { return bank.getCrossover_Hz(i); }          //between band i and band i+1
+		float getResponse_dB(const int band, const float f_Hz) { return bank.getResponse_dB(band, f_Hz); }
+		float getGroupDelay_msec(const float f_Hz) { return 1000.0f * bank.getGroupDelay_samples(f_Hz) / sample_rate_Hz; }
+		void printBands(Print *p);
+
+		virtual void update(void);
+
+	protected:
+		audio_block_f32_t *inputQueueArray[1];
+		FreqWarpFilterBank bank;
+		float sample_rate_Hz = AUDIO_SAMPLE_RATE_EXACT;
+		int n_bands = FREQ_WARP_FIR_BANK_DEFAULT_BANDS, n_taps = FREQ_WARP_FIR_BANK_DEFAULT_TAPS;
+		float rho = -1.0f;
+		bool use_crossovers = false;
+		float crossover_Hz[FREQ_WARP_BANK_MAX_BANDS];
+
+		bool setup(const float fs_Hz);
+		bool configure(const float fs_Hz);
+};
+
+#endif
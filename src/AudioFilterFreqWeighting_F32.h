@@ -4,7 +4,7 @@
 
 #include "utility/FreqWeighting_IEC1672.h"
 
-//Frequency weighting.  Defaults to A-Weighting
+//Frequency weighting (A_WEIGHT, C_WEIGHT, or Z_WEIGHT), designed for the sample rate.  Defaults to A-Weighting
 class AudioFilterFreqWeighting_F32: public AudioFilterBiquad_F32 {
 	public:
 		AudioFilterFreqWeighting_F32(void): AudioFilterBiquad_F32() {
@@ -10,6 +10,14 @@
  *
  * Extended to AudioMixer8
  * By: Chip Audette, OpenAudio, Feb 2017
+ *
+ * Extended to AudioMixerN
+ * By: OpenAudio, Oct 2026
+ * Purpose: Any number of inputs (such as all 16 or 32 microphones of an array), as a template:
+ *    AudioMixerN_F32<16> mixer16;  AudioMixer4_F32 and AudioMixer8_F32 are now this template with
+ *    4 and 8 inputs.  Each input is multiplied and added straight into the output block in one pass,
+ *    with no temporary blocks.  Inputs whose gain is zero are skipped (their blocks are just released).
+ *    A gain can also be changed with a ramp, gain(channel, gain, ramp_msec), to avoid clicks.
  *          
  * MIT License.  use at your own risk.
 */
@@ -20,55 +28,130 @@
 #include <arm_math.h> 
 #include <AudioStream_F32.h>
 
-class AudioMixer4_F32 : public AudioStream_F32 {
-//GUI: inputs:4, outputs:1  //this line used for automatic generation of GUI node
-//GUI: shortName:Mixer4
+//(no GUI lines here: the GUI needs a fixed number of inputs, so its nodes are AudioMixer4_F32 and AudioMixer8_F32, below)
+template <int N>
+class AudioMixerN_F32 : public AudioStream_F32 {
 public:
-    AudioMixer4_F32() : AudioStream_F32(4, inputQueueArray) { setDefaultValues(); }
-	AudioMixer4_F32(const AudioSettings_F32 &settings) : AudioStream_F32(4, inputQueueArray) { setDefaultValues(); }
-	
+	AudioMixerN_F32() : AudioStream_F32(N, inputQueueArray) { setDefaultValues(); }
+	AudioMixerN_F32(const AudioSettings_F32 &settings) : AudioStream_F32(N, inputQueueArray) {
+		setDefaultValues();
+		setSampleRate_Hz(settings.sample_rate_Hz);
+	}
+
 	void setDefaultValues(void) {
-		for (int i=0; i<4; i++) multiplier[i] = 1.0;
+		for (int i=0; i<N; i++) { multiplier[i] = 1.0f; target[i] = 1.0f; ramp_left[i] = 0; }
+	}
+	void setSampleRate_Hz(float fs_Hz) { if (fs_Hz > 0.0f) sample_rate_Hz = fs_Hz; }
+
+	virtual void update(void);
+
+	//set the gain immediately
+	void gain(unsigned int channel, float gain) {
+		if (channel >= (unsigned int)N) return;
+		__disable_irq();
+		multiplier[channel] = gain;  target[channel] = gain;  ramp_left[channel] = 0;
+		__enable_irq();
+	}
+	//glide linearly to the new gain over ramp_msec
+	void gain(unsigned int channel, float gain, float ramp_msec) {
+		if (channel >= (unsigned int)N) return;
+		int n = (int)(ramp_msec * 0.001f * sample_rate_Hz + 0.5f);
+		if (n < 1) { this->gain(channel, gain); return; }
+		__disable_irq();
+		target[channel] = gain;  ramp_left[channel] = n;
+		ramp_step[channel] = (gain - multiplier[channel]) / n;
+		__enable_irq();
 	}
-	
-    virtual void update(void);
-
-    void gain(unsigned int channel, float gain) {
-      if (channel >= 4 || channel < 0) return;
-      multiplier[channel] = gain;
-    }
-	void mute(void) { for (int i=0; i < 4; i++) gain(i,0.0); };  //mute all channels
+	float getGain(unsigned int channel) { return (channel < (unsigned int)N) ? target[channel] : 0.0f; }
+	void mute(void) { for (int i=0; i < N; i++) gain(i,0.0); };  //mute all channels
 	void switchChannel(unsigned int channel) { mute(); gain(channel,1.0); } //mute all channels except the given one.  Set the given one to 1.0.
 
-  private:
-    audio_block_f32_t *inputQueueArray[4];
-    float multiplier[4];
+protected:
+	audio_block_f32_t *inputQueueArray[N];
+	float multiplier[N];   //present gain
+	float target[N];       //gain at the end of any ramp
+	float ramp_step[N];    //change in gain per sample, while ramping
+	int ramp_left[N];      //samples left in the ramp
+	float sample_rate_Hz = AUDIO_SAMPLE_RATE_EXACT;
+
+	//out = g*in (first input used) or out += g*in (the rest), with g ramping if need be
+	void mixIn(float *out, const float *in, int n, int channel, bool first);
 };
 
-class AudioMixer8_F32 : public AudioStream_F32 {
-//GUI: inputs:8, outputs:1  //this line used for automatic generation of GUI node
-//GUI: shortName:Mixer8
-public:
-    AudioMixer8_F32() : AudioStream_F32(8, inputQueueArray) { setDefaultValues();}
-    AudioMixer8_F32(const AudioSettings_F32 &settings) : AudioStream_F32(8, inputQueueArray) { setDefaultValues();}
-	
-	void setDefaultValues(void) {
-      for (int i=0; i<8; i++) multiplier[i] = 1.0;
-    }
+template <int N>
+void AudioMixerN_F32<N>::mixIn(float *out, const float *in, int n, int channel, bool first) {
+	int i = 0;
+	if (ramp_left[channel] > 0) {
+		float g = multiplier[channel];
+		const float dg = ramp_step[channel];
+		const int n_ramp = (ramp_left[channel] < n) ? ramp_left[channel] : n;
+		if (first) { for ( ; i < n_ramp; i++) { g += dg; out[i] = g * in[i]; } }
+		else       { for ( ; i < n_ramp; i++) { g += dg; out[i] += g * in[i]; } }
+		ramp_left[channel] -= n_ramp;
+		multiplier[channel] = (ramp_left[channel] > 0) ? g : target[channel];  //land exactly on the target
+	}
+	const float g = multiplier[channel];
+	if (first) { for ( ; i < n; i++) out[i] = g * in[i]; }
+	else       { for ( ; i < n; i++) out[i] += g * in[i]; }   //a fused multiply-add per sample
+}
 
-    virtual void update(void);
+template <int N>
+void AudioMixerN_F32<N>::update(void) {
+	audio_block_f32_t *out = NULL;
+	bool any_input = false;
 
-    void gain(unsigned int channel, float gain) {
-      if (channel >= 8 || channel < 0) return;
-      multiplier[channel] = gain;
-    }
-	void mute(void) { for (int i=0; i < 8; i++) gain(i,0.0); };  //mute all channels
-	void switchChannel(unsigned int channel) { mute(); gain(channel,1.0); } //mute all channels except the given one.  Set the given one to 1.0.
+	for (int channel = 0; channel < N; channel++) {
+		audio_block_f32_t *in = receiveReadOnly_f32(channel);
+		if (!in) {
+			if (ramp_left[channel] > 0) { multiplier[channel] = target[channel]; ramp_left[channel] = 0; }  //nothing to ramp
+			continue;
+		}
+		any_input = true;
+
+		//skip inputs that are (and will stay) silent
+		if ((multiplier[channel] == 0.0f) && (ramp_left[channel] == 0)) {
+			AudioStream_F32::release(in);
+			continue;
+		}
+
+		bool first = false;
+		if (!out) {
+			out = allocate_f32();
+			if (!out) { AudioStream_F32::release(in); return; }
+			out->length = in->length;
+			out->fs_Hz = in->fs_Hz;
+			out->id = in->id;
+			first = true;
+		}
+		const int n = (in->length < out->length) ? in->length : out->length;
+		mixIn(out->data, in->data, n, channel, first);
+		AudioStream_F32::release(in);
+	}
+
+	if (!out) {
+		if (!any_input) return;  //there was no data available.  so exit.
+		out = allocate_f32();    //every input was muted, so send silence
+		if (!out) return;
+		arm_fill_f32(0.0f, out->data, out->length);
+	}
+	AudioStream_F32::transmit(out);
+	AudioStream_F32::release(out);
+}
 
+class AudioMixer4_F32 : public AudioMixerN_F32<4> {
+//GUI: inputs:4, outputs:1  //this line used for automatic generation of GUI node
+//GUI: shortName:Mixer4
+public:
+	AudioMixer4_F32() : AudioMixerN_F32<4>() { }
+	AudioMixer4_F32(const AudioSettings_F32 &settings) : AudioMixerN_F32<4>(settings) { }
+};
 
-  private:
-    audio_block_f32_t *inputQueueArray[8];
-    float multiplier[8];
+class AudioMixer8_F32 : public AudioMixerN_F32<8> {
+//GUI: inputs:8, outputs:1  //this line used for automatic generation of GUI node
+//GUI: shortName:Mixer8
+public:
+	AudioMixer8_F32() : AudioMixerN_F32<8>() { }
+	AudioMixer8_F32(const AudioSettings_F32 &settings) : AudioMixerN_F32<8>(settings) { }
 };
 
-#endif
\ No newline at end of file
+#endif
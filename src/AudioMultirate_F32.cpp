@@ -0,0 +1,146 @@
+#include "AudioMultirate_F32.h"
+
+//Hamming-windowed sinc low-pass, with its cutoff at fc (as a fraction of the sample rate) and a DC gain of "gain"
+static void designLowpass(float32_t *h, const int n, const float fc, const float gain) {
+	const float center = 0.5f * (n - 1);
+	float sum = 0.0f;
+	for (int k = 0; k < n; k++) {
+		float t = k - center;
+		float sinc = (fabsf(t) < 1.0e-6f) ? 2.0f * fc : sinf(2.0f * M_PI * fc * t) / (M_PI * t);
+		float win = (n > 1) ? (0.54f - 0.46f * cosf(2.0f * M_PI * k / (n - 1))) : 1.0f;
+		h[k] = sinc * win;
+		sum += h[k];
+	}
+	for (int k = 0; k < n; k++) h[k] *= gain / sum;
+}
+
+//the filter length for a given factor, rounded to a multiple of the factor (needed by the interpolator)
+static int defaultNumTaps(const int factor) {
+	int n = MULTIRATE_F32_TAPS_PER_FACTOR * factor;
+	if (n > MULTIRATE_F32_MAX_TAPS) n = (MULTIRATE_F32_MAX_TAPS / factor) * factor;
+	return n;
+}
+
+// ///////////////////////////////////////////////////////// Decimate
+
+bool AudioDecimate_F32::setFactor(const int _factor, int _n_taps) {
+	if ((_factor < 1) || (_factor > MULTIRATE_F32_MAX_FACTOR)) return false;
+	if (_n_taps <= 0) _n_taps = defaultNumTaps(_factor);
+	if (_n_taps > MULTIRATE_F32_MAX_TAPS) return false;
+	designLowpass(coeff, _n_taps, 0.8f * 0.5f / _factor, 1.0f);
+	return begin(coeff, _n_taps, _factor);
+}
+
+bool AudioDecimate_F32::begin(const float32_t *_coeff, const int _n_taps, const int _factor) {
+	if ((_factor < 1) || (_factor > MULTIRATE_F32_MAX_FACTOR) || (_n_taps < 1) || (_n_taps > MULTIRATE_F32_MAX_TAPS)) return false;
+	if (_coeff != coeff) for (int k = 0; k < _n_taps; k++) coeff[k] = _coeff[k];
+
+	__disable_irq();
+	factor = _factor;
+	n_taps = _n_taps;
+	warned = false;
+	//the block size here is only checked (and a multiple of the factor is fine); update() gives the real length
+	arm_fir_decimate_init_f32(&fir_inst, n_taps, factor, coeff, state, factor);
+	__enable_irq();
+	return true;
+}
+
+void AudioDecimate_F32::update(void) {
+	audio_block_f32_t *in_block = AudioStream_F32::receiveReadOnly_f32();
+	if (!in_block) return;
+
+	if (factor == 1) {
+		AudioStream_F32::transmit(in_block);
+		AudioStream_F32::release(in_block);
+		return;
+	}
+
+	//check format
+	if ((in_block->length % factor) != 0) {
+		if (!warned) {
+			Serial.print("AudioDecimate_F32: *** WARNING ***: Block length ("); Serial.print(in_block->length);
+			Serial.print(") is not a multiple of the factor ("); Serial.print(factor); Serial.println(").  Dropping data.");
+			warned = true;
+		}
+		AudioStream_F32::release(in_block);
+		return;
+	}
+
+	audio_block_f32_t *out_block = AudioStream_F32::allocate_f32();
+	if (!out_block) {
+		AudioStream_F32::release(in_block);
+		return;
+	}
+
+	//filter and keep every factor'th sample, in one step
+	arm_fir_decimate_f32(&fir_inst, in_block->data, out_block->data, in_block->length);
+	out_block->length = in_block->length / factor;
+	out_block->fs_Hz = in_block->fs_Hz / factor;
+	out_block->id = in_block->id;
+
+	AudioStream_F32::transmit(out_block);
+	AudioStream_F32::release(out_block);
+	AudioStream_F32::release(in_block);
+}
+
+// ///////////////////////////////////////////////////////// Interpolate
+
+bool AudioInterpolate_F32::setFactor(const int _factor, int _n_taps) {
+	if ((_factor < 1) || (_factor > MULTIRATE_F32_MAX_FACTOR)) return false;
+	if (_n_taps <= 0) _n_taps = defaultNumTaps(_factor);
+	if ((_n_taps > MULTIRATE_F32_MAX_TAPS) || ((_n_taps % _factor) != 0)) return false;
+	designLowpass(coeff, _n_taps, 0.8f * 0.5f / _factor, (float)_factor);
+	return begin(coeff, _n_taps, _factor);
+}
+
+bool AudioInterpolate_F32::begin(const float32_t *_coeff, const int _n_taps, const int _factor) {
+	if ((_factor < 1) || (_factor > MULTIRATE_F32_MAX_FACTOR) || (_n_taps < 1) || (_n_taps > MULTIRATE_F32_MAX_TAPS)) return false;
+	if ((_n_taps % _factor) != 0) return false;
+	if (_coeff != coeff) for (int k = 0; k < _n_taps; k++) coeff[k] = _coeff[k];
+
+	__disable_irq();
+	factor = _factor;
+	n_taps = _n_taps;
+	warned = false;
+	if (factor > 1) arm_fir_interpolate_init_f32(&fir_inst, factor, n_taps, coeff, state, AUDIO_BLOCK_SAMPLES / factor);
+	__enable_irq();
+	return true;
+}
+
+void AudioInterpolate_F32::update(void) {
+	audio_block_f32_t *in_block = AudioStream_F32::receiveReadOnly_f32();
+	if (!in_block) return;
+
+	if (factor == 1) {
+		AudioStream_F32::transmit(in_block);
+		AudioStream_F32::release(in_block);
+		return;
+	}
+
+	//check format
+	if (in_block->length * factor > AUDIO_BLOCK_SAMPLES) {
+		if (!warned) {
+			Serial.print("AudioInterpolate_F32: *** WARNING ***: Block length ("); Serial.print(in_block->length);
+			Serial.print(") times the factor ("); Serial.print(factor); Serial.println(") won't fit in a block.  Dropping data.");
+			warned = true;
+		}
+		AudioStream_F32::release(in_block);
+		return;
+	}
+
+	audio_block_f32_t *out_block = AudioStream_F32::allocate_f32();
+	if (!out_block) {
+		AudioStream_F32::release(in_block);
+		return;
+	}
+
+	//insert zeros between the samples and filter, in one step
+	arm_fir_interpolate_f32(&fir_inst, in_block->data, out_block->data, in_block->length);
+	out_block->length = in_block->length * factor;
+	out_block->fs_Hz = in_block->fs_Hz * factor;
+	out_block->id = in_block->id;
+
+	AudioStream_F32::transmit(out_block);
+	AudioStream_F32::release(out_block);
+	AudioStream_F32::release(in_block);
+}
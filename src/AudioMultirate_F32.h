@@ -0,0 +1,99 @@
+/*
+ * AudioMultirate
+ * 
+ * AudioDecimate_F32 and AudioInterpolate_F32
+ * Created: OpenAudio, Oct 2026
+ * Purpose: Change the sample rate by an integer factor inside the audio graph, so that part of the
+ *     processing (such as the low-frequency bands of a multiband WDRC) can run at 1/2, 1/4, or 1/8
+ *     of the full rate.  Both use polyphase FIR filters (from the ARM DSP library), which only compute
+ *     the samples that are kept, so their cost is a small fraction of a full-rate FIR of the same length.
+ *
+ *     The block rate doesn't change; the blocks get shorter.  With 128-sample blocks, decimating by 4 gives
+ *     one 32-sample block per update.  Each block's length and fs_Hz are set to match, so the nodes
+ *     downstream (envelopes, WDRC, FIR filters, etc) see the new rate.  An AudioInterpolate_F32 with
+ *     the same factor brings the audio back to the full rate and the full block length.
+ *
+ *     Typical use, for a low band:
+ *         input -> AudioDecimate_F32(settings,4) -> [band filter, WDRC at 1/4 rate] -> AudioInterpolate_F32(settings,4) -> mixer
+ *
+ *     The anti-aliasing (decimate) and anti-imaging (interpolate) filters are designed for you (a
+ *     Hamming-windowed sinc with 12 taps per unit of the factor).  Each is flat to half of the new Nyquist
+ *     frequency, is down 6 dB at 0.8 of it, and rejects anything that would alias by more than 50 dB.
+ *     Or, give your own coefficients with begin().  Each filter delays the audio by getGroupDelay_samples()
+ *     at the full rate, so other paths that get mixed back in may need a matching delay.
+ *
+ *     The decimator needs each block's length to be a multiple of the factor.  The interpolator needs
+ *     each block's length times the factor to fit in one block (AUDIO_BLOCK_SAMPLES).  Allocate the memory
+ *     with AudioMemory_F32(num, settings) so that new blocks start out at your sample rate and block size.
+ *          
+ * MIT License.  use at your own risk.
+*/
+
+#ifndef _AudioMultirate_F32_h
+#define _AudioMultirate_F32_h
+
+#include <arm_math.h>
+#include <AudioStream_F32.h>
+
+#define MULTIRATE_F32_MAX_FACTOR 16
+#define MULTIRATE_F32_MAX_TAPS 192
+#define MULTIRATE_F32_TAPS_PER_FACTOR 12
+
+class AudioDecimate_F32 : public AudioStream_F32 {
+//GUI: inputs:1, outputs:1  //this line used for automatic generation of GUI node
+//GUI: shortName:Decimate
+  public:
+	AudioDecimate_F32(void) : AudioStream_F32(1, inputQueueArray) { setFactor(2); }
+	AudioDecimate_F32(const AudioSettings_F32 &settings) : AudioStream_F32(1, inputQueueArray) { setFactor(2); }
+	AudioDecimate_F32(const AudioSettings_F32 &settings, const int factor) : AudioStream_F32(1, inputQueueArray) { setFactor(factor); }
+
+	//choose the decimation factor and design the anti-aliasing filter (n_taps = 0 picks the length for you)
+	bool setFactor(const int factor, const int n_taps = 0);
+	//or use your own filter, designed for the input sample rate
+	bool begin(const float32_t *coeff, const int n_taps, const int factor);
+
+	int getFactor(void) { return factor; }
+	int getNumTaps(void) { return n_taps; }
+	float getGroupDelay_samples(void) { return 0.5f * (n_taps - 1); }  //at the input (full) rate
+
+	virtual void update(void);
+
+  private:
+	audio_block_f32_t *inputQueueArray[1];
+	int factor = 1, n_taps = 1;
+	bool warned = false;
+	float32_t coeff[MULTIRATE_F32_MAX_TAPS];
+	float32_t state[MULTIRATE_F32_MAX_TAPS + AUDIO_BLOCK_SAMPLES - 1];
+	arm_fir_decimate_instance_f32 fir_inst;
+};
+
+class AudioInterpolate_F32 : public AudioStream_F32 {
+//GUI: inputs:1, outputs:1  //this line used for automatic generation of GUI node
+//GUI: shortName:Interpolate
+  public:
+	AudioInterpolate_F32(void) : AudioStream_F32(1, inputQueueArray) { setFactor(2); }
+	AudioInterpolate_F32(const AudioSettings_F32 &settings) : AudioStream_F32(1, inputQueueArray) { setFactor(2); }
+	AudioInterpolate_F32(const AudioSettings_F32 &settings, const int factor) : AudioStream_F32(1, inputQueueArray) { setFactor(factor); }
+
+	//choose the interpolation factor and design the anti-imaging filter (n_taps = 0 picks the length for you)
+	bool setFactor(const int factor, const int n_taps = 0);
+	//or use your own filter, designed for the output sample rate.  n_taps must be a multiple of the factor, and
+	//the filter's gain must be the factor (to make up for the zeros that are inserted between the samples).
+	bool begin(const float32_t *coeff, const int n_taps, const int factor);
+
+	int getFactor(void) { return factor; }
+	int getNumTaps(void) { return n_taps; }
+	float getGroupDelay_samples(void) { return 0.5f * (n_taps - 1); }  //at the output (full) rate
+
+	virtual void update(void);
+
+  private:
+	audio_block_f32_t *inputQueueArray[1];
+	int factor = 1, n_taps = 1;
+	bool warned = false;
+	float32_t coeff[MULTIRATE_F32_MAX_TAPS];
+	float32_t state[MULTIRATE_F32_MAX_TAPS / 2 + AUDIO_BLOCK_SAMPLES - 1];  //factor is at least 2
+	arm_fir_interpolate_instance_f32 fir_inst;
+};
+
+#endif
@@ -0,0 +1,46 @@
+#include "AudioResampleAsync_F32.h"
+
+static const float32_t zerodata[AUDIO_BLOCK_SAMPLES] = {0};
+
+bool AudioResampleAsync_F32::setup(const float _input_rate_Hz, const float _output_rate_Hz, const int block_size, const int n_chan, const AudioResampleAsync::Mode mode) {
+	input_rate_Hz = _input_rate_Hz;
+	output_rate_Hz = _output_rate_Hz;
+	return resampler.configure(input_rate_Hz, output_rate_Hz, block_size, n_chan, mode);
+}
+
+void AudioResampleAsync_F32::update(void) {
+	const int n_chan = resampler.getNumChannels();
+	audio_block_f32_t *in[2], *out[2] = {NULL, NULL};
+
+	//queue up whatever has arrived (a missing channel is filled with silence)
+	in[0] = AudioStream_F32::receiveReadOnly_f32(0);
+	in[1] = AudioStream_F32::receiveReadOnly_f32(1);
+	if (in[0] || ((n_chan > 1) && in[1])) {
+		int len = (in[0]) ? in[0]->length : in[1]->length;
+		const float32_t *p_in[2];
+		for (int Ichan = 0; Ichan < n_chan; Ichan++) p_in[Ichan] = (in[Ichan]) ? in[Ichan]->data : zerodata;
+		resampler.push(p_in, len);
+	}
+	if (in[0]) AudioStream_F32::release(in[0]);
+	if (in[1]) AudioStream_F32::release(in[1]);
+
+	//make one block per channel, at the graph's rate
+	for (int Ichan = 0; Ichan < n_chan; Ichan++) {
+		out[Ichan] = AudioStream_F32::allocate_f32();
+		if (!out[Ichan]) {
+			for (int j = 0; j < Ichan; j++) AudioStream_F32::release(out[j]);
+			return;
+		}
+	}
+	float32_t *p_out[2] = { out[0]->data, (n_chan > 1) ? out[1]->data : NULL };
+	resampler.pull(p_out);
+
+	update_counter++;
+	for (int Ichan = 0; Ichan < n_chan; Ichan++) {
+		out[Ichan]->length = resampler.getBlockOut();
+		out[Ichan]->fs_Hz = output_rate_Hz;
+		out[Ichan]->id = update_counter;
+		AudioStream_F32::transmit(out[Ichan], Ichan);
+		AudioStream_F32::release(out[Ichan]);
+	}
+}
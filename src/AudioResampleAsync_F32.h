@@ -0,0 +1,76 @@
+/*
+ * AudioResampleAsync_F32
+ * 
+ * Created: OpenAudio, Oct 2026
+ * Purpose: Bridge audio from another clock domain (such as USB audio, which runs on the PC's clock) into
+ *     the audio graph, which runs on the I2S clock.  Whatever blocks arrive are queued up, and exactly one
+ *     block per channel goes out every update, resampled from the input's rate to the graph's rate.  The
+ *     ratio is trimmed continuously to follow the drift between the two clocks, so the queue never runs
+ *     dry or overflows, however long the stream runs.  See utility/resample_async.h for the details.
+ *
+ *     The input rate is the producer's nominal rate (such as 44100 or 48000 Hz for USB).  The output rate
+ *     is the graph's (such as 44117.647 or 24000 Hz from setI2SFreq()).  Blocks may arrive in bursts or
+ *     not at all on some updates; the controller averages that out.  Until the queue first fills (about
+ *     1.5 blocks) and after any underrun, the output is silent.
+ *
+ *     Use AudioResampleAsync::CHEAP for a 4-point cubic interpolator instead of the polyphase FIR.  It is
+ *     about 5x cheaper and is plenty for speech-band audio at hearing-aid sample rates.
+ *
+ * Handles 1 or 2 channels (as chosen in the constructor), which are resampled in lockstep.
+ *          
+ * MIT License.  use at your own risk.
+*/
+
+#ifndef _AudioResampleAsync_F32_h
+#define _AudioResampleAsync_F32_h
+
+#include <arm_math.h>
+#include <AudioStream_F32.h>
+#include "utility/resample_async.h"
+
+class AudioResampleAsync_F32 : public AudioStream_F32
+{
+  //GUI: inputs:2, outputs:2  //this line used for automatic generation of GUI node
+  public:
+    AudioResampleAsync_F32(void) : AudioStream_F32(2, inputQueueArray_f32) {
+		setup(AUDIO_SAMPLE_RATE, AUDIO_SAMPLE_RATE, AUDIO_BLOCK_SAMPLES, 2, AudioResampleAsync::QUALITY);
+	};
+	AudioResampleAsync_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray_f32) {
+		setup(settings.sample_rate_Hz, settings.sample_rate_Hz, settings.audio_block_samples, 2, AudioResampleAsync::QUALITY);
+	};
+	AudioResampleAsync_F32(const AudioSettings_F32 &settings, const float input_rate_Hz, const int n_chan = 2,
+			const AudioResampleAsync::Mode mode = AudioResampleAsync::QUALITY) : AudioStream_F32(2, inputQueueArray_f32) {
+		setup(input_rate_Hz, settings.sample_rate_Hz, settings.audio_block_samples, n_chan, mode);
+	};
+
+	//change the rates or the mode.  This restarts the resampler.  Returns false if the ratio is out of range.
+	bool setup(const float input_rate_Hz, const float output_rate_Hz, const int block_size, const int n_chan, const AudioResampleAsync::Mode mode);
+	bool setInputSampleRate_Hz(const float input_rate_Hz) {
+		return setup(input_rate_Hz, output_rate_Hz, resampler.getBlockOut(), resampler.getNumChannels(), resampler.getMode());
+	}
+	bool setMode(const AudioResampleAsync::Mode mode) {
+		return setup(input_rate_Hz, output_rate_Hz, resampler.getBlockOut(), resampler.getNumChannels(), mode);
+	}
+
+    void update(void);
+
+	//status and tuning.  See utility/resample_async.h
+	float getCorrection_ppm(void) { return resampler.getCorrection_ppm(); }  //the measured drift between the clocks
+	float getRatio(void) { return resampler.getRatio(); }
+	float getQueueFill_samples(void) { return resampler.getFill(); }
+	void setTargetFill_samples(float samples) { resampler.setTargetFill(samples); }
+	void setLoopBandwidth_Hz(float bw_Hz) { resampler.setLoopBandwidth_Hz(bw_Hz); }
+	bool isLocked(void) { return resampler.isLocked(); }
+	unsigned long getUnderrunCount(void) { return resampler.getUnderrunCount(); }
+	unsigned long getOverrunCount(void) { return resampler.getOverrunCount(); }
+	void resetCounts(void) { resampler.resetCounts(); }
+
+	AudioResampleAsync resampler;
+	
+  private:
+    audio_block_f32_t *inputQueueArray_f32[2];
+	float input_rate_Hz, output_rate_Hz;
+	unsigned long update_counter = 0;
+};
+
+#endif
@@ -0,0 +1,164 @@
+
+#include "AudioSDPlayer_F32.h"
+#include "utility/convert_f32.h"
+
+#define I24_TO_F32_NORM_FACTOR (1.192093037616377e-07f)   //which is 1/(2^23 - 1)
+
+void AudioSDPlayer_F32::prepareSDforPlayback(void) {
+  if (current_SD_state == STATE::UNPREPARED) {
+	if (buffSDReader) buffSDReader->init();
+	current_SD_state = STATE::STOPPED;
+  }
+}
+
+int AudioSDPlayer_F32::play(const char* fname) {
+  //check to see if the SD has been initialized
+  if (current_SD_state == STATE::UNPREPARED) prepareSDforPlayback();
+  stop();
+  if (!buffSDReader) return -1;
+
+  if (!buffSDReader->openWAV(fname)) {
+	if (serial_ptr) { serial_ptr->print("AudioSDPlayer: play: Failed to open "); serial_ptr->println(fname); }
+	return -1;
+  }
+  if (buffSDReader->getNumChannels() > AUDIOSDPLAYER_MAX_FILE_CHAN) {
+	if (serial_ptr) { serial_ptr->print("AudioSDPlayer: play: too many channels in "); serial_ptr->println(fname); }
+	buffSDReader->close();
+	return -1;
+  }
+
+  if (serial_ptr) {
+	serial_ptr->print("AudioSDPlayer: Opened "); serial_ptr->print(fname);
+	serial_ptr->print(", chan = "); serial_ptr->print(buffSDReader->getNumChannels());
+	serial_ptr->print(", fs_Hz = "); serial_ptr->println(buffSDReader->getSampleRate_Hz());
+	float fs_file = buffSDReader->getSampleRate_Hz();
+	if (fabsf(fs_file - sample_rate_Hz) > 0.01f*sample_rate_Hz) {
+	  serial_ptr->print("AudioSDPlayer: *** WARNING ***: file sample rate does not match audio system (");
+	  serial_ptr->print(sample_rate_Hz); serial_ptr->println(" Hz).  Audio will play at the wrong speed.");
+	}
+  }
+
+  position_samples = 0;
+  current_SD_state = STATE::PLAYING;
+  return 0;
+}
+
+void AudioSDPlayer_F32::stop(void) {
+  if (current_SD_state != STATE::UNPREPARED) current_SD_state = STATE::STOPPED;  //set this first so that update() stops pulling from the buffer
+
+  //close the file (it might still be open if update() reached the end of the file on its own)
+  if (buffSDReader && buffSDReader->isFileOpen()) buffSDReader->close();
+}
+
+bool AudioSDPlayer_F32::seekToSample(uint32_t sample) {
+  if (!buffSDReader) return false;
+  if ((current_SD_state != STATE::PLAYING) && (current_SD_state != STATE::PAUSED)) return false;
+  STATE prev_state = current_SD_state;
+  current_SD_state = STATE::PAUSED; //keep update() out of the buffer while we move things around
+  sample = min(sample, buffSDReader->getLengthFrames());
+  bool ret_val = buffSDReader->seekToFrame(sample);
+  position_samples = sample;
+  current_SD_state = prev_state;
+  return ret_val;
+}
+
+//update is called by the Audio processing ISR.  This update function should
+//only decode audio from the memory buffer.  The actual SD reading should occur
+//in the loop() as invoked by serviceSD()
+void AudioSDPlayer_F32::update(void) {
+  if (current_SD_state != STATE::PLAYING) return;
+  if (!buffSDReader) return;
+
+  //get the output audio blocks
+  const int nout = min(4, buffSDReader->getNumChannels());
+  if (nout <= 0) return;
+  audio_block_f32_t *blocks[4] = {};
+  for (int Ichan = 0; Ichan < nout; Ichan++) {
+	blocks[Ichan] = AudioStream_F32::allocate_f32();
+	if (!blocks[Ichan]) {
+	  for (int J = 0; J < Ichan; J++) AudioStream_F32::release(blocks[J]);
+	  return;
+	}
+  }
+  const int nsamps = blocks[0]->length;
+
+  //pull whole frames out of the read-ahead buffer
+  const uint32_t bytesPerFrame = buffSDReader->getBytesPerFrame();
+  uint32_t nbytes = min(buffSDReader->bytesAvailable(), nsamps * bytesPerFrame);
+  nbytes -= (nbytes % bytesPerFrame);
+  nbytes = buffSDReader->readFromBuffer((uint8_t *)scratch, nbytes);
+  const int nframes = nbytes / bytesPerFrame;
+
+  //decode and de-interleave
+  decodeToBlocks((const uint8_t *)scratch, nframes, blocks, nout);
+  for (int Ichan = 0; Ichan < nout; Ichan++) {
+	for (int i = nframes; i < nsamps; i++) blocks[Ichan]->data[i] = 0.0f;  //pad any shortfall with silence
+  }
+  position_samples += nframes;
+
+  //did we run out of data?
+  if (nframes < nsamps) {
+	if (buffSDReader->isEndOfData() && (buffSDReader->bytesAvailable() == 0)) {
+	  current_SD_state = STATE::STOPPED;  //reached the end of the file.  The loop() will see this and can close the file.
+	} else {
+	  underrun_count++;  //serviceSD() isn't keeping up
+	}
+  }
+  if (buffSDReader->getLooping() && (position_samples >= buffSDReader->getLengthFrames())) {
+	position_samples -= buffSDReader->getLengthFrames();
+  }
+
+  //transmit the audio and release
+  block_counter++;
+  for (int Ichan = 0; Ichan < nout; Ichan++) {
+	blocks[Ichan]->id = block_counter;
+	AudioStream_F32::transmit(blocks[Ichan], Ichan);
+	AudioStream_F32::release(blocks[Ichan]);
+  }
+}
+
+void AudioSDPlayer_F32::decodeToBlocks(const uint8_t *raw, const int nframes, audio_block_f32_t *blocks[], const int nout) {
+  const int nchan = buffSDReader->getNumChannels();
+
+  switch (buffSDReader->getSampleFormat()) {
+	case BufferedSDReader::SampleFormat::INT16:
+	  if (nchan <= 4) {
+		float32_t *ptr_audio[4];
+		for (int Ichan = 0; Ichan < nchan; Ichan++) ptr_audio[Ichan] = blocks[Ichan]->data;
+		deinterleave_i16_to_f32((const int16_t *)raw, ptr_audio, nframes, nchan);  //fast versions for 1, 2, and 4 channels
+	  } else {
+		const int16_t *p_i16 = (const int16_t *)raw;
+		for (int Ichan = 0; Ichan < nout; Ichan++) {
+		  float32_t *out = blocks[Ichan]->data;
+		  for (int i = 0; i < nframes; i++) out[i] = ((float32_t)p_i16[i*nchan + Ichan]) * I16_TO_F32_SCALE;
+		}
+	  }
+	  break;
+
+	case BufferedSDReader::SampleFormat::INT24:
+	  for (int Ichan = 0; Ichan < nout; Ichan++) {
+		float32_t *out = blocks[Ichan]->data;
+		const uint8_t *p = raw + 3*Ichan;
+		for (int i = 0; i < nframes; i++) {
+		  int32_t val = (int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24)) >> 8; //little-endian, sign-extended
+		  out[i] = ((float32_t)val) * I24_TO_F32_NORM_FACTOR;
+		  p += 3*nchan;
+		}
+	  }
+	  break;
+
+	case BufferedSDReader::SampleFormat::FLOAT32: {
+	  const float32_t *p_f32 = (const float32_t *)raw;
+	  for (int Ichan = 0; Ichan < nout; Ichan++) {
+		float32_t *out = blocks[Ichan]->data;
+		for (int i = 0; i < nframes; i++) out[i] = p_f32[i*nchan + Ichan];
+	  }
+	  break;
+	}
+
+	default:
+	  for (int Ichan = 0; Ichan < nout; Ichan++) {
+		for (int i = 0; i < nframes; i++) blocks[Ichan]->data[i] = 0.0f;
+	  }
+  }
+}
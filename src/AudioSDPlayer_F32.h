@@ -0,0 +1,120 @@
+/*
+ * AudioSDPlayer_F32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Play WAV files from the SD card into the Tympan/OpenAudio/Teensy audio
+ *   processing paradigm.  This is the playback counterpart to AudioSDWriter_F32, so it
+ *   is handy for re-playing field recordings through an algorithm in a repeatable way.
+ *
+ *   Supports WAV files with int16, int24, or float32 samples and any number of channels.
+ *   The first four channels of the file come out of the four outputs of this block.
+ *
+ *   Like AudioSDWriter_F32, the SD card is only touched from the loop(): you must call
+ *   serviceSD() regularly so that the read-ahead buffer stays full.  The update()
+ *   (called in the audio ISR) only decodes from the memory buffer.
+
+   MIT License.  Use at your own risk.
+*/
+
+#ifndef _AudioSDPlayer_F32_h
+#define _AudioSDPlayer_F32_h
+
+#include "SDReader.h"
+#include "AudioSettings_F32.h"
+#include "AudioStream_F32.h"
+
+#define AUDIOSDPLAYER_MAX_FILE_CHAN 8  //most channels that can be in the WAV file (only the first 4 are output)
+
+class AudioSDPlayer_F32 : public AudioStream_F32 {
+  //GUI: inputs:0, outputs:4 //this line used for automatic generation of GUI node
+  public:
+    AudioSDPlayer_F32(void) : AudioStream_F32(0, NULL) { setup(); }
+    AudioSDPlayer_F32(const AudioSettings_F32 &settings) : AudioStream_F32(0, NULL) {
+      setup();
+      sample_rate_Hz = settings.sample_rate_Hz;
+    }
+    AudioSDPlayer_F32(const AudioSettings_F32 &settings, Print* _serial_ptr) : AudioStream_F32(0, NULL) {
+      setup(_serial_ptr);
+      sample_rate_Hz = settings.sample_rate_Hz;
+    }
+    ~AudioSDPlayer_F32(void) {
+      stop();
+      delete buffSDReader;
+    }
+
+    enum class STATE { UNPREPARED = -1, STOPPED, PLAYING, PAUSED };
+    STATE getState(void) { return current_SD_state; };
+
+    void setup(void) { setup(&Serial); }
+    void setup(Print *_serial_ptr) {
+      setSerial(_serial_ptr);
+      if (!buffSDReader) buffSDReader = new BufferedSDReader(_serial_ptr);
+    }
+    void setSerial(Print *_serial_ptr) {
+      serial_ptr = _serial_ptr;
+      if (buffSDReader) buffSDReader->setSerial(_serial_ptr);
+    }
+
+    //if you want to set the read-ahead buffer size yourself, call this method before calling play()
+    int allocateBuffer(const int nBytes) {
+      if (buffSDReader) return buffSDReader->allocateBuffer(nBytes);
+      return 0;
+    }
+
+    void prepareSDforPlayback(void);  //you can call this explicitly, or play() will call it automatically
+    int play(const char* fname);      //open the file and start playing from the beginning
+    void stop(void);                  //stop playing and close the file
+    void pause(void) { if (current_SD_state == STATE::PLAYING) current_SD_state = STATE::PAUSED; }
+    void resume(void) { if (current_SD_state == STATE::PAUSED) current_SD_state = STATE::PLAYING; }
+    bool isPlaying(void) { return (current_SD_state == STATE::PLAYING); }
+
+    //jump to a new place in the file.  Call from the loop()
+    bool seekToSample(uint32_t sample);
+    bool seekToTime_sec(float t_sec) { return seekToSample((uint32_t)(max(0.0f, t_sec) * getFileSampleRate_Hz())); }
+
+    //start back at the beginning whenever the end of the file is reached
+    bool setLooping(bool flag) { if (buffSDReader) return buffSDReader->setLooping(flag); return false; }
+    bool getLooping(void) { if (buffSDReader) return buffSDReader->getLooping(); return false; }
+
+    //In the loop(), the user must call serviceSD regularly so that the system will actually
+    //read the audio from the SD.  If you don't call this routine, the buffer will run dry
+    //and the output will go silent.
+    int serviceSD(void) {
+      if ((current_SD_state == STATE::PLAYING) || (current_SD_state == STATE::PAUSED)) {
+        if (buffSDReader) return buffSDReader->fillBuffer();
+      }
+      return 0;
+    }
+
+    //update is called by the Audio processing ISR.  It only decodes data that
+    //serviceSD() has already put into the memory buffer.
+    virtual void update(void);
+
+    //info about the file that is playing
+    int getNumChannels(void) { if (buffSDReader) return buffSDReader->getNumChannels(); return 0; }
+    float getFileSampleRate_Hz(void) { if (buffSDReader) return buffSDReader->getSampleRate_Hz(); return 0.0f; }
+    uint32_t getLengthSamples(void) { if (buffSDReader) return buffSDReader->getLengthFrames(); return 0; }
+    uint32_t getPositionSamples(void) { return position_samples; }
+    float getPosition_sec(void) { return ((float)position_samples) / max(1.0f, getFileSampleRate_Hz()); }
+
+    //how many times did update() find the buffer empty before the end of the file?
+    unsigned long getUnderrunCount(void) { return underrun_count; }
+    void resetUnderrunCount(void) { underrun_count = 0; }
+
+  protected:
+    STATE current_SD_state = STATE::UNPREPARED;
+    BufferedSDReader *buffSDReader = 0;
+    Print *serial_ptr = &Serial;
+    float sample_rate_Hz = AUDIO_SAMPLE_RATE;
+    volatile uint32_t position_samples = 0;
+    volatile unsigned long underrun_count = 0;
+    unsigned long block_counter = 0;
+
+    //linear working memory for one audio block worth of raw bytes from the file
+    uint32_t scratch[AUDIO_BLOCK_SAMPLES * AUDIOSDPLAYER_MAX_FILE_CHAN];  //uint32 so that float32 data is aligned
+
+    void decodeToBlocks(const uint8_t *raw, const int nframes, audio_block_f32_t *blocks[], const int nout);
+};
+
+#endif
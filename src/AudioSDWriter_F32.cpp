@@ -55,6 +55,7 @@ int AudioSDWriter_F32::startRecording(char* fname) {
 	  //start the queues.  Then, in the serviceSD, the fact that the queues
 	  //are getting full will begin the writing
 	  buffSDWriter->resetBuffer();
+	  for (int Ichan = 0; Ichan < 4; Ichan++) last_audio_block_id[Ichan] = 0; //don't count the pause between recordings as a gap
 	  current_SD_state = STATE::RECORDING;
 	  setStartTimeMillis();
 	  
@@ -106,7 +107,6 @@ void AudioSDWriter_F32::update(void) {
 }
 
 void AudioSDWriter_F32::copyAudioToWriteBuffer(audio_block_f32_t *audio_blocks[], const int numChan) {
-  static unsigned long last_audio_block_id[4];
   if (numChan == 0) return;
   
   //do any of the given audio blocks actually contain data
@@ -122,13 +122,15 @@ void AudioSDWriter_F32::copyAudioToWriteBuffer(audio_block_f32_t *audio_blocks[]
   if (any_data < numChan) { // do we have all the channels?  If not, send error?
     Serial.print("AudioSDWriter: copyToWriteBuffer: only got "); Serial.print(any_data);
     Serial.print(" of ");  Serial.print(numChan);  Serial.println(" channels.");
+	if (buffSDWriter) buffSDWriter->countDroppedBlock();
 	return;
   }
 
-  //check to see if there have been any jumps in the data counters
+  //check to see if there have been any jumps in the data counters.  Count them (for getSDStats) and complain.
   for (int Ichan = 0; Ichan < numChan; Ichan++) {
 	if (audio_blocks[Ichan] != NULL) {
 	  if (((audio_blocks[Ichan]->id - last_audio_block_id[Ichan]) != 1) && (last_audio_block_id[Ichan] != 0)) {
+		if ((Ichan == 0) && buffSDWriter) buffSDWriter->countBlockIdGap(audio_blocks[Ichan]->id - last_audio_block_id[Ichan] - 1); //all channels skip together, so only count the first
 		Serial.print("AudioSDWriter: chan "); Serial.print(Ichan);
 		Serial.print(", data skip? This ID = "); Serial.print(audio_blocks[Ichan]->id);
 		Serial.print(", Previous ID = "); Serial.println(last_audio_block_id[Ichan]);
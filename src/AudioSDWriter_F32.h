@@ -179,6 +179,16 @@ class AudioSDWriter_F32 : public AudioSDWriter, public AudioStream_F32 {
       return false;
     }
 
+    //SD write timing, buffer fill, and lost-data counters.  See SDWriterStats in SDWriter.h.
+    //Safe to call from the loop() while recording.
+    bool getSDStats(SDWriterStats *stats) {
+      if (buffSDWriter) { buffSDWriter->getStats(stats); return true; }
+      return false;
+    }
+    void printSDStats(void) { printSDStats(serial_ptr); }
+    void printSDStats(Print *p) { if (buffSDWriter) buffSDWriter->printStats(p); }
+    void resetSDStats(void) { if (buffSDWriter) buffSDWriter->resetStats(); }
+
 	
   unsigned long getStartTimeMillis(void) { return t_start_millis; };
   unsigned long setStartTimeMillis(void) { return t_start_millis = millis(); };
@@ -188,6 +198,7 @@ class AudioSDWriter_F32 : public AudioSDWriter, public AudioStream_F32 {
     BufferedSDWriter *buffSDWriter = 0;
     Print *serial_ptr = &Serial;
     unsigned long t_start_millis = 0;
+    unsigned long last_audio_block_id[4] = {};  //for spotting skipped audio blocks
 
     bool openAsWAV(char *fname) {
       if (buffSDWriter) return buffSDWriter->openAsWAV(fname);
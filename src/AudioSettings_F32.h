@@ -1,4 +1,3 @@
-
 #ifndef _AudioSettings_F32_
 #define _AudioSettings_F32_
 
@@ -6,13 +5,25 @@ class AudioSettings_F32 {
 	public:
 		AudioSettings_F32(float fs_Hz, int block_size) :
 			sample_rate_Hz(fs_Hz), audio_block_samples(block_size) {}
+
+		//Optionally, choose how the I2S DMA is buffered.  The DMA ring holds num_periods periods of
+		//period_samples each (0 is one audio block), with one interrupt per period, independent of the
+		//audio block size.  Longer periods mean fewer interrupts but more latency.  If the ring isn't
+		//possible, or by default, the I2S uses its original double buffer.  The ring also needs the library
+		//built with -DI2S_DMA_RING_MAX_FRAMES (see output_i2s_f32.h).  See utility/dma_ring.h
+		AudioSettings_F32(float fs_Hz, int block_size, int period_samples, int num_periods) :
+			sample_rate_Hz(fs_Hz), audio_block_samples(block_size),
+			dma_period_samples(period_samples), dma_num_periods(num_periods) {}
+
 		const float sample_rate_Hz;
 		const int audio_block_samples;
-		
+		const int dma_period_samples = 0;
+		const int dma_num_periods = 2;
+
 		float cpu_load_percent(const int n);
 		float processorUsage(void);
 		float processorUsageMax(void);
 		void processorUsageMaxReset(void);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -6,6 +6,8 @@ uint32_t AudioStream_F32::f32_memory_pool_available_mask[6];
 
 uint8_t AudioStream_F32::f32_memory_used = 0;
 uint8_t AudioStream_F32::f32_memory_used_max = 0;
+int AudioStream_F32::f32_default_length = AUDIO_BLOCK_SAMPLES;
+float AudioStream_F32::f32_default_fs_Hz = AUDIO_SAMPLE_RATE;
 
 audio_block_f32_t* allocate_f32_memory(const int num) {
 	static bool firstTime=true;
@@ -51,6 +53,8 @@ void AudioStream_F32::initialize_f32_memory(audio_block_f32_t *data, unsigned in
 void AudioStream_F32::initialize_f32_memory(audio_block_f32_t *data, unsigned int num, const AudioSettings_F32 &settings)
 {
  initialize_f32_memory(data,num);
+ f32_default_length = settings.audio_block_samples;
+ f32_default_fs_Hz = settings.sample_rate_Hz;
  for (unsigned int i=0; i < num; i++) {
 	 data[i].fs_Hz = settings.sample_rate_Hz;
 	 data[i].length = settings.audio_block_samples;
@@ -87,6 +91,8 @@ audio_block_f32_t * AudioStream_F32::allocate_f32(void)
   index = p - f32_memory_pool_available_mask;
   block = f32_memory_pool + ((index << 5) + (31 - n));
   block->ref_count = 1;
+  block->length = f32_default_length;
+  block->fs_Hz = f32_default_fs_Hz;
   if (used > f32_memory_used_max) f32_memory_used_max = used;
   //Serial.print("alloc_f32:");
   //Serial.println((uint32_t)block, HEX);
@@ -163,7 +169,10 @@ audio_block_f32_t * AudioStream_F32::receiveWritable_f32(unsigned int index)
   inputQueue_f32[index] = NULL;
   if (in && in->ref_count > 1) {
     p = allocate_f32();
-    if (p) memcpy(p->data, in->data, sizeof(p->data));
+    if (p) {
+      memcpy(p->data, in->data, sizeof(p->data));
+      p->length = in->length;  p->fs_Hz = in->fs_Hz;  p->id = in->id;  //keep its own length and rate (it may be decimated)
+    }
     in->ref_count--;
     in = p;
   }
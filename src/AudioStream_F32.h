@@ -87,6 +87,8 @@ class AudioStream_F32 : public AudioStream {
     //virtual void update(audio_block_f32_t *) = 0; 
     static uint8_t f32_memory_used;
     static uint8_t f32_memory_used_max;
+    static int f32_default_length;     //every newly allocated block starts with this length and sample rate,
+    static float f32_default_fs_Hz;    //no matter what a decimator or interpolator last did with it
     static audio_block_f32_t * allocate_f32(void);
     static void release(audio_block_f32_t * block);
     
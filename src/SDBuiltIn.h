@@ -0,0 +1,34 @@
+/*
+ * SDBuiltIn.h
+ *
+ * Created: OpenAudio, Oct 2026
+ * Purpose: The Teensy's built-in SD slot, as one file system shared by SDWriter and BufferedSDReader,
+ *    so that the card is only started once and there is only one FAT cache to keep in step.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _SDBuiltIn_h
+#define _SDBuiltIn_h
+
+#include "SdFat_Gre_FatLib/FatLibConfig.h"
+#if !ENABLE_HOST_BLOCK_DRIVER   //on a PC, there is no built-in SD
+#include <SdFat_Gre.h>
+#include <Print.h>
+
+//the one instance, made on first use
+inline SdFatSdioEX* getBuiltInSD(void) {
+  static SdFatSdioEX sdio;  //faster than SdFatSdio
+  return &sdio;
+}
+
+//start the built-in SD, unless someone already has.  If it won't start, print msg and halt.
+inline void beginBuiltInSD(Print *serial_ptr, const char *msg) {
+  static bool started = false;
+  if (started) return;
+  if (!getBuiltInSD()->begin()) getBuiltInSD()->errorHalt(serial_ptr, msg);
+  started = true;
+}
+#endif
+
+#endif
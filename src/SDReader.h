@@ -0,0 +1,270 @@
+/*
+ * SDReader.h containing BufferedSDReader
+ *
+ * Created: OpenAudio, Oct 2026
+ * Purpose: This class is the playback counterpart of BufferedSDWriter (see SDWriter.h).
+ *    It (1) opens a WAV file and parses its header, (2) reads the audio data from the
+ *    SD card in large, 512B-aligned chunks, and (3) keeps those bytes in a big
+ *    read-ahead memory buffer so that the occasional slow SD read does not starve the
+ *    audio processing.
+ *
+ *    Reading is done from the loop() via fillBuffer().  Because each read starts on a
+ *    512B boundary and is a whole number of 512B blocks, SdFat_Gre's FatFile::read()
+ *    hands the transfer straight to SdioCardEX::readBlocks() as one multi-block read
+ *    into our buffer, without going through the single-block cache.
+ *
+ *    The audio ISR pulls bytes out via readFromBuffer().  The loop() only ever advances
+ *    the fill counter and the ISR only ever advances the consumed counter, so no locking
+ *    is needed between the two.
+ *
+ *    By default, this reads from the Teensy's built-in SD slot, which it shares with SDWriter
+ *    (see SDBuiltIn.h).  To read from somewhere else, give it a FatFileSystem that you have
+ *    already started with begin(BlockDriver *).
+ *
+ *    For a wrapper that works directly with the Tympan/OpenAudio library, see the class
+ *    AudioSDPlayer_F32 in AudioSDPlayer_F32.h
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _SDReader_h
+#define _SDReader_h
+
+#include <arm_math.h>        //for float32_t definition
+#include "SdFat_Gre_FatLib/FatLibConfig.h"
+#if ENABLE_HOST_BLOCK_DRIVER
+#include "SdFat_Gre_BlockDriver.h"    //FileImageDriver, for running on a desktop PC
+#include "SdFat_Gre_FatLib/FatLib.h"
+#else
+#include <SdFat_Gre.h>       //originally from https://github.com/greiman/SdFat  but class names have been modified to prevent collisions with Teensy Audio/SD libraries
+#include "SDBuiltIn.h"       //the built-in SD slot, shared with SDWriter
+#endif
+#include <Print.h>
+
+//set some constants
+#define maxReadBufferLengthBytes 65536      //largest allowed read-ahead buffer.  Must be a power of two.
+const int DEFAULT_SDREAD_BUFFER_BYTES = 32768; //default read-ahead buffer.  Must be a power of two.  At 44.1kHz stereo int16, this is ~185 msec of audio
+const int DEFAULT_SDREAD_BYTES = 8*512;        //largest single read from the SD card.  Keep it a multiple of 512B.
+
+class BufferedSDReader
+{
+  public:
+    enum class SampleFormat { UNKNOWN = 0, INT16, INT24, FLOAT32 };
+
+    BufferedSDReader() {};
+    BufferedSDReader(Print* _serial_ptr) { setSerial(_serial_ptr); };
+    BufferedSDReader(FatFileSystem *_fs, Print* _serial_ptr) {
+      setFileSystem(_fs);
+      setSerial(_serial_ptr);
+    };
+    virtual ~BufferedSDReader() {
+      close();
+      delete[] read_buffer;
+    }
+
+    void setup(void) { init(); }
+    virtual void init() {
+      #if !ENABLE_HOST_BLOCK_DRIVER
+      if (sd == getBuiltInSD()) { beginBuiltInSD(serial_ptr, "BufferedSDReader: begin failed"); return; }
+      #endif
+      if ((sd == NULL) || (!sd->vwd()->isOpen())) serial_ptr->println("BufferedSDReader: *** WARNING ***: the file system has not been started.");
+    }
+
+    //read from this file system instead of the built-in SD slot.  Call before init() and openWAV().
+    void setFileSystem(FatFileSystem *_fs) { sd = _fs; }
+    FatFileSystem* getFileSystem(void) { return sd; }
+
+    //allocate the read-ahead buffer.  The size is rounded down to a power of two.
+    int allocateBuffer(const int _nBytes = DEFAULT_SDREAD_BUFFER_BYTES) {
+      uint32_t maxBytes = (uint32_t)min(_nBytes, maxReadBufferLengthBytes);
+      uint32_t nBytes = 1024;
+      while (2*nBytes <= maxBytes) nBytes *= 2;
+      delete[] read_buffer;
+      read_buffer = new uint8_t[nBytes];
+      bufferLengthBytes = (read_buffer) ? nBytes : 0;
+      resetBuffer();
+      return (int)bufferLengthBytes;
+    }
+    void resetBuffer(void) { bytesFilled = 0; bytesConsumed = 0; }
+    int getBufferLengthBytes(void) { return (int)bufferLengthBytes; }
+
+    //largest single read from the SD card (in the loop).  Bigger is more efficient, but blocks the loop() for longer.
+    void setReadSizeBytes(const int n) { maxReadBytes = max(512, 512*(n / 512)); }
+    int getReadSizeBytes(void) { return maxReadBytes; }
+
+    //open a WAV file and position it at the start of the audio data
+    bool openWAV(const char *fname) {
+      close();
+      if ((sd == NULL) || !file.open(sd->vwd(), fname, O_READ)) {
+        if (serial_ptr) { serial_ptr->print("BufferedSDReader: cannot open "); serial_ptr->println(fname); }
+        return false;
+      }
+      if (!parseWAVHeader()) {
+        if (serial_ptr) { serial_ptr->print("BufferedSDReader: unsupported WAV file "); serial_ptr->println(fname); }
+        close();
+        return false;
+      }
+      if (!read_buffer) { if (!allocateBuffer()) { close(); return false; } }
+      return seekToFrame(0);
+    }
+
+    void close(void) {
+      if (file.isOpen()) file.close();
+      flag_endOfData = true;
+      resetBuffer();
+    }
+    bool isFileOpen(void) { return file.isOpen(); }
+
+    //Move to the given audio frame (one frame is one sample of every channel).  Call from the loop(), not the ISR.
+    bool seekToFrame(uint32_t frame) {
+      if (!file.isOpen() || (bytesPerFrame == 0)) return false;
+      uint32_t pos = dataStartByte + min(frame, getLengthFrames()) * bytesPerFrame;
+      __disable_irq();
+      bytesConsumed = bytesFilled;  //discard anything that was buffered
+      flag_endOfData = (pos >= dataEndByte);
+      __enable_irq();
+      bool ret_val = file.seekSet(pos);
+      fillBuffer();  //prime the buffer right away
+      return ret_val;
+    }
+
+    //when the end of the audio data is reached, start again from the beginning?
+    bool setLooping(bool flag) { return flag_loop = flag; }
+    bool getLooping(void) { return flag_loop; }
+
+    //Read more data from the SD card, if there is room in the buffer.  Call this regularly from the loop().
+    //Returns the number of bytes read (or -1 if something is wrong)
+    int fillBuffer(void) {
+      if (!read_buffer || !file.isOpen()) return -1;
+      if (flag_endOfData) {
+        if (!flag_loop) return 0;
+        if (!file.seekSet(dataStartByte)) return -1;  //loop back to the start of the audio data
+        flag_endOfData = false;
+      }
+
+      //how much room is there, without wrapping around the end of the buffer?
+      uint32_t writeInd = bytesFilled & (bufferLengthBytes - 1);
+      uint32_t nBytes = bufferLengthBytes - (bytesFilled - bytesConsumed);
+      nBytes = min(nBytes, bufferLengthBytes - writeInd);
+      nBytes = min(nBytes, (uint32_t)maxReadBytes);
+
+      //don't read past the audio data (there might be other chunks after it)
+      uint32_t pos = file.curPosition();
+      if (pos >= dataEndByte) { flag_endOfData = true; return 0; }
+      nBytes = min(nBytes, dataEndByte - pos);
+
+      //keep the file position on 512B boundaries so that SdFat can do multi-block reads
+      if (pos & 0x1FF) {
+        nBytes = min(nBytes, 512 - (pos & 0x1FF));
+      } else if (nBytes >= 512) {
+        nBytes &= ~((uint32_t)0x1FF);
+      }
+      if (nBytes == 0) return 0;
+
+      int nRead = file.read(read_buffer + writeInd, nBytes);
+      if (nRead <= 0) { flag_endOfData = true; return nRead; }
+      bytesFilled += nRead;   //only now does the ISR get to see the new data
+      if (file.curPosition() >= dataEndByte) flag_endOfData = true;
+      return nRead;
+    }
+
+    //How many bytes are waiting in the buffer?  Safe to call from the ISR
+    uint32_t bytesAvailable(void) { return bytesFilled - bytesConsumed; }
+
+    //Pull bytes out of the buffer.  This is what the audio ISR should call.  Returns the number of bytes copied.
+    uint32_t readFromBuffer(uint8_t *dest, uint32_t nBytes) {
+      if (!read_buffer) return 0;
+      nBytes = min(nBytes, bytesAvailable());
+      uint32_t readInd = bytesConsumed & (bufferLengthBytes - 1);
+      uint32_t n1 = min(nBytes, bufferLengthBytes - readInd);
+      memcpy(dest, read_buffer + readInd, n1);
+      if (nBytes > n1) memcpy(dest + n1, read_buffer, nBytes - n1);  //wrap around
+      bytesConsumed += nBytes;
+      return nBytes;
+    }
+
+    //true when the file has been fully read into the buffer (the buffer itself might still hold data)
+    bool isEndOfData(void) { return (flag_endOfData && !flag_loop); }
+
+    //info about the file's audio format
+    SampleFormat getSampleFormat(void) { return sampleFormat; }
+    int getNumChannels(void) { return WAV_nchan; }
+    float getSampleRate_Hz(void) { return WAV_sampleRate_Hz; }
+    int getBytesPerSample(void) { return bytesPerSample; }
+    int getBytesPerFrame(void) { return bytesPerFrame; }
+    uint32_t getLengthFrames(void) { return (bytesPerFrame) ? ((dataEndByte - dataStartByte) / bytesPerFrame) : 0; }
+
+    virtual void setSerial(Print *ptr) { serial_ptr = ptr; }
+    virtual Print* getSerial(void) { return serial_ptr; }
+
+  protected:
+    #if ENABLE_HOST_BLOCK_DRIVER
+    FatFileSystem *sd = NULL;  //on a PC, there is no built-in SD, so one must be given
+    FatFile file;
+    #else
+    FatFileSystem *sd = getBuiltInSD();  //the built-in SD slot, unless another file system is given
+    SdFile_Gre file;
+    #endif
+    Print* serial_ptr = &Serial;
+
+    uint8_t *read_buffer = NULL;
+    uint32_t bufferLengthBytes = 0;
+    volatile uint32_t bytesFilled = 0;    //total bytes put into the buffer.  Only advanced by fillBuffer()
+    volatile uint32_t bytesConsumed = 0;  //total bytes taken from the buffer.  Only advanced by readFromBuffer()
+    int maxReadBytes = DEFAULT_SDREAD_BYTES;
+    volatile bool flag_endOfData = true;
+    bool flag_loop = false;
+
+    SampleFormat sampleFormat = SampleFormat::UNKNOWN;
+    int WAV_nchan = 0;
+    float WAV_sampleRate_Hz = 0.0;
+    int bytesPerSample = 0;
+    int bytesPerFrame = 0;
+    uint32_t dataStartByte = 0;
+    uint32_t dataEndByte = 0;
+
+    static uint16_t read_le16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+    static uint32_t read_le32(const uint8_t *p) { return ((uint32_t)p[0]) | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+    //walk the RIFF chunks to find "fmt " and "data".  Supports PCM int16, PCM int24, and IEEE float32.
+    bool parseWAVHeader(void) {
+      uint8_t buf[40];
+      bool foundFormat = false;
+      sampleFormat = SampleFormat::UNKNOWN;  bytesPerFrame = 0;
+
+      if (!file.seekSet(0)) return false;
+      if (file.read(buf, 12) != 12) return false;
+      if ((memcmp(buf, "RIFF", 4) != 0) || (memcmp(buf + 8, "WAVE", 4) != 0)) return false;
+
+      while (file.read(buf, 8) == 8) {
+        uint32_t chunkSize = read_le32(buf + 4);
+        uint32_t chunkStart = file.curPosition();
+        if (memcmp(buf, "fmt ", 4) == 0) {
+          int nRead = file.read(buf, min(chunkSize, (uint32_t)sizeof(buf)));
+          if (nRead < 16) return false;
+          uint16_t formatCode = read_le16(buf);
+          if ((formatCode == 0xFFFE) && (nRead >= 26)) formatCode = read_le16(buf + 24); //WAVE_FORMAT_EXTENSIBLE: use the sub-format
+          WAV_nchan = read_le16(buf + 2);
+          WAV_sampleRate_Hz = (float)read_le32(buf + 4);
+          int nbits = read_le16(buf + 14);
+          if ((formatCode == 1) && (nbits == 16)) sampleFormat = SampleFormat::INT16;
+          if ((formatCode == 1) && (nbits == 24)) sampleFormat = SampleFormat::INT24;
+          if ((formatCode == 3) && (nbits == 32)) sampleFormat = SampleFormat::FLOAT32;
+          bytesPerSample = nbits / 8;
+          bytesPerFrame = WAV_nchan * bytesPerSample;
+          foundFormat = (sampleFormat != SampleFormat::UNKNOWN) && (WAV_nchan > 0);
+        } else if (memcmp(buf, "data", 4) == 0) {
+          dataStartByte = chunkStart;
+          dataEndByte = chunkStart + chunkSize;
+          //a recording that was never closed properly will say zero (or too many) bytes.  Use the file size instead.
+          if ((chunkSize == 0) || (dataEndByte > file.fileSize())) dataEndByte = file.fileSize();
+          if (bytesPerFrame > 0) dataEndByte -= (dataEndByte - dataStartByte) % bytesPerFrame; //whole frames only
+          return foundFormat;
+        }
+        if (!file.seekSet(chunkStart + chunkSize + (chunkSize & 1))) return false;  //chunks are padded to an even length
+      }
+      return false;
+    }
+};
+
+#endif
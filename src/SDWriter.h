@@ -21,13 +21,35 @@
 #define _SDWriter_h
 
 #include <arm_math.h>        //possibly only used for float32_t definition?
+#include "SdFat_Gre_FatLib/FatLibConfig.h"
+#if ENABLE_HOST_BLOCK_DRIVER
+#include "SdFat_Gre_BlockDriver.h"    //FileImageDriver, for running on a desktop PC.  See extras/host/sd_writer_sim.cpp
+#include "SdFat_Gre_FatLib/FatLib.h"
+#else
 #include <SdFat_Gre.h>       //originally from https://github.com/greiman/SdFat  but class names have been modified to prevent collisions with Teensy Audio/SD libraries
+#include "SDBuiltIn.h"       //the built-in SD slot, shared with BufferedSDReader
+#endif
 #include <Print.h>
+#include "utility/convert_f32.h"  //for interleave_f32_to_i16()
 
 //set some constants
 #define maxBufferLengthBytes 150000    //size of big memroy buffer to smooth out slow SD write operations
 const int DEFAULT_SDWRITE_BYTES = 512; //target size for individual writes to the SD card.  Usually 512
 //const uint64_t PRE_ALLOCATE_SIZE = 40ULL << 20;// Preallocate 40MB file.  Not used.
+#define SDWRITER_LATENCY_NBINS 12      //bins of the SD write-time histogram.  Bin k holds writes shorter than (256 << k) usec.  The last bin holds everything longer.
+
+//Snapshot of the BufferedSDWriter telemetry.  Use it to size the buffer (allocateBuffer) and to
+//compare SD cards: the buffer must hold at least as much audio as arrives during the slowest write.
+typedef struct {
+  uint32_t nWrites;                                    //number of SD write calls timed
+  uint32_t writeLatencyHist[SDWRITER_LATENCY_NBINS];   //histogram of SD write times (see SDWRITER_LATENCY_NBINS)
+  uint32_t maxWriteLatency_usec;                       //slowest single SD write
+  uint32_t peakBufferFill_bytes;                       //most data ever waiting in the buffer
+  uint32_t bufferLength_bytes;                         //size of the buffer
+  uint32_t droppedBlocks;                              //audio blocks lost (buffer overrun or missing channels)
+  uint32_t blockIdGaps;                                //times the audio block ID did not increment by one
+  uint32_t missingBlockIds;                            //total audio blocks skipped, as judged by the block IDs
+} SDWriterStats;
 
 //SDWriter:  This is a class to write blocks of bytes, chars, ints or floats to
 //  the SD card.  It will write blocks of data of whatever the size, even if it is not
@@ -39,6 +61,10 @@ const int DEFAULT_SDWRITE_BYTES = 512; //target size for individual writes to th
 //  desired write type (float32 -> int16) and to handle buffering so that the optimal
 //  number of bytes are written at once, use one of the derived classes such as
 //  BufferedSDWriter
+//
+//  By default, this class writes to the Teensy's built-in SD slot.  To write somewhere else
+//  (another card, or a disk image on a PC), give it a FatFileSystem that you have already
+//  started with begin(BlockDriver *).
 class SDWriter : public Print
 {
   public:
@@ -46,15 +72,26 @@ class SDWriter : public Print
     SDWriter(Print* _serial_ptr) {
       setSerial(_serial_ptr);
     };
+    SDWriter(FatFileSystem *_fs, Print* _serial_ptr) {
+      setFileSystem(_fs);
+      setSerial(_serial_ptr);
+    };
     virtual ~SDWriter() {
       if (isFileOpen()) close();
     }
 
     void setup(void) { init(); }
     virtual void init() {
-      if (!sd.begin()) sd.errorHalt(serial_ptr, "SDWriter: begin failed");
+      #if !ENABLE_HOST_BLOCK_DRIVER
+      if (sd == getBuiltInSD()) { beginBuiltInSD(serial_ptr, "SDWriter: begin failed"); return; }
+      #endif
+      if ((sd == NULL) || (!sd->vwd()->isOpen())) serial_ptr->println("SDWriter: *** WARNING ***: the file system has not been started.");
     }
 
+    //write to this file system instead of the built-in SD slot.  Call before init() and open().
+    void setFileSystem(FatFileSystem *_fs) { sd = _fs; }
+    FatFileSystem* getFileSystem(void) { return sd; }
+
     bool openAsWAV(char *fname) {
       bool returnVal = open(fname);
       if (isFileOpen()) { //true if file is open
@@ -65,12 +102,13 @@ class SDWriter : public Print
     }
 
     bool open(char *fname) {
-      if (sd.exists(fname)) {  //maybe this isn't necessary when using the O_TRUNC flag below
+      if (sd == NULL) return false;
+      if (sd->exists(fname)) {  //maybe this isn't necessary when using the O_TRUNC flag below
         // The SD library writes new data to the end of the file, so to start
         //a new recording, the old file must be deleted before new data is written.
-        sd.remove(fname);
+        sd->remove(fname);
       }
-      file.open(fname, O_RDWR | O_CREAT | O_TRUNC);
+      file.open(sd->vwd(), fname, O_RDWR | O_CREAT | O_TRUNC);
       //file.createContiguous(fname, PRE_ALLOCATE_SIZE); //alternative to the line above
       return isFileOpen();
     }
@@ -179,9 +217,13 @@ class SDWriter : public Print
     }
     
   protected:
-    //SdFatSdio sd; //slower
-    SdFatSdioEX sd; //faster
+    #if ENABLE_HOST_BLOCK_DRIVER
+    FatFileSystem *sd = NULL;  //on a PC, there is no built-in SD, so one must be given
+    FatFile file;
+    #else
+    FatFileSystem *sd = getBuiltInSD();  //the built-in SD slot, unless another file system is given
     SdFile_Gre file;
+    #endif
     boolean flagPrintElapsedWriteTime = false;
     elapsedMicros usec;
     Print* serial_ptr = &Serial;
@@ -214,6 +256,9 @@ class BufferedSDWriter : public SDWriter
     BufferedSDWriter(Print* _serial_ptr, const int _writeSizeBytes) : SDWriter(_serial_ptr) {
       setWriteSizeBytes(_writeSizeBytes);
     };
+    BufferedSDWriter(FatFileSystem *_fs, Print* _serial_ptr, const int _writeSizeBytes = DEFAULT_SDWRITE_BYTES) : SDWriter(_fs, _serial_ptr) {
+      setWriteSizeBytes(_writeSizeBytes);
+    };
     ~BufferedSDWriter(void) {
       delete ptr_zeros;
       delete write_buffer;
@@ -236,20 +281,65 @@ class BufferedSDWriter : public SDWriter
       if (write_buffer != 0) delete write_buffer;  //delete the old buffer
       write_buffer = new int16_t[bufferLengthSamples];
       resetBuffer();
-      return (int)write_buffer;
+      return (write_buffer) ? bufferLengthSamples * nBytesPerSample : 0;  //bytes allocated
     }
     void resetBuffer(void) { bufferReadInd = 0; bufferWriteInd = 0;  }
+
+    //Telemetry.  The loop() owns the write-time counters and the audio ISR owns the buffer
+    //counters, so each counter has only one writer and no locking is needed.  A reset from
+    //the loop() is passed to the ISR as a request that it acknowledges on its next call.
+    void getStats(SDWriterStats *stats) {
+      volatile SDWriterStats *s = &sdStats;  //each field is a single 32-bit read, so no locking needed
+      stats->nWrites = s->nWrites;
+      for (int i = 0; i < SDWRITER_LATENCY_NBINS; i++) stats->writeLatencyHist[i] = s->writeLatencyHist[i];
+      stats->maxWriteLatency_usec = s->maxWriteLatency_usec;
+      bool resetPending = (statsResetRequest != statsResetAck); //the ISR has not yet cleared its counters
+      stats->peakBufferFill_bytes = resetPending ? 0 : s->peakBufferFill_bytes;
+      stats->droppedBlocks = resetPending ? 0 : s->droppedBlocks;
+      stats->blockIdGaps = resetPending ? 0 : s->blockIdGaps;
+      stats->missingBlockIds = resetPending ? 0 : s->missingBlockIds;
+      stats->bufferLength_bytes = bufferLengthSamples * nBytesPerSample;
+    }
+    void resetStats(void) {
+      for (int i = 0; i < SDWRITER_LATENCY_NBINS; i++) sdStats.writeLatencyHist[i] = 0;
+      sdStats.nWrites = 0; sdStats.maxWriteLatency_usec = 0;
+      statsResetRequest++;  //the ISR side clears its counters when it sees this
+    }
+    void printStats(Print *p) {
+      if (!p) return;
+      SDWriterStats stats;
+      getStats(&stats);
+      p->print("BufferedSDWriter: writes = "); p->print(stats.nWrites);
+      p->print(", max write = "); p->print(stats.maxWriteLatency_usec); p->println(" usec");
+      p->print("  write time histogram (usec): ");
+      for (int i = 0; i < SDWRITER_LATENCY_NBINS; i++) {
+        if (i < SDWRITER_LATENCY_NBINS-1) { p->print("<"); p->print(getLatencyBinEdge_usec(i)); }
+        else { p->print(">="); p->print(getLatencyBinEdge_usec(i-1)); }
+        p->print(":"); p->print(stats.writeLatencyHist[i]); p->print(" ");
+      }
+      p->println();
+      p->print("  peak buffer fill = "); p->print(stats.peakBufferFill_bytes);
+      p->print(" of "); p->print(stats.bufferLength_bytes); p->println(" bytes");
+      p->print("  dropped blocks = "); p->print(stats.droppedBlocks);
+      p->print(", block ID gaps = "); p->print(stats.blockIdGaps);
+      p->print(" (missing "); p->print(stats.missingBlockIds); p->println(" blocks)");
+    }
+    static uint32_t getLatencyBinEdge_usec(int bin) { return ((uint32_t)256) << bin; } //upper edge of bin
+
+    //The audio ISR reports lost data and block-ID jumps here
+    void countDroppedBlock(void) { checkStatsReset(); sdStats.droppedBlocks++; }
+    void countBlockIdGap(uint32_t nMissing) { checkStatsReset(); sdStats.blockIdGaps++; sdStats.missingBlockIds += nMissing; }
  
     //here is how you send data to this class.  this doesn't write any data, it just stores data
     virtual void copyToWriteBuffer(float32_t *ptr_audio[], const int nsamps, const int numChan) {
-      if (!write_buffer) {if (!allocateBuffer()) return; }; //try to allocate buffer, return if it doesn't work
+      if (!write_buffer) {if (!allocateBuffer()) { countDroppedBlock(); return; } }; //try to allocate buffer, return if it doesn't work
 
       //how much data will we write?
       int estFinalWriteInd = bufferWriteInd + (numChan * nsamps);
 
       //will we pass by the read index?
       bool flag_moveReadIndexToEndOfWrite = false;
-      if ((bufferWriteInd < bufferReadInd) && (estFinalWriteInd > bufferReadInd)) {
+      if ((bufferWriteInd < bufferReadInd) && (estFinalWriteInd >= bufferReadInd)) {
         Serial.println("BufferedSDWriter_I16: WARNING: writing past the read index.");
         flag_moveReadIndexToEndOfWrite = true;
       }
@@ -262,7 +352,7 @@ class BufferedSDWriter : public SDWriter
 
         //recheck to see if we're going to pass by the read buffer index
         estFinalWriteInd = bufferWriteInd + (numChan * nsamps);
-        if ((bufferWriteInd < bufferReadInd) && (estFinalWriteInd > bufferReadInd)) {
+        if ((bufferWriteInd < bufferReadInd) && (estFinalWriteInd >= bufferReadInd)) {
           Serial.println("BufferedSDWriter_I16: WARNING: writing past the read index.");
           flag_moveReadIndexToEndOfWrite = true;
         }
@@ -276,16 +366,23 @@ class BufferedSDWriter : public SDWriter
         }
       }
 
-      //now interleave the data into the buffer
-      for (int Isamp = 0; Isamp < nsamps; Isamp++) {
-        for (int Ichan = 0; Ichan < numChan; Ichan++) {
-            //convert the F32 to Int16 and interleave
-            write_buffer[bufferWriteInd++] = (int16_t)(ptr_audio[Ichan][Isamp]*32767.0);
-        }
-      }
+      //now convert the F32 to Int16 (with saturation) and interleave the data into the buffer
+      interleave_f32_to_i16(ptr_audio, write_buffer + bufferWriteInd, nsamps, numChan);
+      bufferWriteInd += (numChan * nsamps);
 
       //handle the case where we just wrote past the read index.  Push the read index ahead.
-      if (flag_moveReadIndexToEndOfWrite) bufferReadInd = bufferWriteInd;
+      if (flag_moveReadIndexToEndOfWrite) {
+        bufferReadInd = bufferWriteInd;
+        countDroppedBlock();
+      }
+
+      //keep track of the highest fill level
+      checkStatsReset();
+      int32_t readInd = bufferReadInd;
+      int32_t fill = bufferWriteInd - readInd;
+      if (fill < 0) fill += bufferEndInd;  //the data wraps around the end of the buffer
+      uint32_t fill_bytes = fill * nBytesPerSample;
+      if (fill_bytes > sdStats.peakBufferFill_bytes) sdStats.peakBufferFill_bytes = fill_bytes;
     }
 
     //write buffered data if enough has accumulated
@@ -312,7 +409,7 @@ class BufferedSDWriter : public SDWriter
           //  Serial.print(samplesAvail); Serial.print(", ");
           //  Serial.println(samplesToWrite);
           //}
-          return_val += write((byte *)(write_buffer + bufferReadInd), samplesToWrite * sizeof(write_buffer[0]));
+          return_val += timedWrite((byte *)(write_buffer + bufferReadInd), samplesToWrite * sizeof(write_buffer[0]));
           //if (return_val == 0) {
           //  Serial.print("SDWriter: writeBuff1: samps to write, bytes written: "); Serial.print(samplesToWrite);
           //  Serial.print(", "); Serial.println(return_val);
@@ -342,7 +439,7 @@ class BufferedSDWriter : public SDWriter
             Serial.print(samplesAvail); Serial.print(", ");
             Serial.println(samplesToWrite);
           }
-          return_val += write((byte *)(write_buffer + bufferReadInd), samplesToWrite * sizeof(write_buffer[0]));
+          return_val += timedWrite((byte *)(write_buffer + bufferReadInd), samplesToWrite * sizeof(write_buffer[0]));
           if (return_val == 0) {
             Serial.print("SDWriter: writeBuff2: samps to write, bytes written: "); Serial.print(samplesToWrite);
             Serial.print(", "); Serial.println(return_val);
@@ -457,6 +554,29 @@ class BufferedSDWriter : public SDWriter
 //    }
 
   protected:
+    //write to the SD and add the time that it took to the histogram.  Called from the loop() only.
+    int timedWrite(const uint8_t *buff, int nbytes) {
+      uint32_t start_usec = micros();
+      int return_val = write(buff, nbytes);
+      uint32_t dt_usec = micros() - start_usec;
+      int bin = 0;
+      while ((bin < SDWRITER_LATENCY_NBINS-1) && (dt_usec >= getLatencyBinEdge_usec(bin))) bin++;
+      sdStats.writeLatencyHist[bin]++;
+      sdStats.nWrites++;
+      if (dt_usec > sdStats.maxWriteLatency_usec) sdStats.maxWriteLatency_usec = dt_usec;
+      return return_val;
+    }
+
+    //called by the ISR-side counters: clear them if the loop() has asked for a reset
+    void checkStatsReset(void) {
+      uint32_t request = statsResetRequest;
+      if (request != statsResetAck) {
+        sdStats.peakBufferFill_bytes = 0; sdStats.droppedBlocks = 0;
+        sdStats.blockIdGaps = 0; sdStats.missingBlockIds = 0;
+        statsResetAck = request;
+      }
+    }
+
     int writeSizeSamples = 0;
     int16_t* write_buffer = 0;
     int32_t bufferWriteInd = 0;
@@ -464,8 +584,12 @@ class BufferedSDWriter : public SDWriter
     const int nBytesPerSample = 2;
     int32_t bufferLengthSamples = maxBufferLengthBytes / nBytesPerSample;
     int32_t bufferEndInd = maxBufferLengthBytes / nBytesPerSample;
-    float32_t *ptr_zeros;
+    float32_t *ptr_zeros = NULL;
 
+    //telemetry.  The write-time fields are only changed by the loop(), the rest only by the ISR.
+    volatile SDWriterStats sdStats = {};
+    volatile uint32_t statsResetRequest = 0;
+    volatile uint32_t statsResetAck = 0;
 };
 
 
@@ -29,10 +29,14 @@
 #ifndef SdFat_Gre_BlockDriver_h
 #define SdFat_Gre_BlockDriver_h
 #include "SdFat_Gre_FatLib/BaseBlockDriver.h"
+#if ENABLE_HOST_BLOCK_DRIVER
+#include "SdFat_Gre_SdCard/FileImageDriver.h"
+#else  // ENABLE_HOST_BLOCK_DRIVER
 #include "SdFat_Gre_SdCard/SdSpiCard.h"
+#endif  // ENABLE_HOST_BLOCK_DRIVER
 //-----------------------------------------------------------------------------
 /** typedef for BlockDriver */
-#if ENABLE_EXTENDED_TRANSFER_CLASS || ENABLE_SDIO_CLASS
+#if ENABLE_EXTENDED_TRANSFER_CLASS || ENABLE_SDIO_CLASS || ENABLE_HOST_BLOCK_DRIVER
 typedef BaseBlockDriver BlockDriver;
 #else  // ENABLE_EXTENDED_TRANSFER_CLASS || ENABLE_SDIO_CLASS
 typedef SdSpiCard BlockDriver;
@@ -71,6 +71,39 @@
 #endif  // __arm__
 #endif  // USE_SEPARATE_FAT_CACHE
 //------------------------------------------------------------------------------
+/**
+ * Number of 512 byte blocks in the separate FAT cache.  The blocks are
+ * replaced least recently used first and dirty blocks are written back
+ * together, in block order, so FAT updates during long recordings do not
+ * cost a single-block write each.  Only used if USE_SEPARATE_FAT_CACHE is
+ * non-zero.  Must be between 1 and 255.
+ */
+#ifndef FAT_CACHE_BLOCK_COUNT
+#define FAT_CACHE_BLOCK_COUNT 4
+#endif  // FAT_CACHE_BLOCK_COUNT
+//------------------------------------------------------------------------------
+/**
+ * Number of FAT blocks to read ahead when the FAT cache misses on the block
+ * that follows the previous miss, as happens when a cluster chain is
+ * followed or free clusters are searched.  Set to zero to disable.  Must be
+ * less than FAT_CACHE_BLOCK_COUNT.
+ */
+#ifndef FAT_CACHE_READ_AHEAD
+#define FAT_CACHE_READ_AHEAD 2
+#endif  // FAT_CACHE_READ_AHEAD
+//------------------------------------------------------------------------------
+/**
+ * Set ENABLE_HOST_BLOCK_DRIVER non-zero to use FileImageDriver, a block
+ * driver backed by a disk image file, on a desktop host.
+ */
+#ifndef ENABLE_HOST_BLOCK_DRIVER
+#if defined(ARDUINO) || defined(PLATFORM_ID)
+#define ENABLE_HOST_BLOCK_DRIVER 0
+#else  // defined(ARDUINO) || defined(PLATFORM_ID)
+#define ENABLE_HOST_BLOCK_DRIVER 1
+#endif  // defined(ARDUINO) || defined(PLATFORM_ID)
+#endif  // ENABLE_HOST_BLOCK_DRIVER
+//------------------------------------------------------------------------------
 /**
  * Set USE_MULTI_BLOCK_IO non-zero to use multi-block SD read/write.
  *
@@ -136,8 +169,8 @@
  */
 // #define ENABLE_ARDUINO_FEATURES 0  ////////////////////////FIX THIS /////////////////
 #ifndef ENABLE_ARDUINO_FEATURES
-#include <Arduino.h>
 #if defined(ARDUINO) || defined(PLATFORM_ID) || defined(DOXYGEN)
+#include <Arduino.h>
 #define ENABLE_ARDUINO_FEATURES 1
 #else  //  #if defined(ARDUINO) || defined(DOXYGEN)
 #define ENABLE_ARDUINO_FEATURES 0
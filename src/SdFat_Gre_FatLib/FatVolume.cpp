@@ -26,7 +26,10 @@
 #include "FatVolume.h"
 //------------------------------------------------------------------------------
 cache_t* FatCache::read(uint32_t lbn, uint8_t option) {
-  if (m_lbn != lbn) {
+  if (m_lbn == lbn) {
+    m_hits++;
+  } else {
+    m_misses++;
     if (!sync()) {
       DBG_FAIL_MACRO;
       goto fail;
@@ -70,6 +73,138 @@ fail:
   return false;
 }
 //------------------------------------------------------------------------------
+uint8_t FatMultiCache::find(uint32_t lbn) const {
+  for (uint8_t i = 0; i < FAT_CACHE_BLOCK_COUNT; i++) {
+    if (m_lbn[i] == lbn) {
+      return i;
+    }
+  }
+  return FAT_CACHE_BLOCK_COUNT;
+}
+//------------------------------------------------------------------------------
+cache_t* FatMultiCache::read(uint32_t lbn, uint8_t option) {
+  uint8_t i = find(lbn);
+  if (i < FAT_CACHE_BLOCK_COUNT) {
+    m_hits++;
+  } else {
+    m_misses++;
+    i = victim(false);
+    // Write all dirty blocks together rather than one per miss.
+    if ((m_status[i] & FatCache::CACHE_STATUS_DIRTY) && !sync()) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+    m_status[i] = 0;
+    m_lbn[i] = 0XFFFFFFFF;
+    if (!(option & FatCache::CACHE_OPTION_NO_READ)) {
+      if (!m_vol->readBlock(lbn, m_block[i].data)) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
+    }
+    m_lbn[i] = lbn;
+    m_lastUse[i] = ++m_useCount;
+    if (!(option & FatCache::CACHE_OPTION_NO_READ) && lbn == m_lastMiss + 1) {
+      readAhead(lbn + 1);
+    }
+    m_lastMiss = lbn;
+  }
+  m_lastUse[i] = ++m_useCount;
+  m_status[i] |= option & FatCache::CACHE_STATUS_MASK;
+  return &m_block[i];
+
+fail:
+  return 0;
+}
+//------------------------------------------------------------------------------
+// Read blocks following a sequential miss into clean entries.  A failure
+// here is not an error, the block will be read again when it is needed.
+void FatMultiCache::readAhead(uint32_t lbn) {
+  uint32_t fatEnd = m_vol->fatStartBlock() + m_vol->blocksPerFat();
+  for (uint8_t n = 0; n < FAT_CACHE_READ_AHEAD; n++, lbn++) {
+    if (lbn >= fatEnd || find(lbn) < FAT_CACHE_BLOCK_COUNT) {
+      return;
+    }
+    uint8_t i = victim(true);
+    if (i == FAT_CACHE_BLOCK_COUNT) {
+      return;
+    }
+    if (!m_vol->readBlock(lbn, m_block[i].data)) {
+      m_status[i] = 0;
+      m_lbn[i] = 0XFFFFFFFF;
+      return;
+    }
+    m_status[i] = 0;
+    m_lbn[i] = lbn;
+    // Same age as the block that caused the read-ahead.
+    m_lastUse[i] = m_useCount;
+    m_readAhead++;
+  }
+}
+//------------------------------------------------------------------------------
+bool FatMultiCache::sync() {
+  uint8_t order[FAT_CACHE_BLOCK_COUNT];
+  uint8_t nDirty = 0;
+  // Insertion sort of dirty entries by block number.
+  for (uint8_t i = 0; i < FAT_CACHE_BLOCK_COUNT; i++) {
+    if (m_status[i] & FatCache::CACHE_STATUS_DIRTY) {
+      uint8_t k = nDirty++;
+      while (k > 0 && m_lbn[order[k - 1]] > m_lbn[i]) {
+        order[k] = order[k - 1];
+        k--;
+      }
+      order[k] = i;
+    }
+  }
+  for (uint8_t k = 0; k < nDirty; k++) {
+    uint8_t i = order[k];
+    if (!m_vol->writeBlock(m_lbn[i], m_block[i].data)) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+  }
+  // mirror second FAT
+  for (uint8_t k = 0; k < nDirty; k++) {
+    uint8_t i = order[k];
+    if (m_status[i] & FatCache::CACHE_STATUS_MIRROR_FAT) {
+      uint32_t lbn = m_lbn[i] + m_vol->blocksPerFat();
+      if (!m_vol->writeBlock(lbn, m_block[i].data)) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
+    }
+  }
+  for (uint8_t k = 0; k < nDirty; k++) {
+    m_status[order[k]] &= ~FatCache::CACHE_STATUS_DIRTY;
+  }
+  return true;
+
+fail:
+  return false;
+}
+//------------------------------------------------------------------------------
+// Return an invalid entry or the least recently used entry.  For read-ahead
+// only clean entries not used by the current request are considered.
+uint8_t FatMultiCache::victim(bool cleanOnly) const {
+  uint8_t best = FAT_CACHE_BLOCK_COUNT;
+  uint32_t bestAge = 0;
+  for (uint8_t i = 0; i < FAT_CACHE_BLOCK_COUNT; i++) {
+    uint32_t age = m_useCount - m_lastUse[i];
+    if (cleanOnly
+        && ((m_status[i] & FatCache::CACHE_STATUS_DIRTY) || age == 0)) {
+      continue;
+    }
+    if (m_lbn[i] == 0XFFFFFFFF) {
+      return i;
+    }
+    if (best == FAT_CACHE_BLOCK_COUNT || age > bestAge) {
+      best = i;
+      bestAge = age;
+    }
+  }
+  return best;
+}
+//------------------------------------------------------------------------------
 bool FatVolume::allocateCluster(uint32_t current, uint32_t* next) {
   uint32_t find = current ? current : m_allocSearchStart;
   uint32_t start = find;
@@ -48,6 +48,12 @@
 #endif  // DEBUG_MODE
 #endif  // DOXYGEN_SHOULD_SKIP_THIS
 //------------------------------------------------------------------------------
+#if USE_SEPARATE_FAT_CACHE
+#if FAT_CACHE_BLOCK_COUNT < 1 || FAT_CACHE_BLOCK_COUNT > 255
+#error FAT_CACHE_BLOCK_COUNT must be between 1 and 255
+#endif  // FAT_CACHE_BLOCK_COUNT
+#endif  // USE_SEPARATE_FAT_CACHE
+//------------------------------------------------------------------------------
 #if ENABLE_ARDUINO_FEATURES
 /** Use Print for Arduino */
 typedef Print print_t;
@@ -119,12 +125,17 @@ class FatCache {
   void dirty() {
     m_status |= CACHE_STATUS_DIRTY;
   }
+  /** \return Number of reads served from the cache. */
+  uint32_t hitCount() const {
+    return m_hits;
+  }
   /** Initialize the cache.
    * \param[in] vol FatVolume that owns this FatCache.
    */
   void init(FatVolume *vol) {
     m_vol = vol;
     invalidate();
+    resetStats();
   }
   /** Invalidate current cache block. */
   void invalidate() {
@@ -139,11 +150,20 @@ class FatCache {
   uint32_t lbn() {
     return m_lbn;
   }
+  /** \return Number of reads that required a new block. */
+  uint32_t missCount() const {
+    return m_misses;
+  }
   /** Read a block into the cache.
    * \param[in] lbn Block to read.
    * \param[in] option mode for cached block.
    * \return Address of cached block. */
   cache_t* read(uint32_t lbn, uint8_t option);
+  /** Clear hit and miss counts. */
+  void resetStats() {
+    m_hits = 0;
+    m_misses = 0;
+  }
   /** Write current block if dirty.
    * \return true for success else false.
    */
@@ -153,9 +173,89 @@ class FatCache {
   uint8_t m_status;
   FatVolume* m_vol;
   uint32_t m_lbn;
+  uint32_t m_hits;
+  uint32_t m_misses;
   cache_t m_block;
 };
 //==============================================================================
+/**
+ * \class FatMultiCache
+ * \brief N-way block cache for FAT blocks.
+ *
+ * Holds FAT_CACHE_BLOCK_COUNT blocks and replaces the least recently used
+ * block on a miss.  Dirty blocks are only written when the cache is synced
+ * or a dirty block must be replaced.  All dirty blocks are then written in
+ * ascending order, first FAT then mirror FAT, so adjacent blocks go to the
+ * device as one multi-block transfer with drivers like SdioCardEX.
+ *
+ * A miss on the block after the previous miss reads FAT_CACHE_READ_AHEAD
+ * more blocks into clean entries.
+ */
+class FatMultiCache {
+ public:
+  /** \return Number of reads served from the cache. */
+  uint32_t hitCount() const {
+    return m_hits;
+  }
+  /** Initialize the cache.
+   * \param[in] vol FatVolume that owns this FatMultiCache.
+   */
+  void init(FatVolume *vol) {
+    m_vol = vol;
+    invalidate();
+    resetStats();
+  }
+  /** Invalidate all cache blocks.  Dirty blocks are discarded. */
+  void invalidate() {
+    for (uint8_t i = 0; i < FAT_CACHE_BLOCK_COUNT; i++) {
+      m_status[i] = 0;
+      m_lbn[i] = 0XFFFFFFFF;
+      m_lastUse[i] = 0;
+    }
+    m_useCount = 0;
+    m_lastMiss = 0XFFFFFFFF;
+  }
+  /** \return Number of reads that required a block from the device. */
+  uint32_t missCount() const {
+    return m_misses;
+  }
+  /** Read a block into the cache.
+   * \param[in] lbn Block to read.
+   * \param[in] option mode for cached block.
+   * \return Address of cached block. */
+  cache_t* read(uint32_t lbn, uint8_t option);
+  /** \return Number of blocks read ahead of need. */
+  uint32_t readAheadCount() const {
+    return m_readAhead;
+  }
+  /** Clear hit, miss and read-ahead counts. */
+  void resetStats() {
+    m_hits = 0;
+    m_misses = 0;
+    m_readAhead = 0;
+  }
+  /** Write all dirty blocks.
+   * \return true for success else false.
+   */
+  bool sync();
+
+ private:
+  uint8_t find(uint32_t lbn) const;
+  void readAhead(uint32_t lbn);
+  uint8_t victim(bool cleanOnly) const;
+
+  FatVolume* m_vol;
+  uint32_t m_useCount;
+  uint32_t m_lastMiss;
+  uint32_t m_hits;
+  uint32_t m_misses;
+  uint32_t m_readAhead;
+  uint8_t  m_status[FAT_CACHE_BLOCK_COUNT];
+  uint32_t m_lbn[FAT_CACHE_BLOCK_COUNT];
+  uint32_t m_lastUse[FAT_CACHE_BLOCK_COUNT];
+  cache_t  m_block[FAT_CACHE_BLOCK_COUNT];
+};
+//==============================================================================
 /**
  * \class FatVolume
  * \brief Access FAT16 and FAT32 volumes on raw file devices.
@@ -182,8 +282,26 @@ class FatVolume {
       return 0;
     }
     m_cache.invalidate();
+#if USE_SEPARATE_FAT_CACHE
+    m_fatCache.invalidate();
+#endif  // USE_SEPARATE_FAT_CACHE
     return m_cache.block();
   }
+  /** \return Data and directory cache reads served from memory. */
+  uint32_t cacheHitCount() const {
+    return m_cache.hitCount();
+  }
+  /** \return Data and directory cache reads that needed a new block. */
+  uint32_t cacheMissCount() const {
+    return m_cache.missCount();
+  }
+  /** Clear all cache hit, miss and read-ahead counts. */
+  void cacheResetStats() {
+    m_cache.resetStats();
+#if USE_SEPARATE_FAT_CACHE
+    m_fatCache.resetStats();
+#endif  // USE_SEPARATE_FAT_CACHE
+  }
   /** \return The total number of clusters in the volume. */
   uint32_t clusterCount() const {
     return m_lastCluster - 1;
@@ -200,6 +318,33 @@ class FatVolume {
   uint8_t fatCount() {
     return 2;
   }
+#if USE_SEPARATE_FAT_CACHE
+  /** \return FAT cache reads served from memory. */
+  uint32_t fatCacheHitCount() const {
+    return m_fatCache.hitCount();
+  }
+  /** \return FAT cache reads that needed a block from the device. */
+  uint32_t fatCacheMissCount() const {
+    return m_fatCache.missCount();
+  }
+  /** \return FAT blocks read ahead of need. */
+  uint32_t fatCacheReadAheadCount() const {
+    return m_fatCache.readAheadCount();
+  }
+#else  // USE_SEPARATE_FAT_CACHE
+  /** \return Zero, FAT blocks are counted by cacheHitCount(). */
+  uint32_t fatCacheHitCount() const {
+    return 0;
+  }
+  /** \return Zero, FAT blocks are counted by cacheMissCount(). */
+  uint32_t fatCacheMissCount() const {
+    return 0;
+  }
+  /** \return Zero, there is no FAT read-ahead without a separate cache. */
+  uint32_t fatCacheReadAheadCount() const {
+    return 0;
+  }
+#endif  // USE_SEPARATE_FAT_CACHE
   /** \return The logical block number for the start of the first FAT. */
   uint32_t fatStartBlock() const {
     return m_fatStartBlock;
@@ -264,6 +409,7 @@ class FatVolume {
  private:
   // Allow FatFile and FatCache access to FatVolume private functions.
   friend class FatCache;
+  friend class FatMultiCache;
   friend class FatFile;
   friend class FatFileSystem;
 //------------------------------------------------------------------------------
@@ -320,7 +466,7 @@ class FatVolume {
 // block caches
   FatCache m_cache;
 #if USE_SEPARATE_FAT_CACHE
-  FatCache m_fatCache;
+  FatMultiCache m_fatCache;
   cache_t* cacheFetchFat(uint32_t blockNumber, uint8_t options) {
     return m_fatCache.read(blockNumber,
                            options | FatCache::CACHE_STATUS_MIRROR_FAT);
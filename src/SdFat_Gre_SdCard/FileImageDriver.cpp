@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 20011-2017 Bill Greiman
+ * This file is part of the SdFat_Gre library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include "FileImageDriver.h"
+#if ENABLE_HOST_BLOCK_DRIVER
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+//-----------------------------------------------------------------------------
+bool FileImageDriver::begin(const char* path, uint32_t createBlocks) {
+  struct stat st;
+  close();
+  if (createBlocks) {
+    m_fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_fd < 0 || ftruncate(m_fd, (off_t)createBlocks << 9) != 0) {
+      goto fail;
+    }
+  } else {
+    m_fd = ::open(path, O_RDWR);
+    if (m_fd < 0) {
+      goto fail;
+    }
+  }
+  if (fstat(m_fd, &st) != 0) {
+    goto fail;
+  }
+  m_blockCount = st.st_size >> 9;
+  return true;
+
+fail:
+  close();
+  return false;
+}
+//-----------------------------------------------------------------------------
+void FileImageDriver::close() {
+  if (m_fd >= 0) {
+    ::close(m_fd);
+  }
+  m_fd = -1;
+  m_blockCount = 0;
+}
+//-----------------------------------------------------------------------------
+void FileImageDriver::delayMicros(uint32_t micros) {
+  m_virtualMicros += micros;
+  if (m_sleep && micros) {
+    struct timespec ts;
+    ts.tv_sec = micros / 1000000;
+    ts.tv_nsec = (micros % 1000000) * 1000L;
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {}
+  }
+}
+//-----------------------------------------------------------------------------
+// xorshift32 so runs with the same seed see the same stalls.
+uint32_t FileImageDriver::random() {
+  m_rand ^= m_rand << 13;
+  m_rand ^= m_rand >> 17;
+  m_rand ^= m_rand << 5;
+  return m_rand;
+}
+//-----------------------------------------------------------------------------
+bool FileImageDriver::readBlock(uint32_t block, uint8_t* dst) {
+  return readBlocks(block, dst, 1);
+}
+//-----------------------------------------------------------------------------
+bool FileImageDriver::readBlocks(uint32_t block, uint8_t* dst, size_t nb) {
+  size_t n = nb << 9;
+  if (m_fd < 0 || block + nb > m_blockCount) {
+    return false;
+  }
+  m_readCount++;
+  delayMicros(m_readMicros);
+  return pread(m_fd, dst, n, (off_t)block << 9) == (ssize_t)n;
+}
+//-----------------------------------------------------------------------------
+void FileImageDriver::resetStats() {
+  m_readCount = 0;
+  m_writeCount = 0;
+  m_stallCount = 0;
+  m_maxWriteMicros = 0;
+  m_virtualMicros = 0;
+}
+//-----------------------------------------------------------------------------
+bool FileImageDriver::syncBlocks() {
+  // pwrite() has already handed the data to the OS.
+  return m_fd >= 0;
+}
+//-----------------------------------------------------------------------------
+bool FileImageDriver::writeBlock(uint32_t block, const uint8_t* src) {
+  return writeBlocks(block, src, 1);
+}
+//-----------------------------------------------------------------------------
+bool FileImageDriver::writeBlocks(uint32_t block,
+                                  const uint8_t* src, size_t nb) {
+  size_t n = nb << 9;
+  if (m_fd < 0 || block + nb > m_blockCount) {
+    return false;
+  }
+  m_writeCount++;
+  delayMicros(writeLatency(nb));
+  return pwrite(m_fd, src, n, (off_t)block << 9) == (ssize_t)n;
+}
+//-----------------------------------------------------------------------------
+uint32_t FileImageDriver::writeLatency(size_t nb) {
+  uint32_t micros = m_writeMicros + nb*m_writeMicrosPerBlock;
+  if (m_jitterMicros) {
+    micros += random() % (m_jitterMicros + 1);
+  }
+  if (m_stallPerMillion && (random() % 1000000) < m_stallPerMillion) {
+    micros += m_stallMinMicros
+              + random() % (m_stallMaxMicros - m_stallMinMicros + 1);
+    m_stallCount++;
+  }
+  if (micros > m_maxWriteMicros) {
+    m_maxWriteMicros = micros;
+  }
+  return micros;
+}
+#endif  // ENABLE_HOST_BLOCK_DRIVER
@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 20011-2017 Bill Greiman
+ * This file is part of the SdFat_Gre library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#ifndef FileImageDriver_h
+#define FileImageDriver_h
+/**
+ * \file
+ * \brief FileImageDriver class
+ */
+#include <stddef.h>
+#include "../SdFat_Gre_FatLib/BaseBlockDriver.h"
+#if ENABLE_HOST_BLOCK_DRIVER || defined(DOXYGEN)
+//-----------------------------------------------------------------------------
+/**
+ * \class FileImageDriver
+ * \brief Block driver backed by a disk image file on a desktop host.
+ *
+ * Lets FatVolume and FatFile run off-device.  The image must already hold
+ * a FAT16 or FAT32 volume, for example one made with
+ * "mkfs.vfat -C card.img 65536".
+ *
+ * Writes can be delayed to look like an SD card.  Each write command costs
+ * a fixed time, a time per block, a uniform random jitter and, with a given
+ * probability, a long stall like the 100 to 250 ms garbage collection pauses
+ * of real cards.  A multi-block transfer is one command, so it is charged
+ * one stall at most.  Delays either sleep the calling thread or, with
+ * setSleep(false), only advance virtualTimeMicros() so a simulation can run
+ * faster than real time.  The random sequence is reproducible from the seed.
+ */
+class FileImageDriver : public BaseBlockDriver {
+ public:
+  FileImageDriver() : m_fd(-1), m_blockCount(0) {
+    setWriteLatency(0, 0, 0);
+    setStall(0, 100000, 250000);
+    setReadLatency(0);
+    setSeed(1);
+    setSleep(true);
+    resetStats();
+  }
+  ~FileImageDriver() {
+    close();
+  }
+  /** Open a disk image file.
+   *
+   * \param[in] path Image file name.
+   * \param[in] createBlocks If nonzero, create or truncate the image and
+   *            set its size to this many blocks.  The image is then blank
+   *            and must be formatted before FatVolume can use it.
+   * \return true for success else false.
+   */
+  bool begin(const char* path, uint32_t createBlocks = 0);
+  /** \return The number of 512 byte blocks in the image. */
+  uint32_t cardSize() const {
+    return m_blockCount;
+  }
+  /** Close the image file. */
+  void close();
+  /** \return true if an image file is open. */
+  bool isOpen() const {
+    return m_fd >= 0;
+  }
+  /** \return Longest delay of a single write command in microseconds. */
+  uint32_t maxWriteLatencyMicros() const {
+    return m_maxWriteMicros;
+  }
+  /**
+   * Read a 512 byte block from the image.
+   *
+   * \param[in] block Logical block to be read.
+   * \param[out] dst Pointer to the location that will receive the data.
+   * \return The value true is returned for success and
+   * the value false is returned for failure.
+   */
+  bool readBlock(uint32_t block, uint8_t* dst);
+  /**
+   * Read multiple 512 byte blocks from the image.
+   *
+   * \param[in] block Logical block to be read.
+   * \param[in] nb Number of blocks to be read.
+   * \param[out] dst Pointer to the location that will receive the data.
+   * \return The value true is returned for success and
+   * the value false is returned for failure.
+   */
+  bool readBlocks(uint32_t block, uint8_t* dst, size_t nb);
+  /** \return Number of read commands. */
+  uint32_t readCount() const {
+    return m_readCount;
+  }
+  /** Clear the statistics and the virtual clock. */
+  void resetStats();
+  /** Set the delay of each read command.
+   * \param[in] micros Delay in microseconds.
+   */
+  void setReadLatency(uint32_t micros) {
+    m_readMicros = micros;
+  }
+  /** Set the seed for the random jitter and stalls.
+   * \param[in] seed Any nonzero value.
+   */
+  void setSeed(uint32_t seed) {
+    m_rand = seed ? seed : 1;
+  }
+  /** Choose between real delays and virtual time.
+   * \param[in] sleep If true, delays sleep the calling thread.  If false,
+   *            delays only advance virtualTimeMicros().
+   */
+  void setSleep(bool sleep) {
+    m_sleep = sleep;
+  }
+  /** Set the long write stalls.
+   * \param[in] perMillion Chance of a stall per write command in parts
+   *            per million.  Zero disables stalls.
+   * \param[in] minMicros Shortest stall in microseconds.
+   * \param[in] maxMicros Longest stall in microseconds.
+   */
+  void setStall(uint32_t perMillion, uint32_t minMicros, uint32_t maxMicros) {
+    m_stallPerMillion = perMillion;
+    m_stallMinMicros = minMicros;
+    m_stallMaxMicros = maxMicros < minMicros ? minMicros : maxMicros;
+  }
+  /** Set the normal delay of each write command.
+   * \param[in] micros Fixed delay per command in microseconds.
+   * \param[in] microsPerBlock Extra delay per block in microseconds.
+   * \param[in] jitterMicros Largest extra uniform random delay.
+   */
+  void setWriteLatency(uint32_t micros, uint32_t microsPerBlock,
+                       uint32_t jitterMicros) {
+    m_writeMicros = micros;
+    m_writeMicrosPerBlock = microsPerBlock;
+    m_jitterMicros = jitterMicros;
+  }
+  /** \return Number of write stalls so far. */
+  uint32_t stallCount() const {
+    return m_stallCount;
+  }
+  /** End a transfer.  Nothing to do for an image file.
+   * \return The value true is returned for success and
+   * the value false is returned for failure.
+   */
+  bool syncBlocks();
+  /** \return Time spent in read and write delays, in microseconds. */
+  uint64_t virtualTimeMicros() const {
+    return m_virtualMicros;
+  }
+  /**
+   * Write a 512 byte block to the image.
+   *
+   * \param[in] block Logical block to be written.
+   * \param[in] src Pointer to the location of the data to be written.
+   * \return The value true is returned for success and
+   * the value false is returned for failure.
+   */
+  bool writeBlock(uint32_t block, const uint8_t* src);
+  /**
+   * Write multiple 512 byte blocks to the image.
+   *
+   * \param[in] block Logical block to be written.
+   * \param[in] nb Number of blocks to be written.
+   * \param[in] src Pointer to the location of the data to be written.
+   * \return The value true is returned for success and
+   * the value false is returned for failure.
+   */
+  bool writeBlocks(uint32_t block, const uint8_t* src, size_t nb);
+  /** \return Number of write commands. */
+  uint32_t writeCount() const {
+    return m_writeCount;
+  }
+
+ private:
+  void delayMicros(uint32_t micros);
+  uint32_t random();
+  uint32_t writeLatency(size_t nb);
+
+  int m_fd;
+  uint32_t m_blockCount;
+  bool m_sleep;
+  uint32_t m_rand;
+  uint32_t m_readMicros;
+  uint32_t m_writeMicros;
+  uint32_t m_writeMicrosPerBlock;
+  uint32_t m_jitterMicros;
+  uint32_t m_stallPerMillion;
+  uint32_t m_stallMinMicros;
+  uint32_t m_stallMaxMicros;
+  uint32_t m_readCount;
+  uint32_t m_writeCount;
+  uint32_t m_stallCount;
+  uint32_t m_maxWriteMicros;
+  uint64_t m_virtualMicros;
+};
+#endif  // ENABLE_HOST_BLOCK_DRIVER || defined(DOXYGEN)
+#endif  // FileImageDriver_h
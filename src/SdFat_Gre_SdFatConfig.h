@@ -28,7 +28,9 @@
  */
 #ifndef SdFat_Gre_SdFatConfig_h
 #define SdFat_Gre_SdFatConfig_h
+#if defined(ARDUINO) || defined(PLATFORM_ID)
 #include <Arduino.h>
+#endif  // defined(ARDUINO) || defined(PLATFORM_ID)
 #include <stdint.h>
 #ifdef __AVR__
 #include <avr/io.h>
@@ -162,6 +164,19 @@
 #define USE_SEPARATE_FAT_CACHE 0
 #endif  // __arm__
 //------------------------------------------------------------------------------
+/**
+ * Number of 512 byte blocks in the separate FAT cache.  Dirty FAT blocks are
+ * written back together in block order.  Used if USE_SEPARATE_FAT_CACHE is
+ * nonzero.
+ */
+#define FAT_CACHE_BLOCK_COUNT 4
+//------------------------------------------------------------------------------
+/**
+ * Number of FAT blocks to read ahead on a sequential FAT cache miss.
+ * Must be less than FAT_CACHE_BLOCK_COUNT.
+ */
+#define FAT_CACHE_READ_AHEAD 2
+//------------------------------------------------------------------------------
 /**
  * Set USE_MULTI_BLOCK_IO nonzero to use multi-block SD read/write.
  *
@@ -173,6 +188,17 @@
 #define USE_MULTI_BLOCK_IO 1
 #endif  // RAMEND
 //-----------------------------------------------------------------------------
+/**
+ * Set ENABLE_HOST_BLOCK_DRIVER nonzero to build the FAT library on a desktop
+ * host with FileImageDriver, a block driver backed by a disk image file.
+ * Nonzero by default when not building for Arduino or Particle.
+ */
+#if defined(ARDUINO) || defined(PLATFORM_ID)
+#define ENABLE_HOST_BLOCK_DRIVER 0
+#else  // defined(ARDUINO) || defined(PLATFORM_ID)
+#define ENABLE_HOST_BLOCK_DRIVER 1
+#endif  // defined(ARDUINO) || defined(PLATFORM_ID)
+//-----------------------------------------------------------------------------
 /** Enable SDIO driver if available. */
 #if defined(__MK64FX512__) || defined(__MK66FX1M0__)
 #define ENABLE_SDIO_CLASS 1
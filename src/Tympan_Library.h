@@ -5,34 +5,47 @@
 #include "AudioCalcEnvelope_F32.h"
 #include "AudioCalcGainWDRC_F32.h"
 #include "AudioCalcLevel_F32.h"
+#include "AudioCalcLevelN_F32.h"
+#include "AudioCalcLevelStats_F32.h"
+#include "AudioCalcOctaveBands_F32.h"
 #include "AudioConfigFIRFilterBank_F32.h"
 #include "AudioControlTester.h"
 #include "AudioConvert_F32.h"
+#include "AudioEffectBeamformerN_F32.h"
 #include "AudioEffectCompWDRC_F32.h"
 #include "AudioEffectEmpty_F32.h"
 #include "AudioEffectGain_F32.h"
 #include "AudioEffectCompressor_F32.h"
 #include "AudioEffectDelay_f32.h"
+#include "AudioEffectDelayLong_F32.h"
+#include "AudioEffectPhaseVocoder_F32.h"
 #include "AudioFilterBiquad_F32.h"
 #include "AudioFilterFIR_F32.h"
+#include "AudioFilterFreqWarpFIRBank_F32.h"
 #include "AudioFilterFreqWeighting_F32.h"
 #include "AudioFilterTimeWeighting_F32.h"
 #include "AudioMixer_F32.h"
+#include "AudioMultirate_F32.h"
 #include "AudioMathAdd_F32.h"
 #include "AudioMathMultiply_F32.h"
 #include "AudioMathOffset_F32.h"
 #include "AudioMathScale_F32.h"
+#include "AudioResampleAsync_F32.h"
 #include "AudioSettings_F32.h"
+#include "AudioSDPlayer_F32.h"
 #include "AudioSDWriter_F32.h"
 #include "AudioSwitch_F32.h"
 #include "FFT_F32.h"
 #include "FFT_Overlapped_F32.h"
 #include "input_i2s_f32.h"
 #include "input_i2s_quad_f32.h"
+#include "input_tdm_f32.h"
 #include "play_queue_f32.h"
 #include "record_queue_f32.h"
 #include "SdFat_Gre.h"
+#include "SDReader.h"
 #include "SDWriter.h"
+#include "synth_oscbank_f32.h"
 #include "synth_pinknoise_f32.h"
 #include "synth_waveform_F32.h"
 #include "synth_whitenoise_f32.h"
@@ -41,4 +54,5 @@
 #include "Tympan.h"
 #include "output_i2s_f32.h"
 #include "output_i2s_quad_f32.h"
+#include "output_tdm_f32.h"
 #include "USB_Audio_F32.h"
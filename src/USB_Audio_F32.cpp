@@ -0,0 +1,63 @@
+/* 
+*	USB_Audio_F32
+*
+*	Created: OpenAudio, Oct 2026
+*
+*	License: MIT License.  Use at your own risk.
+*/
+
+#include "USB_Audio_F32.h"
+#include "utility/convert_f32.h"
+
+void AudioInputUSB_F32::update(void) {
+	audio_block_t *block_i16[USB_AUDIO_F32_NCHAN];
+	
+	//Take any blocks that are waiting.  Usually there are none, so have the USB object give up its
+	//blocks now.  (The audio library also calls usb_in.update() itself, later in the update cycle.
+	//Anything it gives then will be waiting here for next time.)
+	bool any = false;
+	for (int Ichan = 0; Ichan < USB_AUDIO_F32_NCHAN; Ichan++) any |= ((block_i16[Ichan] = bridge.take(Ichan)) != NULL);
+	if (!any) {
+		usb_in.update();
+		for (int Ichan = 0; Ichan < USB_AUDIO_F32_NCHAN; Ichan++) any |= ((block_i16[Ichan] = bridge.take(Ichan)) != NULL);
+	}
+	if (!any) {
+		if (isStreaming()) missed_block_count++;
+		return;
+	}
+	
+	//convert each channel straight into a new F32 block
+	for (int Ichan = 0; Ichan < USB_AUDIO_F32_NCHAN; Ichan++) {
+		if (block_i16[Ichan] == NULL) continue;
+		audio_block_f32_t *block_f32 = AudioStream_F32::allocate_f32();
+		if (block_f32) {
+			i16_to_f32_scaled(block_i16[Ichan]->data, block_f32->data, block_f32->length);
+			AudioStream_F32::transmit(block_f32, Ichan);
+			AudioStream_F32::release(block_f32);
+		}
+		AudioUSBBridge_I16::release_i16(block_i16[Ichan]);
+	}
+}
+
+void AudioOutputUSB_F32::update(void) {
+	bool any = false;
+	for (int Ichan = 0; Ichan < USB_AUDIO_F32_NCHAN; Ichan++) {
+		audio_block_f32_t *block_f32 = receiveReadOnly_f32(Ichan);
+		if (!block_f32) continue;
+		
+		//convert straight into an Int16 block for the USB
+		audio_block_t *block_i16 = AudioUSBBridge_I16::allocate_i16();
+		if (block_i16) {
+			int len = (block_f32->length < AUDIO_BLOCK_SAMPLES) ? block_f32->length : AUDIO_BLOCK_SAMPLES;
+			f32_to_i16_sat(block_f32->data, block_i16->data, len);
+			for (int i = len; i < AUDIO_BLOCK_SAMPLES; i++) block_i16->data[i] = 0;
+			bridge.send(block_i16, Ichan);
+			AudioUSBBridge_I16::release_i16(block_i16);
+			any = true;
+		}
+		AudioStream_F32::release(block_f32);
+	}
+	
+	//hand the blocks to the USB now (the USB object makes silence for any channel that's missing)
+	if (any) usb_out.update();
+}
@@ -4,6 +4,16 @@
 *	Created: Chip Audette (OpenAudio), Mar 2017
 *       Float32 wrapper for the Audio USB classes from the Teensy Audio Library
 *
+*	Extended: OpenAudio, Oct 2026
+*       Converts between the USB's Int16 blocks and the F32 blocks in one pass, right inside this
+*       node's update(), instead of passing every block through an Int16<->F32 converter and a
+*       record/play queue (which cost two extra block hops and allocations per channel per update).
+*
+*       The USB endpoint itself (its packets, its format, and its asynchronous feedback to the PC) is
+*       run by the Teensy core, which is built for 16-bit stereo.  The feedback is how the Teensy tells
+*       the PC to send a little faster or slower to match the Teensy's audio clock.  It is available
+*       here as getFeedback_samplesPerFrame() and getRequestedSampleRate_Hz(), for monitoring.
+*
 *	License: MIT License.  Use at your own risk.
 */
 
@@ -14,6 +24,25 @@
 #include <AudioStream.h>
 //include <Audio.h>
 
+#define USB_AUDIO_F32_NCHAN 2               //the Teensy core's USB audio is stereo
+#define USB_AUDIO_F32_FEEDBACK_SCALE 65536.0f  //the core's feedback is samples per USB frame, in 16.16 fixed point
+#define USB_AUDIO_F32_FRAMES_PER_SEC 1000.0f   //full-speed USB
+
+//Holds the Int16 blocks passing between the Teensy's USB audio objects and the F32 nodes below.  Its own
+//update() does nothing; the F32 node moves the blocks in and out during its update().
+class AudioUSBBridge_I16 : public AudioStream
+{
+public:
+	AudioUSBBridge_I16(void) : AudioStream(USB_AUDIO_F32_NCHAN, inputQueueArray) {}
+	void update(void) {}
+	
+	audio_block_t *take(unsigned int chan) { return receiveReadOnly(chan); }
+	void send(audio_block_t *block, unsigned char chan) { transmit(block, chan); }
+	static audio_block_t *allocate_i16(void) { return allocate(); }
+	static void release_i16(audio_block_t *block) { release(block); }
+private:
+	audio_block_t *inputQueueArray[USB_AUDIO_F32_NCHAN];
+};
 
 class AudioInputUSB_F32 : public AudioStream_F32
 {
@@ -21,64 +50,43 @@ class AudioInputUSB_F32 : public AudioStream_F32
 //GUI: shortName:usbAudioIn  //this line used for automatic generation of GUI node
 public:
 	AudioInputUSB_F32() : AudioStream_F32(0, NULL) {
-		//i16_to_f32.disconnectFromUpdateAll(); //requires modification to AudioStream.h
-		//output_queue.disconnectFromUpdateAll(); //requires modification to AudioStream.h
-		
 		makeConnections();
 	}
 	AudioInputUSB_F32(const AudioSettings_F32 &settings) : AudioStream_F32(0, NULL) {
-		//i16_to_f32.disconnectFromUpdateAll(); //requires modification to AudioStream.h
-		//output_queue.disconnectFromUpdateAll(); //requires modification to AudioStream.h
-		
 		makeConnections();
 	}
 	
 	void makeConnections(void) {
 		//make the audio connections
-		patchCord100_L = new AudioConnection(usb_in, 0, i16_to_f32_L, 0);  //usb_in is an Int16 audio object.  So, convert it!
-    	patchCord100_R = new AudioConnection(usb_in, 1, i16_to_f32_R, 0);  //usb_in is an Int16 audio object.  So, convert it!
-    	patchCord101_L = new AudioConnection_F32(i16_to_f32_L, 0, output_queue_L, 0);
-		patchCord101_R = new AudioConnection_F32(i16_to_f32_R, 0, output_queue_R, 0);
+		patchCord100_L = new AudioConnection(usb_in, 0, bridge, 0);  //usb_in is an Int16 audio object.  Its blocks wait in the bridge.
+		patchCord100_R = new AudioConnection(usb_in, 1, bridge, 1);
 	}
 	
 	//define audio processing blocks.
-    AudioInputUSB  	usb_in;  //from the original Teensy Audio Library, expects Int16 audio data
-    AudioConvert_I16toF32   i16_to_f32_L, i16_to_f32_R; 
-    AudioRecordQueue_F32    output_queue_L,output_queue_R;    
+	AudioInputUSB  	usb_in;  //from the original Teensy Audio Library, expects Int16 audio data
+	AudioUSBBridge_I16	bridge;
 	
 	//define the audio connections
-    AudioConnection     *patchCord100_L, *patchCord100_R;
-    AudioConnection_F32 *patchCord101_L, *patchCord101_R;
+	AudioConnection     *patchCord100_L, *patchCord100_R;
 	
-    void update(void) {
-		//Serial.println("AudioSynthNoiseWhite_F32: update().");
-		output_queue_L.begin();
-		output_queue_R.begin();
-		
-		//manually update audio blocks in the desired order
-		usb_in.update();  //the output should be routed directly via the AudioConnection
-		i16_to_f32_L.update();  // output is routed via the AudioConnection
-		i16_to_f32_R.update();  // output is routed via the AudioConnection
-		output_queue_L.update();
-		output_queue_R.update();
+	void update(void);
 
-		//handle the output for the left channel
-		audio_block_f32_t  *block;
-		block = output_queue_L.getAudioBlock();
-		if (block == NULL) return;
-		AudioStream_F32::transmit(block,0);
-		output_queue_L.freeAudioBlock();
-		output_queue_L.end();
-		
-		//handle the output for the left channel
-		block = output_queue_R.getAudioBlock();
-		if (block == NULL) return;
-		AudioStream_F32::transmit(block,1);
-		output_queue_R.freeAudioBlock();
-		output_queue_R.end();
-    }
-private:    
+	//the volume setting from the PC (0.0 to 1.0)
+	float volume(void) { return usb_in.volume(); }
+	
+	//is the PC sending audio?
+	bool isStreaming(void) { return usb_audio_receive_setting != 0; }
 
+	//the asynchronous feedback that the Teensy is sending to the PC
+	float getFeedback_samplesPerFrame(void) { return ((float)usb_audio_sync_feedback) / USB_AUDIO_F32_FEEDBACK_SCALE; }
+	float getRequestedSampleRate_Hz(void) { return getFeedback_samplesPerFrame() * USB_AUDIO_F32_FRAMES_PER_SEC; }
+
+	//updates where the USB had no audio waiting (after streaming has started)
+	unsigned long getMissedBlockCount(void) { return missed_block_count; }
+	void resetMissedBlockCount(void) { missed_block_count = 0; }
+	
+private:    
+	unsigned long missed_block_count = 0;
 };
 
 class AudioOutputUSB_F32 : public AudioStream_F32
@@ -86,63 +94,34 @@ class AudioOutputUSB_F32 : public AudioStream_F32
 //GUI: inputs:2, outputs:0 //this line used for automatic generation of GUI node
 //GUI: shortName:usbAudioOut  //this line used for automatic generation of GUI node
 public:
-	AudioOutputUSB_F32() : AudioStream_F32(2, inputQueueArray_f32) {
+	AudioOutputUSB_F32() : AudioStream_F32(USB_AUDIO_F32_NCHAN, inputQueueArray_f32) {
 		makeConnections();
 	}
 	
-	AudioOutputUSB_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray_f32) {
+	AudioOutputUSB_F32(const AudioSettings_F32 &settings) : AudioStream_F32(USB_AUDIO_F32_NCHAN, inputQueueArray_f32) {
 		makeConnections();
 	}
 	
 	void makeConnections(void) {
 		//make the audio connections
-		patchCord100_L = new AudioConnection_F32(queue_L, 0, f32_to_i16_L, 0);  //noise is an Int16 audio object.  So, convert it!
-    	patchCord100_R = new AudioConnection_F32(queue_R, 0, f32_to_i16_R, 0);  //noise is an Int16 audio object.  So, convert it!
-    	patchCord101_L = new AudioConnection(f32_to_i16_L, 0, usb_out, 0); //Int16 audio connection
-		patchCord101_R = new AudioConnection(f32_to_i16_R, 0, usb_out, 1); //Int16 audio connection
+		patchCord101_L = new AudioConnection(bridge, 0, usb_out, 0); //Int16 audio connection
+		patchCord101_R = new AudioConnection(bridge, 1, usb_out, 1); //Int16 audio connection
 	}
 	
 	//define audio processing blocks.
-    AudioPlayQueue_F32    queue_L,queue_R;    
-	AudioConvert_F32toI16   f32_to_i16_L, f32_to_i16_R; 
-    AudioOutputUSB  	    usb_out; //from the original Teensy Audio Library, expects Int16 audio data
+	AudioUSBBridge_I16	bridge;
+	AudioOutputUSB  	usb_out; //from the original Teensy Audio Library, expects Int16 audio data
     
 	//define the audio connections
-    AudioConnection_F32     *patchCord100_L, *patchCord100_R;
-    AudioConnection *patchCord101_L, *patchCord101_R;
+	AudioConnection *patchCord101_L, *patchCord101_R;
 	
-    void update(void) {
-		//Serial.println("AudioSynthNoiseWhite_F32: update().");
-		//queue_L.begin();
-		//queue_R.begin();
-		
-		//is there audio waiting for us for the left channel?
-		audio_block_f32_t *block;
-		block = receiveReadOnly_f32(0); 
-		if (!block) return; //if no audio, return now.
-		
-		//there is some audio, so execute the processing chain for the left channel
-		queue_L.playAudioBlock(block);
-		AudioStream_F32::release(block);
-		queue_L.update();
-		f32_to_i16_L.update();
-		
-		//see if there is a right channel
-		block = receiveReadOnly_f32(1); 
-		if (block) {
-			//there is a right channel.  process it now
-			queue_R.playAudioBlock(block);
-			AudioStream_F32::release(block);
-			queue_R.update();
-			f32_to_i16_R.update();
-		}
-		
-		//whether or not there was right-channel audio, update the usb_out
-		usb_out.update();
-		return;
-    }
+	void update(void);
+
+	//is the PC listening?
+	bool isStreaming(void) { return usb_audio_transmit_setting != 0; }
+
 private:    
-	audio_block_f32_t *inputQueueArray_f32[2];
+	audio_block_f32_t *inputQueueArray_f32[USB_AUDIO_F32_NCHAN];
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -32,6 +32,7 @@
  
 #include "input_i2s_f32.h"
 #include "output_i2s_f32.h"
+#include "utility/convert_f32.h"
 #include <arm_math.h>
 
 //audio_block_t * AudioInputI2S_F32::block_left = NULL;
@@ -41,10 +42,20 @@ audio_block_f32_t * AudioInputI2S_F32::block_right_f32 = NULL;
 uint16_t AudioInputI2S_F32::block_offset = 0;
 bool AudioInputI2S_F32::update_responsibility = false;
 //DMAMEM static uint32_t i2s_rx_buffer[AUDIO_BLOCK_SAMPLES];  //minimum for stereo 16-bit transfers
+#if (I2S_DMA_RING_MAX_FRAMES > AUDIO_BLOCK_SAMPLES)
+//big enough for the DMA ring, and aligned so that the DMA's address modulo can wrap it.  The double buffer uses the first audio_block_samples frames.
+DMAMEM __attribute__((aligned(I2S_DMA_RING_MAX_FRAMES*8))) static int32_t i2s_rx_buffer[2*I2S_DMA_RING_MAX_FRAMES];
+#else
 DMAMEM static int32_t i2s_rx_buffer[2*AUDIO_BLOCK_SAMPLES];//minimum for stereo 32-bit transfers
+#endif
 DMAChannel AudioInputI2S_F32::dma(false);
+AudioDMARing AudioInputI2S_F32::rx_ring;
+bool AudioInputI2S_F32::use_dma_ring = false;
+int AudioInputI2S_F32::dma_period_samples = 0;
+int AudioInputI2S_F32::dma_num_periods = 2;
 int AudioInputI2S_F32::flag_out_of_memory = 0;
 unsigned long AudioInputI2S_F32::update_counter = 0;
+volatile int AudioInputI2S_F32::word_bits = 32;
 
 float AudioInputI2S_F32::sample_rate_Hz = AUDIO_SAMPLE_RATE;
 int AudioInputI2S_F32::audio_block_samples = AUDIO_BLOCK_SAMPLES;
@@ -67,6 +78,8 @@ void AudioInputI2S_F32::begin(bool transferUsing32bit) {
 	
 	AudioOutputI2S_F32::sample_rate_Hz = sample_rate_Hz; //these were given in the AudioSettings in the contructor
 	AudioOutputI2S_F32::audio_block_samples = audio_block_samples;//these were given in the AudioSettings in the contructor
+	AudioOutputI2S_F32::dma_period_samples = dma_period_samples;
+	AudioOutputI2S_F32::dma_num_periods = dma_num_periods;
 	
 	//setup I2S parameters
 	AudioOutputI2S_F32::config_i2s(transferUsing32bit);
@@ -75,11 +88,23 @@ void AudioInputI2S_F32::begin(bool transferUsing32bit) {
 	CORE_PIN13_CONFIG = PORT_PCR_MUX(4); // pin 13, PTC5, I2S0_RXD0
 	
 	// setup DMA parameters
+	use_dma_ring = false;
+	if ((dma_period_samples > 0) || (dma_num_periods > 2)) {
+		use_dma_ring = rx_ring.configure(audio_block_samples, dma_period_samples, dma_num_periods, I2S_DMA_RING_MAX_FRAMES);
+		if (!use_dma_ring) {
+			Serial.println("AudioInputI2S_F32: *** WARNING ***: DMA ring settings not possible.  Using the double buffer.");
+			if (I2S_DMA_RING_MAX_FRAMES == 0) Serial.println("    : the DMA ring needs the library built with -DI2S_DMA_RING_MAX_FRAMES=1024 (for example).");
+		}
+	}
+	if (use_dma_ring) {
+		sub_begin_ring();
+	} else {
 	//if (transferUsing32bit) {
 		sub_begin_i32();
 	//} else {
 	//	sub_begin_i16();
 	//}
+	}
 	
 	// finish DMA setup
 	dma.triggerAtHardwareEvent(DMAMUX_SOURCE_I2S0_RX);
@@ -90,11 +115,15 @@ void AudioInputI2S_F32::begin(bool transferUsing32bit) {
 	I2S0_RCSR |= I2S_RCSR_RE | I2S_RCSR_BCE | I2S_RCSR_FRDE | I2S_RCSR_FR;
 	I2S0_TCSR |= I2S_TCSR_TE | I2S_TCSR_BCE; // TX clock enable, because sync'd to TX
 	
+	if (use_dma_ring) {
+		dma.attachInterrupt(isr_ring);
+	} else {
 	//if (transferUsing32bit) {
 		dma.attachInterrupt(isr_32);
 	//} else {
 	//	dma.attachInterrupt(isr_16);
 	//}
+	}
 	
 	update_counter = 0;
 }
@@ -149,6 +178,34 @@ void AudioInputI2S_F32::sub_begin_i32(void)
 	dma.TCD->CSR = DMA_TCD_CSR_INTHALF | DMA_TCD_CSR_INTMAJOR;
 };
 
+//DMA ring: one interrupt per period.  See AudioOutputI2S_F32::sub_begin_ring()
+void AudioInputI2S_F32::sub_begin_ring(void)
+{
+	const int ring_frames = rx_ring.getRingFrames();
+	const int period_frames = rx_ring.getPeriodFrames();
+	
+	dma.TCD->SADDR = (void *)((uint32_t)&I2S0_RDR0);
+	dma.TCD->SOFF = 0;
+	dma.TCD->ATTR = DMA_TCD_ATTR_SSIZE(DMA_TCD_ATTR_SIZE_32BIT) | DMA_TCD_ATTR_DSIZE(DMA_TCD_ATTR_SIZE_32BIT);
+	dma.TCD->NBYTES_MLNO = 4;  //one sample (left or right) per minor loop
+	dma.TCD->SLAST = 0;
+	dma.TCD->DADDR = i2s_rx_buffer;
+	dma.TCD->DOFF = 4;
+	if (rx_ring.usesAddressModulo()) {
+		//the destination address wraps at the end of the ring by itself (the buffer is aligned to its size)
+		dma.TCD->ATTR |= DMA_TCD_ATTR_DMOD(AudioDMARing::log2_int(ring_frames*2*sizeof(i2s_rx_buffer[0])));
+		dma.TCD->DLASTSGA = 0;
+		dma.TCD->CITER_ELINKNO = period_frames*2;
+		dma.TCD->BITER_ELINKNO = period_frames*2;
+		dma.TCD->CSR = DMA_TCD_CSR_INTMAJOR;
+	} else {
+		dma.TCD->DLASTSGA = -ring_frames*2*sizeof(i2s_rx_buffer[0]);
+		dma.TCD->CITER_ELINKNO = ring_frames*2;
+		dma.TCD->BITER_ELINKNO = ring_frames*2;
+		dma.TCD->CSR = DMA_TCD_CSR_INTHALF | DMA_TCD_CSR_INTMAJOR;
+	}
+}
+
 /* void AudioInputI2S_F32::isr_16(void)
 {
 	uint32_t daddr, offset;
@@ -247,13 +304,8 @@ void AudioInputI2S_F32::isr_32(void)
 			dest_right_f32 = &(right_f32->data[offset]);
 			//AudioInputI2S_F32::block_offset = offset + AUDIO_BLOCK_SAMPLES/2;	//original
 			AudioInputI2S_F32::block_offset = offset + audio_block_samples/2;
-			do {
-				//n = *src++;
-				// *dest_left++ = (int16_t)n;
-				// *dest_right++ = (int16_t)(n >> 16);
-				*dest_left_f32++ = (float32_t) *src_i32++; 
-				*dest_right_f32++ = (float32_t) *src_i32++;
-			} while (src_i32 < end_i32);
+			//de-interleave, sign-extend, and scale to +/-1.0 all in one pass over the DMA buffer
+			deinterleave_i32_to_f32_2chan(src_i32, dest_left_f32, dest_right_f32, (end_i32 - src_i32)/2, word_bits);
 		}
 		flag_beenSuccessfullOnce = true;
 	} else {
@@ -265,6 +317,17 @@ void AudioInputI2S_F32::isr_32(void)
 	}
 }
 
+//DMA ring: the interrupt only keeps count.  update() reads straight from the ring.
+void AudioInputI2S_F32::isr_ring(void)
+{
+	dma.clearInterrupt();
+	if ((rx_ring.periodDone() > 0) && AudioInputI2S_F32::update_responsibility) AudioStream_F32::update_all();
+}
+
+uint32_t AudioInputI2S_F32::ringFramesNow(void) {
+	return rx_ring.framesNow(((uint32_t)(dma.TCD->DADDR) - (uint32_t)i2s_rx_buffer) / 8);  //8 bytes per stereo frame
+}
+
 #define I16_TO_F32_NORM_FACTOR (3.051850947599719e-05)  //which is 1/32767 
 void AudioInputI2S_F32::scale_i16_to_f32( float32_t *p_i16, float32_t *p_f32, int len) {
 	for (int i=0; i<len; i++) { *p_f32++ = ((*p_i16++) * I16_TO_F32_NORM_FACTOR); }
@@ -368,8 +431,7 @@ void AudioInputI2S_F32::scale_i32_to_f32( float32_t *p_i32, float32_t *p_f32, in
  void AudioInputI2S_F32::update_1chan(int chan, audio_block_f32_t *&out_f32) {
 	 if (!out_f32) return;
 	 
-	//scale the float values so that the maximum possible audio values span -1.0 to + 1.0
-	scale_i32_to_f32(out_f32->data, out_f32->data, audio_block_samples);
+	//no scaling needed here.  isr_32() already converted the data to span -1.0 to +1.0
 
 	//prepare to transmit by setting the update_counter (which helps tell if data is skipped or out-of-order)
 	out_f32->id = update_counter;
@@ -383,6 +445,8 @@ void AudioInputI2S_F32::scale_i32_to_f32( float32_t *p_i32, float32_t *p_f32, in
  
 void AudioInputI2S_F32::update(void)
 {
+	if (use_dma_ring) { update_ring(); return; }
+	
 	static bool flag_beenSuccessfullOnce = false;
 	audio_block_f32_t *new_left_f32=NULL, *new_right_f32=NULL, *out_left_f32=NULL, *out_right_f32=NULL;
 
@@ -439,6 +503,41 @@ void AudioInputI2S_F32::update(void)
 	}
 }
 
+//DMA ring: convert the oldest unread block straight out of the ring
+void AudioInputI2S_F32::update_ring(void)
+{
+	__disable_irq();
+	bool more = rx_ring.updateStarted();
+	uint32_t now = ringFramesNow();
+	__enable_irq();
+	if (more && update_responsibility) AudioStream_F32::update_all();  //the DMA ran more than one block since the last update
+	
+	int idx = rx_ring.startRead(now);
+	if (idx < 0) return;  //not a whole block yet
+	
+	audio_block_f32_t *out_left_f32 = AudioStream_F32::allocate_f32();
+	audio_block_f32_t *out_right_f32 = AudioStream_F32::allocate_f32();
+	if ((!out_left_f32) || (!out_right_f32)) {
+		//ran out of memory.  This block is lost.
+		if (out_left_f32) AudioStream_F32::release(out_left_f32);
+		if (out_right_f32) AudioStream_F32::release(out_right_f32);
+		flag_out_of_memory = 1;
+		return;
+	}
+	
+	//the block might wrap around the end of the ring
+	const int ring_frames = rx_ring.getRingFrames();
+	int n1 = min(audio_block_samples, ring_frames - idx);
+	deinterleave_i32_to_f32_2chan(&i2s_rx_buffer[2*idx], out_left_f32->data, out_right_f32->data, n1, word_bits);
+	if (n1 < audio_block_samples) {
+		deinterleave_i32_to_f32_2chan(&i2s_rx_buffer[0], out_left_f32->data+n1, out_right_f32->data+n1, audio_block_samples-n1, word_bits);
+	}
+	
+	update_counter++;
+	update_1chan(0,out_left_f32);  //uses update_counter
+	update_1chan(1,out_right_f32);
+}
+
 
 /******************************************************************/
 
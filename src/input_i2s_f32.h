@@ -37,6 +37,7 @@
 #include "AudioStream_F32.h"
 #include "AudioStream.h"
 #include "DMAChannel.h"
+#include "utility/dma_ring.h"
 
 class AudioInputI2S_F32 : public AudioStream_F32
 {
@@ -46,6 +47,8 @@ public:
 	AudioInputI2S_F32(const AudioSettings_F32 &settings) : AudioStream_F32(0, NULL) { 
 		sample_rate_Hz = settings.sample_rate_Hz;
 		audio_block_samples = settings.audio_block_samples;
+		dma_period_samples = settings.dma_period_samples;
+		dma_num_periods = settings.dma_num_periods;
 		begin(); 
 	}
 	
@@ -59,13 +62,27 @@ public:
 	//void sub_begin_i16(void);
 	int get_isOutOfMemory(void) { return flag_out_of_memory; }
 	void clear_isOutOfMemory(void) { flag_out_of_memory = 0; }
-	//friend class AudioOutputI2S_F32;
+	
+	//How many data bits does the codec put in each 32-bit I2S slot?  Use 32 (the default) for normal
+	//MSB-first I2S data of any resolution, which includes the AIC3206's 24-bit samples.  Use 24 or 16
+	//only if the codec is set to right-justified mode with that word length.  Can be changed at any time.
+	int setWordBits(int bits) { if ((bits == 16) || (bits == 24)) { word_bits = bits; } else { word_bits = 32; } return word_bits; }
+	int getWordBits(void) { return word_bits; }
+	friend class AudioOutputI2S_F32;
 protected:	
 	AudioInputI2S_F32(int dummy): AudioStream_F32(0, NULL) {} // to be used only inside AudioInputI2Sslave !!
 	static bool update_responsibility;
 	static DMAChannel dma;
 	static void isr_32(void);
 	virtual void update_1chan(int, audio_block_f32_t *&);
+	static void isr_ring(void);
+	void sub_begin_ring(void);
+	void update_ring(void);
+	static uint32_t ringFramesNow(void);  //call with interrupts disabled
+	static AudioDMARing rx_ring;
+	static bool use_dma_ring;
+	static int dma_period_samples;
+	static int dma_num_periods;
 private:
 	static audio_block_f32_t *block_left_f32;
 	static audio_block_f32_t *block_right_f32;
@@ -74,6 +91,7 @@ private:
 	static uint16_t block_offset;
 	static int flag_out_of_memory;
 	static unsigned long update_counter;
+	static volatile int word_bits;
 };
 
 
@@ -33,8 +33,9 @@
 #include <Arduino.h>
 #include "input_i2s_quad_f32.h"
 #include "output_i2s_quad_f32.h"
+#include "utility/convert_f32.h"
 
-DMAMEM static uint32_t i2s_rx_buffer[AUDIO_BLOCK_SAMPLES/2*4];
+DMAMEM static uint32_t i2s_rx_buffer[AUDIO_BLOCK_SAMPLES*4];  //big enough for 4 channels of 32-bit slots
 audio_block_f32_t * AudioInputI2SQuad_F32::block_ch1 = NULL;
 audio_block_f32_t * AudioInputI2SQuad_F32::block_ch2 = NULL;
 audio_block_f32_t * AudioInputI2SQuad_F32::block_ch3 = NULL;
@@ -47,7 +48,7 @@ int AudioInputI2SQuad_F32::flag_out_of_memory = 0;
 float AudioInputI2SQuad_F32::sample_rate_Hz = AUDIO_SAMPLE_RATE;
 int AudioInputI2SQuad_F32::audio_block_samples = AUDIO_BLOCK_SAMPLES;
 
-#define I2S_BUFFER_TO_USE_BYTES ((AudioOutputI2SQuad_F32::audio_block_samples)*4*(sizeof(i2s_rx_buffer[0])/2))
+#define I2S_BUFFER_TO_USE_BYTES ((AudioOutputI2SQuad_F32::audio_block_samples)*4*(AudioOutputI2SQuad_F32::i2s_word_bits/8))
 
 
 #if defined(__MK20DX256__) || defined(__MK64FX512__) || defined(__MK66FX1M0__)
@@ -71,20 +72,26 @@ void AudioInputI2SQuad_F32::begin(void)
 
 
 #if defined(KINETISK)
+	//each minor loop reads one slot from RDR0 and the same slot from RDR1 (SMOD(3) wraps the source back to RDR0)
+	const int bytes_per_word = AudioOutputI2SQuad_F32::i2s_word_bits / 8;
 	dma.TCD->SADDR = &I2S0_RDR0;
 	dma.TCD->SOFF = 4;
-	dma.TCD->ATTR = DMA_TCD_ATTR_SSIZE(1) | DMA_TCD_ATTR_SMOD(3) | DMA_TCD_ATTR_DSIZE(1);
-	dma.TCD->NBYTES_MLNO = 4;
+	if (bytes_per_word == 4) {
+		dma.TCD->ATTR = DMA_TCD_ATTR_SSIZE(DMA_TCD_ATTR_SIZE_32BIT) | DMA_TCD_ATTR_SMOD(3) | DMA_TCD_ATTR_DSIZE(DMA_TCD_ATTR_SIZE_32BIT);
+	} else {
+		dma.TCD->ATTR = DMA_TCD_ATTR_SSIZE(1) | DMA_TCD_ATTR_SMOD(3) | DMA_TCD_ATTR_DSIZE(1);
+	}
+	dma.TCD->NBYTES_MLNO = 2*bytes_per_word;
 	dma.TCD->SLAST = 0;
 	dma.TCD->DADDR = i2s_rx_buffer;
-	dma.TCD->DOFF = 2;
+	dma.TCD->DOFF = bytes_per_word;
 	//dma.TCD->CITER_ELINKNO = sizeof(i2s_rx_buffer) / 4; //original quad
 	//dma.TCD->DLASTSGA = -sizeof(i2s_rx_buffer			//original quad
 	//dma.TCD->BITER_ELINKNO = sizeof(i2s_rx_buffer) / 4; //original quad
 	
-	dma.TCD->CITER_ELINKNO = I2S_BUFFER_TO_USE_BYTES/ 4; //new quad, enable diff len audio blocks
+	dma.TCD->CITER_ELINKNO = I2S_BUFFER_TO_USE_BYTES / (2*bytes_per_word); //new quad, enable diff len audio blocks
 	dma.TCD->DLASTSGA = -I2S_BUFFER_TO_USE_BYTES;			//new quad, enable diff len audio blocks
-	dma.TCD->BITER_ELINKNO = I2S_BUFFER_TO_USE_BYTES / 4;//new quad, enable diff len audio blocks
+	dma.TCD->BITER_ELINKNO = I2S_BUFFER_TO_USE_BYTES / (2*bytes_per_word);//new quad, enable diff len audio blocks
 	
 	dma.TCD->CSR = DMA_TCD_CSR_INTHALF | DMA_TCD_CSR_INTMAJOR;
 #endif
@@ -100,7 +107,7 @@ void AudioInputI2SQuad_F32::begin(void)
 void AudioInputI2SQuad_F32::isr(void)
 {
 	uint32_t daddr, offset;
-	const int16_t *src;  //*end;
+	const uint8_t *src;  //*end;
 	float32_t *dest1_f32, *dest2_f32, *dest3_f32, *dest4_f32;
 
 	//digitalWriteFast(3, HIGH);
@@ -111,14 +118,12 @@ void AudioInputI2SQuad_F32::isr(void)
 	if (daddr < (uint32_t)i2s_rx_buffer + I2S_BUFFER_TO_USE_BYTES / 2) { //new quad, enable diff audio block lengths
 		// DMA is receiving to the first half of the buffer
 		// need to remove data from the second half
-		src = (int16_t *)&i2s_rx_buffer[audio_block_samples];
-		//end = (int16_t *)&i2s_rx_buffer[audio_block_samples*2];
+		src = ((const uint8_t *)i2s_rx_buffer) + I2S_BUFFER_TO_USE_BYTES / 2;
 		if (AudioInputI2SQuad_F32::update_responsibility) AudioStream_F32::update_all();
 	} else {
 		// DMA is receiving to the second half of the buffer
 		// need to remove data from the first half
-		src = (int16_t *)&i2s_rx_buffer[0];
-		//end = (int16_t *)&i2s_rx_buffer[audio_block_samples];
+		src = (const uint8_t *)i2s_rx_buffer;
 	}
 	
 	//De-interleave and copy to destination audio buffers.  
@@ -131,11 +136,11 @@ void AudioInputI2SQuad_F32::isr(void)
 			dest2_f32 = &(block_ch2->data[offset]);
 			dest3_f32 = &(block_ch3->data[offset]);
 			dest4_f32 = &(block_ch4->data[offset]);
-			for (int i=0; i < audio_block_samples/2; i++) {
-				*dest1_f32++ = (float32_t) *src++; //will need to scale this in update()
-				*dest3_f32++ = (float32_t) *src++;//will need to scale this in update()
-				*dest2_f32++ = (float32_t) *src++;//will need to scale this in update()
-				*dest4_f32++ = (float32_t) *src++;//will need to scale this in update()
+			//de-interleave and scale to +/-1.0 in one pass (note the channel order passed to the converter)
+			if (AudioOutputI2SQuad_F32::i2s_word_bits == 32) {
+				deinterleave_i32_to_f32_4chan((const int32_t *)src, dest1_f32, dest3_f32, dest2_f32, dest4_f32, audio_block_samples/2);
+			} else {
+				deinterleave_i16_to_f32_4chan((const int16_t *)src, dest1_f32, dest3_f32, dest2_f32, dest4_f32, audio_block_samples/2);
 			}
 		}
 	} //else {
@@ -160,8 +165,7 @@ void AudioInputI2SQuad_F32::scale_i32_to_f32( float32_t *p_i32, float32_t *p_f32
 void AudioInputI2SQuad_F32::update_1chan(int chan, audio_block_f32_t *&out_block) {
 	if (!out_block) return;
 		
-	//scale the float values so that the maximum possible audio values span -1.0 to + 1.0
-	scale_i16_to_f32(out_block->data, out_block->data, audio_block_samples);
+	//no scaling needed here.  isr() already converted the data to span -1.0 to +1.0
 	
 	//prepare to transmit by setting the update_counter (which helps tell if data is skipped or out-of-order)
 	out_block->id = update_counter;
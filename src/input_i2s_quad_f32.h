@@ -37,6 +37,7 @@
 #include "AudioStream_F32.h"
 #include "AudioStream.h"
 #include "DMAChannel.h"
+#include "output_i2s_quad_f32.h"  //for the shared I2S word size
 
 class AudioInputI2SQuad_F32 : public AudioStream_F32
 {
@@ -48,6 +49,14 @@ public:
 		audio_block_samples = settings.audio_block_samples;
 		begin(); 
 	}
+	//i2s_word_bits is 16 (the original format) or 32 (all 24 bits from the AIC3206).  See AudioOutputI2SQuad_F32.
+	AudioInputI2SQuad_F32(const AudioSettings_F32 &settings, const int i2s_word_bits) : AudioStream_F32(0, NULL) { 
+		sample_rate_Hz = settings.sample_rate_Hz;
+		audio_block_samples = settings.audio_block_samples;
+		AudioOutputI2SQuad_F32::setI2SWordBits(i2s_word_bits);
+		begin(); 
+	}
+	int getI2SWordBits(void) { return AudioOutputI2SQuad_F32::getI2SWordBits(); }
 	virtual void update(void);
 	static void scale_i16_to_f32( float32_t *p_i16, float32_t *p_f32, int len) ;
 	static void scale_i24_to_f32( float32_t *p_i24, float32_t *p_f32, int len) ;
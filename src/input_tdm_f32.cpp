@@ -0,0 +1,205 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2014, Paul Stoffregen, paul@pjrc.com
+ *
+ * Development of this audio library was funded by PJRC.COM, LLC by sales of
+ * Teensy and Audio Adaptor boards.  Please support PJRC's efforts to develop
+ * open source software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+ 
+ /* 
+ *  Extended by OpenAudio, Oct 2026
+ *  Converted to F32, to variable audio block length, and to 8 or 16 slots of 16, 24, or 32-bit words.
+ *	The F32 conversion is under the MIT License.  Use at your own risk.
+ */
+
+#include <Arduino.h>
+#include "input_tdm_f32.h"
+#include "output_tdm_f32.h"
+#include "utility/convert_f32.h"
+
+DMAMEM static uint32_t tdm_rx_buffer[AUDIO_BLOCK_SAMPLES*8];  //big enough for 8 slots of 32 bits or 16 slots of 16 bits
+audio_block_f32_t * AudioInputTDM_F32::block[TDM_F32_MAX_SLOTS];
+uint32_t AudioInputTDM_F32::block_offset = 0;
+bool AudioInputTDM_F32::update_responsibility = false;
+DMAChannel AudioInputTDM_F32::dma(false);
+int AudioInputTDM_F32::flag_out_of_memory = 0;
+
+float AudioInputTDM_F32::sample_rate_Hz = AUDIO_SAMPLE_RATE;
+int AudioInputTDM_F32::audio_block_samples = AUDIO_BLOCK_SAMPLES;
+
+
+#if defined(__MK20DX256__) || defined(__MK64FX512__) || defined(__MK66FX1M0__)
+
+void AudioInputTDM_F32::begin(void)
+{
+	dma.begin(true); // Allocate the DMA channel first
+
+	AudioOutputTDM_F32::sample_rate_Hz = sample_rate_Hz;  //these were given in the AudioSettings in the Contructor
+	AudioOutputTDM_F32::audio_block_samples = audio_block_samples;//these were given in the AudioSettings in the Contructor
+
+	AudioOutputTDM_F32::config_tdm();
+	CORE_PIN13_CONFIG = PORT_PCR_MUX(4); // pin 13, PTC5, I2S0_RXD0
+
+#if defined(KINETISK)
+	//each minor loop reads one slot from RDR0
+	const int bytes_per_slot = AudioOutputTDM_F32::slot_bits / 8;
+	const int buffer_bytes = AudioOutputTDM_F32::getBufferBytes();
+	dma.TCD->SADDR = &I2S0_RDR0;
+	dma.TCD->SOFF = 0;
+	if (bytes_per_slot == 4) {
+		dma.TCD->ATTR = DMA_TCD_ATTR_SSIZE(DMA_TCD_ATTR_SIZE_32BIT) | DMA_TCD_ATTR_DSIZE(DMA_TCD_ATTR_SIZE_32BIT);
+	} else {
+		dma.TCD->ATTR = DMA_TCD_ATTR_SSIZE(1) | DMA_TCD_ATTR_DSIZE(1);
+	}
+	dma.TCD->NBYTES_MLNO = bytes_per_slot;
+	dma.TCD->SLAST = 0;
+	dma.TCD->DADDR = tdm_rx_buffer;
+	dma.TCD->DOFF = bytes_per_slot;
+	dma.TCD->CITER_ELINKNO = buffer_bytes / bytes_per_slot;
+	dma.TCD->DLASTSGA = -buffer_bytes;
+	dma.TCD->BITER_ELINKNO = buffer_bytes / bytes_per_slot;
+	dma.TCD->CSR = DMA_TCD_CSR_INTHALF | DMA_TCD_CSR_INTMAJOR;
+#endif
+	dma.triggerAtHardwareEvent(DMAMUX_SOURCE_I2S0_RX);
+	update_responsibility = update_setup();
+	dma.enable();
+
+	I2S0_RCSR |= I2S_RCSR_RE | I2S_RCSR_BCE | I2S_RCSR_FRDE | I2S_RCSR_FR;
+	I2S0_TCSR |= I2S_TCSR_TE | I2S_TCSR_BCE; // TX clock enable, because sync'd to TX
+	dma.attachInterrupt(isr);
+}
+
+void AudioInputTDM_F32::isr(void)
+{
+	uint32_t daddr, offset;
+	const uint8_t *src;
+	const int buffer_bytes = AudioOutputTDM_F32::getBufferBytes();
+	const int n_slots = AudioOutputTDM_F32::n_slots;
+
+	daddr = (uint32_t)(dma.TCD->DADDR);
+	dma.clearInterrupt();
+
+	if (daddr < (uint32_t)tdm_rx_buffer + buffer_bytes / 2) {
+		// DMA is receiving to the first half of the buffer
+		// need to remove data from the second half
+		src = ((const uint8_t *)tdm_rx_buffer) + buffer_bytes / 2;
+		if (AudioInputTDM_F32::update_responsibility) AudioStream_F32::update_all();
+	} else {
+		// DMA is receiving to the second half of the buffer
+		// need to remove data from the first half
+		src = (const uint8_t *)tdm_rx_buffer;
+	}
+
+	//De-interleave, scale to +/-1.0, and copy to the destination audio blocks, in one pass
+	if (block[0]) {  //update() gives us blocks for all of the slots, or for none
+		offset = AudioInputTDM_F32::block_offset;
+		if (offset <= (uint32_t)(audio_block_samples/2)) {
+			AudioInputTDM_F32::block_offset = offset + audio_block_samples/2;
+			float32_t *dest[TDM_F32_MAX_SLOTS];
+			for (int i=0; i < n_slots; i++) dest[i] = &(block[i]->data[offset]);
+			if (AudioOutputTDM_F32::slot_bits == 32) {
+				deinterleave_i32_to_f32((const int32_t *)src, dest, audio_block_samples/2, n_slots);
+			} else {
+				deinterleave_i16_to_f32((const int16_t *)src, dest, audio_block_samples/2, n_slots);
+			}
+		}
+	}
+}
+
+void AudioInputTDM_F32::update_1chan(int chan, audio_block_f32_t *&out_block) {
+	if (!out_block) return;
+		
+	//no scaling needed here.  isr() already converted the data to span -1.0 to +1.0
+	
+	//prepare to transmit by setting the update_counter (which helps tell if data is skipped or out-of-order)
+	out_block->id = update_counter;
+
+	// then transmit and release the DMA's former blocks
+	AudioStream_F32::transmit(out_block, chan);
+	AudioStream_F32::release(out_block);
+}
+
+void AudioInputTDM_F32::update(void)
+{
+	const int n_slots = AudioOutputTDM_F32::n_slots;
+	audio_block_f32_t *new_block[TDM_F32_MAX_SLOTS], *out_block[TDM_F32_MAX_SLOTS];
+
+	// allocate one new block per slot, but if any fails, allocate none
+	bool all_ok = true;
+	for (int i=0; i < n_slots; i++) {
+		new_block[i] = AudioStream_F32::allocate_f32();
+		if (!new_block[i]) all_ok = false;
+	}
+	if (!all_ok) {
+		flag_out_of_memory = 1;
+		for (int i=0; i < n_slots; i++) {
+			if (new_block[i]) AudioStream_F32::release(new_block[i]);
+			new_block[i] = NULL;
+		}
+	}
+
+	__disable_irq();
+	if (block_offset >= (uint32_t)audio_block_samples) {
+		// the DMA filled the blocks, so grab them and get the
+		// new blocks to the DMA, as quickly as possible
+		for (int i=0; i < n_slots; i++) {
+			out_block[i] = block[i];
+			block[i] = new_block[i];
+		}
+		block_offset = 0;
+		__enable_irq();
+		
+		//service the data that we just got out of the DMA
+		update_counter++;
+		for (int i=0; i < n_slots; i++) update_1chan(i, out_block[i]);
+		
+	} else if (new_block[0] != NULL) {
+		// the DMA didn't fill blocks, but we allocated blocks
+		if (block[0] == NULL) {
+			// the DMA doesn't have any blocks to fill, so
+			// give it the ones we just allocated
+			for (int i=0; i < n_slots; i++) block[i] = new_block[i];
+			block_offset = 0;
+			__enable_irq();
+		} else {
+			// the DMA already has blocks, doesn't need these
+			__enable_irq();
+			for (int i=0; i < n_slots; i++) AudioStream_F32::release(new_block[i]);
+		}
+	} else {
+		// The DMA didn't fill blocks, and we could not allocate
+		// memory... the system is likely starving for memory!
+		// Sadly, there's nothing we can do.
+		__enable_irq();
+	}
+}
+
+#else // not __MK20DX256__
+
+void AudioInputTDM_F32::begin(void)
+{
+}
+
+void AudioInputTDM_F32::update(void)
+{
+}
+
+#endif
@@ -0,0 +1,83 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2014, Paul Stoffregen, paul@pjrc.com
+ *
+ * Development of this audio library was funded by PJRC.COM, LLC by sales of
+ * Teensy and Audio Adaptor boards.  Please support PJRC's efforts to develop
+ * open source software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+ 
+ /* 
+ *  Extended by OpenAudio, Oct 2026
+ *  Converted to F32, to variable audio block length, and to 8 or 16 slots of 16, 24, or 32-bit words.
+ *	The F32 conversion is under the MIT License.  Use at your own risk.
+ */
+
+//Receives 8 or 16 channels on one TDM data line (pin 13).  See output_tdm_f32.h for the formats and clocks.
+//The DMA interrupt converts and de-interleaves the slots straight into one F32 audio block per channel.
+//Every update() needs one free audio block per slot, so allow for them in AudioMemory_F32().
+
+#ifndef _input_tdm_f32_h_
+#define _input_tdm_f32_h_
+
+#include "Arduino.h"
+#include "AudioStream_F32.h"
+#include "DMAChannel.h"
+#include "output_tdm_f32.h"  //for the shared TDM format
+
+class AudioInputTDM_F32 : public AudioStream_F32
+{
+//GUI: inputs:0, outputs:16  //this line used for automatic generation of GUI nodes
+public:
+	AudioInputTDM_F32(void) : AudioStream_F32(0, NULL) { begin(); }
+	AudioInputTDM_F32(const AudioSettings_F32 &settings) : AudioStream_F32(0, NULL) { 
+		sample_rate_Hz = settings.sample_rate_Hz;
+		audio_block_samples = settings.audio_block_samples;
+		begin(); 
+	}
+	//n_slots is 8 or 16.  word_bits is 16, 24, or 32.  See AudioOutputTDM_F32.
+	AudioInputTDM_F32(const AudioSettings_F32 &settings, const int n_slots, const int word_bits) : AudioStream_F32(0, NULL) { 
+		sample_rate_Hz = settings.sample_rate_Hz;
+		audio_block_samples = settings.audio_block_samples;
+		AudioOutputTDM_F32::setTDMFormat(n_slots, word_bits);
+		begin(); 
+	}
+	int getNumSlots(void) { return AudioOutputTDM_F32::getNumSlots(); }
+	int getWordBits(void) { return AudioOutputTDM_F32::getWordBits(); }
+	virtual void update(void);
+	void begin(void);
+	int get_isOutOfMemory(void) { return flag_out_of_memory; }
+	void clear_isOutOfMemory(void) { flag_out_of_memory = 0; }
+protected:
+	static bool update_responsibility;
+	static DMAChannel dma;
+	static void isr(void);
+	virtual void update_1chan(int, audio_block_f32_t *&);
+private:
+	static audio_block_f32_t *block[TDM_F32_MAX_SLOTS];
+	static float sample_rate_Hz;
+	static int audio_block_samples;
+	static uint32_t block_offset;
+	static int flag_out_of_memory;
+	unsigned long update_counter=0;
+};
+
+
+#endif
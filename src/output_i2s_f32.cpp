@@ -31,7 +31,8 @@
  */
  
 #include "output_i2s_f32.h"
-//#include "input_i2s_f32.h"
+#include "input_i2s_f32.h"
+#include "utility/convert_f32.h"
 //include "memcpy_audio.h"
 //#include "memcpy_interleave.h"
 #include <arm_math.h>
@@ -90,8 +91,17 @@ uint16_t  AudioOutputI2S_F32::block_left_offset = 0;
 uint16_t  AudioOutputI2S_F32::block_right_offset = 0;
 bool AudioOutputI2S_F32::update_responsibility = false;
 //DMAMEM static uint32_t i2s_tx_buffer[AUDIO_BLOCK_SAMPLES]; //local audio_block_samples should be no larger than global AUDIO_BLOCK_SAMPLES
+#if (I2S_DMA_RING_MAX_FRAMES > AUDIO_BLOCK_SAMPLES)
+//big enough for the DMA ring, and aligned so that the DMA's address modulo can wrap it.  The double buffer uses the first audio_block_samples frames.
+DMAMEM __attribute__((aligned(I2S_DMA_RING_MAX_FRAMES*8))) static int32_t i2s_tx_buffer[2*I2S_DMA_RING_MAX_FRAMES];
+#else
 DMAMEM static int32_t i2s_tx_buffer[2*AUDIO_BLOCK_SAMPLES]; //2 channels at 32-bits per sample.  Local "audio_block_samples" should be no larger than global "AUDIO_BLOCK_SAMPLES"
+#endif
 DMAChannel AudioOutputI2S_F32::dma(false);
+AudioDMARing AudioOutputI2S_F32::tx_ring;
+bool AudioOutputI2S_F32::use_dma_ring = false;
+int AudioOutputI2S_F32::dma_period_samples = 0;
+int AudioOutputI2S_F32::dma_num_periods = 2;
 
 float AudioOutputI2S_F32::sample_rate_Hz = AUDIO_SAMPLE_RATE;
 int AudioOutputI2S_F32::audio_block_samples = AUDIO_BLOCK_SAMPLES;
@@ -121,11 +131,23 @@ void AudioOutputI2S_F32::begin(bool transferUsing32bit) {
 	CORE_PIN22_CONFIG = PORT_PCR_MUX(6); // pin 22, PTC1, I2S0_TXD0
 
 	//setup DMA parameters
+	use_dma_ring = false;
+	if ((dma_period_samples > 0) || (dma_num_periods > 2)) {
+		use_dma_ring = tx_ring.configure(audio_block_samples, dma_period_samples, dma_num_periods, I2S_DMA_RING_MAX_FRAMES);
+		if (!use_dma_ring) {
+			Serial.println("AudioOutputI2S_F32: *** WARNING ***: DMA ring settings not possible.  Using the double buffer.");
+			if (I2S_DMA_RING_MAX_FRAMES == 0) Serial.println("    : the DMA ring needs the library built with -DI2S_DMA_RING_MAX_FRAMES=1024 (for example).");
+		}
+	}
+	if (use_dma_ring) {
+		sub_begin_ring();
+	} else {
 	//if (transferUsing32bit) {
 		sub_begin_i32();
 	//} else {
 	//	sub_begin_i16();
 	//}
+	}
 	
 	dma.triggerAtHardwareEvent(DMAMUX_SOURCE_I2S0_TX);
 	update_responsibility = update_setup();
@@ -133,7 +155,11 @@ void AudioOutputI2S_F32::begin(bool transferUsing32bit) {
 
 	I2S0_TCSR = I2S_TCSR_SR;
 	I2S0_TCSR = I2S_TCSR_TE | I2S_TCSR_BCE | I2S_TCSR_FRDE;
-	dma.attachInterrupt(isr_32);
+	if (use_dma_ring) {
+		dma.attachInterrupt(isr_ring);
+	} else {
+		dma.attachInterrupt(isr_32);
+	}
 	
 	// change the I2S frequencies to make the requested sample rate
 	setI2SFreq(AudioOutputI2S_F32::sample_rate_Hz);
@@ -180,6 +206,34 @@ void AudioOutputI2S_F32::sub_begin_i32(void) {
 	dma.TCD->CSR = DMA_TCD_CSR_INTHALF | DMA_TCD_CSR_INTMAJOR;
 }
 
+//DMA ring: one major loop per period, or (for 2 periods) one major loop for the whole ring with an
+//interrupt at the half and at the end.  Either way, there is one interrupt per period.
+void AudioOutputI2S_F32::sub_begin_ring(void) {
+	const int ring_frames = tx_ring.getRingFrames();
+	const int period_frames = tx_ring.getPeriodFrames();
+	memset(i2s_tx_buffer, 0, ring_frames*2*sizeof(i2s_tx_buffer[0]));
+	
+	dma.TCD->SADDR = i2s_tx_buffer;
+	dma.TCD->SOFF = 4;
+	dma.TCD->ATTR = DMA_TCD_ATTR_SSIZE(DMA_TCD_ATTR_SIZE_32BIT) | DMA_TCD_ATTR_DSIZE(DMA_TCD_ATTR_SIZE_32BIT);
+	dma.TCD->NBYTES_MLNO = 4;   //one sample (left or right) per minor loop
+	dma.TCD->DADDR = &I2S0_TDR0;
+	dma.TCD->DOFF = 0;
+	dma.TCD->DLASTSGA = 0;
+	if (tx_ring.usesAddressModulo()) {
+		//the source address wraps at the end of the ring by itself (the buffer is aligned to its size)
+		dma.TCD->ATTR |= DMA_TCD_ATTR_SMOD(AudioDMARing::log2_int(ring_frames*2*sizeof(i2s_tx_buffer[0])));
+		dma.TCD->SLAST = 0;
+		dma.TCD->CITER_ELINKNO = period_frames*2;
+		dma.TCD->BITER_ELINKNO = period_frames*2;
+		dma.TCD->CSR = DMA_TCD_CSR_INTMAJOR;
+	} else {
+		dma.TCD->SLAST = -ring_frames*2*sizeof(i2s_tx_buffer[0]);
+		dma.TCD->CITER_ELINKNO = ring_frames*2;
+		dma.TCD->BITER_ELINKNO = ring_frames*2;
+		dma.TCD->CSR = DMA_TCD_CSR_INTHALF | DMA_TCD_CSR_INTMAJOR;
+	}
+}
 
 /* void AudioOutputI2S_F32::isr_16(void)
 {
@@ -408,6 +462,31 @@ void AudioOutputI2S_F32::isr_32(void)  //should be called every half of an audio
 
 }
 
+//DMA ring: the interrupt only keeps count.  update() writes straight into the ring.
+void AudioOutputI2S_F32::isr_ring(void)
+{
+	dma.clearInterrupt();
+	int n_updates = tx_ring.periodDone();
+	if (tx_ring.isStarved()) {
+		//the audio updates have stopped.  Don't keep replaying the old audio.
+		memset(&i2s_tx_buffer[2*tx_ring.getStarvedPeriodIndex()], 0, tx_ring.getPeriodFrames()*2*sizeof(i2s_tx_buffer[0]));
+	}
+	if ((n_updates > 0) && AudioOutputI2S_F32::update_responsibility) AudioStream_F32::update_all();
+}
+
+unsigned long AudioOutputI2S_F32::getDMAGlitchCount(void) {
+	unsigned long count = tx_ring.getUnderrunCount() + tx_ring.getOverrunCount() + tx_ring.getSkippedUpdateCount();
+	if (AudioInputI2S_F32::use_dma_ring) {
+		AudioDMARing &rx_ring = AudioInputI2S_F32::rx_ring;
+		count += rx_ring.getUnderrunCount() + rx_ring.getOverrunCount() + rx_ring.getSkippedUpdateCount();
+	}
+	return count;
+}
+void AudioOutputI2S_F32::resetDMAGlitchCount(void) {
+	tx_ring.resetCounts();
+	AudioInputI2S_F32::rx_ring.resetCounts();
+}
+
 void AudioOutputI2S_F32::scale_f32_to_i16(float32_t *p_f32, float32_t *p_i16, int len) {
 	for (int i=0; i<len; i++) { *p_i16++ = max(-32767,min(32767,(*p_f32++) * 32767.f)); }
 }
@@ -431,6 +510,8 @@ void AudioOutputI2S_F32::update(void)
 	//audio_block_t *block = receiveReadOnly();
 	//if (block) release(block);
 
+	if (use_dma_ring) { update_ring(); return; }
+
 	audio_block_f32_t *block_f32;
 	audio_block_f32_t *block_f32_scaled = AudioStream_F32::allocate_f32();
 	audio_block_f32_t *block2_f32_scaled = AudioStream_F32::allocate_f32();
@@ -510,6 +591,40 @@ void AudioOutputI2S_F32::update(void)
 	}
 }
 
+//DMA ring: convert and write the block straight into the ring, at the spot that gives the fixed latency
+void AudioOutputI2S_F32::update_ring(void)
+{
+	static float32_t zeros[AUDIO_BLOCK_SAMPLES];  //stands in for a missing channel
+	AudioDMARing *rx_ring = AudioInputI2S_F32::use_dma_ring ? &AudioInputI2S_F32::rx_ring : NULL;
+	
+	__disable_irq();
+	bool more = tx_ring.updateStarted();
+	uint32_t now = tx_ring.framesNow(((uint32_t)dma.TCD->SADDR - (uint32_t)i2s_tx_buffer) / 8);
+	uint32_t rx_now = rx_ring ? AudioInputI2S_F32::ringFramesNow() : 0;
+	__enable_irq();
+	if (more && update_responsibility) AudioStream_F32::update_all();  //the DMA ran more than one block since the last update
+	
+	int lead = tx_ring.getOutputLead(rx_ring, rx_now);
+	int idx = tx_ring.startWrite(now, lead, rx_ring && rx_ring->isStarted());
+	
+	audio_block_f32_t *block_left = receiveReadOnly_f32(0);
+	audio_block_f32_t *block_right = receiveReadOnly_f32(1);
+	const float32_t *p_left = block_left ? block_left->data : zeros;
+	const float32_t *p_right = block_right ? block_right->data : zeros;
+	
+	//the block might wrap around the end of the ring
+	const int ring_frames = tx_ring.getRingFrames();
+	int n1 = min(audio_block_samples, ring_frames - idx);
+	interleave_f32_to_i32_2chan(p_left, p_right, &i2s_tx_buffer[2*idx], n1);
+	if (n1 < audio_block_samples) {
+		interleave_f32_to_i32_2chan(p_left+n1, p_right+n1, &i2s_tx_buffer[0], audio_block_samples-n1);
+	}
+	
+	//echo the incoming audio out the outputs
+	if (block_left) { AudioStream_F32::transmit(block_left,0); AudioStream_F32::release(block_left); }
+	if (block_right) { AudioStream_F32::transmit(block_right,1); AudioStream_F32::release(block_right); }
+}
+
 
 // MCLK needs to be 48e6 / 1088 * 256 = 11.29411765 MHz -> 44.117647 kHz sample rate
 //
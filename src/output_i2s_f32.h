@@ -37,7 +37,15 @@
 #include "AudioStream_F32.h"
 //include "AudioStream.h"
 #include "DMAChannel.h"
+#include "utility/dma_ring.h"
 
+//Largest DMA ring, in stereo frames, that AudioSettings_F32 can ask for.  The DMA ring needs bigger DMA
+//buffers, aligned to their size, so it is off (0) unless the library is built with a compiler flag such as
+//-DI2S_DMA_RING_MAX_FRAMES=1024 (a power of two, at least 4*AUDIO_BLOCK_SAMPLES).  A #define in the sketch
+//does not reach the library's .cpp files.  With it off, the DMA buffers are their original size.
+#ifndef I2S_DMA_RING_MAX_FRAMES
+#define I2S_DMA_RING_MAX_FRAMES 0
+#endif
 
 class AudioOutputI2S_F32 : public AudioStream_F32
 {
@@ -48,6 +56,8 @@ public:
 	{ 
 		sample_rate_Hz = settings.sample_rate_Hz;
 		audio_block_samples = settings.audio_block_samples;
+		dma_period_samples = settings.dma_period_samples;
+		dma_num_periods = settings.dma_num_periods;
 		begin(); 	
 	}
 	virtual void update(void);
@@ -60,6 +70,15 @@ public:
 	static void scale_f32_to_i24( float32_t *p_f32, float32_t *p_i16, int len) ;
 	static void scale_f32_to_i32( float32_t *p_f32, float32_t *p_i32, int len) ;
 	static float setI2SFreq(const float);
+	
+	//DMA ring (see AudioSettings_F32).  The latency is from the input DMA to the output DMA, so it does not
+	//include the I2S FIFOs or the codec's own converter delay.  It is -1 when using the original double buffer,
+	//whose latency depends on which object has update responsibility.
+	static bool isUsingDMARing(void) { return use_dma_ring; }
+	static int getIOLatency_samples(void) { return use_dma_ring ? tx_ring.getLatencyFrames() : -1; }
+	static float getIOLatency_msec(void) { return use_dma_ring ? (1000.0f * tx_ring.getLatencyFrames() / sample_rate_Hz) : -1.0f; }
+	static unsigned long getDMAGlitchCount(void);  //underruns + overruns + skipped updates, input and output
+	static void resetDMAGlitchCount(void);
 protected:
 	//AudioOutputI2S_F32(const AudioSettings &settings): AudioStream_F32(2, inputQueueArray) {} // to be used only inside AudioOutputI2Sslave !!
 	static void config_i2s(void);
@@ -72,6 +91,13 @@ protected:
 	static DMAChannel dma;
 	static void isr_16(void);
 	static void isr_32(void);
+	static void isr_ring(void);
+	void sub_begin_ring(void);
+	void update_ring(void);
+	static AudioDMARing tx_ring;
+	static bool use_dma_ring;
+	static int dma_period_samples;
+	static int dma_num_periods;
 private:
 	static audio_block_f32_t *block_left_2nd;
 	static audio_block_f32_t *block_right_2nd;
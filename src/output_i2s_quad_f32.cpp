@@ -54,7 +54,7 @@ uint32_t  AudioOutputI2SQuad_F32::ch4_offset = 0;
 //audio_block_f32_t * AudioOutputI2SQuad_F32::inputQueueArray[4];
 bool AudioOutputI2SQuad_F32::update_responsibility = false;
 //DMAMEM static uint32_t i2s_tx_buffer[AUDIO_BLOCK_SAMPLES/2*4];  //pack 2 int16s into 1 int32 to make dense, so that 4 channels = 4*(audio_block_samples/2)
-DMAMEM static uint32_t i2s_tx_buffer[AUDIO_BLOCK_SAMPLES/2*4];
+DMAMEM static uint32_t i2s_tx_buffer[AUDIO_BLOCK_SAMPLES*4];  //big enough for 4 channels of 32-bit slots
 DMAChannel AudioOutputI2SQuad_F32::dma(false);
 
 //static const uint32_t zerodata[AUDIO_BLOCK_SAMPLES/4] = {0};
@@ -63,9 +63,10 @@ static const float32_t zerodata[AUDIO_BLOCK_SAMPLES/2] = {0};
 //initialize some static variables.  Likely get overwritten by constructor.
 float AudioOutputI2SQuad_F32::sample_rate_Hz = AUDIO_SAMPLE_RATE;
 int AudioOutputI2SQuad_F32::audio_block_samples = AUDIO_BLOCK_SAMPLES;
+int AudioOutputI2SQuad_F32::i2s_word_bits = 16;
 
 //#define I2S_BUFFER_TO_USE_BYTES ((AudioOutputI2SQuad_F32::audio_block_samples)*2*sizeof(i2s_tx_buffer[0]))
-#define I2S_BUFFER_TO_USE_BYTES ((AudioOutputI2SQuad_F32::audio_block_samples)*4*(sizeof(i2s_tx_buffer[0])/2))
+#define I2S_BUFFER_TO_USE_BYTES ((AudioOutputI2SQuad_F32::audio_block_samples)*4*(AudioOutputI2SQuad_F32::i2s_word_bits/8))
 
 
 void AudioOutputI2SQuad_F32::begin(void)
@@ -83,19 +84,25 @@ void AudioOutputI2SQuad_F32::begin(void)
 	CORE_PIN22_CONFIG = PORT_PCR_MUX(6); // pin 22, PTC1, I2S0_TXD0 -> ch1 & ch2
 	CORE_PIN15_CONFIG = PORT_PCR_MUX(6); // pin 15, PTC0, I2S0_TXD1 -> ch3 & ch4
 
+	//each minor loop writes one slot to TDR0 and the same slot to TDR1 (DMOD(3) wraps the destination back to TDR0)
+	const int bytes_per_word = i2s_word_bits / 8;
 	dma.TCD->SADDR = i2s_tx_buffer;
-	dma.TCD->SOFF = 2;
-	dma.TCD->ATTR = DMA_TCD_ATTR_SSIZE(1) | DMA_TCD_ATTR_DSIZE(1) | DMA_TCD_ATTR_DMOD(3);
-	dma.TCD->NBYTES_MLNO = 4;
+	dma.TCD->SOFF = bytes_per_word;
+	if (i2s_word_bits == 32) {
+		dma.TCD->ATTR = DMA_TCD_ATTR_SSIZE(DMA_TCD_ATTR_SIZE_32BIT) | DMA_TCD_ATTR_DSIZE(DMA_TCD_ATTR_SIZE_32BIT) | DMA_TCD_ATTR_DMOD(3);
+	} else {
+		dma.TCD->ATTR = DMA_TCD_ATTR_SSIZE(1) | DMA_TCD_ATTR_DSIZE(1) | DMA_TCD_ATTR_DMOD(3);
+	}
+	dma.TCD->NBYTES_MLNO = 2*bytes_per_word;
 	//dma.TCD->SLAST = -sizeof(i2s_tx_buffer); //orig
 	dma.TCD->SLAST = -I2S_BUFFER_TO_USE_BYTES; //allows for variable audio block length
 	dma.TCD->DADDR = &I2S0_TDR0;
 	dma.TCD->DOFF = 4;
 	//dma.TCD->CITER_ELINKNO = sizeof(i2s_tx_buffer) / 4; //orig
-	dma.TCD->CITER_ELINKNO = I2S_BUFFER_TO_USE_BYTES / 4; //allows for variable audio block length
+	dma.TCD->CITER_ELINKNO = I2S_BUFFER_TO_USE_BYTES / (2*bytes_per_word); //allows for variable audio block length
 	dma.TCD->DLASTSGA = 0;
 	//dma.TCD->BITER_ELINKNO = sizeof(i2s_tx_buffer) / 4; //orig
-	dma.TCD->BITER_ELINKNO = I2S_BUFFER_TO_USE_BYTES / 4; //allows for variable audio block length
+	dma.TCD->BITER_ELINKNO = I2S_BUFFER_TO_USE_BYTES / (2*bytes_per_word); //allows for variable audio block length
 	dma.TCD->CSR = DMA_TCD_CSR_INTHALF | DMA_TCD_CSR_INTMAJOR;
 	dma.triggerAtHardwareEvent(DMAMUX_SOURCE_I2S0_TX);
 	update_responsibility = update_setup();
@@ -128,7 +135,7 @@ void AudioOutputI2SQuad_F32::isr_shuffleDataBlocks(audio_block_f32_t *&block_1st
 
 void AudioOutputI2SQuad_F32::isr(void)
 {
-	int16_t *dest; //int16 is data type being sent to the audio codec
+	uint8_t *dest; //int16 or int32 is the data type being sent to the audio codec
 
 	//update the dma and get pointer for the destination tx buffer
 	uint32_t saddr = (uint32_t)(dma.TCD->SADDR);
@@ -137,10 +144,10 @@ void AudioOutputI2SQuad_F32::isr(void)
 	if (saddr < (uint32_t)i2s_tx_buffer + I2S_BUFFER_TO_USE_BYTES / 2) { //variable audio block length
 		// DMA is transmitting the first half of the buffer so we must fill the second half
 		//dest = (int16_t *)&i2s_tx_buffer[AUDIO_BLOCK_SAMPLES]; //orig
-		dest = (int16_t *)(&i2s_tx_buffer[audio_block_samples]); //new
+		dest = ((uint8_t *)i2s_tx_buffer) + I2S_BUFFER_TO_USE_BYTES / 2; //new
 		if (AudioOutputI2SQuad_F32::update_responsibility) AudioStream_F32::update_all();
 	} else {
-		dest = (int16_t *)i2s_tx_buffer;
+		dest = (uint8_t *)i2s_tx_buffer;
 	}
 
 	//get pointers for source data that we will copy into the tx buffer
@@ -153,11 +160,22 @@ void AudioOutputI2SQuad_F32::isr(void)
 
 	//Interleave and copy into txt buffer (note the unexpected order!!!: chan 1, chan 3, chan 2, chan 4)
 	//for (int i=0; i < AUDIO_BLOCK_SAMPLES/2; i++) {	//original
-	for (int i=0; i < audio_block_samples/2; i++) {
-		*dest++ = (int16_t) (*src1++); //hopefully the float32 src1 data was pre-scaled in the update() method
-		*dest++ = (int16_t) (*src3++);
-		*dest++ = (int16_t) (*src2++);
-		*dest++ = (int16_t) (*src4++);
+	if (i2s_word_bits == 32) {
+		int32_t *d = (int32_t *)dest;
+		for (int i=0; i < audio_block_samples/2; i++) {
+			*d++ = (int32_t) (*src1++); //hopefully the float32 src1 data was pre-scaled in the update() method
+			*d++ = (int32_t) (*src3++);
+			*d++ = (int32_t) (*src2++);
+			*d++ = (int32_t) (*src4++);
+		}
+	} else {
+		int16_t *d = (int16_t *)dest;
+		for (int i=0; i < audio_block_samples/2; i++) {
+			*d++ = (int16_t) (*src1++); //hopefully the float32 src1 data was pre-scaled in the update() method
+			*d++ = (int16_t) (*src3++);
+			*d++ = (int16_t) (*src2++);
+			*d++ = (int16_t) (*src4++);
+		}
 	}
 
 	//now, shuffle the 1st and 2nd data block for each channel
@@ -203,9 +221,13 @@ void AudioOutputI2SQuad_F32::update_1chan(const int chan,  //this is not changed
 			}
 		} 
 	
-		//scale F32 to Int16
+		//scale F32 to Int16 (or Int32, if using 32-bit I2S slots)
 		//audio_block_f32_t *block_f32_scaled = AudioStream_F32::allocate_f32();
-		scale_f32_to_i16(block_f32->data, block_f32_scaled->data, audio_block_samples);
+		if (i2s_word_bits == 32) {
+			scale_f32_to_i32(block_f32->data, block_f32_scaled->data, audio_block_samples);
+		} else {
+			scale_f32_to_i16(block_f32->data, block_f32_scaled->data, audio_block_samples);
+		}
 		
 		//shuffle between the two buffers that the isr() routines looks for
 		__disable_irq();
@@ -325,22 +347,25 @@ void AudioOutputI2SQuad_F32::config_i2s(void)
 	// configure transmitter
 	I2S0_TMR = 0;
 	I2S0_TCR1 = I2S_TCR1_TFW(1);  // watermark at half fifo size
+	//32-bit slots need twice the bit clock (DIV(1) instead of DIV(3)) to keep the same sample rate
+	const int bclk_div = (i2s_word_bits == 32) ? 1 : 3;
+	const int nbits = i2s_word_bits - 1;
 	I2S0_TCR2 = I2S_TCR2_SYNC(0) | I2S_TCR2_BCP | I2S_TCR2_MSEL(1)
-		| I2S_TCR2_BCD | I2S_TCR2_DIV(3);
+		| I2S_TCR2_BCD | I2S_TCR2_DIV(bclk_div);
 	I2S0_TCR3 = I2S_TCR3_TCE_2CH;
-	I2S0_TCR4 = I2S_TCR4_FRSZ(1) | I2S_TCR4_SYWD(15) | I2S_TCR4_MF
+	I2S0_TCR4 = I2S_TCR4_FRSZ(1) | I2S_TCR4_SYWD(nbits) | I2S_TCR4_MF
 		| I2S_TCR4_FSE | I2S_TCR4_FSP | I2S_TCR4_FSD;
-	I2S0_TCR5 = I2S_TCR5_WNW(15) | I2S_TCR5_W0W(15) | I2S_TCR5_FBT(15);
+	I2S0_TCR5 = I2S_TCR5_WNW(nbits) | I2S_TCR5_W0W(nbits) | I2S_TCR5_FBT(nbits);
 
 	// configure receiver (sync'd to transmitter clocks)
 	I2S0_RMR = 0;
 	I2S0_RCR1 = I2S_RCR1_RFW(1);
 	I2S0_RCR2 = I2S_RCR2_SYNC(1) | I2S_TCR2_BCP | I2S_RCR2_MSEL(1)
-		| I2S_RCR2_BCD | I2S_RCR2_DIV(3);
+		| I2S_RCR2_BCD | I2S_RCR2_DIV(bclk_div);
 	I2S0_RCR3 = I2S_RCR3_RCE_2CH;
-	I2S0_RCR4 = I2S_RCR4_FRSZ(1) | I2S_RCR4_SYWD(15) | I2S_RCR4_MF
+	I2S0_RCR4 = I2S_RCR4_FRSZ(1) | I2S_RCR4_SYWD(nbits) | I2S_RCR4_MF
 		| I2S_RCR4_FSE | I2S_RCR4_FSP | I2S_RCR4_FSD;
-	I2S0_RCR5 = I2S_RCR5_WNW(15) | I2S_RCR5_W0W(15) | I2S_RCR5_FBT(15);
+	I2S0_RCR5 = I2S_RCR5_WNW(nbits) | I2S_RCR5_W0W(nbits) | I2S_RCR5_FBT(nbits);
 
 	// configure pin mux for 3 clock signals
 	CORE_PIN23_CONFIG = PORT_PCR_MUX(6); // pin 23, PTC2, I2S0_TX_FS (LRCLK)
@@ -49,9 +49,21 @@ public:
 		audio_block_samples = settings.audio_block_samples;
 		begin(); 	
 	}
+	AudioOutputI2SQuad_F32(const AudioSettings_F32 &settings, const int _i2s_word_bits) : AudioStream_F32(4, inputQueueArray)
+	{ 
+		sample_rate_Hz = settings.sample_rate_Hz;
+		audio_block_samples = settings.audio_block_samples;
+		setI2SWordBits(_i2s_word_bits);
+		begin(); 	
+	}
 	virtual void update(void);
 	void begin(void);
 	friend class AudioInputI2SQuad_F32;
+	
+	//Width of each I2S slot: 16 (the original quad format) or 32 (so that 24-bit codecs, like the AIC3206,
+	//keep all of their bits).  The quad input and output share the I2S port, so they always use the same
+	//width.  It must be chosen before the first quad input or output object is created (ie, via the constructor).
+	static int getI2SWordBits(void) { return i2s_word_bits; }
 	static void scale_f32_to_i16( float32_t *p_f32, float32_t *p_i16, int len) ;
 	static void scale_f32_to_i24( float32_t *p_f32, float32_t *p_i16, int len) ;
 	static void scale_f32_to_i32( float32_t *p_f32, float32_t *p_i32, int len) ;
@@ -78,6 +90,8 @@ private:
 	audio_block_f32_t *inputQueueArray[4];
 	static float sample_rate_Hz;
 	static int audio_block_samples;
+	static int i2s_word_bits;
+	static void setI2SWordBits(int bits) { i2s_word_bits = (bits == 16) ? 16 : 32; }
 	volatile uint8_t enabled = 1;
 };
 
@@ -0,0 +1,264 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2014, Paul Stoffregen, paul@pjrc.com
+ *
+ * Development of this audio library was funded by PJRC.COM, LLC by sales of
+ * Teensy and Audio Adaptor boards.  Please support PJRC's efforts to develop
+ * open source software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+ 
+ /* 
+ *  Extended by OpenAudio, Oct 2026
+ *  Converted to F32, to variable audio block length, and to 8 or 16 slots of 16, 24, or 32-bit words.
+ *	The F32 conversion is under the MIT License.  Use at your own risk.
+ */
+
+#include <Arduino.h>
+#include "output_tdm_f32.h"
+#include "utility/convert_f32.h"
+
+//initialize some static variables.  Likely get overwritten by constructor.
+float AudioOutputTDM_F32::sample_rate_Hz = AUDIO_SAMPLE_RATE;
+int AudioOutputTDM_F32::audio_block_samples = AUDIO_BLOCK_SAMPLES;
+int AudioOutputTDM_F32::n_slots = 8;
+int AudioOutputTDM_F32::word_bits = 32;
+int AudioOutputTDM_F32::slot_bits = 32;
+
+
+void AudioOutputTDM_F32::setTDMFormat(int _n_slots, int _word_bits)
+{
+	n_slots = (_n_slots == 16) ? 16 : 8;
+	word_bits = ((_word_bits == 16) || (_word_bits == 24)) ? _word_bits : 32;
+	if ((n_slots == 16) && (word_bits != 16)) {
+		Serial.println("AudioOutputTDM_F32: *** WARNING ***: 16 slots only fit 16-bit words.  Using 16-bit words.");
+		word_bits = 16;
+	}
+	slot_bits = (word_bits == 16) ? 16 : 32;  //24-bit words ride MSB-first in 32-bit slots
+}
+
+#if defined(__MK20DX256__) || defined(__MK64FX512__) || defined(__MK66FX1M0__)
+
+audio_block_f32_t * AudioOutputTDM_F32::block_1st[TDM_F32_MAX_SLOTS];
+audio_block_f32_t * AudioOutputTDM_F32::block_2nd[TDM_F32_MAX_SLOTS];
+uint16_t AudioOutputTDM_F32::block_offset[TDM_F32_MAX_SLOTS];
+bool AudioOutputTDM_F32::update_responsibility = false;
+DMAMEM static uint32_t tdm_tx_buffer[AUDIO_BLOCK_SAMPLES*8];  //big enough for 8 slots of 32 bits or 16 slots of 16 bits
+DMAChannel AudioOutputTDM_F32::dma(false);
+
+static const float32_t zerodata[AUDIO_BLOCK_SAMPLES/2] = {0};
+
+void AudioOutputTDM_F32::begin(void)
+{
+	dma.begin(true); // Allocate the DMA channel first
+
+	for (int i=0; i < TDM_F32_MAX_SLOTS; i++) {
+		block_1st[i] = NULL;
+		block_2nd[i] = NULL;
+		block_offset[i] = 0;
+	}
+	memset(tdm_tx_buffer, 0, sizeof(tdm_tx_buffer));
+
+	config_tdm();
+	CORE_PIN22_CONFIG = PORT_PCR_MUX(6); // pin 22, PTC1, I2S0_TXD0
+
+	//each minor loop writes one slot to TDR0
+	const int bytes_per_slot = slot_bits / 8;
+	dma.TCD->SADDR = tdm_tx_buffer;
+	dma.TCD->SOFF = bytes_per_slot;
+	if (slot_bits == 32) {
+		dma.TCD->ATTR = DMA_TCD_ATTR_SSIZE(DMA_TCD_ATTR_SIZE_32BIT) | DMA_TCD_ATTR_DSIZE(DMA_TCD_ATTR_SIZE_32BIT);
+	} else {
+		dma.TCD->ATTR = DMA_TCD_ATTR_SSIZE(1) | DMA_TCD_ATTR_DSIZE(1);
+	}
+	dma.TCD->NBYTES_MLNO = bytes_per_slot;
+	dma.TCD->SLAST = -getBufferBytes();
+	dma.TCD->DADDR = &I2S0_TDR0;
+	dma.TCD->DOFF = 0;
+	dma.TCD->CITER_ELINKNO = getBufferBytes() / bytes_per_slot;
+	dma.TCD->DLASTSGA = 0;
+	dma.TCD->BITER_ELINKNO = getBufferBytes() / bytes_per_slot;
+	dma.TCD->CSR = DMA_TCD_CSR_INTHALF | DMA_TCD_CSR_INTMAJOR;
+	dma.triggerAtHardwareEvent(DMAMUX_SOURCE_I2S0_TX);
+	update_responsibility = update_setup();
+	dma.enable();
+
+	I2S0_TCSR = I2S_TCSR_SR;
+	I2S0_TCSR = I2S_TCSR_TE | I2S_TCSR_BCE | I2S_TCSR_FRDE;
+	dma.attachInterrupt(isr);
+}
+
+void AudioOutputTDM_F32::isr(void)
+{
+	uint8_t *dest; //int16 or int32 is the data type being sent to the audio codec
+	const int buffer_bytes = getBufferBytes();
+	const int nsamps = audio_block_samples/2;
+
+	//update the dma and get pointer for the destination tx buffer
+	uint32_t saddr = (uint32_t)(dma.TCD->SADDR);
+	dma.clearInterrupt();
+	if (saddr < (uint32_t)tdm_tx_buffer + buffer_bytes / 2) {
+		// DMA is transmitting the first half of the buffer so we must fill the second half
+		dest = ((uint8_t *)tdm_tx_buffer) + buffer_bytes / 2;
+		if (AudioOutputTDM_F32::update_responsibility) AudioStream_F32::update_all();
+	} else {
+		dest = (uint8_t *)tdm_tx_buffer;
+	}
+
+	//scale, convert, and interleave straight from the audio blocks into the tx buffer, in one pass
+	float32_t *src[TDM_F32_MAX_SLOTS];
+	for (int i=0; i < n_slots; i++) {
+		src[i] = (block_1st[i]) ? (&(block_1st[i]->data[block_offset[i]])) : ((float32_t *)zerodata);
+	}
+	if (slot_bits == 32) {
+		interleave_f32_to_i32(src, (int32_t *)dest, nsamps, n_slots);
+	} else {
+		interleave_f32_to_i16(src, (int16_t *)dest, nsamps, n_slots);
+	}
+
+	//now, move each channel on to the 2nd half of its block, or on to its next block
+	for (int i=0; i < n_slots; i++) {
+		if (block_1st[i]) {
+			if (block_offset[i] == 0) {
+				block_offset[i] = nsamps;
+			} else {
+				block_offset[i] = 0;
+				AudioStream_F32::release(block_1st[i]);
+				block_1st[i] = block_2nd[i];
+				block_2nd[i] = NULL;
+			}
+		}
+	}
+}
+
+//Receive one block per channel and queue it up for the isr().  Unlike the I2S outputs, the blocks are
+//held as-is (not copied to scaled blocks), because the isr() converts them straight into the DMA buffer.
+//So, with 16 channels, this doesn't need 16 extra blocks of audio memory.
+void AudioOutputTDM_F32::update(void)
+{
+	for (int i=0; i < TDM_F32_MAX_SLOTS; i++) {
+		audio_block_f32_t *block_f32 = receiveReadOnly_f32(i);
+		if (!block_f32) continue;
+		if (i >= n_slots) { AudioStream_F32::release(block_f32); continue; }  //no slot for this input
+
+		if ((i == 0) && (block_f32->length != audio_block_samples)) {
+			Serial.print("AudioOutputTDM_F32: *** WARNING ***: audio_block says len = ");
+			Serial.print(block_f32->length);
+			Serial.print(", but TDM settings want it to be = ");
+			Serial.println(audio_block_samples);
+		}
+
+		//shuffle between the two buffers that the isr() routines looks for
+		__disable_irq();
+		if (block_1st[i] == NULL) {
+			block_1st[i] = block_f32;
+			block_offset[i] = 0;
+			__enable_irq();
+		} else if (block_2nd[i] == NULL) {
+			block_2nd[i] = block_f32;
+			__enable_irq();
+		} else {
+			audio_block_f32_t *tmp = block_1st[i];
+			block_1st[i] = block_2nd[i];
+			block_2nd[i] = block_f32;
+			block_offset[i] = 0;
+			__enable_irq();
+			AudioStream_F32::release(tmp);
+		}
+	}
+}
+
+float AudioOutputTDM_F32::setTDMFreq(const float freq_Hz)
+{
+	//setI2SFreq() makes MCLK = 256x the rate that it is given, so ask it for twice the sample rate
+	return 0.5f * AudioOutputI2S_F32::setI2SFreq(2.0f * freq_Hz);
+}
+
+#if (F_CPU == 180000000) || (F_CPU == 216000000) || (F_CPU < 20000000)
+  #define MCLK_SRC  0  // system clock
+#else
+  #define MCLK_SRC  3  // the PLL
+#endif
+
+void AudioOutputTDM_F32::config_tdm(void)
+{
+	SIM_SCGC6 |= SIM_SCGC6_I2S;
+	SIM_SCGC7 |= SIM_SCGC7_DMA;
+	SIM_SCGC6 |= SIM_SCGC6_DMAMUX;
+
+	// if either transmitter or receiver is enabled, do nothing
+	if (I2S0_TCSR & I2S_TCSR_TE) return;
+	if (I2S0_RCSR & I2S_RCSR_RE) return;
+
+	// enable MCLK output, at 512x the sample rate
+	I2S0_MCR = I2S_MCR_MICS(MCLK_SRC) | I2S_MCR_MOE;
+	if (setTDMFreq(sample_rate_Hz) == 0.0f) {
+		Serial.print("AudioOutputTDM_F32: *** WARNING ***: sample rate not supported: ");
+		Serial.print(sample_rate_Hz);
+		Serial.println(".  Using 44117 Hz.");
+		sample_rate_Hz = setTDMFreq(AUDIO_SAMPLE_RATE_EXACT);
+	}
+
+	//BCLK = MCLK / (2*(DIV+1)), so DIV(0) gives 256 bits per frame and DIV(1) gives 128
+	const int bclk_div = (n_slots * slot_bits == 256) ? 0 : 1;
+	const int nbits = slot_bits - 1;
+
+	// configure transmitter.  The frame sync is a one-bit pulse, one bit before slot 0 (DSP mode).
+	I2S0_TMR = 0;
+	I2S0_TCR1 = I2S_TCR1_TFW(4);
+	I2S0_TCR2 = I2S_TCR2_SYNC(0) | I2S_TCR2_BCP | I2S_TCR2_MSEL(1)
+		| I2S_TCR2_BCD | I2S_TCR2_DIV(bclk_div);
+	I2S0_TCR3 = I2S_TCR3_TCE;
+	I2S0_TCR4 = I2S_TCR4_FRSZ(n_slots-1) | I2S_TCR4_SYWD(0) | I2S_TCR4_MF
+		| I2S_TCR4_FSE | I2S_TCR4_FSD;
+	I2S0_TCR5 = I2S_TCR5_WNW(nbits) | I2S_TCR5_W0W(nbits) | I2S_TCR5_FBT(nbits);
+
+	// configure receiver (sync'd to transmitter clocks)
+	I2S0_RMR = 0;
+	I2S0_RCR1 = I2S_RCR1_RFW(4);
+	I2S0_RCR2 = I2S_RCR2_SYNC(1) | I2S_TCR2_BCP | I2S_RCR2_MSEL(1)
+		| I2S_RCR2_BCD | I2S_RCR2_DIV(bclk_div);
+	I2S0_RCR3 = I2S_RCR3_RCE;
+	I2S0_RCR4 = I2S_RCR4_FRSZ(n_slots-1) | I2S_RCR4_SYWD(0) | I2S_RCR4_MF
+		| I2S_RCR4_FSE | I2S_RCR4_FSD;
+	I2S0_RCR5 = I2S_RCR5_WNW(nbits) | I2S_RCR5_W0W(nbits) | I2S_RCR5_FBT(nbits);
+
+	// configure pin mux for 3 clock signals
+	CORE_PIN23_CONFIG = PORT_PCR_MUX(6); // pin 23, PTC2, I2S0_TX_FS
+	CORE_PIN9_CONFIG  = PORT_PCR_MUX(6); // pin  9, PTC3, I2S0_TX_BCLK
+	CORE_PIN11_CONFIG = PORT_PCR_MUX(6); // pin 11, PTC6, I2S0_MCLK
+}
+
+
+#else // not __MK20DX256__
+
+
+void AudioOutputTDM_F32::begin(void)
+{
+}
+
+void AudioOutputTDM_F32::update(void)
+{
+	for (int i=0; i < TDM_F32_MAX_SLOTS; i++) {
+		audio_block_f32_t *block_f32 = receiveReadOnly_f32(i);
+		if (block_f32) release(block_f32);
+	}
+}
+
+#endif
@@ -0,0 +1,108 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2014, Paul Stoffregen, paul@pjrc.com
+ *
+ * Development of this audio library was funded by PJRC.COM, LLC by sales of
+ * Teensy and Audio Adaptor boards.  Please support PJRC's efforts to develop
+ * open source software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+ 
+ /* 
+ *  Extended by OpenAudio, Oct 2026
+ *  Converted to F32, to variable audio block length, and to 8 or 16 slots of 16, 24, or 32-bit words.
+ *	The F32 conversion is under the MIT License.  Use at your own risk.
+ */
+
+//TDM ("DSP mode") puts all of the channels on one data line: one short frame-sync pulse per sample, then
+//8 or 16 time slots, one per channel.  Several codecs can share the bus (each answering in its own slots),
+//which is how to get 8 or 16 channels, such as for a microphone array.
+//
+//The bit clock must fit 256 bits in each sample period, so MCLK runs at 512x the sample rate (twice the
+//usual I2S rate).  Configure the codecs for that MCLK, for DSP/TDM mode, and for their slot offsets.
+//Pins are the same as the regular I2S: TX data on pin 22, RX data on pin 13, FS on 23, BCLK on 9, MCLK on 11.
+//
+//Formats (n_slots, word_bits):
+//   8 slots,  32-bit words: 32-bit slots, 256 bits per frame (the default)
+//   8 slots,  24-bit words: same as 32-bit.  24-bit codecs send their data MSB-first and ignore the rest of the slot.
+//   8 slots,  16-bit words: 16-bit slots, 128 bits per frame
+//  16 slots,  16-bit words: 16-bit slots, 256 bits per frame
+//  16 slots of 24 or 32-bit words would need 512 bits per frame, which is faster than this bit clock can go,
+//  so it falls back to 16-bit words (with a warning on Serial).
+
+#ifndef output_tdm_f32_h_
+#define output_tdm_f32_h_
+
+#include "Arduino.h"
+#include "AudioStream_F32.h"
+#include "DMAChannel.h"
+#include "output_i2s_f32.h"  //for setI2SFreq()
+
+#define TDM_F32_MAX_SLOTS 16
+
+class AudioOutputTDM_F32 : public AudioStream_F32
+{
+//GUI: inputs:16, outputs:0  //this line used for automatic generation of GUI nodes
+public:
+	AudioOutputTDM_F32(void) : AudioStream_F32(TDM_F32_MAX_SLOTS, inputQueueArray) { begin(); }
+	AudioOutputTDM_F32(const AudioSettings_F32 &settings) : AudioStream_F32(TDM_F32_MAX_SLOTS, inputQueueArray)
+	{ 
+		sample_rate_Hz = settings.sample_rate_Hz;
+		audio_block_samples = settings.audio_block_samples;
+		begin(); 	
+	}
+	AudioOutputTDM_F32(const AudioSettings_F32 &settings, const int _n_slots, const int _word_bits) : AudioStream_F32(TDM_F32_MAX_SLOTS, inputQueueArray)
+	{ 
+		sample_rate_Hz = settings.sample_rate_Hz;
+		audio_block_samples = settings.audio_block_samples;
+		setTDMFormat(_n_slots, _word_bits);
+		begin(); 	
+	}
+	virtual void update(void);
+	void begin(void);
+	friend class AudioInputTDM_F32;
+
+	//The TDM input and output share the I2S port, so they always use the same format.  It must be chosen
+	//before the first TDM input or output object is created (ie, via the constructor).
+	static int getNumSlots(void) { return n_slots; }
+	static int getWordBits(void) { return word_bits; }
+	static int getSlotBits(void) { return slot_bits; }
+	
+	//set MCLK to 512x the sample rate.  Returns the actual sample rate (or 0.0 if it isn't supported).
+	static float setTDMFreq(const float freq_Hz);
+protected: 
+	static void config_tdm(void);
+	static audio_block_f32_t *block_1st[TDM_F32_MAX_SLOTS];
+	static audio_block_f32_t *block_2nd[TDM_F32_MAX_SLOTS];
+	static uint16_t block_offset[TDM_F32_MAX_SLOTS];
+	static bool update_responsibility;
+	static DMAChannel dma;
+	static void isr(void);
+	static int getBufferBytes(void) { return audio_block_samples * n_slots * (slot_bits/8); }
+private:
+	audio_block_f32_t *inputQueueArray[TDM_F32_MAX_SLOTS];
+	static float sample_rate_Hz;
+	static int audio_block_samples;
+	static int n_slots;
+	static int word_bits;
+	static int slot_bits;
+	static void setTDMFormat(int n_slots, int word_bits);
+};
+
+#endif
@@ -0,0 +1,28 @@
+/* 
+ * AudioSynthOscillatorBank_F32
+ * 
+ * Created: OpenAudio, Oct 2026
+ *
+ * License: MIT License. Use at your own risk.
+ *
+ */
+
+#include "synth_oscbank_f32.h"
+
+void AudioSynthOscillatorBank_F32::update(void)
+{
+	if (!enabled) return;
+	if (bank.getNumTones() == 0) return;
+	
+	audio_block_f32_t *block = allocate_f32();
+	if (!block) return;
+	
+	bank.synthesize(block->data, block->length);
+	
+	block_counter++;
+	block->id = block_counter;
+	block->fs_Hz = bank.getSampleRate_Hz();
+	
+	AudioStream_F32::transmit(block);
+	AudioStream_F32::release(block);
+}
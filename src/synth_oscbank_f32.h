@@ -0,0 +1,75 @@
+/* 
+ * AudioSynthOscillatorBank_F32
+ * 
+ * Created: OpenAudio, Oct 2026
+ * 
+ * Purpose: Make many sines at once (a multitone), each with its own frequency, amplitude, and phase,
+ *     summed into one output.  Meant for calibration and test signals, where many clean, cheap tones
+ *     are needed.  Uses OscillatorBank (see utility/osc_bank.h): float complex phasors instead of a
+ *     sine table, renormalized every block, so each tone stays accurate to better than -100 dB.
+ *
+ *     Amplitudes can be changed in steps as small as you like (such as 0.1 dB); each change ramps
+ *     smoothly over one block.  Each tone can also be swept (linear or log) with no jumps in phase.
+ *
+ *     Up to OSC_BANK_MAX_TONES (32) tones.  The cost is about the same for 1 to 4 tones, and grows in
+ *     steps of 4 after that.
+ *
+ * License: MIT License. Use at your own risk.
+ *
+ */
+
+#ifndef synth_oscbank_f32_h_
+#define synth_oscbank_f32_h_
+
+#include "Arduino.h"
+#include "AudioStream_F32.h"
+#include "arm_math.h"
+#include "utility/osc_bank.h"
+
+class AudioSynthOscillatorBank_F32 : public AudioStream_F32
+{
+//GUI: inputs:0, outputs:1 //this line used for automatic generation of GUI node
+//GUI: shortName:oscBank  //this line used for automatic generation of GUI node
+public:
+	AudioSynthOscillatorBank_F32() : AudioStream_F32(0, NULL) { setSampleRate_Hz(AUDIO_SAMPLE_RATE_EXACT); } //uses default AUDIO_SAMPLE_RATE_EXACT from AudioStream.h
+	AudioSynthOscillatorBank_F32(const AudioSettings_F32 &settings) : AudioStream_F32(0, NULL) {
+		setSampleRate_Hz(settings.sample_rate_Hz);
+	}
+
+	void setSampleRate_Hz(const float fs_Hz) { __disable_irq(); bank.setSampleRate_Hz(fs_Hz); __enable_irq(); }
+	
+	//build the multitone.  addTone() returns the tone's index, or -1 if the bank is full.
+	void clear(void) { __disable_irq(); bank.clear(); __enable_irq(); }
+	int addTone(float freq_Hz, float amplitude, float phase_deg = 0.0f) {
+		__disable_irq(); int i = bank.addTone(freq_Hz, amplitude, phase_deg); __enable_irq();
+		return i;
+	}
+	int addTone_dBFS(float freq_Hz, float amp_dBFS, float phase_deg = 0.0f) { return addTone(freq_Hz, powf(10.0f, 0.05f*amp_dBFS), phase_deg); }
+	int getNumTones(void) { return bank.getNumTones(); }
+
+	//change a tone
+	void setFrequency_Hz(int i, float freq_Hz) { __disable_irq(); bank.setFrequency_Hz(i, freq_Hz); __enable_irq(); }
+	void setAmplitude(int i, float amplitude) { __disable_irq(); bank.setAmplitude(i, amplitude); __enable_irq(); }
+	void setAmplitude_dBFS(int i, float amp_dBFS) { __disable_irq(); bank.setAmplitude_dB(i, amp_dBFS); __enable_irq(); }  //peak amplitude, re: 1.0
+	void setPhase_deg(int i, float deg) { __disable_irq(); bank.setPhase_deg(i, deg); __enable_irq(); }
+	float getFrequency_Hz(int i) { return bank.getFrequency_Hz(i); }
+	float getAmplitude(int i) { return bank.getAmplitude(i); }
+
+	//glide a tone to a new frequency, with no jump in phase
+	void sweep(int i, float freq_end_Hz, float dur_sec, OscillatorBank::SweepType type = OscillatorBank::LOG) {
+		__disable_irq(); bank.sweep(i, freq_end_Hz, dur_sec, type); __enable_irq();
+	}
+	bool isSweeping(int i) { return bank.isSweeping(i); }
+	bool isAnySweeping(void) { return bank.isAnySweeping(); }
+
+	void begin(void) { enabled = true; }
+	void end(void) { enabled = false; }
+	virtual void update(void);
+
+private:
+	OscillatorBank bank;
+	volatile uint8_t enabled = 1;
+	unsigned int block_counter=0;
+};
+
+#endif
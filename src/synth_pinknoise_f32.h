@@ -2,44 +2,22 @@
 	Extended to f32 data
 	Created: Chip Audette, OpenAudio, Feb 2017
 	
+	Rewritten: OpenAudio, Oct 2026
+	   Now made directly in float: counter-based white noise (see utility/noise_f32.h) through a bank of
+	   first-order filters with an accurate -3 dB/octave slope at any sample rate.  Give a seed to get the
+	   same noise every time, on the Teensy or on a PC.  The level is about the same as before: at
+	   amplitude(1.0), the RMS is 0.2 and the peaks reach about 0.9.
+	
 	License: MIT License. Use at your own risk.
 */
 
-/* Audio Library for Teensy 3.X
- * Copyright (c) 2014, Paul Stoffregen, paul@pjrc.com
- *
- * Development of this audio library was funded by PJRC.COM, LLC by sales of
- * Teensy and Audio Adaptor boards.  Please support PJRC's efforts to develop
- * open source software by purchasing Teensy or other PJRC products.
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy
- * of this software and associated documentation files (the "Software"), to deal
- * in the Software without restriction, including without limitation the rights
- * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
- * copies of the Software, and to permit persons to whom the Software is
- * furnished to do so, subject to the following conditions:
- *
- * The above copyright notice, development funding notice, and this permission
- * notice shall be included in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
- * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
- * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
- * THE SOFTWARE.
- */
-
 #ifndef synth_pinknoise_f32_h_
 #define synth_pinknoise_f32_h_
 #include "Arduino.h"
-#include "AudioStream.h"
 #include "AudioStream_F32.h"
-#include "utility/dspinst.h"
-#include "AudioConvert_F32.h" //for convert_i16_to_f32
-
+#include "utility/noise_f32.h"
 
+#define PINK_F32_RMS_AT_FULL_SCALE 0.2f
 
 class AudioSynthNoisePink_F32 : public AudioStream_F32
 {
@@ -48,38 +26,42 @@ class AudioSynthNoisePink_F32 : public AudioStream_F32
 public:
 	AudioSynthNoisePink_F32() : AudioStream_F32(0, NULL) {
 		setDefaultValues();
+		setSampleRate_Hz(AUDIO_SAMPLE_RATE);
 		enabled = 1;
 	}
 	AudioSynthNoisePink_F32(const AudioSettings_F32 &settings) : AudioStream_F32(0, NULL) {
 		setDefaultValues();
+		setSampleRate_Hz(settings.sample_rate_Hz);
 		enabled = 1;
 	}
 	
 	void setDefaultValues() {
-		plfsr  = 0x5EED41F5 + instance_cnt++;
-		paccu  = 0;
-		pncnt  = 0;
-		pinc   = 0x0CCC;
-		pdec   = 0x0CCC;
-	}	
+		level = 0.0f;
+		noise.setSeed(0x5EED41F5 + instance_cnt++);  //each instance makes different noise
+	}
+	void setSampleRate_Hz(const float fs_Hz) {
+		sample_rate_Hz = fs_Hz;
+		PinkFilter new_pink;  new_pink.setup(fs_Hz);   //designed with the audio running, then swapped in
+		__disable_irq(); pink = new_pink; __enable_irq();
+	}
 	void amplitude(float n) {
 		if (n < 0.0) n = 0.0;
 		else if (n > 1.0) n = 1.0;
-		level = (int32_t)(n * 65536.0);
+		level = n;
 	}
+	
+	//the same seed always gives the same noise.  This also restarts the noise from its beginning.
+	void setSeed(uint32_t seed) { __disable_irq(); noise.setSeed(seed); pink.reset(); __enable_irq(); }
+	uint32_t getSeed(void) { return noise.getSeed(); }
+	
 	virtual void update(void);
 	int enabled = 0;
 private:
-	static const uint8_t pnmask[256];
-	static const int32_t pfira[64];
-	static const int32_t pfirb[64];
 	static int16_t instance_cnt;
-	int32_t plfsr;		// linear feedback shift register
-	int32_t pinc;		// increment for all noise sources (bits)
-	int32_t pdec;		// decrement for all noise sources
-	int32_t paccu;		// accumulator
-	uint8_t pncnt;		// overflowing counter as index to pnmask[]
-	int32_t level;		// 0=off, 65536=max
+	float level;		// 0=off, 1.0=max
+	float sample_rate_Hz;
+	NoiseGenerator noise;
+	PinkFilter pink;
 };
 
 #endif
@@ -6,6 +6,11 @@
  * 
  * Purpose: Create sine wave of given amplitude and frequency
  *
+ * Extended: OpenAudio, Oct 2026
+ *    Now computed directly in float by a rotating complex phasor (see utility/osc_bank.h) instead of
+ *    interpolating the Int16 sine table, so it is more accurate (better than -100 dB) and has no
+ *    processor-specific code.  For many tones at once, see AudioSynthOscillatorBank_F32.
+ *
  * License: MIT License. Use at your own risk.        
  *
  */
@@ -16,6 +21,7 @@
 #include "Arduino.h"
 #include "AudioStream_F32.h"
 #include "arm_math.h"
+#include "utility/osc_bank.h"
 
 
 class AudioSynthWaveformSine_F32 : public AudioStream_F32
@@ -23,15 +29,17 @@ class AudioSynthWaveformSine_F32 : public AudioStream_F32
 //GUI: inputs:0, outputs:1 //this line used for automatic generation of GUI node
 //GUI: shortName:sine  //this line used for automatic generation of GUI node
 public:
-	AudioSynthWaveformSine_F32() : AudioStream_F32(0, NULL), magnitude(16384) { } //uses default AUDIO_SAMPLE_RATE from AudioStream.h
-	AudioSynthWaveformSine_F32(const AudioSettings_F32 &settings) : AudioStream_F32(0, NULL), magnitude(16384) {
+	AudioSynthWaveformSine_F32() : AudioStream_F32(0, NULL) { } //uses default AUDIO_SAMPLE_RATE from AudioStream.h
+	AudioSynthWaveformSine_F32(const AudioSettings_F32 &settings) : AudioStream_F32(0, NULL) {
 		setSampleRate_Hz(settings.sample_rate_Hz);
 	}
 	void frequency(float freq) {
 		if (freq < 0.0) freq = 0.0;
 		else if (freq > sample_rate_Hz/2.f) freq = sample_rate_Hz/2.f;
 		frequency_Hz = freq;
-		phase_increment = freq * (4294967296.0 / sample_rate_Hz);
+		__disable_irq();
+		osc.setFrequency(frequency_Hz, sample_rate_Hz);
+		__enable_irq();
 	}
 	void phase(float angle) {
 		if (angle < 0.0f) angle = 0.0f;
@@ -39,33 +47,34 @@ public:
 			angle = angle - 360.0f;
 			if (angle >= 360.0f) return;
 		}
-		phase_accumulator = angle * (4294967296.0f / 360.0f);
+		__disable_irq();
+		osc.setPhase_deg(angle);
+		__enable_irq();
 	}
 	void amplitude(float n) {
 		if (n < 0) n = 0;
 		else if (n > 1.0f) n = 1.0f;
-		magnitude = n * magnitude_scale_factor;
+		magnitude = n;
 	}
 	void setSampleRate_Hz(const float &fs_Hz) {
-		phase_increment *= sample_rate_Hz / fs_Hz; //change the phase increment for the new frequency
 		sample_rate_Hz = fs_Hz;
+		frequency(frequency_Hz); //keep the same frequency in Hz
 	}
 	void begin(void) { enabled = true; }
 	void end(void) { enabled = false; }
 	virtual void update(void);
 	float getFrequency_Hz(void) { return frequency_Hz; }
 	float setFrequency_Hz(float _freq_Hz) { frequency(_freq_Hz); return getFrequency_Hz(); }
-	float getAmplitude(void) { return (magnitude/magnitude_scale_factor); }
+	float getAmplitude(void) { return magnitude; }
 	float setAmplitude(float amp) { amplitude(amp); return getAmplitude(); }
 	
 private:
-	uint32_t phase_accumulator = 0;
-	uint32_t phase_increment = 0;
-	int32_t magnitude = 0;
+	OscillatorPhasor osc;
+	float magnitude = 0.25f;
 	float sample_rate_Hz = AUDIO_SAMPLE_RATE;
 	volatile uint8_t enabled = 1;
-	float32_t frequency_Hz;
-	const float magnitude_scale_factor = 65536.0f;
+	float32_t frequency_Hz = 0.0f;
+	int block_length = AUDIO_BLOCK_SAMPLES;
 	unsigned int block_counter=0;
 };
 
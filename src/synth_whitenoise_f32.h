@@ -3,42 +3,20 @@
 	
 	Extended by: Chip Audette, OpenAudio, Feb 2017
 	
+	Rewritten: OpenAudio, Oct 2026
+	   Now made directly in float from a counter-based random number generator (see utility/noise_f32.h),
+	   instead of making Int16 noise and converting it (which took a second block, and leaked the F32 block
+	   whenever the Int16 block couldn't be had).  Give a seed to get the same noise every time, on the
+	   Teensy or on a PC.
+	
 	License: MIT License.  Use at your own risk.
 */
 
-/* Audio Library for Teensy 3.X
- * Copyright (c) 2014, Paul Stoffregen, paul@pjrc.com
- *
- * Development of this audio library was funded by PJRC.COM, LLC by sales of
- * Teensy and Audio Adaptor boards.  Please support PJRC's efforts to develop
- * open source software by purchasing Teensy or other PJRC products.
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy
- * of this software and associated documentation files (the "Software"), to deal
- * in the Software without restriction, including without limitation the rights
- * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
- * copies of the Software, and to permit persons to whom the Software is
- * furnished to do so, subject to the following conditions:
- *
- * The above copyright notice, development funding notice, and this permission
- * notice shall be included in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
- * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
- * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
- * THE SOFTWARE.
- */
-
 #ifndef synth_whitenoise_f32_h_
 #define synth_whitenoise_f32_h_
 #include "Arduino.h"
-#include "AudioStream.h"
 #include "AudioStream_F32.h"
-#include "utility/dspinst.h"
-#include "AudioConvert_F32.h" //for convert_i16_to_f32
+#include "utility/noise_f32.h"
 
 
 class AudioSynthNoiseWhite_F32 : public AudioStream_F32
@@ -50,18 +28,28 @@ public:
 	AudioSynthNoiseWhite_F32(const AudioSettings_F32 &settings) : AudioStream_F32(0, NULL) { setDefaultValues(); }
 	
 	void setDefaultValues(void) {
-		level = 0;
-		seed = 1 + instance_count++;
+		level = 0.0f;
+		noise.setSeed(1 + instance_count++);  //each instance makes different noise
 	}
+	
+	//peak amplitude, 0.0 to 1.0 (the RMS is amplitude/sqrt(3))
 	void amplitude(float n) {
 		if (n < 0.0) n = 0.0;
 		else if (n > 1.0) n = 1.0;
-		level = (int32_t)(n * 65536.0);
+		level = n;
 	}
+	
+	//the same seed always gives the same noise.  This also restarts the noise from its beginning.
+	void setSeed(uint32_t seed) { __disable_irq(); noise.setSeed(seed); __enable_irq(); }
+	uint32_t getSeed(void) { return noise.getSeed(); }
+	
+	//uniform (the default) or Gaussian, with the same RMS
+	void setDistribution(NoiseGenerator::Distribution d) { noise.setDistribution(d); }
+	
 	virtual void update(void);
 private:
-	int32_t  level; // 0=off, 65536=max
-	uint32_t seed;  // must start at 1
+	float level;   // 0=off, 1.0=max
+	NoiseGenerator noise;
 	static uint16_t instance_count;
 };
 
@@ -1,9 +1,9 @@
 #ifndef _FreqWeighting_IEC1672_h
 #define _FreqWeighting_IEC1672_h
-//These filter coefficients were written by the Matlab code "make_A_C_weighting_sos.m
- 
-#define A_WEIGHT 1
-#define C_WEIGHT 3
+//The filters are designed for the sample rate that is asked for (see freq_weighting.h).  The tables of
+//coefficients, written by the Matlab code "make_A_C_weighting_sos.m", are still here, for comparison.
+
+#include "freq_weighting.h"   //A_WEIGHT, C_WEIGHT, and Z_WEIGHT
  
 class FreqWeighting_IEC1672 {
   public:
@@ -11,6 +11,7 @@ class FreqWeighting_IEC1672 {
 	
 	//include all of the coefficients
 	#include "FreqWeighting_IEC1672_coeff.h"
+	float32_t designed_sos[FREQ_WEIGHTING_MAX_SOS*6];
 	
 	int get_N_sos_per_filter(int type) {
 		int out_val = Aweight_N_SOS_PER_FILTER;
@@ -21,6 +22,9 @@ class FreqWeighting_IEC1672 {
 			case C_WEIGHT:
 				out_val = Cweight_N_SOS_PER_FILTER;
 				break;	
+			case Z_WEIGHT:
+				out_val = FreqWeightingDesign::getNumSections(Z_WEIGHT);
+				break;
 		
 		}
 		return out_val;
@@ -32,7 +36,7 @@ class FreqWeighting_IEC1672 {
 	
 		while (!done & (index < (N_all_fs_Hz-1))) {
 			val = 0.5*(all_fs_Hz[index] + all_fs_Hz[index+1]);
-			if (targ_fs_Hz < val) {
+			if (targ_fs_Hz > val) {
 				index++;
 			} else {
 				done = 1;
@@ -40,7 +44,16 @@ class FreqWeighting_IEC1672 {
 		}
 		return index;
 	}
+	//the filter, designed for exactly this sample rate (with the correction of the top section)
 	float32_t* get_filter_matlab_sos(int type, float32_t targ_fs_Hz) {
+		if ((type != C_WEIGHT) && (type != Z_WEIGHT)) type = A_WEIGHT;   //as get_N_sos_per_filter()
+		if (FreqWeightingDesign::design(type, targ_fs_Hz, designed_sos) == 0) {
+			for (int i=0; i < FREQ_WEIGHTING_MAX_SOS*6; i++) designed_sos[i] = ((i % 6) == 0 || (i % 6) == 3) ? 1.0f : 0.0f;  //no good, so pass everything
+		}
+		return designed_sos;
+	}
+	//the filter from the tables, for the nearest sample rate that has one
+	float32_t* get_table_matlab_sos(int type, float32_t targ_fs_Hz) {
 		int ind = findIndexForSampleRate(targ_fs_Hz);
 		float32_t* coeff = (all_A_matlab_sos[ind]);
 		switch (type) {
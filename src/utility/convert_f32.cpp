@@ -0,0 +1,361 @@
+/*
+ * convert_f32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Shared sample-format conversion kernels.  See convert_f32.h
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include "convert_f32.h"
+
+#if defined(CONVERT_F32_PLAIN_C)
+	//only the plain C loops (extras/host/convert_f32_check checks the fast versions against them)
+#elif defined(__ARM_ARCH_7EM__)
+	//Cortex-M4F (Teensy 3.5 / 3.6).  __SSAT and __PKHBT come in via arm_math.h -> core_cm4.h
+	#define CONVERT_F32_USE_ARM_DSP
+#elif defined(__SSE2__)
+	//host PC builds
+	#include <emmintrin.h>
+	#define CONVERT_F32_USE_SSE2
+#endif
+
+// ///////////////////////////////////////// helpers
+
+static inline int32_t sat_i16(const float32_t val) {
+#if defined(CONVERT_F32_USE_ARM_DSP)
+	return __SSAT((int32_t)val, 16);  //the float-to-int cast itself saturates at +/-2^31 on the M4F
+#else
+	if (val >= 32767.0f) return 32767;
+	if (val <= -32768.0f) return -32768;
+	return (int32_t)val;
+#endif
+}
+
+static inline int32_t sat_i32(const float32_t val) {
+#if defined(CONVERT_F32_USE_ARM_DSP)
+	return (int32_t)val;  //VCVT saturates by itself
+#else
+	if (val >= 2147483648.0f) return 0x7FFFFFFF;
+	if (val <= -2147483648.0f) return (int32_t)0x80000000;
+	return (int32_t)val;
+#endif
+}
+
+#if defined(CONVERT_F32_USE_ARM_DSP)
+static inline uint32_t pack_i16x2(const float32_t first, const float32_t second) {
+	return __PKHBT(sat_i16(first*F32_TO_I16_SCALE), sat_i16(second*F32_TO_I16_SCALE), 16);  //first sample goes in the low half-word
+}
+static inline bool is_word_aligned(const void *ptr) { return ((((uint32_t)ptr) & 0x03) == 0); }
+#endif
+
+#if defined(CONVERT_F32_USE_SSE2)
+static inline __m128i sse_f32_to_i32_sat(__m128 val) {
+	const __m128 scale = _mm_set1_ps(F32_TO_I16_SCALE);
+	const __m128 max_val = _mm_set1_ps(32767.0f), min_val = _mm_set1_ps(-32768.0f);
+	val = _mm_min_ps(_mm_max_ps(_mm_mul_ps(val, scale), min_val), max_val); //clamp in float so cvtt can't overflow
+	return _mm_cvttps_epi32(val);  //truncate, same as the C cast
+}
+static inline __m128 sse_i32_to_f32_scaled(__m128i val) {
+	return _mm_mul_ps(_mm_cvtepi32_ps(val), _mm_set1_ps(I16_TO_F32_SCALE));
+}
+static inline __m128i sse_f32_to_i32_full(__m128 val) {
+	val = _mm_mul_ps(val, _mm_set1_ps(F32_TO_I32_SCALE));
+	__m128i too_big = _mm_castps_si128(_mm_cmpge_ps(val, _mm_set1_ps(2147483648.0f)));
+	return _mm_xor_si128(_mm_cvttps_epi32(val), too_big);  //cvtt gives 0x80000000 on overflow.  Flip it to 0x7FFFFFFF.
+}
+static inline __m128 sse_slot_to_f32(const int32_t *p_i32, __m128i shift) {
+	__m128i x = _mm_sll_epi32(_mm_loadu_si128((const __m128i *)p_i32), shift);  //data sign bit up to bit 31
+	return _mm_mul_ps(_mm_cvtepi32_ps(x), _mm_set1_ps(I32_TO_F32_SCALE));
+}
+#endif
+
+//shift the data's sign bit up to bit 31 so that every word size shares one scale factor
+static inline float32_t slot_to_f32(const int32_t val, const int shift) {
+	return ((float32_t)((int32_t)(((uint32_t)val) << shift))) * I32_TO_F32_SCALE;
+}
+static inline int slot_shift(const int word_bits) {
+	if ((word_bits <= 0) || (word_bits >= 32)) return 0;
+	return 32 - word_bits;
+}
+
+// ///////////////////////////////////////// single channel
+
+void f32_to_i16_sat(const float32_t *p_f32, int16_t *p_i16, int len) {
+	int i = 0;
+#if defined(CONVERT_F32_USE_ARM_DSP)
+	if (is_word_aligned(p_i16)) {
+		uint32_t *p_out = (uint32_t *)p_i16;
+		for (; i < len-3; i += 4) {
+			*p_out++ = pack_i16x2(p_f32[i], p_f32[i+1]);
+			*p_out++ = pack_i16x2(p_f32[i+2], p_f32[i+3]);
+		}
+	}
+#elif defined(CONVERT_F32_USE_SSE2)
+	for (; i < len-7; i += 8) {
+		__m128i a = sse_f32_to_i32_sat(_mm_loadu_ps(p_f32+i));
+		__m128i b = sse_f32_to_i32_sat(_mm_loadu_ps(p_f32+i+4));
+		_mm_storeu_si128((__m128i *)(p_i16+i), _mm_packs_epi32(a, b));
+	}
+#endif
+	for (; i < len; i++) p_i16[i] = (int16_t)sat_i16(p_f32[i]*F32_TO_I16_SCALE);
+}
+
+void i16_to_f32_scaled(const int16_t *p_i16, float32_t *p_f32, int len) {
+	int i = 0;
+#if defined(CONVERT_F32_USE_SSE2)
+	for (; i < len-7; i += 8) {
+		__m128i x = _mm_loadu_si128((const __m128i *)(p_i16+i));
+		_mm_storeu_ps(p_f32+i,   sse_i32_to_f32_scaled(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16)));  //sign extend
+		_mm_storeu_ps(p_f32+i+4, sse_i32_to_f32_scaled(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16)));
+	}
+#endif
+	for (; i < len; i++) p_f32[i] = ((float32_t)p_i16[i]) * I16_TO_F32_SCALE;
+}
+
+// ///////////////////////////////////////// interleave
+
+void interleave_f32_to_i16_2chan(const float32_t *p_ch0, const float32_t *p_ch1, int16_t *p_i16, int nsamps) {
+	int i = 0;
+#if defined(CONVERT_F32_USE_ARM_DSP)
+	if (is_word_aligned(p_i16)) {
+		uint32_t *p_out = (uint32_t *)p_i16;
+		for (; i < nsamps; i++) *p_out++ = pack_i16x2(p_ch0[i], p_ch1[i]); //one 32-bit store per stereo frame
+		return;
+	}
+#elif defined(CONVERT_F32_USE_SSE2)
+	for (; i < nsamps-3; i += 4) {
+		__m128i a = sse_f32_to_i32_sat(_mm_loadu_ps(p_ch0+i));
+		__m128i b = sse_f32_to_i32_sat(_mm_loadu_ps(p_ch1+i));
+		_mm_storeu_si128((__m128i *)(p_i16+2*i), _mm_packs_epi32(_mm_unpacklo_epi32(a, b), _mm_unpackhi_epi32(a, b)));
+	}
+#endif
+	for (; i < nsamps; i++) {
+		p_i16[2*i]   = (int16_t)sat_i16(p_ch0[i]*F32_TO_I16_SCALE);
+		p_i16[2*i+1] = (int16_t)sat_i16(p_ch1[i]*F32_TO_I16_SCALE);
+	}
+}
+
+void interleave_f32_to_i16_4chan(const float32_t *p_ch0, const float32_t *p_ch1, const float32_t *p_ch2, const float32_t *p_ch3, int16_t *p_i16, int nsamps) {
+	int i = 0;
+#if defined(CONVERT_F32_USE_ARM_DSP)
+	if (is_word_aligned(p_i16)) {
+		uint32_t *p_out = (uint32_t *)p_i16;
+		for (; i < nsamps; i++) {
+			*p_out++ = pack_i16x2(p_ch0[i], p_ch1[i]);
+			*p_out++ = pack_i16x2(p_ch2[i], p_ch3[i]);
+		}
+		return;
+	}
+#elif defined(CONVERT_F32_USE_SSE2)
+	for (; i < nsamps-3; i += 4) {
+		__m128 a = _mm_loadu_ps(p_ch0+i), b = _mm_loadu_ps(p_ch1+i);
+		__m128 c = _mm_loadu_ps(p_ch2+i), d = _mm_loadu_ps(p_ch3+i);
+		_MM_TRANSPOSE4_PS(a, b, c, d);  //now each register holds one 4-channel frame
+		int16_t *p_out = p_i16 + 4*i;
+		_mm_storeu_si128((__m128i *)(p_out),   _mm_packs_epi32(sse_f32_to_i32_sat(a), sse_f32_to_i32_sat(b)));
+		_mm_storeu_si128((__m128i *)(p_out+8), _mm_packs_epi32(sse_f32_to_i32_sat(c), sse_f32_to_i32_sat(d)));
+	}
+#endif
+	for (; i < nsamps; i++) {
+		p_i16[4*i]   = (int16_t)sat_i16(p_ch0[i]*F32_TO_I16_SCALE);
+		p_i16[4*i+1] = (int16_t)sat_i16(p_ch1[i]*F32_TO_I16_SCALE);
+		p_i16[4*i+2] = (int16_t)sat_i16(p_ch2[i]*F32_TO_I16_SCALE);
+		p_i16[4*i+3] = (int16_t)sat_i16(p_ch3[i]*F32_TO_I16_SCALE);
+	}
+}
+
+void interleave_f32_to_i16(float32_t *p_f32[], int16_t *p_i16, int nsamps, int nchan) {
+	switch (nchan) {
+		case 1:
+			f32_to_i16_sat(p_f32[0], p_i16, nsamps); break;
+		case 2:
+			interleave_f32_to_i16_2chan(p_f32[0], p_f32[1], p_i16, nsamps); break;
+		case 4:
+			interleave_f32_to_i16_4chan(p_f32[0], p_f32[1], p_f32[2], p_f32[3], p_i16, nsamps); break;
+		default:
+			for (int Isamp = 0; Isamp < nsamps; Isamp++) {
+				for (int Ichan = 0; Ichan < nchan; Ichan++) {
+					*p_i16++ = (int16_t)sat_i16(p_f32[Ichan][Isamp]*F32_TO_I16_SCALE);
+				}
+			}
+	}
+}
+
+// ///////////////////////////////////////// de-interleave
+
+void deinterleave_i16_to_f32_2chan(const int16_t *p_i16, float32_t *p_ch0, float32_t *p_ch1, int nsamps) {
+	int i = 0;
+#if defined(CONVERT_F32_USE_ARM_DSP)
+	if (is_word_aligned(p_i16)) {
+		const uint32_t *p_in = (const uint32_t *)p_i16;
+		for (; i < nsamps; i++) {
+			uint32_t val = *p_in++;  //one 32-bit load per stereo frame
+			p_ch0[i] = ((float32_t)((int16_t)(val & 0xFFFF))) * I16_TO_F32_SCALE;
+			p_ch1[i] = ((float32_t)(((int32_t)val) >> 16)) * I16_TO_F32_SCALE;
+		}
+		return;
+	}
+#elif defined(CONVERT_F32_USE_SSE2)
+	for (; i < nsamps-3; i += 4) {
+		__m128i x = _mm_loadu_si128((const __m128i *)(p_i16+2*i));
+		_mm_storeu_ps(p_ch0+i, sse_i32_to_f32_scaled(_mm_srai_epi32(_mm_slli_epi32(x, 16), 16))); //even samples
+		_mm_storeu_ps(p_ch1+i, sse_i32_to_f32_scaled(_mm_srai_epi32(x, 16)));  //odd samples
+	}
+#endif
+	for (; i < nsamps; i++) {
+		p_ch0[i] = ((float32_t)p_i16[2*i])   * I16_TO_F32_SCALE;
+		p_ch1[i] = ((float32_t)p_i16[2*i+1]) * I16_TO_F32_SCALE;
+	}
+}
+
+void deinterleave_i16_to_f32_4chan(const int16_t *p_i16, float32_t *p_ch0, float32_t *p_ch1, float32_t *p_ch2, float32_t *p_ch3, int nsamps) {
+	int i = 0;
+#if defined(CONVERT_F32_USE_ARM_DSP)
+	if (is_word_aligned(p_i16)) {
+		const uint32_t *p_in = (const uint32_t *)p_i16;
+		for (; i < nsamps; i++) {
+			uint32_t val01 = *p_in++, val23 = *p_in++;
+			p_ch0[i] = ((float32_t)((int16_t)(val01 & 0xFFFF))) * I16_TO_F32_SCALE;
+			p_ch1[i] = ((float32_t)(((int32_t)val01) >> 16)) * I16_TO_F32_SCALE;
+			p_ch2[i] = ((float32_t)((int16_t)(val23 & 0xFFFF))) * I16_TO_F32_SCALE;
+			p_ch3[i] = ((float32_t)(((int32_t)val23) >> 16)) * I16_TO_F32_SCALE;
+		}
+		return;
+	}
+#elif defined(CONVERT_F32_USE_SSE2)
+	for (; i < nsamps-3; i += 4) {
+		__m128i x01 = _mm_loadu_si128((const __m128i *)(p_i16+4*i));   //frames 0 and 1
+		__m128i x23 = _mm_loadu_si128((const __m128i *)(p_i16+4*i+8)); //frames 2 and 3
+		__m128 a = sse_i32_to_f32_scaled(_mm_srai_epi32(_mm_unpacklo_epi16(x01, x01), 16));
+		__m128 b = sse_i32_to_f32_scaled(_mm_srai_epi32(_mm_unpackhi_epi16(x01, x01), 16));
+		__m128 c = sse_i32_to_f32_scaled(_mm_srai_epi32(_mm_unpacklo_epi16(x23, x23), 16));
+		__m128 d = sse_i32_to_f32_scaled(_mm_srai_epi32(_mm_unpackhi_epi16(x23, x23), 16));
+		_MM_TRANSPOSE4_PS(a, b, c, d);  //now each register holds one channel
+		_mm_storeu_ps(p_ch0+i, a); _mm_storeu_ps(p_ch1+i, b);
+		_mm_storeu_ps(p_ch2+i, c); _mm_storeu_ps(p_ch3+i, d);
+	}
+#endif
+	for (; i < nsamps; i++) {
+		p_ch0[i] = ((float32_t)p_i16[4*i])   * I16_TO_F32_SCALE;
+		p_ch1[i] = ((float32_t)p_i16[4*i+1]) * I16_TO_F32_SCALE;
+		p_ch2[i] = ((float32_t)p_i16[4*i+2]) * I16_TO_F32_SCALE;
+		p_ch3[i] = ((float32_t)p_i16[4*i+3]) * I16_TO_F32_SCALE;
+	}
+}
+
+void deinterleave_i16_to_f32(const int16_t *p_i16, float32_t *p_f32[], int nsamps, int nchan) {
+	switch (nchan) {
+		case 1:
+			i16_to_f32_scaled(p_i16, p_f32[0], nsamps); break;
+		case 2:
+			deinterleave_i16_to_f32_2chan(p_i16, p_f32[0], p_f32[1], nsamps); break;
+		case 4:
+			deinterleave_i16_to_f32_4chan(p_i16, p_f32[0], p_f32[1], p_f32[2], p_f32[3], nsamps); break;
+		default:
+			for (int Isamp = 0; Isamp < nsamps; Isamp++) {
+				for (int Ichan = 0; Ichan < nchan; Ichan++) {
+					p_f32[Ichan][Isamp] = ((float32_t)(*p_i16++)) * I16_TO_F32_SCALE;
+				}
+			}
+	}
+}
+
+// ///////////////////////////////////////// de-interleave 32-bit I2S slots
+
+void deinterleave_i32_to_f32_2chan(const int32_t *p_i32, float32_t *p_ch0, float32_t *p_ch1, int nsamps, int word_bits) {
+	const int shift = slot_shift(word_bits);
+	int i = 0;
+#if defined(CONVERT_F32_USE_ARM_DSP)
+	for (; i < nsamps-1; i += 2) {  //two frames per pass so the loads can issue back-to-back
+		int32_t a = p_i32[0], b = p_i32[1], c = p_i32[2], d = p_i32[3];
+		p_i32 += 4;
+		p_ch0[i]   = slot_to_f32(a, shift);
+		p_ch1[i]   = slot_to_f32(b, shift);
+		p_ch0[i+1] = slot_to_f32(c, shift);
+		p_ch1[i+1] = slot_to_f32(d, shift);
+	}
+#elif defined(CONVERT_F32_USE_SSE2)
+	const __m128i sh = _mm_cvtsi32_si128(shift);
+	for (; i < nsamps-3; i += 4) {
+		__m128 a = sse_slot_to_f32(p_i32, sh);    //L0 R0 L1 R1
+		__m128 b = sse_slot_to_f32(p_i32+4, sh);  //L2 R2 L3 R3
+		p_i32 += 8;
+		_mm_storeu_ps(p_ch0+i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0)));
+		_mm_storeu_ps(p_ch1+i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1)));
+	}
+#endif
+	for (; i < nsamps; i++) {
+		p_ch0[i] = slot_to_f32(*p_i32++, shift);
+		p_ch1[i] = slot_to_f32(*p_i32++, shift);
+	}
+}
+
+void deinterleave_i32_to_f32_4chan(const int32_t *p_i32, float32_t *p_ch0, float32_t *p_ch1, float32_t *p_ch2, float32_t *p_ch3, int nsamps, int word_bits) {
+	const int shift = slot_shift(word_bits);
+	int i = 0;
+#if defined(CONVERT_F32_USE_SSE2)
+	const __m128i sh = _mm_cvtsi32_si128(shift);
+	for (; i < nsamps-3; i += 4) {
+		__m128 a = sse_slot_to_f32(p_i32, sh),   b = sse_slot_to_f32(p_i32+4, sh);
+		__m128 c = sse_slot_to_f32(p_i32+8, sh), d = sse_slot_to_f32(p_i32+12, sh);
+		p_i32 += 16;
+		_MM_TRANSPOSE4_PS(a, b, c, d);  //now each register holds one channel
+		_mm_storeu_ps(p_ch0+i, a); _mm_storeu_ps(p_ch1+i, b);
+		_mm_storeu_ps(p_ch2+i, c); _mm_storeu_ps(p_ch3+i, d);
+	}
+#endif
+	for (; i < nsamps; i++) {
+		int32_t a = p_i32[0], b = p_i32[1], c = p_i32[2], d = p_i32[3];
+		p_i32 += 4;
+		p_ch0[i] = slot_to_f32(a, shift);
+		p_ch1[i] = slot_to_f32(b, shift);
+		p_ch2[i] = slot_to_f32(c, shift);
+		p_ch3[i] = slot_to_f32(d, shift);
+	}
+}
+
+void deinterleave_i32_to_f32(const int32_t *p_i32, float32_t *p_f32[], int nsamps, int nchan, int word_bits) {
+	switch (nchan) {
+		case 2:
+			deinterleave_i32_to_f32_2chan(p_i32, p_f32[0], p_f32[1], nsamps, word_bits); break;
+		case 4:
+			deinterleave_i32_to_f32_4chan(p_i32, p_f32[0], p_f32[1], p_f32[2], p_f32[3], nsamps, word_bits); break;
+		default: {
+			const int shift = slot_shift(word_bits);
+			for (int Isamp = 0; Isamp < nsamps; Isamp++) {
+				for (int Ichan = 0; Ichan < nchan; Ichan++) {
+					p_f32[Ichan][Isamp] = slot_to_f32(*p_i32++, shift);
+				}
+			}
+		}
+	}
+}
+
+// ///////////////////////////////////////// interleave to 32-bit I2S slots
+
+void interleave_f32_to_i32_2chan(const float32_t *p_ch0, const float32_t *p_ch1, int32_t *p_i32, int nsamps) {
+	int i = 0;
+#if defined(CONVERT_F32_USE_SSE2)
+	for (; i < nsamps-3; i += 4) {
+		__m128i a = sse_f32_to_i32_full(_mm_loadu_ps(p_ch0+i));
+		__m128i b = sse_f32_to_i32_full(_mm_loadu_ps(p_ch1+i));
+		_mm_storeu_si128((__m128i *)(p_i32+2*i),   _mm_unpacklo_epi32(a, b));
+		_mm_storeu_si128((__m128i *)(p_i32+2*i+4), _mm_unpackhi_epi32(a, b));
+	}
+#endif
+	for (; i < nsamps; i++) {
+		p_i32[2*i]   = sat_i32(p_ch0[i]*F32_TO_I32_SCALE);
+		p_i32[2*i+1] = sat_i32(p_ch1[i]*F32_TO_I32_SCALE);
+	}
+}
+
+void interleave_f32_to_i32(float32_t *p_f32[], int32_t *p_i32, int nsamps, int nchan) {
+	if (nchan == 2) { interleave_f32_to_i32_2chan(p_f32[0], p_f32[1], p_i32, nsamps); return; }
+	for (int Isamp = 0; Isamp < nsamps; Isamp++) {
+		for (int Ichan = 0; Ichan < nchan; Ichan++) {
+			*p_i32++ = sat_i32(p_f32[Ichan][Isamp]*F32_TO_I32_SCALE);
+		}
+	}
+}
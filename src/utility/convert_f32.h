@@ -0,0 +1,63 @@
+/*
+ * convert_f32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Shared sample-format conversion kernels for moving audio between the
+ *    float32 audio blocks used by the F32 audio graph and the int16 buffers used
+ *    by the SD writer, the USB audio, and the Int16 Teensy Audio objects.  Also
+ *    converts the 32-bit I2S slots coming from the DMA straight into float32.
+ *
+ *    All float-to-int conversions saturate (like CMSIS arm_float_to_q15) rather
+ *    than wrapping around.  Full scale is +/-1.0 in float and +/-32767 in int16.
+ *
+ *    The interleave / deinterleave routines have special fast versions for 2 and 4
+ *    channels.  On the Teensy (Cortex-M4F) they use the DSP-extension saturate and
+ *    pack instructions to write two int16 samples per 32-bit store.  On a host PC
+ *    with SSE2, they process four samples per instruction.  Everything else falls
+ *    back to a plain C loop that gives identical results.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _convert_f32_h
+#define _convert_f32_h
+
+#include <arm_math.h>  //for float32_t
+
+#define I16_TO_F32_SCALE (3.051850947599719e-05f)  //which is 1/32767
+#define F32_TO_I16_SCALE (32767.0f)
+#define I32_TO_F32_SCALE (4.656612875245797e-10f)  //which is 1/(2^31-1)
+#define F32_TO_I32_SCALE (2147483647.0f)
+
+//convert one channel of float32 (+/-1.0) to int16 (+/-32767), with saturation
+void f32_to_i16_sat(const float32_t *p_f32, int16_t *p_i16, int len);
+
+//convert one channel of int16 (+/-32767) to float32 (+/-1.0)
+void i16_to_f32_scaled(const int16_t *p_i16, float32_t *p_f32, int len);
+
+//convert several float32 channels to int16 and interleave them into one buffer (ch0, ch1, ..., ch0, ch1, ...).
+//Specialized (fast) versions exist for 2 and 4 channels.  Any other channel count uses a generic loop.
+void interleave_f32_to_i16(float32_t *p_f32[], int16_t *p_i16, int nsamps, int nchan);
+void interleave_f32_to_i16_2chan(const float32_t *p_ch0, const float32_t *p_ch1, int16_t *p_i16, int nsamps);
+void interleave_f32_to_i16_4chan(const float32_t *p_ch0, const float32_t *p_ch1, const float32_t *p_ch2, const float32_t *p_ch3, int16_t *p_i16, int nsamps);
+
+//de-interleave an int16 buffer into several float32 channels.  This is the reverse of the routines above.
+void deinterleave_i16_to_f32(const int16_t *p_i16, float32_t *p_f32[], int nsamps, int nchan);
+void deinterleave_i16_to_f32_2chan(const int16_t *p_i16, float32_t *p_ch0, float32_t *p_ch1, int nsamps);
+void deinterleave_i16_to_f32_4chan(const int16_t *p_i16, float32_t *p_ch0, float32_t *p_ch1, float32_t *p_ch2, float32_t *p_ch3, int nsamps);
+
+//de-interleave a buffer of 32-bit I2S slots (as filled by the DMA) into several float32 channels, in one pass.
+//word_bits says how many data bits sit in the bottom of each slot: use 32 for data that fills the slot (which is
+//also right for MSB-first 16/24-bit codecs, like the AIC3206, whose unused low bits are zero), or use 24 or 16
+//for right-justified data.  The data is sign-extended from word_bits and scaled so that full scale is +/-1.0.
+void deinterleave_i32_to_f32(const int32_t *p_i32, float32_t *p_f32[], int nsamps, int nchan, int word_bits = 32);
+void deinterleave_i32_to_f32_2chan(const int32_t *p_i32, float32_t *p_ch0, float32_t *p_ch1, int nsamps, int word_bits = 32);
+void deinterleave_i32_to_f32_4chan(const int32_t *p_i32, float32_t *p_ch0, float32_t *p_ch1, float32_t *p_ch2, float32_t *p_ch3, int nsamps, int word_bits = 32);
+
+//convert several float32 channels to full-scale 32-bit I2S slots (+/-2^31, saturated) and interleave them, in one pass.
+//Any channel count works (such as the 8 or 16 slots of TDM).  2 channels has a fast version.
+void interleave_f32_to_i32(float32_t *p_f32[], int32_t *p_i32, int nsamps, int nchan);
+void interleave_f32_to_i32_2chan(const float32_t *p_ch0, const float32_t *p_ch1, int32_t *p_i32, int nsamps);
+
+#endif
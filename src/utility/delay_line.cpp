@@ -0,0 +1,197 @@
+/*
+ * delay_line
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Long multi-tap delay line in one contiguous ring buffer.  See delay_line.h
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <math.h>
+#include <string.h>
+#include "delay_line.h"
+
+#define DELAY_LINE_INT16_SCALE 32767.0f
+
+// ///////////////////////////////////////// setup
+
+bool DelayLine::setBuffer(void *_mem, uint32_t n_samples, Storage _storage, int max_block) {
+	mem = 0;
+	for (int i = 0; i < DELAY_LINE_MAX_TAPS; i++) tap_on[i] = false;
+	if ((_mem == 0) || (max_block < 1)) return false;
+
+	//the ring has to hold the longest delay, plus a block, plus the interpolator's reach.  After it comes
+	//the mirror of its first guard_len samples, so that a whole block (and the interpolator) can be read
+	//without wrapping.
+	guard_len = max_block + 4;
+	ring_len = ((int32_t)n_samples) - guard_len;
+	max_delay = (float)(ring_len - max_block - 3);
+	if (max_delay < 1.0f) { max_delay = 0.0f; return false; }
+
+	mem = _mem;
+	storage = _storage;
+	write_idx = 0;
+	block_start = 0;
+	block_len = 0;
+	clear();
+	return true;
+}
+
+void DelayLine::clear(void) {
+	if (mem == 0) return;
+	const size_t bytes = (storage == INT16) ? sizeof(int16_t) : sizeof(float);
+	memset(mem, 0, (ring_len + guard_len) * bytes);
+}
+
+void DelayLine::setDelay_samples(int tap, float delay_samples) {
+	if ((tap < 0) || (tap >= DELAY_LINE_MAX_TAPS)) return;
+	const float min_delay = (interp == CUBIC) ? 1.0f : 0.0f;
+	if (delay_samples < min_delay) delay_samples = min_delay;
+	if (delay_samples > max_delay) delay_samples = max_delay;
+	if (interp == NONE) delay_samples = floorf(delay_samples + 0.5f);
+	target[tap] = delay_samples;
+	if (!tap_on[tap]) { tap_on[tap] = true; fresh[tap] = true; }
+}
+
+void DelayLine::setInterpolation(Interp type) {
+	interp = type;
+	for (int i = 0; i < DELAY_LINE_MAX_TAPS; i++) {   //apply the new limits to every tap
+		if (tap_on[i]) { tap_on[i] = false; setDelay_samples(i, target[i]); fresh[i] = false; }
+	}
+}
+
+// ///////////////////////////////////////// writing
+
+void DelayLine::put(int32_t idx, const float *in, int n) {
+	if (storage == INT16) {
+		int16_t *x = ((int16_t *)mem) + idx;
+		for (int i = 0; i < n; i++) {
+			float v = in[i] * DELAY_LINE_INT16_SCALE;
+			if (v > DELAY_LINE_INT16_SCALE) v = DELAY_LINE_INT16_SCALE;
+			if (v < -DELAY_LINE_INT16_SCALE) v = -DELAY_LINE_INT16_SCALE;
+			x[i] = (int16_t)lrintf(v);
+		}
+	} else {
+		memcpy(((float *)mem) + idx, in, n * sizeof(float));
+	}
+	//keep the mirror past the end of the ring up to date
+	if (idx < guard_len) {
+		const int n_mirror = (n < guard_len - idx) ? n : (guard_len - idx);
+		if (storage == INT16) {
+			int16_t *x = (int16_t *)mem;
+			memcpy(x + ring_len + idx, x + idx, n_mirror * sizeof(int16_t));
+		} else {
+			float *x = (float *)mem;
+			memcpy(x + ring_len + idx, x + idx, n_mirror * sizeof(float));
+		}
+	}
+}
+
+void DelayLine::write(const float *in, int n) {
+	if ((mem == 0) || (n <= 0)) return;
+	if (n > guard_len - 4) n = guard_len - 4;
+	block_start = write_idx;
+	block_len = n;
+	const int n_first = (n < ring_len - write_idx) ? n : (ring_len - write_idx);
+	put(write_idx, in, n_first);
+	if (n_first < n) put(0, in + n_first, n - n_first);
+	write_idx += n;
+	if (write_idx >= ring_len) write_idx -= ring_len;
+}
+
+void DelayLine::writeSilence(int n) {
+	static const float zeros[32] = {0};
+	if ((mem == 0) || (n <= 0)) return;
+	if (n > guard_len - 4) n = guard_len - 4;
+	int32_t start = write_idx;
+	int n_done = 0;
+	while (n_done < n) {
+		int m = n - n_done;
+		if (m > 32) m = 32;
+		write(zeros, m);
+		n_done += m;
+	}
+	block_start = start;
+	block_len = n;
+}
+
+// ///////////////////////////////////////// reading
+
+template <typename T> void DelayLine::readRun(const T *x, const int start, const float *c, const int n_coeff, const float scale,
+	float *out, bool accumulate, float gain_start, float gain_step) {
+	//out[i] = (gain) * sum_k c[k]*x[start+i+k], on a straight run of the ring
+	const int n = block_len;
+	const T *p = x + start;
+	const float c0 = c[0]*scale, c1 = c[1]*scale, c2 = c[2]*scale, c3 = c[3]*scale;
+	if (!accumulate && (gain_step == 0.0f) && (gain_start == 1.0f)) {
+		switch (n_coeff) {
+			case 1:  for (int i = 0; i < n; i++) out[i] = c0*p[i];  break;
+			case 2:  for (int i = 0; i < n; i++) out[i] = c0*p[i] + c1*p[i+1];  break;
+			default: for (int i = 0; i < n; i++) out[i] = c0*p[i] + c1*p[i+1] + c2*p[i+2] + c3*p[i+3];  break;
+		}
+		return;
+	}
+	//crossfading
+	float g = gain_start;
+	for (int i = 0; i < n; i++) {
+		float v;
+		switch (n_coeff) {
+			case 1:  v = c0*p[i];  break;
+			case 2:  v = c0*p[i] + c1*p[i+1];  break;
+			default: v = c0*p[i] + c1*p[i+1] + c2*p[i+2] + c3*p[i+3];  break;
+		}
+		out[i] = accumulate ? (out[i] + g*v) : (g*v);
+		g += gain_step;
+	}
+}
+
+void DelayLine::readFixed(float delay, float *out, bool accumulate, float gain_start, float gain_step) {
+	//Output sample i is the input at (block_start + i - delay).  With D whole samples of delay and a
+	//fraction f, that lies a fraction mu = 1-f past sample (block_start + i - D - 1).
+	const int32_t D = (int32_t)floorf(delay);
+	const float f = delay - D;
+	float c[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+	int32_t offset = D;    //from the block's start back to the first sample read
+	int n_coeff = 1;
+	if ((f > 0.0f) && (interp != NONE)) {
+		const float mu = 1.0f - f;
+		if (interp == LINEAR) {
+			c[0] = 1.0f - mu;  c[1] = mu;
+			offset = D + 1;
+			n_coeff = 2;
+		} else {
+			//Lagrange, on the samples at -1, 0, 1, 2 (mu is between 0 and 1)
+			const float mp1 = mu + 1.0f, mm1 = mu - 1.0f, mm2 = mu - 2.0f;
+			c[0] = -mu * mm1 * mm2 * (1.0f/6.0f);
+			c[1] = mp1 * mm1 * mm2 * 0.5f;
+			c[2] = -mp1 * mu * mm2 * 0.5f;
+			c[3] = mp1 * mu * mm1 * (1.0f/6.0f);
+			offset = D + 2;
+			n_coeff = 4;
+		}
+	}
+	int32_t start = block_start - offset;
+	while (start < 0) start += ring_len;
+	if (storage == INT16) {
+		readRun((const int16_t *)mem, start, c, n_coeff, 1.0f / DELAY_LINE_INT16_SCALE, out, accumulate, gain_start, gain_step);
+	} else {
+		readRun((const float *)mem, start, c, n_coeff, 1.0f, out, accumulate, gain_start, gain_step);
+	}
+}
+
+void DelayLine::readTap(int tap, float *out) {
+	if ((tap < 0) || (tap >= DELAY_LINE_MAX_TAPS) || (mem == 0) || (block_len == 0)) return;
+	if (!tap_on[tap]) { memset(out, 0, block_len * sizeof(float)); return; }
+	const float new_delay = target[tap];
+	if (fresh[tap] || (new_delay == current[tap])) {
+		readFixed(new_delay, out, false, 1.0f, 0.0f);
+	} else {
+		//crossfade from the old delay to the new one across this block
+		const float step = 1.0f / block_len;
+		readFixed(current[tap], out, false, 1.0f - step, -step);
+		readFixed(new_delay, out, true, step, step);
+	}
+	current[tap] = new_delay;
+	fresh[tap] = false;
+}
@@ -0,0 +1,72 @@
+/*
+ * delay_line
+ *
+ * Created: OpenAudio, Oct 2026
+ * Purpose: Long multi-tap delay line in one contiguous ring (float or int16), with NONE, LINEAR, or
+ *     CUBIC interpolation per tap.  See AudioEffectDelayLong_F32 for the audio node.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _delay_line_h
+#define _delay_line_h
+
+#include <stdint.h>
+
+#define DELAY_LINE_MAX_TAPS 8
+
+class DelayLine {
+	public:
+		enum Storage { FLOAT32 = 0, INT16 = 1 };
+		enum Interp { NONE = 0, LINEAR = 1, CUBIC = 2 };
+
+		DelayLine(void) {}
+
+		//Use n_samples samples of memory (each a float or an int16, as given by storage) for the ring.
+		//Writes (and so reads) are never longer than max_block samples.  Clears the ring and disables
+		//every tap.  Returns false if the memory is too small to be useful.
+		bool setBuffer(void *mem, uint32_t n_samples, Storage storage, int max_block);
+		static uint32_t samplesNeeded(uint32_t max_delay_samples, int max_block) { return max_delay_samples + 2*max_block + 8; }
+		void clear(void);   //fill the ring with silence
+		bool isReady(void) { return (mem != 0); }
+
+		//Taps.  The delay is in samples (and can be fractional), and is limited to 0 to getMaxDelay_samples()
+		//(with CUBIC, the shortest delay is 1 sample).  A new delay takes effect at the next block.
+		void setDelay_samples(int tap, float delay_samples);
+		void disable(int tap) { if ((tap >= 0) && (tap < DELAY_LINE_MAX_TAPS)) tap_on[tap] = false; }
+		bool isEnabled(int tap) { return (tap >= 0) && (tap < DELAY_LINE_MAX_TAPS) && tap_on[tap]; }
+		float getDelay_samples(int tap) { return ((tap >= 0) && (tap < DELAY_LINE_MAX_TAPS)) ? target[tap] : 0.0f; }
+		float getMaxDelay_samples(void) { return max_delay; }
+		void setInterpolation(Interp type);
+		Interp getInterpolation(void) { return interp; }
+		Storage getStorage(void) { return storage; }
+
+		//Once per block: write() the newest n samples (or writeSilence()), then readTap() each tap's delayed
+		//copy of that same block.
+		void write(const float *in, int n);
+		void writeSilence(int n);
+		void readTap(int tap, float *out);
+
+	protected:
+		void *mem = 0;
+		Storage storage = FLOAT32;
+		Interp interp = CUBIC;
+		int32_t ring_len = 0;      //samples in the ring (the mirror of its start comes after)
+		int32_t guard_len = 0;     //samples mirrored past the end
+		int32_t write_idx = 0;     //where the next sample goes
+		int32_t block_start = 0;   //where the last block written starts
+		int block_len = 0;         //...and its length
+		float max_delay = 0.0f;
+
+		bool tap_on[DELAY_LINE_MAX_TAPS] = {};
+		float target[DELAY_LINE_MAX_TAPS] = {};     //delay asked for
+		float current[DELAY_LINE_MAX_TAPS] = {};    //delay used last block
+		bool fresh[DELAY_LINE_MAX_TAPS] = {};       //just enabled, so no need to crossfade
+
+		void put(int32_t idx, const float *in, int n);
+		void readFixed(float delay, float *out, bool accumulate, float gain_start, float gain_step);
+		template <typename T> void readRun(const T *x, const int start, const float *c, const int n_coeff, const float scale,
+			float *out, bool accumulate, float gain_start, float gain_step);
+};
+
+#endif
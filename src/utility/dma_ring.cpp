@@ -0,0 +1,173 @@
+/*
+ * dma_ring
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Bookkeeping for an I2S DMA ring buffer.  See dma_ring.h
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include "dma_ring.h"
+
+static inline int max_int(int a, int b) { return (a > b) ? a : b; }
+static inline bool is_pow2(int val) { return (val > 0) && ((val & (val-1)) == 0); }
+
+// ///////////////////////////////////////// geometry
+
+bool AudioDMARing::isValid(int block, int period, int nper, int max_ring) {
+	if (period <= 0) period = block;
+	if ((block < 1) || (nper < 2)) return false;
+	int ring = period * nper;
+	if (ring > max_ring) return false;
+	//room for the period (or block) being filled, the block being read, and the block being written
+	if (ring < max_int(period, block) + 2*block + 2*AUDIO_DMA_RING_GUARD_FRAMES) return false;
+	if ((nper > 2) && !is_pow2(ring)) return false;      //the DMA address modulo only works on power-of-two sizes
+	return true;
+}
+
+bool AudioDMARing::configure(int block, int period, int nper, int max_ring) {
+	if (period <= 0) period = block;
+	bool ok = isValid(block, period, nper, max_ring);
+	if (!ok) { period = block; nper = 2; }  //the classic double buffer.  The I2S classes then use their original scheme.
+	block_frames = block;
+	period_frames = period;
+	n_periods = nper;
+	ring_frames = period * nper;
+	reset();
+	resetCounts();
+	return ok;
+}
+
+int AudioDMARing::log2_int(uint32_t val) {
+	int n = 0;
+	while (val > 1) { val >>= 1; n++; }
+	return n;
+}
+
+int AudioDMARing::getLatencyFrames(void) {
+	//wait for a whole period (or block), allow a whole block for processing, and keep a guard on each side
+	return max_int(period_frames, block_frames) + block_frames + 2*AUDIO_DMA_RING_GUARD_FRAMES;
+}
+
+void AudioDMARing::reset(void) {
+	frames_done = 0;
+	frames_done_idx = 0;
+	accum_frames = 0;
+	pending_updates = 0;
+	updates_remaining = 0;
+	pos = 0;
+	pos_idx = 0;
+	started = false;
+	locked = false;
+	last_block_start = 0;
+}
+
+int AudioDMARing::indexOf(uint32_t frame) {
+	int idx = (frames_done_idx + (int32_t)(frame - frames_done)) % ring_frames;
+	return (idx < 0) ? (idx + ring_frames) : idx;
+}
+
+// ///////////////////////////////////////// interrupt side
+
+int AudioDMARing::periodDone(void) {
+	frames_done += period_frames;
+	frames_done_idx += period_frames;
+	if (frames_done_idx >= ring_frames) frames_done_idx -= ring_frames;
+
+	int n = 0, acc = accum_frames + period_frames;
+	while (acc >= block_frames) { acc -= block_frames; n++; }
+	accum_frames = acc;
+
+	//if the audio graph has fallen a whole ring behind, there's no point trying to catch up
+	const int max_pending = max_int(1, ring_frames / block_frames);
+	int pending = pending_updates + n;
+	if (pending > max_pending) { n_skipped += pending - max_pending; pending = max_pending; }
+	pending_updates = pending;
+	return n;
+}
+
+bool AudioDMARing::isStarved(void) {
+	return started && ((int32_t)(pos - frames_done) <= 0);
+}
+
+int AudioDMARing::getStarvedPeriodIndex(void) {
+	int idx = frames_done_idx + period_frames;  //the period after the one now being sent
+	return (idx >= ring_frames) ? (idx - ring_frames) : idx;
+}
+
+// ///////////////////////////////////////// update side
+
+bool AudioDMARing::updateStarted(void) {
+	if (pending_updates > 0) pending_updates--;
+	updates_remaining = pending_updates;
+	return (updates_remaining > 0);
+}
+
+uint32_t AudioDMARing::framesNow(int ring_offset_frames) {
+	//the DMA is at most one ring ahead of the last interrupt, so this unwraps cleanly
+	int dist = ring_offset_frames - frames_done_idx;
+	if (dist < 0) dist += ring_frames;
+	return frames_done + dist;
+}
+
+int AudioDMARing::startRead(uint32_t now) {
+	//Read whole blocks from the periods that the interrupt has reported.  When an interrupt makes several
+	//updates due, they read the blocks of that period in order, so this update's block is as many blocks
+	//back from the end of the reported data as there are updates still to come (plus itself).
+	const uint32_t done = frames_done;
+	const int32_t back = (1 + updates_remaining) * block_frames;
+	if (!started) {
+		if ((int32_t)done < back) return -1;  //just started.  Not enough data yet.
+		pos = done - back;
+		pos_idx = indexOf(pos);
+		started = true;
+	}
+	if ((int32_t)(done - pos) < block_frames) { n_underrun++; return -1; }
+	if ((int32_t)(now - pos) > ring_frames - AUDIO_DMA_RING_GUARD_FRAMES) {
+		//the DMA has lapped us.  Jump to the newest whole block.
+		n_overrun++;
+		pos = done - block_frames;
+		pos_idx = indexOf(pos);
+	}
+	int idx = pos_idx;
+	last_block_start = pos;
+	pos += block_frames;
+	pos_idx += block_frames;
+	if (pos_idx >= ring_frames) pos_idx -= ring_frames;
+	return idx;
+}
+
+int AudioDMARing::getOutputLead(AudioDMARing *input_ring, uint32_t input_now) {
+	//without a running input there is nothing to lock to, so just stay a safe distance ahead of the DMA
+	int lead;
+	if (input_ring && input_ring->isStarted()) {
+		int32_t age = (int32_t)(input_now - input_ring->getLastBlockStart());
+		lead = getLatencyFrames() - age;
+	} else {
+		lead = max_int(period_frames, block_frames) + AUDIO_DMA_RING_GUARD_FRAMES;
+	}
+	if (lead < AUDIO_DMA_RING_GUARD_FRAMES) lead = AUDIO_DMA_RING_GUARD_FRAMES;
+	if (lead > ring_frames - block_frames) lead = ring_frames - block_frames;
+	return lead;
+}
+
+int AudioDMARing::startWrite(uint32_t now, int lead_frames, bool lead_is_locked) {
+	int32_t ahead = (int32_t)(pos - now);
+	bool relock = started && lead_is_locked && !locked;  //the input has just started.  Move to the fixed latency.
+	if (!started || relock || (ahead < AUDIO_DMA_RING_GUARD_FRAMES) || (ahead > ring_frames - block_frames)) {
+		if (started && !relock) {
+			if (ahead < AUDIO_DMA_RING_GUARD_FRAMES) { n_underrun++; } else { n_overrun++; }
+		}
+		pos = now + lead_frames;
+		pos_idx = indexOf(pos);
+		started = true;
+		locked = lead_is_locked;
+	}
+	int idx = pos_idx;
+	last_block_start = pos;
+	pos += block_frames;
+	pos_idx += block_frames;
+	if (pos_idx >= ring_frames) pos_idx -= ring_frames;
+	return idx;
+}
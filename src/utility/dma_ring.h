@@ -0,0 +1,97 @@
+/*
+ * dma_ring
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Bookkeeping for an I2S DMA ring whose interrupt period is not tied to the audio
+ *    block size.  The interrupt only counts periods; the I2S update() methods read and write
+ *    whole blocks in the ring at the positions chosen here, for a fixed input-to-output latency.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _dma_ring_h
+#define _dma_ring_h
+
+#include <stdint.h>
+
+//frames of slack kept between the DMA and the software, to cover the I2S FIFO and interrupt jitter
+#define AUDIO_DMA_RING_GUARD_FRAMES 4
+
+class AudioDMARing {
+	public:
+		AudioDMARing(void) { configure(128, 0, 2, 256); }
+
+		//Choose the geometry.  period_frames <= 0 means one block per period.  The ring must hold at least
+		//max(period,block) + 2*block + 2*guard frames and no more than max_ring_frames.  With more than 2 periods
+		//the ring length must also be a power of two (the DMA wraps it with its address-modulo feature).  Returns
+		//false, and falls back to 2 periods of one block each, if the request can't be met.  That fallback is too
+		//small to be used this way, so the I2S classes go back to their original double-buffer scheme.
+		bool configure(int block_frames, int period_frames, int n_periods, int max_ring_frames);
+		static bool isValid(int block_frames, int period_frames, int n_periods, int max_ring_frames);
+
+		int getBlockFrames(void) { return block_frames; }
+		int getPeriodFrames(void) { return period_frames; }
+		int getNumPeriods(void) { return n_periods; }
+		int getRingFrames(void) { return ring_frames; }
+		//true: one DMA major loop per period, wrapped with address modulo.  false: one major loop for the whole ring,
+		//with interrupts at the half and at the end (the 2-period case, which works for any length)
+		bool usesAddressModulo(void) { return n_periods > 2; }
+		static int log2_int(uint32_t val);
+
+		//the fixed input-to-output latency that the output aims for
+		int getLatencyFrames(void);
+
+		void reset(void);
+
+		// ///////// called from the DMA interrupt (once per period)
+		//returns the number of audio updates that became due.  The interrupt should call update_all() if non-zero.
+		int periodDone(void);
+		//output only: true if the DMA has run past everything the software wrote (the audio graph stalled).  The
+		//interrupt should then silence the period after the one being sent.  See getStarvedPeriodIndex().
+		bool isStarved(void);
+		int getStarvedPeriodIndex(void);
+
+		// ///////// called from update()
+		//call at the start of every update().  For the object that has update responsibility, true means
+		//that more updates are still due, in which case update_all() must be called again.
+		bool updateStarted(void);
+		//convert the DMA's current offset in the ring (in frames) into a running frame count
+		uint32_t framesNow(int ring_offset_frames);
+		//input: ring index (frames) of the next block to read, or -1 if a whole block isn't there yet.  Call after updateStarted().
+		int startRead(uint32_t now);
+		//output: ring index (frames) at which to write the next block.  lead_frames is how far ahead of the
+		//DMA to put the block when (re)starting.  Use getOutputLead() to get the fixed latency, and set
+		//lead_is_locked once the input is running so that the output moves to the fixed latency.
+		int startWrite(uint32_t now, int lead_frames, bool lead_is_locked);
+		//output: the lead that gives the fixed latency, given the input's ring and the current input position
+		int getOutputLead(AudioDMARing *input_ring, uint32_t input_now);
+
+		bool isStarted(void) { return started; }
+		uint32_t getLastBlockStart(void) { return last_block_start; }
+		uint32_t getFramesDone(void) { return frames_done; }
+
+		//problems seen since the last reset
+		unsigned long getUnderrunCount(void) { return n_underrun; }  //data wasn't ready (input) or was written too late (output)
+		unsigned long getOverrunCount(void) { return n_overrun; }    //the DMA caught up with the software and overwrote/replayed data
+		unsigned long getSkippedUpdateCount(void) { return n_skipped; } //updates dropped because the graph fell a whole ring behind
+		void resetCounts(void) { n_underrun = 0; n_overrun = 0; n_skipped = 0; }
+
+	protected:
+		int block_frames, period_frames, n_periods, ring_frames;
+		volatile uint32_t frames_done;   //frames the DMA has finished with, in whole periods
+		volatile int frames_done_idx;    //same, as an index into the ring
+		volatile int accum_frames;       //frames counted toward the next update
+		volatile int pending_updates;
+		int updates_remaining;           //updates still due after the one now running
+		uint32_t pos;        //running frame count of the next block to read or write
+		int pos_idx;         //same, as an index into the ring
+		bool started;
+		bool locked;         //output: position was set from a running input
+		uint32_t last_block_start;
+		unsigned long n_underrun, n_overrun, n_skipped;
+
+		int indexOf(uint32_t frame);
+};
+
+#endif
@@ -0,0 +1,190 @@
+/*
+ * freq_warp_bank
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: A frequency-warped FIR filterbank.  See freq_warp_bank.h.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stddef.h>
+#include <math.h>
+#include "freq_warp_bank.h"
+
+#if defined(__SSE2__) && !defined(__ARM_ARCH_7EM__)
+	//host PC builds
+	#include <emmintrin.h>
+	#define FREQ_WARP_BANK_USE_SSE2
+#endif
+
+static const double fwb_pi = 3.14159265358979323846;
+
+// ///////////////////////////////////////// design
+
+float FreqWarpFilterBank::barkRho(const float fs_Hz) {
+	//Smith and Abel, "Bark and ERB Bilinear Transforms", 1999 (as in the WDRC_8BandFreqWarpFIR example)
+	const float fs_kHz = fs_Hz / 1000.0f;
+	return 1.0674f * sqrtf(2.0f / (float)fwb_pi * atanf(0.06583f * fs_kHz)) - 0.1916f;
+}
+
+float FreqWarpFilterBank::warpedFreq_rad(const float f_Hz) {
+	const double w = 2.0 * fwb_pi * f_Hz / sample_rate_Hz;
+	return (float)(w + 2.0 * atan2(rho * sin(w), 1.0 - rho * cos(w)));
+}
+
+float FreqWarpFilterBank::unwarpedFreq_Hz(const float w_rad) {
+	const double w = w_rad - 2.0 * atan2(rho * sin(w_rad), 1.0 + rho * cos(w_rad));
+	return (float)(w * sample_rate_Hz / (2.0 * fwb_pi));
+}
+
+bool FreqWarpFilterBank::setup(const float fs_Hz, const int _n_bands, const float *xover_Hz, const int _n_taps, const float _rho) {
+	n_bands = 0;  n_taps = 0;  n_groups = 0;
+	if ((fs_Hz <= 0.0f) || (_n_bands < 1) || (_n_bands > FREQ_WARP_BANK_MAX_BANDS)) return false;
+	if ((_n_taps < 3) || (_n_taps > FREQ_WARP_BANK_MAX_TAPS)) return false;
+	sample_rate_Hz = fs_Hz;
+	rho = (_rho < 0.0f) ? barkRho(fs_Hz) : _rho;
+	if (rho >= 1.0f) return false;
+
+	//the crossovers, on the warped scale (0 to pi)
+	double edge[FREQ_WARP_BANK_MAX_BANDS + 1];
+	edge[0] = 0.0;  edge[_n_bands] = fwb_pi;
+	for (int b = 1; b < _n_bands; b++) {
+		if (xover_Hz) {
+			if ((xover_Hz[b-1] <= 0.0f) || (xover_Hz[b-1] >= 0.5f * fs_Hz)) return false;
+			edge[b] = warpedFreq_rad(xover_Hz[b-1]);
+		} else {
+			edge[b] = fwb_pi * b / _n_bands;
+		}
+		if (edge[b] <= edge[b-1]) return false;
+		crossover_Hz[b-1] = xover_Hz ? xover_Hz[b-1] : unwarpedFreq_Hz((float)edge[b]);
+	}
+
+	//each band: (ideal low-pass at its upper edge) - (ideal low-pass at its lower edge), times a Hann
+	//window that is 1.0 in the middle.  Only the first half (through the middle) is kept.
+	const double mid = 0.5 * (_n_taps - 1);
+	const int n_half = (_n_taps + 1) / 2;
+	for (int k = 0; k < n_half; k++) {
+		const double t = k - mid;
+		const double win = 0.5 - 0.5 * cos(2.0 * fwb_pi * (k + 1) / (_n_taps + 1));
+		for (int b = 0; b < FREQ_WARP_BANK_MAX_BANDS; b++) {
+			double h = 0.0;
+			if (b < _n_bands) {
+				if (fabs(t) < 1.0e-9) h = (edge[b+1] - edge[b]) / fwb_pi;
+				else h = (sin(edge[b+1] * t) - sin(edge[b] * t)) / (fwb_pi * t);
+			}
+			coeff[k][b] = (float)(h * win);
+		}
+	}
+	n_bands = _n_bands;  n_taps = _n_taps;
+	n_groups = (n_bands + FREQ_WARP_BANK_LANES - 1) / FREQ_WARP_BANK_LANES;
+	clearStates();
+	return true;
+}
+
+void FreqWarpFilterBank::clearStates(void) {
+	for (int k = 0; k < FREQ_WARP_BANK_MAX_TAPS; k++) tap[k] = 0.0f;
+}
+
+//the band's (complex) response at warped frequency w: the sum over the taps of h[k]*exp(-j*k*w)
+double FreqWarpFilterBank::responseMag(const int band, const double w, double *re_out, double *im_out) {
+	double re = 0.0, im = 0.0;
+	const int n_half = (n_taps + 1) / 2;
+	for (int k = 0; k < n_taps; k++) {
+		const int kk = (k < n_half) ? k : (n_taps - 1 - k);
+		const double h = coeff[kk][band];
+		re += h * cos(k * w);  im -= h * sin(k * w);
+	}
+	if (re_out) *re_out = re;
+	if (im_out) *im_out = im;
+	return sqrt(re * re + im * im);
+}
+
+float FreqWarpFilterBank::getResponse_dB(const int band, const float f_Hz) {
+	if ((band < 0) || (band >= n_bands)) return -200.0f;
+	const double mag = responseMag(band, warpedFreq_rad(f_Hz));
+	return (mag > 1.0e-10) ? (float)(20.0 * log10(mag)) : -200.0f;
+}
+
+float FreqWarpFilterBank::getSumResponse_dB(const float f_Hz) {
+	const double w = warpedFreq_rad(f_Hz);
+	double re = 0.0, im = 0.0;
+	for (int b = 0; b < n_bands; b++) {
+		double r, i;
+		responseMag(b, w, &r, &i);
+		re += r;  im += i;
+	}
+	const double mag = sqrt(re * re + im * im);
+	return (mag > 1.0e-10) ? (float)(20.0 * log10(mag)) : -200.0f;
+}
+
+float FreqWarpFilterBank::getGroupDelay_samples(const float f_Hz) {
+	//each allpass delays by (1 - rho^2) / (1 + rho^2 - 2*rho*cos(w)) samples
+	const double w = 2.0 * fwb_pi * f_Hz / sample_rate_Hz;
+	const double d = (1.0 - rho * rho) / (1.0 + rho * rho - 2.0 * rho * cos(w));
+	return (float)(0.5 * (n_taps - 1) * d);
+}
+
+// ///////////////////////////////////////// processing
+
+//one sample into the allpass chain.  Each allpass's input is the tap before it, and its last input
+//is that tap's old value, so the chain needs no state of its own:
+//  tap[k] = -rho*tap[k-1] + old_tap[k-1] + rho*old_tap[k]
+void FreqWarpFilterBank::advance(const float x) {
+	const float r = rho;
+	float prev_old = tap[0];
+	tap[0] = x;
+	for (int k = 1; k < n_taps; k++) {
+		const float old = tap[k];
+		tap[k] = (prev_old + r * old) - r * tap[k-1];   //only the last product waits on the tap before
+		prev_old = old;
+	}
+}
+
+#if defined(FREQ_WARP_BANK_USE_SSE2)
+
+void FreqWarpFilterBank::bandOutputs(float *acc) {
+	const int n_half = n_taps / 2;
+	__m128 a[FREQ_WARP_BANK_MAX_BANDS / FREQ_WARP_BANK_LANES];
+	for (int g = 0; g < n_groups; g++) a[g] = _mm_setzero_ps();
+	for (int k = 0; k < n_half; k++) {
+		const __m128 t = _mm_set1_ps(tap[k] + tap[n_taps - 1 - k]);
+		const float *c = coeff[k];
+		for (int g = 0; g < n_groups; g++) a[g] = _mm_add_ps(a[g], _mm_mul_ps(t, _mm_loadu_ps(c + FREQ_WARP_BANK_LANES * g)));
+	}
+	if (n_taps & 1) {
+		const __m128 t = _mm_set1_ps(tap[n_half]);
+		const float *c = coeff[n_half];
+		for (int g = 0; g < n_groups; g++) a[g] = _mm_add_ps(a[g], _mm_mul_ps(t, _mm_loadu_ps(c + FREQ_WARP_BANK_LANES * g)));
+	}
+	for (int g = 0; g < n_groups; g++) _mm_storeu_ps(acc + FREQ_WARP_BANK_LANES * g, a[g]);
+}
+
+#else
+
+void FreqWarpFilterBank::bandOutputs(float *acc) {
+	const int n_half = n_taps / 2, n_lanes = FREQ_WARP_BANK_LANES * n_groups;
+	for (int b = 0; b < n_lanes; b++) acc[b] = 0.0f;
+	for (int k = 0; k < n_half; k++) {
+		const float t = tap[k] + tap[n_taps - 1 - k];
+		const float *c = coeff[k];
+		for (int b = 0; b < n_lanes; b++) acc[b] += t * c[b];
+	}
+	if (n_taps & 1) {
+		const float t = tap[n_half];
+		const float *c = coeff[n_half];
+		for (int b = 0; b < n_lanes; b++) acc[b] += t * c[b];
+	}
+}
+
+#endif
+
+void FreqWarpFilterBank::process(const float *x, float * const *y, const int n) {
+	if (n_bands == 0) return;
+	float acc[FREQ_WARP_BANK_MAX_BANDS];
+	for (int i = 0; i < n; i++) {
+		advance(x[i]);
+		bandOutputs(acc);
+		for (int b = 0; b < n_bands; b++) y[b][i] = acc[b];
+	}
+}
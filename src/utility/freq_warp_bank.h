@@ -0,0 +1,64 @@
+/*
+ * freq_warp_bank
+ *
+ * Created: OpenAudio, Oct 2026
+ * Purpose: Frequency-warped FIR filterbank (Kates, "Digital Hearing Aids", Ch. 8): one shared
+ *     allpass chain, and complementary bands designed in the warped domain.  See AudioFilterFreqWarpFIRBank_F32.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _freq_warp_bank_h
+#define _freq_warp_bank_h
+
+#ifndef FREQ_WARP_BANK_MAX_BANDS
+#define FREQ_WARP_BANK_MAX_BANDS 16   //must be a multiple of 4
+#endif
+#define FREQ_WARP_BANK_MAX_TAPS 65
+#define FREQ_WARP_BANK_LANES 4         //bands computed together
+
+class FreqWarpFilterBank {
+	public:
+		FreqWarpFilterBank(void) { clearStates(); }
+
+		//n_bands bands, split at the n_bands-1 crossovers (Hz, rising), or equally on the warped scale if
+		//crossover_Hz is NULL.  rho < 0 uses barkRho(fs_Hz).  Clears the states.  Returns false if the
+		//settings are no good (and then there are no bands).
+		bool setup(const float fs_Hz, const int n_bands, const float *crossover_Hz, const int n_taps, const float rho = -1.0f);
+
+		void process(const float *x, float * const *y, const int n);   //y[band] gets n samples of each band
+		void clearStates(void);
+
+		int getNumBands(void) { return n_bands; }
+		int getNumTaps(void) { return n_taps; }
+		float getRho(void) { return rho; }
+		float getSampleRate_Hz(void) { return sample_rate_Hz; }
+		float getCrossover_Hz(const int i) { return ((i >= 0) && (i < n_bands - 1)) ? crossover_Hz[i] : 0.0f; }
+		float getCoeff(const int band, const int tap) { return coeff[tap][band]; }   //tap < (n_taps+1)/2; the rest are the mirror image
+
+		//the design's response (magnitude, in dB) of a band at f_Hz, and of all bands added together
+		float getResponse_dB(const int band, const float f_Hz);
+		float getSumResponse_dB(const float f_Hz);
+		//the delay of the chain's middle tap (where each band is centered) at f_Hz, in samples
+		float getGroupDelay_samples(const float f_Hz);
+
+		static float barkRho(const float fs_Hz);
+		float warpedFreq_rad(const float f_Hz);        //where f_Hz lands on the warped scale (0 to pi)
+		float unwarpedFreq_Hz(const float w_rad);      //the inverse
+
+	protected:
+		float sample_rate_Hz = 24000.0f, rho = 0.0f;
+		int n_bands = 0, n_taps = 0, n_groups = 0;
+		float crossover_Hz[FREQ_WARP_BANK_MAX_BANDS];
+
+		//the chain's taps (the input and each allpass's output), and the folded coefficients, tap by tap,
+		//with the bands side by side (unused bands are zero)
+		float tap[FREQ_WARP_BANK_MAX_TAPS];
+		float coeff[(FREQ_WARP_BANK_MAX_TAPS + 1) / 2][FREQ_WARP_BANK_MAX_BANDS];
+
+		void advance(const float x);
+		void bandOutputs(float *acc);
+		double responseMag(const int band, const double w_warped, double *re_out = 0, double *im_out = 0);
+};
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * freq_weighting
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: A- and C-weighting filters designed at run time for any sample rate.  See freq_weighting.h.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stddef.h>
+#include <math.h>
+#include "freq_weighting.h"
+
+//the poles of the weighting filters (IEC 61672-1, Annex E)
+#define FREQ_WEIGHTING_F1_HZ 20.598997
+#define FREQ_WEIGHTING_F2_HZ 107.65265
+#define FREQ_WEIGHTING_F3_HZ 737.86223
+#define FREQ_WEIGHTING_F4_HZ 12194.217
+#define FREQ_WEIGHTING_REF_HZ 1000.0     //where the weighting is 0 dB
+#define FREQ_WEIGHTING_MATCH_FRAC 0.25   //the corrected top section matches the analog magnitude here (re: fs), too
+
+static const double fw_pi = 3.14159265358979323846;
+
+double FreqWeightingDesign::goal_dB(const int type, const double f_Hz) {
+	if ((type != A_WEIGHT) && (type != C_WEIGHT)) return 0.0;
+	const double f1 = FREQ_WEIGHTING_F1_HZ * FREQ_WEIGHTING_F1_HZ, f2 = FREQ_WEIGHTING_F2_HZ * FREQ_WEIGHTING_F2_HZ;
+	const double f3 = FREQ_WEIGHTING_F3_HZ * FREQ_WEIGHTING_F3_HZ, f4 = FREQ_WEIGHTING_F4_HZ * FREQ_WEIGHTING_F4_HZ;
+	double mag[2];
+	for (int i = 0; i < 2; i++) {
+		const double f = (i == 0) ? f_Hz * f_Hz : FREQ_WEIGHTING_REF_HZ * FREQ_WEIGHTING_REF_HZ;
+		mag[i] = f4 * f / ((f + f1) * (f + f4));       //C
+		if (type == A_WEIGHT) mag[i] *= f / sqrt((f + f2) * (f + f3));
+	}
+	return (mag[0] > 0.0) ? 20.0 * log10(mag[0] / mag[1]) : -400.0;
+}
+
+double FreqWeightingDesign::response_dB(const float *sos, const int n_sos, const double f_Hz, const double fs_Hz) {
+	const double w = 2.0 * fw_pi * f_Hz / fs_Hz;
+	const double c1 = cos(w), s1 = sin(w), c2 = cos(2.0 * w), s2 = sin(2.0 * w);
+	double mag2 = 1.0;
+	for (int s = 0; s < n_sos; s++) {
+		const float *row = sos + 6 * s;
+		const double br = row[0] + row[1] * c1 + row[2] * c2, bi = -row[1] * s1 - row[2] * s2;
+		const double ar = row[3] + row[4] * c1 + row[5] * c2, ai = -row[4] * s1 - row[5] * s2;
+		mag2 *= (br * br + bi * bi) / (ar * ar + ai * ai);
+	}
+	return (mag2 > 0.0) ? 10.0 * log10(mag2) : -400.0;
+}
+
+//the bilinear transform's constant that makes the digital filter match the analog one exactly at w
+//(so long as w is below Nyquist; otherwise, just below Nyquist)
+static double prewarp(double w, const double fs_Hz) {
+	if (w > 0.9 * 3.14159265358979323846 * fs_Hz) w = 0.9 * 3.14159265358979323846 * fs_Hz;
+	return w / tan(0.5 * w / fs_Hz);
+}
+
+//(B[2]*s^2 + B[1]*s + B[0]) / (A[2]*s^2 + A[1]*s + A[0]), with s = K*(1 - z^-1)/(1 + z^-1)
+void FreqWeightingDesign::bilinear(const double *B, const double *A, const double K, double *sos) {
+	const double K2 = K * K;
+	const double a0 = A[2] * K2 + A[1] * K + A[0];
+	sos[0] = (B[2] * K2 + B[1] * K + B[0]) / a0;
+	sos[1] = 2.0 * (B[0] - B[2] * K2) / a0;
+	sos[2] = (B[2] * K2 - B[1] * K + B[0]) / a0;
+	sos[3] = 1.0;
+	sos[4] = 2.0 * (A[0] - A[2] * K2) / a0;
+	sos[5] = (A[2] * K2 - A[1] * K + A[0]) / a0;
+}
+
+//w^2 / (s + w)^2, with its poles mapped exactly and its numerator matching the analog magnitude at
+//DC, fs/4, and Nyquist.  Works with the magnitude squared written in phi = sin^2(w/2):
+//  |H|^2 = (B0*(1-phi) + B1*phi + B2*4*phi*(1-phi)) / (A0*(1-phi) + A1*phi + A2*4*phi*(1-phi))
+//Returns false if no numerator can do that.
+bool FreqWeightingDesign::matchedLowpass(const double w_pole, const double fs_Hz, double *sos) {
+	const double p = exp(-w_pole / fs_Hz);
+	const double a1 = -2.0 * p, a2 = p * p;
+	const double A0 = (1.0 + a1 + a2) * (1.0 + a1 + a2), A1 = (1.0 - a1 + a2) * (1.0 - a1 + a2), A2 = -4.0 * a2;
+
+	//the analog magnitude squared at DC (1), Nyquist, and f_match
+	const double phi1 = pow(sin(fw_pi * FREQ_WEIGHTING_MATCH_FRAC), 2.0), phi0 = 1.0 - phi1, phi2 = 4.0 * phi0 * phi1;
+	const double w_nyq = fw_pi * fs_Hz, w_mid = 2.0 * fw_pi * FREQ_WEIGHTING_MATCH_FRAC * fs_Hz;
+	const double g_nyq = w_pole * w_pole / (w_pole * w_pole + w_nyq * w_nyq);
+	const double g_mid = w_pole * w_pole / (w_pole * w_pole + w_mid * w_mid);
+	const double B0 = A0, B1 = A1 * g_nyq * g_nyq;
+	const double B2 = (g_mid * g_mid * (A0 * phi0 + A1 * phi1 + A2 * phi2) - B0 * phi0 - B1 * phi1) / phi2;
+
+	//factor back into b0 + b1*z^-1 + b2*z^-2
+	const double W = 0.5 * (sqrt(B0) + sqrt(B1));
+	if (W * W + B2 < 0.0) return false;
+	const double b0 = 0.5 * (W + sqrt(W * W + B2));
+	sos[0] = b0;
+	sos[1] = 0.5 * (sqrt(B0) - sqrt(B1));
+	sos[2] = -B2 / (4.0 * b0);
+	sos[3] = 1.0;  sos[4] = a1;  sos[5] = a2;
+	return true;
+}
+
+int FreqWeightingDesign::design(const int type, const float fs_Hz, float *matlab_sos, const bool hf_correction) {
+	if ((fs_Hz <= 2.0f * FREQ_WEIGHTING_REF_HZ) || (matlab_sos == NULL)) return 0;
+	const int n_sos = getNumSections(type);
+	if (type == Z_WEIGHT) {
+		const float pass[6] = { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f };
+		for (int i = 0; i < 6; i++) matlab_sos[i] = pass[i];
+		return n_sos;
+	}
+	if ((type != A_WEIGHT) && (type != C_WEIGHT)) return 0;
+
+	const double w1 = 2.0 * fw_pi * FREQ_WEIGHTING_F1_HZ, w2 = 2.0 * fw_pi * FREQ_WEIGHTING_F2_HZ;
+	const double w3 = 2.0 * fw_pi * FREQ_WEIGHTING_F3_HZ, w4 = 2.0 * fw_pi * FREQ_WEIGHTING_F4_HZ;
+	const double w_23 = sqrt(w2 * w3);
+
+	//the sections, as analog biquads: s^2/(s+w1)^2, [A only: s^2/((s+w2)(s+w3))], and w4^2/(s+w4)^2
+	double sos[FREQ_WEIGHTING_MAX_SOS][6];
+	const double hp_B[3] = { 0.0, 0.0, 1.0 };
+	const double hp1_A[3] = { w1 * w1, 2.0 * w1, 1.0 };
+	const double hp23_A[3] = { w2 * w3, w2 + w3, 1.0 };
+	const double lp_B[3] = { w4 * w4, 0.0, 0.0 };
+	const double lp_A[3] = { w4 * w4, 2.0 * w4, 1.0 };
+	int s = 0;
+	bilinear(hp_B, hp1_A, prewarp(w1, fs_Hz), sos[s++]);
+	if (type == A_WEIGHT) bilinear(hp_B, hp23_A, prewarp(w_23, fs_Hz), sos[s++]);
+	if (!hf_correction || !matchedLowpass(w4, fs_Hz, sos[s])) bilinear(lp_B, lp_A, prewarp(w4, fs_Hz), sos[s]);
+	s++;
+
+	//to float, with the gain set for 0 dB at 1 kHz
+	for (int i = 0; i < s; i++) for (int j = 0; j < 6; j++) matlab_sos[6 * i + j] = (float)sos[i][j];
+	const double g = pow(10.0, -response_dB(matlab_sos, s, FREQ_WEIGHTING_REF_HZ, fs_Hz) / 20.0);
+	for (int j = 0; j < 3; j++) matlab_sos[j] = (float)(sos[0][j] * g);
+	return s;
+}
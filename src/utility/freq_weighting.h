@@ -0,0 +1,38 @@
+/*
+ * freq_weighting
+ *
+ * Created: OpenAudio, Oct 2026
+ * Purpose: A- and C-weighting (IEC 61672-1) filters, designed at run time for any sample rate, as
+ *     Matlab sos rows.  Checked against the class 1 limits by extras/host/weighting_check.cpp.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _freq_weighting_h
+#define _freq_weighting_h
+
+#define Z_WEIGHT 0   //flat (no weighting)
+#define A_WEIGHT 1
+#define C_WEIGHT 3
+
+#define FREQ_WEIGHTING_MAX_SOS 3
+
+class FreqWeightingDesign {
+	public:
+		//Design the filter (A_WEIGHT, C_WEIGHT, or Z_WEIGHT) for this sample rate into matlab_sos (room for
+		//FREQ_WEIGHTING_MAX_SOS rows of 6).  hf_correction = false gives the plain (prewarped) bilinear
+		//transform.  Returns the number of sections (Z is one section that passes everything), or 0 if the
+		//type or sample rate is no good.
+		static int design(const int type, const float fs_Hz, float *matlab_sos, const bool hf_correction = true);
+		static int getNumSections(const int type) { return (type == A_WEIGHT) ? 3 : ((type == C_WEIGHT) ? 2 : 1); }
+
+		//the standard's weighting (the analog filter), in dB, and the response of n_sos Matlab sos rows, in dB
+		static double goal_dB(const int type, const double f_Hz);
+		static double response_dB(const float *matlab_sos, const int n_sos, const double f_Hz, const double fs_Hz);
+
+	protected:
+		static void bilinear(const double *B, const double *A, const double K, double *sos);
+		static bool matchedLowpass(const double w_pole, const double fs_Hz, double *sos);
+};
+
+#endif
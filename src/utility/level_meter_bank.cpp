@@ -0,0 +1,118 @@
+/*
+ * level_meter_bank
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Frequency and time weighting for many channels at once.  See level_meter_bank.h.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stddef.h>
+#include <math.h>
+#include "level_meter_bank.h"
+
+bool LevelMeterBank::setup(const float fs_Hz, const int _n_chan) {
+	if ((_n_chan < 1) || (_n_chan > LEVEL_METER_BANK_MAX_CHAN)) { n_chan = 0; return false; }
+	if (fs_Hz > 0.0f) sample_rate_Hz = fs_Hz;
+	n_chan = _n_chan;
+	computeTimeWeighting();
+	clearStates();
+	reset();
+	return true;
+}
+
+bool LevelMeterBank::setFreqWeighting(const float *sos, const int _n_sos) {
+	n_sos = 0;
+	if ((sos == NULL) || (_n_sos <= 0)) { clearStates(); return true; }   //Z
+	if (_n_sos > LEVEL_METER_BANK_MAX_SOS) return false;
+	for (int s = 0; s < _n_sos; s++) {
+		const float *row = sos + 6 * s;
+		const float a0 = (row[3] != 0.0f) ? row[3] : 1.0f;
+		b0[s] = row[0] / a0;  b1[s] = row[1] / a0;  b2[s] = row[2] / a0;
+		a1[s] = row[4] / a0;  a2[s] = row[5] / a0;
+	}
+	n_sos = _n_sos;
+	clearStates();
+	return true;
+}
+
+void LevelMeterBank::setTimeWeighting(const TimeWeighting type) {
+	time_weighting = type;
+	if (type == SLOW) time_const_sec = 1.0f;
+	if (type == FAST) time_const_sec = 0.125f;
+	if (type == IMPULSE) time_const_sec = LEVEL_METER_BANK_IMPULSE_RISE_SEC;
+	computeTimeWeighting();
+}
+
+void LevelMeterBank::setTimeConst_sec(const float tau_sec) {
+	if (tau_sec <= 0.0f) return;
+	time_weighting = CUSTOM;
+	time_const_sec = tau_sec;
+	computeTimeWeighting();
+}
+
+//expm1f(), not 1.0f - expf(): at SLOW, alpha is within 3e-5 of 1, where rounding it to a float would
+//change the time constant (and, on noise, the level) by up to 0.006 dB
+void LevelMeterBank::computeTimeWeighting(void) {
+	k_rise = -expm1f(-1.0f / (sample_rate_Hz * time_const_sec));
+	k_fall = -expm1f(-1.0f / (sample_rate_Hz * LEVEL_METER_BANK_IMPULSE_FALL_SEC));
+}
+
+void LevelMeterBank::reset(void) {
+	for (int c = 0; c < LEVEL_METER_BANK_MAX_CHAN; c++) max_ms[c] = 0.0f;
+}
+
+void LevelMeterBank::clearStates(void) {
+	for (int s = 0; s <= LEVEL_METER_BANK_MAX_SOS; s++) {
+		for (int c = 0; c < LEVEL_METER_BANK_MAX_CHAN; c++) { h1[s][c] = 0.0f; h2[s][c] = 0.0f; }
+	}
+	for (int c = 0; c < LEVEL_METER_BANK_MAX_CHAN; c++) { avg[c] = 0.0f; ms[c] = 0.0f; }
+}
+
+void LevelMeterBank::process(const float * const *x, float * const *y, const int n) {
+	if ((n_chan == 0) || (x == NULL)) return;
+	if (time_weighting == IMPULSE) run<true>(x, y, n);
+	else run<false>(x, y, n);
+}
+
+//Sample by sample, then section by section, and innermost across the channels, where every
+//channel uses the same coefficients and the states are side by side.
+template <bool IMPULSE_HOLD>
+void LevelMeterBank::run(const float * const *x, float * const *y, const int n) {
+	const int nc = n_chan, ns = n_sos;
+	float v[LEVEL_METER_BANK_MAX_CHAN];
+	for (int i = 0; i < n; i++) {
+		for (int c = 0; c < nc; c++) v[c] = x[c] ? x[c][i] : 0.0f;
+
+		//frequency weighting (Direct Form I).  Section s's output history is section s+1's input history.
+		for (int s = 0; s < ns; s++) {
+			const float c0 = b0[s], c1 = b1[s], c2 = b2[s], d1 = a1[s], d2 = a2[s];
+			float *in1 = h1[s], *in2 = h2[s];
+			const float *out1 = h1[s + 1], *out2 = h2[s + 1];
+			for (int c = 0; c < nc; c++) {
+				const float in = v[c];
+				v[c] = c0 * in + c1 * in1[c] + c2 * in2[c] - d1 * out1[c] - d2 * out2[c];
+				in2[c] = in1[c];  in1[c] = in;
+			}
+		}
+		if (ns > 0) {
+			float *out1 = h1[ns], *out2 = h2[ns];
+			for (int c = 0; c < nc; c++) { out2[c] = out1[c];  out1[c] = v[c]; }
+		}
+
+		//time weighting, and the maxima
+		for (int c = 0; c < nc; c++) {
+			const float sq = v[c] * v[c];
+			float m = avg[c] + k_rise * (sq - avg[c]);
+			avg[c] = m;
+			if (IMPULSE_HOLD) {   //follow the average up, but fall only slowly
+				const float held = ms[c] - k_fall * ms[c];
+				if (held > m) m = held;
+			}
+			ms[c] = m;
+			if (m > max_ms[c]) max_ms[c] = m;
+		}
+		if (y) { for (int c = 0; c < nc; c++) if (y[c]) y[c][i] = ms[c]; }
+	}
+}
@@ -0,0 +1,71 @@
+/*
+ * level_meter_bank
+ *
+ * Created: OpenAudio, Oct 2026
+ * Purpose: A/C/Z frequency weighting and FAST/SLOW/IMPULSE time weighting for many channels
+ *     at once, sharing one set of coefficients.  See AudioCalcLevelN_F32 for the audio node.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _level_meter_bank_h
+#define _level_meter_bank_h
+
+#ifndef LEVEL_METER_BANK_MAX_CHAN
+#define LEVEL_METER_BANK_MAX_CHAN 16
+#endif
+#define LEVEL_METER_BANK_MAX_SOS 3          //enough for A-weighting
+#define LEVEL_METER_BANK_IMPULSE_RISE_SEC 0.035f
+#define LEVEL_METER_BANK_IMPULSE_FALL_SEC 1.5f
+
+class LevelMeterBank {
+	public:
+		enum TimeWeighting { FAST = 0, SLOW, IMPULSE, CUSTOM };
+
+		LevelMeterBank(void) { reset(); clearStates(); }
+
+		//the number of channels and the sample rate.  Clears everything.  Returns false if n_chan is too many.
+		bool setup(const float fs_Hz, const int n_chan);
+		int getNumChannels(void) { return n_chan; }
+		float getSampleRate_Hz(void) { return sample_rate_Hz; }
+
+		//the frequency weighting, as n_sos Matlab sos rows (6 values each); n_sos = 0 (or NULL) is Z.  Clears the filters.
+		bool setFreqWeighting(const float *matlab_sos, const int n_sos);
+		int getNumSections(void) { return n_sos; }
+		void setTimeWeighting(const TimeWeighting type);    //FAST (0.125 s), SLOW (1 s), or IMPULSE
+		void setTimeConst_sec(const float tau_sec);         //any other exponential (CUSTOM)
+		TimeWeighting getTimeWeighting(void) { return time_weighting; }
+		float getTimeConst_sec(void) { return time_const_sec; }
+
+		//n samples of each channel.  x[c] may be NULL (silence).  If y is not NULL, y[c] (unless NULL) gets
+		//the time-weighted mean square of channel c, sample by sample.
+		void process(const float * const *x, float * const *y, const int n);
+		void reset(void);          //start the maxima over
+		void clearStates(void);    //silence the filters and the time weighting
+
+		float getMeanSquare(const int c) { return validChan(c) ? ms[c] : 0.0f; }         //time weighted, right now
+		float getMaxMeanSquare(const int c) { return validChan(c) ? max_ms[c] : 0.0f; }  //since reset()
+
+	protected:
+		float sample_rate_Hz = 44100.0f;
+		int n_chan = 0, n_sos = 0;
+		TimeWeighting time_weighting = FAST;
+		float time_const_sec = 0.125f;
+		float k_rise = 0.0f, k_fall = 0.0f;    //1-alpha of the time weighting, and of IMPULSE's hold
+
+		//the coefficients (shared), with a1 and a2 as in the denominator (1 + a1*z^-1 + a2*z^-2)
+		float b0[LEVEL_METER_BANK_MAX_SOS], b1[LEVEL_METER_BANK_MAX_SOS], b2[LEVEL_METER_BANK_MAX_SOS];
+		float a1[LEVEL_METER_BANK_MAX_SOS], a2[LEVEL_METER_BANK_MAX_SOS];
+
+		//the states, one per channel, side by side: the last two inputs of each section (h1[s], h2[s]),
+		//which are also the last two outputs of the section before, and the last two outputs (h1[n_sos], h2[n_sos])
+		float h1[LEVEL_METER_BANK_MAX_SOS + 1][LEVEL_METER_BANK_MAX_CHAN], h2[LEVEL_METER_BANK_MAX_SOS + 1][LEVEL_METER_BANK_MAX_CHAN];
+		float avg[LEVEL_METER_BANK_MAX_CHAN];       //the exponential average of the square
+		float ms[LEVEL_METER_BANK_MAX_CHAN], max_ms[LEVEL_METER_BANK_MAX_CHAN];  //the time-weighted level (avg[], or IMPULSE's hold of it)
+
+		bool validChan(const int c) { return (c >= 0) && (c < n_chan); }
+		void computeTimeWeighting(void);
+		template <bool IMPULSE_HOLD> void run(const float * const *x, float * const *y, const int n);
+};
+
+#endif
@@ -0,0 +1,199 @@
+/*
+ * level_stats
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Leq, Lmax, Lpeak, and L10/L50/L90, for a run and for intervals.  See level_stats.h.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include "level_stats.h"
+
+LevelStats::LevelStats(void) {
+	designTruePeak();
+	for (int i = 0; i < 64; i++) tp_hist[i] = 0.0f;
+	setSampleRate_Hz(sample_rate_Hz);
+}
+
+void LevelStats::setSampleRate_Hz(const float fs_Hz) {
+	if (fs_Hz > 0.0f) sample_rate_Hz = fs_Hz;
+	hist_period_samples = (uint32_t)(LEVEL_STATS_HIST_PERIOD_SEC * sample_rate_Hz + 0.5f);
+	if (hist_period_samples < 1) hist_period_samples = 1;
+	setTimeConst_sec(time_const_sec);
+	setInterval_sec(interval_sec);
+	reset();
+}
+
+void LevelStats::setTimeConst_sec(const float tau_sec) {
+	if (tau_sec > 0.0f) time_const_sec = tau_sec;
+	alpha = expf(-1.0f / (sample_rate_Hz * time_const_sec));
+}
+
+void LevelStats::setInterval_sec(const float sec) {
+	interval_sec = (sec > 0.0f) ? sec : 0.0f;
+	interval_samples = (uint32_t)(interval_sec * sample_rate_Hz + 0.5f);
+	to_interval_end = interval_samples;
+	acc[1].clear();
+}
+
+void LevelStats::reset(void) {
+	acc[0].clear();
+	acc[1].clear();
+	to_interval_end = interval_samples;
+	to_hist_tick = hist_period_samples;
+	n_intervals = 0;
+	last_interval = LevelStatsResult();
+	run_L_n_hist = 0xFFFFFFFF;
+}
+
+//Hamming-windowed sinc at the input's Nyquist frequency, split into its 4 phases.  Each phase is scaled
+//to a DC gain of 1.
+void LevelStats::designTruePeak(void) {
+	const int L = LEVEL_STATS_TP_FACTOR, N = L * LEVEL_STATS_TP_TAPS_PER_PHASE;
+	const float center = 0.5f * (N - 1);
+	float h[N];
+	for (int j = 0; j < N; j++) {
+		const float t = (j - center) / L;        //in input samples
+		const float win = 0.54f - 0.46f * cosf(2.0f * (float)M_PI * j / (N - 1));
+		h[j] = win * sinf((float)M_PI * t) / ((float)M_PI * t);   //t is never 0 (N is even)
+	}
+	tp_bound = 0.0f;
+	for (int p = 0; p < L; p++) {
+		float sum = 0.0f, sum_abs = 0.0f;
+		for (int k = 0; k < LEVEL_STATS_TP_TAPS_PER_PHASE; k++) sum += h[p + L * k];
+		for (int k = 0; k < LEVEL_STATS_TP_TAPS_PER_PHASE; k++) {
+			tp_coeff[p][k] = h[p + L * k] / sum;
+			sum_abs += fabsf(tp_coeff[p][k]);
+		}
+		if (sum_abs > tp_bound) tp_bound = sum_abs;
+	}
+}
+
+//The largest |x| at and between the samples, where it might beat "beat".  The peaks of |x| between
+//the samples are next to the samples that are local peaks of |x|, so only those samples (and only the
+//ones big enough that the interpolator could carry them past "beat") get the 8 interpolated points
+//on either side of them.  The interpolator delays by 5.875 samples, so that is done 6 samples late.
+float LevelStats::truePeak(const float *x, const int n, const float beat) {
+	const int T = LEVEL_STATS_TP_TAPS_PER_PHASE, L = LEVEL_STATS_TP_FACTOR;
+	float peak = 0.0f;
+	int pos = tp_pos;
+	for (int i = 0; i < n; i++) {
+		pos = (pos + 1) & 31;
+		tp_hist[pos] = x[i];  tp_hist[pos + 32] = x[i];
+		const float *newest = tp_hist + pos + 32;
+
+		//is the sample 6 back a local peak, and big enough?
+		const float a = fabsf(newest[-6]);
+		if ((a * tp_bound <= fmaxf(beat, peak)) || (a < fabsf(newest[-7])) || (a < fabsf(newest[-5]))) continue;
+		peak = fmaxf(peak, a);
+		for (int d = 0; d < 2; d++) {         //the points before it, and then after it
+			const float *last = newest - 1 + d;
+			for (int p = 0; p < L; p++) {
+				float y = 0.0f;
+				for (int k = 0; k < T; k++) y += tp_coeff[p][k] * last[-k];
+				peak = fmaxf(peak, fabsf(y));
+			}
+		}
+	}
+	tp_pos = pos;
+	return peak;
+}
+
+void LevelStats::process(const float *x, const float *x_peak, const int n_total) {
+	if (x_peak == NULL) x_peak = x;
+	int n = n_total;
+	while (n > 0) {
+		//stop at the next histogram sample or the end of the interval, whichever comes first
+		uint32_t m = (uint32_t)n;
+		if (to_hist_tick < m) m = to_hist_tick;
+		if ((interval_samples > 0) && (to_interval_end < m)) m = to_interval_end;
+
+		//the levels
+		float e = ms, e_max = 0.0f, sum = 0.0f;
+		const float a = alpha, one_minus_a = 1.0f - alpha;
+		for (uint32_t i = 0; i < m; i++) {
+			const float sq = x[i] * x[i];
+			sum += sq;
+			e = a * e + one_minus_a * sq;
+			if (e > e_max) e_max = e;
+		}
+		ms = e;
+
+		//the peak.  The interval's is never bigger than the run's, so it is the one to beat.
+		const float peak = truePeak(x_peak, m, acc[1].max_abs);
+		for (int j = 0; j < 2; j++) {
+			acc[j].sum_sq += sum;
+			acc[j].n_samples += m;
+			if (e_max > acc[j].max_ms) acc[j].max_ms = e_max;
+			if (peak > acc[j].max_abs) acc[j].max_abs = peak;
+		}
+
+		x += m;  x_peak += m;  n -= m;
+		to_hist_tick -= m;
+		if (to_hist_tick == 0) { addToHistograms(); to_hist_tick = hist_period_samples; }
+		if (interval_samples > 0) {
+			to_interval_end -= m;
+			if (to_interval_end == 0) {
+				finish(acc[1], &last_interval);
+				last_interval.index = ++n_intervals;
+				acc[1].clear();
+				to_interval_end = interval_samples;
+			}
+		}
+	}
+}
+
+void LevelStats::addToHistograms(void) {
+	int bin = (int)floorf((to_dB(ms) - LEVEL_STATS_HIST_LO_DB) / LEVEL_STATS_HIST_STEP_DB);
+	if (bin < 0) bin = 0;
+	if (bin >= LEVEL_STATS_HIST_BINS) bin = LEVEL_STATS_HIST_BINS - 1;
+	acc[0].hist[bin]++;  acc[0].n_hist++;
+	acc[1].hist[bin]++;  acc[1].n_hist++;
+}
+
+float LevelStats::exceeded_dB(const uint32_t *hist, const float fraction) {
+	uint32_t total = 0;
+	for (int b = 0; b < LEVEL_STATS_HIST_BINS; b++) total += hist[b];
+	return exceeded_dB(hist, total, fraction);
+}
+
+float LevelStats::exceeded_dB(const uint32_t *hist, const uint32_t total, const float fraction) {
+	if (total == 0) return LEVEL_STATS_NO_LEVEL;
+
+	//from the top, find the level with "fraction" of the samples above it (spread evenly within each bin)
+	const float target = fraction * total;
+	float above = 0.0f;
+	for (int b = LEVEL_STATS_HIST_BINS - 1; b >= 0; b--) {
+		if ((hist[b] > 0) && (above + hist[b] >= target)) {
+			const float top_dB = LEVEL_STATS_HIST_LO_DB + (b + 1) * LEVEL_STATS_HIST_STEP_DB;
+			return top_dB - LEVEL_STATS_HIST_STEP_DB * (target - above) / hist[b];
+		}
+		above += hist[b];
+	}
+	return LEVEL_STATS_HIST_LO_DB;
+}
+
+void LevelStats::finish(const Accum &a, LevelStatsResult *r, const bool percentiles) {
+	r->leq_dB = (a.n_samples > 0.0) ? to_dB((float)(a.sum_sq / a.n_samples)) : LEVEL_STATS_NO_LEVEL;
+	r->lmax_dB = to_dB(a.max_ms);
+	r->lpeak_dB = to_dB(a.max_abs * a.max_abs);
+	if (percentiles) {
+		r->L10_dB = exceeded_dB(a.hist, a.n_hist, 0.10f);
+		r->L50_dB = exceeded_dB(a.hist, a.n_hist, 0.50f);
+		r->L90_dB = exceeded_dB(a.hist, a.n_hist, 0.90f);
+	}
+	r->duration_sec = (float)(a.n_samples / sample_rate_Hz);
+}
+
+void LevelStats::getRun(LevelStatsResult *r) {
+	if (acc[0].n_hist != run_L_n_hist) {
+		run_L_dB[0] = exceeded_dB(acc[0].hist, acc[0].n_hist, 0.10f);
+		run_L_dB[1] = exceeded_dB(acc[0].hist, acc[0].n_hist, 0.50f);
+		run_L_dB[2] = exceeded_dB(acc[0].hist, acc[0].n_hist, 0.90f);
+		run_L_n_hist = acc[0].n_hist;
+	}
+	finish(acc[0], r, false);
+	r->L10_dB = run_L_dB[0];  r->L50_dB = run_L_dB[1];  r->L90_dB = run_L_dB[2];
+	r->index = 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * level_stats
+ *
+ * Created: OpenAudio, Oct 2026
+ * Purpose: Integrating sound level meter statistics: Leq, Lmax, true-peak Lpeak, and L10/L50/L90, for the
+ *     whole run and for each interval.  See AudioCalcLevelStats_F32 for the audio node.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _level_stats_h
+#define _level_stats_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+
+#define LEVEL_STATS_HIST_BINS 256
+#define LEVEL_STATS_HIST_LO_DB (-120.0f)
+#define LEVEL_STATS_HIST_STEP_DB 0.5f
+#define LEVEL_STATS_HIST_PERIOD_SEC 0.01f
+#define LEVEL_STATS_TP_FACTOR 4          //true-peak oversampling
+#define LEVEL_STATS_TP_TAPS_PER_PHASE 12
+#define LEVEL_STATS_NO_LEVEL (-200.0f)   //the dB given for silence (or no data)
+
+//the results for a run or an interval, all in dB re: full scale
+struct LevelStatsResult {
+	float leq_dB = LEVEL_STATS_NO_LEVEL;
+	float lmax_dB = LEVEL_STATS_NO_LEVEL;
+	float lpeak_dB = LEVEL_STATS_NO_LEVEL;
+	float L10_dB = LEVEL_STATS_NO_LEVEL, L50_dB = LEVEL_STATS_NO_LEVEL, L90_dB = LEVEL_STATS_NO_LEVEL;
+	float duration_sec = 0.0f;
+	uint32_t index = 0;       //which interval (counting from 1), or 0 for the run
+};
+
+class LevelStats {
+	public:
+		LevelStats(void);
+
+		void setSampleRate_Hz(const float fs_Hz);
+		float getSampleRate_Hz(void) { return sample_rate_Hz; }
+		void setTimeConst_sec(const float tau_sec);   //0.125 is FAST, 1.0 is SLOW
+		float getTimeConst_sec(void) { return time_const_sec; }
+		void setInterval_sec(const float sec);        //0 for no intervals.  Starts a new interval.
+		float getInterval_sec(void) { return interval_sec; }
+
+		//n samples.  x_peak is what the peak is taken from (NULL to use x).
+		void process(const float *x, const float *x_peak, const int n);
+		void reset(void);    //start everything over (the time weighting keeps running)
+
+		//the run so far, and the last interval that finished (false if none has yet)
+		void getRun(LevelStatsResult *r);
+		bool getLastInterval(LevelStatsResult *r) { *r = last_interval; return last_interval.index > 0; }
+		uint32_t getNumIntervals(void) { return n_intervals; }
+		float getCurrentLevel_dB(void) { return to_dB(ms); }   //time weighted
+
+		//from a histogram (LEVEL_STATS_HIST_BINS counters): the level exceeded the given fraction of the time
+		static float exceeded_dB(const uint32_t *hist, const float fraction);
+		static float exceeded_dB(const uint32_t *hist, const uint32_t total, const float fraction);
+		static float to_dB(const float ms) { return (ms > 0.0f) ? 10.0f * log10f(ms) : LEVEL_STATS_NO_LEVEL; }
+
+	protected:
+		float sample_rate_Hz = 44100.0f;
+		float time_const_sec = 0.125f, alpha = 0.0f;
+		float interval_sec = 0.0f;
+		uint32_t interval_samples = 0, hist_period_samples = 441;
+
+		//the time weighting, and the true-peak interpolator's history (stored twice, so that it reads straight through)
+		float ms = 0.0f;
+		float tp_hist[2 * 32];
+		int tp_pos = 0;
+		float tp_coeff[LEVEL_STATS_TP_FACTOR][LEVEL_STATS_TP_TAPS_PER_PHASE];
+		float tp_bound = 1.0f;         //the most that the interpolator's output can be, re: its largest input
+
+		//what is being added up, for the run [0] and the interval [1]
+		struct Accum {
+			double sum_sq = 0.0;
+			double n_samples = 0.0;
+			float max_ms = 0.0f, max_abs = 0.0f;
+			uint32_t hist[LEVEL_STATS_HIST_BINS];
+			uint32_t n_hist = 0;    //the sum of hist[]
+			void clear(void) { sum_sq = 0.0; n_samples = 0.0; max_ms = 0.0f; max_abs = 0.0f; n_hist = 0; for (int i = 0; i < LEVEL_STATS_HIST_BINS; i++) hist[i] = 0; }
+		};
+		Accum acc[2];
+		uint32_t to_interval_end = 0, to_hist_tick = 0;
+		uint32_t n_intervals = 0;
+		LevelStatsResult last_interval;
+		uint32_t run_L_n_hist = 0xFFFFFFFF;   //getRun() only finds the percentiles again when the histogram has changed
+		float run_L_dB[3];
+
+		void designTruePeak(void);
+		float truePeak(const float *x, const int n, const float beat);
+		void finish(const Accum &a, LevelStatsResult *r, const bool percentiles = true);
+		void addToHistograms(void);
+};
+
+#endif
@@ -0,0 +1,132 @@
+
+
+
+/*
+ * noise_f32
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Float white and pink noise.  See noise_f32.h
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <math.h>
+#include <string.h>
+#include "noise_f32.h"
+
+// ///////////////////////////////////////// white
+
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_ROUNDS 10
+
+void NoiseGenerator::philox4x32(const uint64_t counter, uint32_t k0, uint32_t k1, uint32_t *out4) {
+	uint32_t c0 = (uint32_t)counter, c1 = (uint32_t)(counter >> 32), c2 = 0, c3 = 0;
+	for (int r = 0; r < PHILOX_ROUNDS; r++) {
+		const uint64_t p0 = ((uint64_t)PHILOX_M0) * c0;   //one UMULL each on the Cortex-M4
+		const uint64_t p1 = ((uint64_t)PHILOX_M1) * c2;
+		c0 = ((uint32_t)(p1 >> 32)) ^ c1 ^ k0;
+		c1 = (uint32_t)p1;
+		c2 = ((uint32_t)(p0 >> 32)) ^ c3 ^ k1;
+		c3 = (uint32_t)p0;
+		k0 += PHILOX_W0;  k1 += PHILOX_W1;
+	}
+	out4[0] = c0; out4[1] = c1; out4[2] = c2; out4[3] = c3;
+}
+
+#define NOISE_U32_TO_SIGNED (4.656612873077393e-10f)   //2^-31: a signed 32-bit word to [-1, 1)
+#define NOISE_U24_TO_UNIT (5.960464477539063e-08f)     //2^-24: the top 24 bits to [0, 1)
+#define NOISE_GAUSS_SCALE (0.5773502691896258f)        //1/sqrt(3): the RMS of the uniform noise
+
+void NoiseGenerator::generate(float *out, const int n, const float amp) {
+	uint32_t words[4];
+	int k = 0;
+	while (k < n) {
+		//each counter gives four samples, so a start partway into a group uses the rest of that group
+		const uint64_t counter = position >> 2;
+		int lane = (int)(position & 0x03);
+		philox4x32(counter, seed, 0, words);
+
+		if (distribution == GAUSSIAN) {
+			//Box-Muller: each pair of words gives a pair of samples
+			float g[4];
+			for (int pair = 0; pair < 4; pair += 2) {
+				const float u1 = ((words[pair] >> 8) + 1) * NOISE_U24_TO_UNIT;   //(0, 1], so the log is finite
+				const float u2 = (words[pair+1] >> 8) * NOISE_U24_TO_UNIT;
+				const float r = sqrtf(-2.0f * logf(u1)) * amp * NOISE_GAUSS_SCALE;
+				const float theta = 2.0f * ((float)M_PI) * u2;
+				g[pair] = r * cosf(theta);
+				g[pair+1] = r * sinf(theta);
+			}
+			for ( ; (lane < 4) && (k < n); lane++, k++) out[k] = g[lane];
+		} else {
+			for ( ; (lane < 4) && (k < n); lane++, k++) out[k] = ((int32_t)words[lane]) * NOISE_U32_TO_SIGNED * amp;
+		}
+		position = (counter << 2) + lane;
+	}
+}
+
+// ///////////////////////////////////////// pink
+
+void PinkFilter::setup(const float fs_Hz, const float f_low_Hz) {
+	//One pole per octave, starting at f_low_Hz.  Each pole is followed by a zero half an octave higher:
+	//between them the slope is -6 dB/oct, and after the zero it's flat, so on average it's -3 dB/oct.
+	//The sections are made by the bilinear transform.  The poles are prewarped so that they land on their
+	//octaves.  Near Nyquist, the bilinear transform squeezes the octaves together, so each zero is placed
+	//half an octave above its pole *before* the transform.  That keeps each section at 3 dB per octave.
+	const float ratio = 2.0f;
+	n_sections = 0;
+	float fp = f_low_Hz;
+	while ((n_sections < PINK_F32_MAX_SECTIONS) && (fp < 0.5f * fs_Hz)) {
+		const float wp = tanf(((float)M_PI) * fp / fs_Hz), wz = wp * sqrtf(ratio);
+		pole[n_sections] = (1.0f - wp) / (1.0f + wp);
+		zero[n_sections] = (1.0f - wz) / (1.0f + wz);
+		n_sections++;
+		fp *= ratio;
+	}
+
+	//set the gain so that the output has the same RMS as the input (for white noise).  That's 1/sqrt of the
+	//energy of the impulse response, found from the poles and zeros rather than by running an impulse
+	//through (which takes a long time at high sample rates).  By partial fractions, the cascade is
+	//1 + sum_s A_s / (z - p_s), so h[0] = 1 and h[n > 0] = sum_s A_s p_s^(n-1), and the energy is
+	//1 + sum_s sum_t A_s A_t / (1 - p_s p_t).  (The poles are all different.)
+	double A[PINK_F32_MAX_SECTIONS];
+	for (int s = 0; s < n_sections; s++) {
+		double num = 1.0, den = 1.0;
+		for (int t = 0; t < n_sections; t++) {
+			num *= (double)pole[s] - zero[t];
+			if (t != s) den *= (double)pole[s] - pole[t];
+		}
+		A[s] = num / den;
+	}
+	double sum_sq = 1.0;
+	for (int s = 0; s < n_sections; s++) {
+		for (int t = 0; t < n_sections; t++) sum_sq += A[s] * A[t] / (1.0 - (double)pole[s] * pole[t]);
+	}
+	gain = (sum_sq > 0.0) ? (float)(1.0 / sqrt(sum_sq)) : 1.0f;
+	reset();
+}
+
+void PinkFilter::reset(void) {
+	memset(x_prev, 0, sizeof(x_prev));
+	memset(y_prev, 0, sizeof(y_prev));
+}
+
+void PinkFilter::process(float *x, const int n) {
+	//the gain goes first, and then each section in turn over the whole block
+	for (int i = 0; i < n; i++) x[i] *= gain;
+	for (int s = 0; s < n_sections; s++) {
+		const float p = pole[s], z = zero[s];
+		float xp = x_prev[s], yp = y_prev[s];
+		for (int i = 0; i < n; i++) {
+			const float xi = x[i];
+			yp = xi - z * xp + p * yp;
+			xp = xi;
+			x[i] = yp;
+		}
+		x_prev[s] = xp;  y_prev[s] = yp;
+	}
+}
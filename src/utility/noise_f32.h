@@ -0,0 +1,64 @@
+/*
+ * noise_f32
+ *
+ * Created: OpenAudio, Oct 2026
+ * Purpose: White noise from a counter-based generator (Philox4x32-10), so a seed gives the same noise
+ *     on any machine, and a -3 dB/octave pink filter.  See AudioSynthNoiseWhite_F32 and AudioSynthNoisePink_F32.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _noise_f32_h
+#define _noise_f32_h
+
+#include <stdint.h>
+
+#define PINK_F32_MAX_SECTIONS 20
+#define PINK_F32_DEFAULT_LOW_HZ 10.0f
+
+class NoiseGenerator {
+	public:
+		enum Distribution { UNIFORM = 0, GAUSSIAN = 1 };
+
+		NoiseGenerator(void) { setSeed(1); }
+
+		void setSeed(const uint32_t _seed) { seed = _seed; position = 0; }   //also goes back to the first sample
+		uint32_t getSeed(void) { return seed; }
+		void setPosition(const uint64_t sample) { position = sample; }       //jump to any sample of the noise
+		uint64_t getPosition(void) { return position; }
+		void setDistribution(const Distribution d) { distribution = d; }
+		Distribution getDistribution(void) { return distribution; }
+
+		//Make the next n samples.  UNIFORM is flat between -amp and +amp.  GAUSSIAN has the same RMS
+		//(amp/sqrt(3)), but its peaks go beyond amp.
+		void generate(float *out, const int n, const float amp);
+
+		//the raw generator: four random 32-bit words for a given 64-bit counter and 64-bit key
+		static void philox4x32(const uint64_t counter, const uint32_t key0, const uint32_t key1, uint32_t *out4);
+
+	protected:
+		uint32_t seed;
+		uint64_t position;   //the next sample
+		Distribution distribution = UNIFORM;
+};
+
+class PinkFilter {
+	public:
+		PinkFilter(void) { setup(44100.0f); }
+
+		//design the filter.  Its gain is set so that white noise of a given RMS comes out as pink noise
+		//of the same RMS.
+		void setup(const float fs_Hz, const float f_low_Hz = PINK_F32_DEFAULT_LOW_HZ);
+		void reset(void);      //clear the filter's memory
+		void process(float *x, const int n);   //in place
+
+		int getNumSections(void) { return n_sections; }
+
+	protected:
+		int n_sections;
+		float pole[PINK_F32_MAX_SECTIONS], zero[PINK_F32_MAX_SECTIONS];
+		float x_prev[PINK_F32_MAX_SECTIONS], y_prev[PINK_F32_MAX_SECTIONS];
+		float gain;
+};
+
+#endif
@@ -0,0 +1,215 @@
+/*
+ * octave_bank
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Octave and third-octave band levels, multirate.  See octave_bank.h.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <math.h>
+#include "octave_bank.h"
+
+#define OCTAVE_BANK_G 1.99526231497f      //10^(3/10), the base-ten octave ratio
+#define OCTAVE_BANK_EDGE_FRAC 0.2f         //a band's upper edge must be below this fraction of its stage's rate
+#define OCTAVE_BANK_TOP_FRAC 0.48f         //no band's upper edge may be above this fraction of the full rate
+
+float OctaveFilterBank::nominalFreq_Hz(const int x, const int b) {
+	static const float mantissa[10] = { 10.0f, 12.5f, 16.0f, 20.0f, 25.0f, 31.5f, 40.0f, 50.0f, 63.0f, 80.0f };
+	const int x3 = (b == 1) ? 3 * x : x;        //octave bands are every third 1/3-octave band
+	const int decade = (x3 >= 0) ? (x3 / 10) : -((9 - x3) / 10);
+	return mantissa[x3 - 10 * decade] * powf(10.0f, 2.0f + decade);
+}
+
+float OctaveFilterBank::getLowerEdge_Hz(const int i) {
+	return validBand(i) ? band[i].fm_Hz * powf(OCTAVE_BANK_G, -0.5f / bands_per_octave) : 0.0f;
+}
+float OctaveFilterBank::getUpperEdge_Hz(const int i) {
+	return validBand(i) ? band[i].fm_Hz * powf(OCTAVE_BANK_G, 0.5f / bands_per_octave) : 0.0f;
+}
+
+bool OctaveFilterBank::setup(const float fs_Hz, const int b, const float lo_Hz, const float hi_Hz) {
+	n_bands = 0;  n_stages = 0;
+	if ((fs_Hz <= 0.0f) || ((b != 1) && (b != 3)) || (lo_Hz <= 0.0f) || (hi_Hz < lo_Hz)) return false;
+	sample_rate_Hz = fs_Hz;
+	bands_per_octave = b;
+	designHalfband();
+
+	//the bands, from low to high.  Each goes to the slowest stage that has room for it.
+	const float edge = powf(OCTAVE_BANK_G, 0.5f / b);
+	const int x_lo = (int)floorf(b * log10f(lo_Hz / 1000.0f) / 0.3f + 0.5f);
+	const int x_hi = (int)floorf(b * log10f(hi_Hz / 1000.0f) / 0.3f + 0.5f);
+	for (int x = x_lo; (x <= x_hi) && (n_bands < OCTAVE_BANK_MAX_BANDS); x++) {
+		const float fm_Hz = 1000.0f * powf(10.0f, 0.3f * x / b);
+		if (fm_Hz * edge > OCTAVE_BANK_TOP_FRAC * fs_Hz) break;
+		int s = 0;
+		while ((s < OCTAVE_BANK_MAX_STAGES - 1) && (fm_Hz * edge < OCTAVE_BANK_EDGE_FRAC * fs_Hz / (2 << s))) s++;
+		Band &bnd = band[n_bands++];
+		bnd = Band();
+		bnd.x = x;
+		bnd.fm_Hz = fm_Hz;
+		bnd.stage = s;
+		designBand(bnd, fs_Hz / (1 << s));
+	}
+	if (n_bands == 0) return false;
+
+	//the stages, down to the slowest one that has a band.  Bands at slower stages are lower, so each
+	//stage's bands are side by side in band[].
+	n_stages = band[0].stage + 1;
+	for (int s = 0; s < n_stages; s++) {
+		stage[s] = Stage();
+		stage[s].first_band = n_bands;
+		for (int i = n_bands - 1; i >= 0; i--) {
+			if (band[i].stage == s) { stage[s].first_band = i; stage[s].n_bands++; }
+		}
+		for (int k = 0; k < 64; k++) stage[s].hist[k] = 0.0f;
+	}
+	setTimeConst_sec(time_const_sec);
+	reset();
+	return true;
+}
+
+void OctaveFilterBank::setTimeConst_sec(const float tau_sec) {
+	if (tau_sec > 0.0f) time_const_sec = tau_sec;
+	for (int s = 0; s < n_stages; s++) stage[s].alpha = expf(-1.0f / (sample_rate_Hz / (1 << s) * time_const_sec));
+}
+
+void OctaveFilterBank::reset(void) {
+	for (int i = 0; i < n_bands; i++) { band[i].energy = 0.0; band[i].max_ms = band[i].ms; }
+	for (int s = 0; s < OCTAVE_BANK_MAX_STAGES; s++) stage_count[s] = 0.0;
+}
+
+//Blackman-windowed sinc at a quarter of the rate.  Every other tap (except the center) is zero.
+void OctaveFilterBank::designHalfband(void) {
+	const int N = OCTAVE_BANK_HB_TAPS, c = (N - 1) / 2;
+	float sum = 0.5f;
+	for (int j = 0; j < (N + 1) / 4; j++) {
+		const int k = 2 * j;                   //outermost first
+		const float t = (float)(k - c);
+		const float win = 0.42f - 0.5f * cosf(2.0f * (float)M_PI * k / (N - 1)) + 0.08f * cosf(4.0f * (float)M_PI * k / (N - 1));
+		hb[j] = win * sinf(0.5f * (float)M_PI * t) / ((float)M_PI * t);
+		sum += 2.0f * hb[j];
+	}
+	hb_center = 0.5f / sum;
+	for (int j = 0; j < (N + 1) / 4; j++) hb[j] /= sum;
+}
+
+//3rd-order Butterworth band-pass: each pole p of the low-pass prototype becomes the two roots of
+//s^2 - p*B*s + W0^2 = 0, which then go through the bilinear transform.  Every biquad gets a pair of
+//conjugate poles and zeros at DC and Nyquist, and a gain of 1 at the mid-band frequency.
+void OctaveFilterBank::designBand(Band &bnd, const float fs_Hz) {
+	const double K = 2.0 * fs_Hz;
+	const double edge = pow((double)OCTAVE_BANK_G, 0.5 / bands_per_octave);
+	const double W1 = K * tan(M_PI * bnd.fm_Hz / edge / fs_Hz), W2 = K * tan(M_PI * bnd.fm_Hz * edge / fs_Hz);
+	const double W0sq = W1 * W2, B = W2 - W1;
+	const double w0 = 2.0 * atan(sqrt(W0sq) / K);   //the digital mid-band frequency (rad/sample)
+
+	int n_sos = 0;
+	for (int k = 0; k < OCTAVE_BANK_ORDER; k++) {
+		const double ang = M_PI * (2 * k + OCTAVE_BANK_ORDER + 1) / (2.0 * OCTAVE_BANK_ORDER);
+		const double pr = cos(ang), pi = sin(ang);
+		if (pi < -1.0e-9) continue;                  //its conjugate's biquads cover it
+
+		//the roots are h +/- sqrt(h^2 - W0^2), with h = p*B/2
+		const double hr = 0.5 * B * pr, hi = 0.5 * B * pi;
+		const double dr = hr * hr - hi * hi - W0sq, di = 2.0 * hr * hi;
+		const double mag = sqrt(sqrt(dr * dr + di * di));
+		const double arg = 0.5 * atan2(di, dr);
+		const double sr = mag * cos(arg), si = mag * sin(arg);
+		const double root_re[2] = { hr + sr, hr - sr }, root_im[2] = { hi + si, hi - si };
+		double zr[2], zi[2];
+		for (int r = 0; r < 2; r++) {   //z = (K + s) / (K - s)
+			const double nr = K + root_re[r], ni = root_im[r];
+			const double er = K - root_re[r], ei = -root_im[r];
+			const double den = er * er + ei * ei;
+			zr[r] = (nr * er + ni * ei) / den;  zi[r] = (ni * er - nr * ei) / den;
+		}
+
+		//A real prototype pole gives one biquad from both of its roots (a conjugate pair, or two real
+		//poles if the band is wide and near Nyquist).  A complex one gives a biquad for each root, with
+		//that root's conjugate.
+		const bool real_pole = (fabs(pi) < 1.0e-9);
+		for (int r = 0; (r < (real_pole ? 1 : 2)) && (n_sos < OCTAVE_BANK_ORDER); r++) {
+			double a1, a2;
+			if (real_pole) { a1 = -(zr[0] + zr[1]);  a2 = zr[0] * zr[1] - zi[0] * zi[1]; }
+			else { a1 = -2.0 * zr[r];  a2 = zr[r] * zr[r] + zi[r] * zi[r]; }
+
+			//gain of 1 at w0: |1 - e^-2jw| / |1 + a1 e^-jw + a2 e^-2jw|
+			const double num = 2.0 * fabs(sin(w0));
+			const double Dr = 1.0 + a1 * cos(w0) + a2 * cos(2.0 * w0), Di = -a1 * sin(w0) - a2 * sin(2.0 * w0);
+			bnd.b0[n_sos] = (float)(sqrt(Dr * Dr + Di * Di) / num);
+			bnd.a1[n_sos] = (float)a1;
+			bnd.a2[n_sos] = (float)a2;
+			bnd.z1[n_sos] = 0.0f;  bnd.z2[n_sos] = 0.0f;
+			n_sos++;
+		}
+	}
+}
+
+void OctaveFilterBank::process(const float *x, const int n) {
+	if (n_bands == 0) return;
+	for (int pos = 0; pos < n; pos += OCTAVE_BANK_CHUNK) {
+		int m = ((n - pos) < OCTAVE_BANK_CHUNK) ? (n - pos) : OCTAVE_BANK_CHUNK;
+		const float *in = x + pos;
+		for (int s = 0; (s < n_stages) && (m > 0); s++) {
+			filterBands(stage[s], in, m);
+			stage_count[s] += m;
+			if (s < n_stages - 1) {
+				float *out = work[s & 1];        //never the one being read
+				m = decimate(stage[s], in, m, out);
+				in = out;
+			}
+		}
+	}
+}
+
+void OctaveFilterBank::filterBands(Stage &stg, const float *x, const int n) {
+	const float alpha = stg.alpha, one_minus_alpha = 1.0f - alpha;
+	for (int i = stg.first_band; i < stg.first_band + stg.n_bands; i++) {
+		Band &bnd = band[i];
+		float ms = bnd.ms, max_ms = bnd.max_ms, energy = 0.0f;
+		float b0[OCTAVE_BANK_ORDER], a1[OCTAVE_BANK_ORDER], a2[OCTAVE_BANK_ORDER], z1[OCTAVE_BANK_ORDER], z2[OCTAVE_BANK_ORDER];
+		for (int j = 0; j < OCTAVE_BANK_ORDER; j++) {   //local copies, so that they can stay in registers
+			b0[j] = bnd.b0[j];  a1[j] = bnd.a1[j];  a2[j] = bnd.a2[j];  z1[j] = bnd.z1[j];  z2[j] = bnd.z2[j];
+		}
+		for (int k = 0; k < n; k++) {
+			float v = x[k];
+			for (int j = 0; j < OCTAVE_BANK_ORDER; j++) {   //transposed direct form II
+				const float y = b0[j] * v + z1[j];
+				z1[j] = z2[j] - a1[j] * y;
+				z2[j] = -b0[j] * v - a2[j] * y;
+				v = y;
+			}
+			const float sq = v * v;
+			energy += sq;
+			ms = alpha * ms + one_minus_alpha * sq;
+			if (ms > max_ms) max_ms = ms;
+		}
+		for (int j = 0; j < OCTAVE_BANK_ORDER; j++) { bnd.z1[j] = z1[j];  bnd.z2[j] = z2[j]; }
+		bnd.ms = ms;
+		bnd.max_ms = max_ms;
+		bnd.energy += energy;
+	}
+}
+
+//half-band low-pass and keep every other sample.  Returns the number of samples made.
+int OctaveFilterBank::decimate(Stage &stg, const float *x, const int n, float *y) {
+	const int n_hb = (OCTAVE_BANK_HB_TAPS + 1) / 4, c = (OCTAVE_BANK_HB_TAPS - 1) / 2;
+	int pos = stg.hist_pos, phase = stg.phase, n_out = 0;
+	float *h = stg.hist;
+	for (int k = 0; k < n; k++) {
+		pos = (pos + 1) & 31;
+		h[pos] = x[k];  h[pos + 32] = x[k];
+		phase ^= 1;
+		if (phase) {
+			const float *newest = h + pos + 32;
+			float acc = hb_center * newest[-c];
+			for (int j = 0; j < n_hb; j++) acc += hb[j] * (newest[-2 * j] + newest[-(OCTAVE_BANK_HB_TAPS - 1) + 2 * j]);
+			y[n_out++] = acc;
+		}
+	}
+	stg.hist_pos = pos;
+	stg.phase = phase;
+	return n_out;
+}
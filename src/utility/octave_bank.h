@@ -0,0 +1,91 @@
+/*
+ * octave_bank
+ *
+ * Created: OpenAudio, Oct 2026
+ * Purpose: Multirate octave and third-octave band levels (IEC 61260 class 1 filters), with Leq, the
+ *     time-weighted level, and Lmax for each band.  See AudioCalcOctaveBands_F32 for the audio node.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _octave_bank_h
+#define _octave_bank_h
+
+#include <stdint.h>
+
+#ifndef OCTAVE_BANK_MAX_BANDS
+#define OCTAVE_BANK_MAX_BANDS 36     //enough for 1/3-octave bands from 12.5 Hz to 40 kHz
+#endif
+#define OCTAVE_BANK_MAX_STAGES 12    //the slowest stage runs at fs/2048
+#define OCTAVE_BANK_ORDER 3          //of the Butterworth prototype (biquads per band)
+#define OCTAVE_BANK_HB_TAPS 23       //of the half-band decimation filters
+#define OCTAVE_BANK_CHUNK 64         //samples processed at a time
+
+class OctaveFilterBank {
+	public:
+		OctaveFilterBank(void) {}
+
+		//Design the bands (1 or 3 per octave) whose nominal frequencies are from lo_Hz to hi_Hz, leaving
+		//out any band whose upper edge is too close to the Nyquist frequency.  Clears everything.  Returns
+		//false if there are no bands.
+		bool setup(const float fs_Hz, const int bands_per_octave, const float lo_Hz, const float hi_Hz);
+		void setTimeConst_sec(const float tau_sec);   //of the time weighting (0.125 is FAST, 1.0 is SLOW)
+		float getTimeConst_sec(void) { return time_const_sec; }
+
+		void process(const float *x, const int n);
+		void reset(void);        //start the Leq and Lmax over (the filters keep running)
+
+		int getNumBands(void) { return n_bands; }
+		int getBandsPerOctave(void) { return bands_per_octave; }
+		int getNumStages(void) { return n_stages; }
+		float getSampleRate_Hz(void) { return sample_rate_Hz; }
+		float getCenter_Hz(const int i) { return validBand(i) ? band[i].fm_Hz : 0.0f; }     //exact
+		float getNominal_Hz(const int i) { return validBand(i) ? nominalFreq_Hz(band[i].x, bands_per_octave) : 0.0f; }  //as labeled
+		float getLowerEdge_Hz(const int i);
+		float getUpperEdge_Hz(const int i);
+		int getStage(const int i) { return validBand(i) ? band[i].stage : -1; }
+
+		//linear mean squares, re: full scale
+		float getMeanSquare(const int i) { return (validBand(i) && (stage_count[band[i].stage] > 0)) ? (float)(band[i].energy / stage_count[band[i].stage]) : 0.0f; }  //Leq
+		float getMaxMeanSquare(const int i) { return validBand(i) ? band[i].max_ms : 0.0f; }   //Lmax
+		float getCurrentMeanSquare(const int i) { return validBand(i) ? band[i].ms : 0.0f; }  //time weighted
+		float getDuration_sec(void) { return (sample_rate_Hz > 0.0f) ? (float)(stage_count[0] / sample_rate_Hz) : 0.0f; }  //since reset()
+
+		//the nominal mid-band frequency of band x (x = 0 is 1000 Hz) with b bands per octave
+		static float nominalFreq_Hz(const int x, const int b);
+
+	protected:
+		struct Band {
+			int x = 0;                 //index from 1000 Hz
+			int stage = 0;
+			float fm_Hz = 0.0f;
+			float b0[OCTAVE_BANK_ORDER], a1[OCTAVE_BANK_ORDER], a2[OCTAVE_BANK_ORDER];  //each biquad is b0*(1 - z^-2) / (1 + a1*z^-1 + a2*z^-2)
+			float z1[OCTAVE_BANK_ORDER], z2[OCTAVE_BANK_ORDER];
+			float ms = 0.0f, max_ms = 0.0f;
+			double energy = 0.0;
+		};
+		struct Stage {
+			int first_band = 0, n_bands = 0;     //the bands filtered at this stage
+			float alpha = 0.0f;                  //time weighting, at this stage's rate
+			float hist[2 * 32];                  //the half-band filter's input, stored twice so that it reads straight through
+			int hist_pos = 0, phase = 0;
+		};
+
+		float sample_rate_Hz = 0.0f;
+		int bands_per_octave = 3;
+		float time_const_sec = 0.125f;
+		int n_bands = 0, n_stages = 0;
+		Band band[OCTAVE_BANK_MAX_BANDS];
+		Stage stage[OCTAVE_BANK_MAX_STAGES];
+		double stage_count[OCTAVE_BANK_MAX_STAGES];   //samples at each stage since reset()
+		float hb_center = 0.5f, hb[(OCTAVE_BANK_HB_TAPS + 1) / 4];   //the half-band's non-zero taps (one side, outermost first)
+		float work[2][OCTAVE_BANK_CHUNK];
+
+		bool validBand(const int i) { return (i >= 0) && (i < n_bands); }
+		void designHalfband(void);
+		void designBand(Band &bnd, const float fs_Hz);
+		void filterBands(Stage &stg, const float *x, const int n);
+		int decimate(Stage &stg, const float *x, const int n, float *y);
+};
+
+#endif
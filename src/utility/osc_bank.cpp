@@ -0,0 +1,203 @@
+/*
+ * osc_bank
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Table-free float oscillators.  See osc_bank.h
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <string.h>
+#include "osc_bank.h"
+
+#if defined(__SSE2__) && !defined(__ARM_ARCH_7EM__)
+	//host PC builds
+	#include <emmintrin.h>
+	#define OSC_BANK_USE_SSE2
+#endif
+
+// ///////////////////////////////////////// setup
+
+void OscillatorBank::clear(void) {
+	n_tones = 0;
+	for (int i = 0; i < OSC_BANK_MAX_TONES; i++) {
+		re[i] = 1.0f; im[i] = 0.0f;
+		wr[i] = 1.0f; wi[i] = 0.0f;
+		amp[i] = amp_target[i] = 0.0f;  //unused lanes of a group stay silent
+		freq_Hz[i] = 0.0f;
+		cycles[i] = 0.0;
+		sweep_remaining[i] = 0;
+	}
+}
+
+void OscillatorBank::setSampleRate_Hz(const float fs_Hz) {
+	if (fs_Hz <= 0.0f) return;
+	sample_rate_Hz = fs_Hz;
+	for (int i = 0; i < n_tones; i++) setRotation(i);
+}
+
+int OscillatorBank::addTone(const float _freq_Hz, const float amplitude, const float phase_deg) {
+	if (n_tones >= OSC_BANK_MAX_TONES) return -1;
+	int i = n_tones++;
+	setFrequency_Hz(i, _freq_Hz);
+	setPhase_deg(i, phase_deg);
+	amp[i] = amp_target[i] = amplitude;  //a new tone starts right away at its amplitude
+	return i;
+}
+
+void OscillatorBank::setRotation(const int i) {
+	const double w = 2.0 * M_PI * freq_Hz[i] / sample_rate_Hz;
+	wr[i] = (float)cos(w);  wi[i] = (float)sin(w);
+}
+
+void OscillatorBank::setFrequency_Hz(const int i, const float _freq_Hz) {
+	if (!valid(i)) return;
+	sweep_remaining[i] = 0;
+	freq_Hz[i] = _freq_Hz;
+	setRotation(i);
+}
+
+void OscillatorBank::setAmplitude(const int i, const float amplitude) {
+	if (!valid(i)) return;
+	amp_target[i] = amplitude;
+}
+
+void OscillatorBank::setPhase_deg(const int i, const float deg) {
+	if (!valid(i)) return;
+	cycles[i] = deg / 360.0;
+	cycles[i] -= floor(cycles[i]);
+	const float p = (float)(2.0 * M_PI * cycles[i]);
+	re[i] = cosf(p);  im[i] = sinf(p);
+}
+
+void OscillatorBank::sweep(const int i, const float freq_end_Hz, const float dur_sec, const SweepType type) {
+	if (!valid(i)) return;
+	const int n = (int)(dur_sec * sample_rate_Hz + 0.5f);
+	if ((n <= 0) || ((type == LOG) && ((freq_Hz[i] <= 0.0f) || (freq_end_Hz <= 0.0f)))) {
+		setFrequency_Hz(i, freq_end_Hz);  //can't glide, so jump
+		return;
+	}
+	sweep_type[i] = type;
+	sweep_end_Hz[i] = freq_end_Hz;
+	sweep_step[i] = (type == LOG) ? (logf(freq_end_Hz / freq_Hz[i]) / n) : ((freq_end_Hz - freq_Hz[i]) / n);
+	sweep_remaining[i] = n;
+}
+
+bool OscillatorBank::isAnySweeping(void) {
+	for (int i = 0; i < n_tones; i++) if (sweep_remaining[i] > 0) return true;
+	return false;
+}
+
+// ///////////////////////////////////////// synthesis
+
+void OscillatorBank::synthesize(float *out, const int n) {
+	memset(out, 0, n * sizeof(float));
+	if (n <= 0) return;
+
+	for (int g = 0; g < n_tones; g += OSC_BANK_LANES) {
+		float da[OSC_BANK_LANES], dr[OSC_BANK_LANES], di[OSC_BANK_LANES];
+		bool chirp = false;
+
+		//plan this block for each tone in the group: the amplitude ramp, and where a sweep gets to
+		for (int lane = 0; lane < OSC_BANK_LANES; lane++) {
+			const int i = g + lane;
+			da[lane] = (amp_target[i] - amp[i]) / n;
+			dr[lane] = 1.0f; di[lane] = 0.0f;
+			if (i >= n_tones) continue;
+			const float f_start = freq_Hz[i];
+			if (sweep_remaining[i] > 0) {
+				const int m = (sweep_remaining[i] < n) ? sweep_remaining[i] : n;
+				float f_next = (sweep_type[i] == LOG) ? (freq_Hz[i] * expf(sweep_step[i] * m)) : (freq_Hz[i] + sweep_step[i] * m);
+				sweep_remaining[i] -= m;
+				if (sweep_remaining[i] <= 0) f_next = sweep_end_Hz[i];
+
+				//the rotation itself rotates a little each sample, so the frequency moves smoothly to f_next
+				const double dw = 2.0 * M_PI * (f_next - freq_Hz[i]) / (sample_rate_Hz * n);
+				dr[lane] = (float)cos(dw);  di[lane] = (float)sin(dw);
+				freq_Hz[i] = f_next;
+				chirp = true;
+			}
+
+			//where the phase will be at the end of the block (the frequency moves linearly across the block)
+			cycles[i] += (((double)f_start) * n + 0.5 * ((double)freq_Hz[i] - f_start) * (n - 1)) / sample_rate_Hz;
+			cycles[i] -= floor(cycles[i]);
+		}
+
+		synthesizeGroup(out, n, g, da, dr, di, chirp);
+
+		//renormalize: exact amplitudes, exact phasors, and exact rotations for any tone that swept
+		for (int lane = 0; lane < OSC_BANK_LANES; lane++) {
+			const int i = g + lane;
+			amp[i] = amp_target[i];
+			if (i >= n_tones) continue;
+			const float p = (float)(2.0 * M_PI * cycles[i]);
+			re[i] = cosf(p);  im[i] = sinf(p);
+			if (chirp) setRotation(i);
+		}
+	}
+}
+
+#if defined(OSC_BANK_USE_SSE2)
+
+void OscillatorBank::synthesizeGroup(float *out, const int n, const int g, const float *da_p, const float *dr_p, const float *di_p, const bool chirp) {
+	__m128 r = _mm_loadu_ps(&re[g]), i = _mm_loadu_ps(&im[g]);
+	__m128 w_r = _mm_loadu_ps(&wr[g]), w_i = _mm_loadu_ps(&wi[g]);
+	__m128 a = _mm_loadu_ps(&amp[g]), da = _mm_loadu_ps(da_p);
+	const __m128 d_r = _mm_loadu_ps(dr_p), d_i = _mm_loadu_ps(di_p);
+	for (int k = 0; k < n; k++) {
+		//add up the four tones
+		__m128 y = _mm_mul_ps(a, i);
+		y = _mm_add_ps(y, _mm_shuffle_ps(y, y, _MM_SHUFFLE(1,0,3,2)));
+		y = _mm_add_ss(y, _mm_shuffle_ps(y, y, _MM_SHUFFLE(2,3,0,1)));
+		out[k] += _mm_cvtss_f32(y);
+
+		//rotate
+		const __m128 r_new = _mm_sub_ps(_mm_mul_ps(r, w_r), _mm_mul_ps(i, w_i));
+		i = _mm_add_ps(_mm_mul_ps(r, w_i), _mm_mul_ps(i, w_r));
+		r = r_new;
+		a = _mm_add_ps(a, da);
+		if (chirp) {
+			const __m128 wr_new = _mm_sub_ps(_mm_mul_ps(w_r, d_r), _mm_mul_ps(w_i, d_i));
+			w_i = _mm_add_ps(_mm_mul_ps(w_r, d_i), _mm_mul_ps(w_i, d_r));
+			w_r = wr_new;
+		}
+	}
+	_mm_storeu_ps(&re[g], r);  _mm_storeu_ps(&im[g], i);
+	_mm_storeu_ps(&wr[g], w_r);  _mm_storeu_ps(&wi[g], w_i);
+}
+
+#else
+
+void OscillatorBank::synthesizeGroup(float *out, const int n, const int g, const float *da, const float *dr, const float *di, const bool chirp) {
+	float r[OSC_BANK_LANES], i[OSC_BANK_LANES], w_r[OSC_BANK_LANES], w_i[OSC_BANK_LANES], a[OSC_BANK_LANES];
+	for (int lane = 0; lane < OSC_BANK_LANES; lane++) {
+		r[lane] = re[g+lane];  i[lane] = im[g+lane];
+		w_r[lane] = wr[g+lane];  w_i[lane] = wi[g+lane];
+		a[lane] = amp[g+lane];
+	}
+	for (int k = 0; k < n; k++) {
+		float y = 0.0f;
+		for (int lane = 0; lane < OSC_BANK_LANES; lane++) {
+			y += a[lane] * i[lane];
+			const float r_new = r[lane]*w_r[lane] - i[lane]*w_i[lane];
+			i[lane] = r[lane]*w_i[lane] + i[lane]*w_r[lane];
+			r[lane] = r_new;
+			a[lane] += da[lane];
+		}
+		if (chirp) {
+			for (int lane = 0; lane < OSC_BANK_LANES; lane++) {
+				const float wr_new = w_r[lane]*dr[lane] - w_i[lane]*di[lane];
+				w_i[lane] = w_r[lane]*di[lane] + w_i[lane]*dr[lane];
+				w_r[lane] = wr_new;
+			}
+		}
+		out[k] += y;
+	}
+	for (int lane = 0; lane < OSC_BANK_LANES; lane++) {
+		re[g+lane] = r[lane];  im[g+lane] = i[lane];
+		wr[g+lane] = w_r[lane];  wi[g+lane] = w_i[lane];
+	}
+}
+
+#endif
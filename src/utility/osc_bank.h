@@ -0,0 +1,124 @@
+/*
+ * osc_bank
+ *
+ * Created: OpenAudio, Oct 2026
+ * Purpose: Table-free float oscillators (a rotating complex phasor, renormalized every block), one at
+ *     a time or as a bank of up to OSC_BANK_MAX_TONES.  See AudioSynthOscillatorBank_F32 for the audio node.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _osc_bank_h
+#define _osc_bank_h
+
+#include <math.h>
+
+#ifndef OSC_BANK_MAX_TONES
+#define OSC_BANK_MAX_TONES 32   //must be a multiple of 4
+#endif
+#define OSC_BANK_LANES 4        //tones computed together
+
+// ///////////////////////////////////////////////////////// one sine
+
+class OscillatorPhasor {
+	public:
+		OscillatorPhasor(void) {};
+
+		//the rotation per sample
+		void setFrequency(const float freq_Hz, const float fs_Hz) {
+			cycles_per_sample = ((double)freq_Hz) / fs_Hz;
+			const double w = 2.0 * M_PI * cycles_per_sample;
+			wr = (float)cos(w);  wi = (float)sin(w);
+		}
+		//the phase of the next sample (the output is sin(phase))
+		void setPhase_deg(const float deg) {
+			cycles = deg / 360.0;
+			renormalize();
+		}
+		float getPhase_deg(void) { return (float)(cycles * 360.0); }
+
+		//make n samples of amp*sin()
+		void synthesize(float *out, const int n, const float amp) {
+			float r = re, i = im;
+			for (int k = 0; k < n; k++) {
+				out[k] = amp * i;
+				const float r_new = r*wr - i*wi;
+				i = r*wi + i*wr;
+				r = r_new;
+			}
+			advance(n);
+		}
+		//skip ahead n samples (this is also how synthesize() renormalizes)
+		void advance(const int n) {
+			cycles += n * cycles_per_sample;
+			renormalize();
+		}
+
+	protected:
+		float re = 1.0f, im = 0.0f;   //the phasor
+		float wr = 1.0f, wi = 0.0f;   //the rotation per sample
+		double cycles = 0.0, cycles_per_sample = 0.0;   //the exact phase
+
+		void renormalize(void) {
+			cycles -= floor(cycles);
+			const float p = (float)(2.0 * M_PI * cycles);
+			re = cosf(p);  im = sinf(p);
+		}
+};
+
+// ///////////////////////////////////////////////////////// many sines
+
+class OscillatorBank {
+	public:
+		enum SweepType { LINEAR = 0, LOG = 1 };
+
+		OscillatorBank(void) { clear(); }
+
+		void setSampleRate_Hz(const float fs_Hz);   //the tones keep their frequencies in Hz
+		float getSampleRate_Hz(void) { return sample_rate_Hz; }
+
+		void clear(void);   //remove all the tones
+		//Add a tone (amplitude is linear, 1.0 is full scale).  Returns its index, or -1 if the bank is full.
+		int addTone(const float freq_Hz, const float amplitude, const float phase_deg = 0.0f);
+		int getNumTones(void) { return n_tones; }
+
+		//Change one tone.  A new frequency or phase takes effect at the next block.  A new amplitude is
+		//reached by a smooth ramp across the next block.
+		void setFrequency_Hz(const int i, const float freq_Hz);   //also stops any sweep
+		void setAmplitude(const int i, const float amplitude);
+		void setAmplitude_dB(const int i, const float amp_dB) { setAmplitude(i, powf(10.0f, 0.05f * amp_dB)); }
+		void setPhase_deg(const int i, const float deg);
+		float getFrequency_Hz(const int i) { return valid(i) ? freq_Hz[i] : 0.0f; }
+		float getAmplitude(const int i) { return valid(i) ? amp_target[i] : 0.0f; }
+
+		//Glide tone i from its present frequency to freq_end_Hz over dur_sec, without any jump in phase
+		void sweep(const int i, const float freq_end_Hz, const float dur_sec, const SweepType type = LOG);
+		bool isSweeping(const int i) { return valid(i) && (sweep_remaining[i] > 0); }
+		bool isAnySweeping(void);
+
+		//Make n samples of the sum of all of the tones.  out is overwritten.
+		void synthesize(float *out, const int n);
+
+	protected:
+		int n_tones;
+		float sample_rate_Hz = 44100.0f;
+
+		//per-tone state, side by side in groups of OSC_BANK_LANES
+		float re[OSC_BANK_MAX_TONES], im[OSC_BANK_MAX_TONES];   //phasors
+		float wr[OSC_BANK_MAX_TONES], wi[OSC_BANK_MAX_TONES];   //rotation per sample
+		float amp[OSC_BANK_MAX_TONES], amp_target[OSC_BANK_MAX_TONES];
+		float freq_Hz[OSC_BANK_MAX_TONES];
+		double cycles[OSC_BANK_MAX_TONES];     //the exact phase (in cycles) at the start of the next block
+
+		//sweeps
+		int sweep_remaining[OSC_BANK_MAX_TONES];     //samples left in the sweep
+		float sweep_step[OSC_BANK_MAX_TONES];        //per sample: Hz (LINEAR) or log of the ratio (LOG)
+		float sweep_end_Hz[OSC_BANK_MAX_TONES];
+		SweepType sweep_type[OSC_BANK_MAX_TONES];
+
+		bool valid(const int i) { return (i >= 0) && (i < n_tones); }
+		void setRotation(const int i);
+		void synthesizeGroup(float *out, const int n, const int g, const float *da, const float *dr, const float *di, const bool chirp);
+};
+
+#endif
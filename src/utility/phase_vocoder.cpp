@@ -0,0 +1,227 @@
+/*
+ * phase_vocoder
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: A phase vocoder for pitch shifting, frequency lowering, and formant shifting.  See phase_vocoder.h.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stddef.h>
+#include <math.h>
+#include "phase_vocoder.h"
+#include "BTNRH_rfft.h"
+
+#define PHASE_VOCODER_TWO_PI 6.28318530717958647692f
+#define PHASE_VOCODER_LOG_FLOOR 1.0e-9f      //so the log of an empty bin isn't -infinity
+
+//to -pi to pi
+static inline float wrapPhase(const float x) {
+	return x - PHASE_VOCODER_TWO_PI * floorf(x * (1.0f / PHASE_VOCODER_TWO_PI) + 0.5f);
+}
+
+bool PhaseVocoder::setup(const float fs_Hz, const int N_FFT, const int overlap) {
+	N = 0;  hop = 0;  n_bins = 0;
+	if (fs_Hz <= 0.0f) return false;
+	if ((N_FFT < PHASE_VOCODER_MIN_FFT) || (N_FFT > PHASE_VOCODER_MAX_FFT) || (N_FFT & (N_FFT - 1))) return false;
+	if ((overlap != 4) && (overlap != 8)) return false;
+	sample_rate_Hz = fs_Hz;
+	N = N_FFT;  hop = N_FFT / overlap;  n_bins = N_FFT / 2 + 1;
+
+	//Hann (periodic), before the FFT and after the IFFT.  Overlapped every N/overlap, the squared
+	//windows add up to 3*overlap/8.
+	for (int i = 0; i < N; i++) window[i] = 0.5f - 0.5f * cosf(PHASE_VOCODER_TWO_PI * i / N);
+	ola_gain = 8.0f / (3.0f * overlap);
+	setLifter();
+	updateIdentity();
+	reset();
+	return true;
+}
+
+void PhaseVocoder::reset(void) {
+	for (int i = 0; i < PHASE_VOCODER_MAX_FFT; i++) { in_buf[i] = 0.0f; out_buf[i] = 0.0f; }
+	for (int k = 0; k < PHASE_VOCODER_MAX_BINS; k++) { last_phase[k] = 0.0f; s_phase[k] = 0.0f; s_mag[k] = 0.0f; env[k] = 1.0f; }
+	fill = 0;
+}
+
+void PhaseVocoder::setPitchRatio(const float ratio) {
+	if (ratio > 0.0f) pitch_ratio = ratio;
+	updateIdentity();
+}
+
+void PhaseVocoder::setFreqLowering(const float start_Hz, const float ratio) {
+	if (start_Hz > 0.0f) lowering_start_Hz = start_Hz;
+	if (ratio >= 1.0f) lowering_ratio = ratio;
+	updateIdentity();
+}
+
+void PhaseVocoder::updateIdentity(void) {
+	map_is_identity = (pitch_ratio == 1.0f) && ((lowering_ratio == 1.0f) || (lowering_start_Hz >= 0.5f * sample_rate_Hz));
+}
+
+void PhaseVocoder::setLifter(void) {
+	int L = (int)(0.001f * envelope_msec * sample_rate_Hz + 0.5f);
+	if (L > N / 4) L = N / 4;
+	lifter = (L < 1) ? 1 : L;
+}
+
+// ///////////////////////////////////////// streaming
+
+void PhaseVocoder::process(const float *x, float *y, const int n) {
+	if (N == 0) { for (int i = 0; i < n; i++) y[i] = 0.0f; return; }
+	const int in_start = N - hop;
+	for (int i = 0; i < n; i++) {
+		const float xi = x[i];          //read before writing, in case x and y are the same
+		y[i] = out_buf[fill];
+		in_buf[in_start + fill] = xi;
+		if (++fill == hop) {
+			fill = 0;
+			frame();
+		}
+	}
+}
+
+//one frame: analysis, processFrame(), synthesis, and overlap-add.  Afterward, out_buf starts with the
+//next hop of output, and in_buf is moved along to make room for the next hop of input.
+void PhaseVocoder::frame(void) {
+	//analysis
+	for (int i = 0; i < N; i++) spec[i] = in_buf[i] * window[i];
+	BTNRH_FFT::cha_fft_rc(spec, N);
+	const float bin_advance = PHASE_VOCODER_TWO_PI * hop / N;   //a bin-centered sinusoid's phase change per hop, per bin
+	const float to_bins = 1.0f / bin_advance;
+	for (int k = 0; k < n_bins; k++) {
+		const float re = spec[2 * k], im = spec[2 * k + 1];
+		a_mag[k] = sqrtf(re * re + im * im);
+		a_phase[k] = atan2f(im, re);
+		a_freq[k] = k + wrapPhase(a_phase[k] - last_phase[k] - bin_advance * k) * to_bins;
+		last_phase[k] = a_phase[k];
+	}
+	if (needsEnvelope()) estimateEnvelope();
+
+	processFrame();
+
+	//synthesis
+	for (int k = 0; k < n_bins; k++) {
+		spec[2 * k] = s_mag[k] * cosf(s_phase[k]);
+		spec[2 * k + 1] = s_mag[k] * sinf(s_phase[k]);
+	}
+	spec[1] = 0.0f;  spec[2 * (n_bins - 1) + 1] = 0.0f;  //DC and Nyquist are real
+	BTNRH_FFT::cha_fft_cr(spec, N);
+
+	//overlap-add
+	const int keep = N - hop;
+	for (int i = 0; i < keep; i++) out_buf[i] = out_buf[i + hop] + spec[i] * window[i] * ola_gain;
+	for (int i = keep; i < N; i++) out_buf[i] = spec[i] * window[i] * ola_gain;
+	for (int i = 0; i < keep; i++) in_buf[i] = in_buf[i + hop];
+}
+
+// ///////////////////////////////////////// spectral envelope
+
+//cepstral smoothing: the log magnitude, to the cepstrum, keep only the low quefrencies, and back again.
+//The log magnitude is first drawn straight from peak to peak, so that the valleys between harmonics don't
+//pull the envelope down and blur the formants (which would leave part of each where it was).
+void PhaseVocoder::estimateEnvelope(void) {
+	for (int k = 0; k < n_bins; k++) { spec[2 * k] = logf(a_mag[k] + PHASE_VOCODER_LOG_FLOOR); spec[2 * k + 1] = 0.0f; }
+	int last = -1;
+	for (int k = 0; k < n_bins; k++) {
+		const bool peak = ((k == 0) || (a_mag[k] > a_mag[k - 1])) && ((k == n_bins - 1) || (a_mag[k] >= a_mag[k + 1]));
+		if (!peak) continue;
+		if (last < 0) {
+			for (int i = 0; i < k; i++) spec[2 * i] = spec[2 * k];
+		} else {
+			const float step = (spec[2 * k] - spec[2 * last]) / (k - last);
+			for (int i = last + 1; i < k; i++) spec[2 * i] = spec[2 * last] + step * (i - last);
+		}
+		last = k;
+	}
+	for (int i = last + 1; i < n_bins; i++) spec[2 * i] = spec[2 * last];   //(there is always a peak)
+	BTNRH_FFT::cha_fft_cr(spec, N);     //the real cepstrum (symmetric)
+	for (int i = lifter + 1; i < N - lifter; i++) spec[i] = 0.0f;
+	BTNRH_FFT::cha_fft_rc(spec, N);
+	for (int k = 0; k < n_bins; k++) env[k] = expf(spec[2 * k]);
+}
+
+//the envelope at a fractional bin (zero above Nyquist)
+float PhaseVocoder::envelopeAt(const float bin) {
+	if (bin <= 0.0f) return env[0];
+	const int k = (int)bin;
+	if (k >= n_bins - 1) return (k == n_bins - 1) ? env[k] : 0.0f;
+	const float frac = bin - k;
+	return env[k] + frac * (env[k + 1] - env[k]);
+}
+
+// ///////////////////////////////////////// the new spectrum
+
+float PhaseVocoder::mapFreq_bins(const float f_bins) {
+	float f = f_bins;
+	const float start_bins = lowering_start_Hz * N / sample_rate_Hz;
+	if ((lowering_ratio != 1.0f) && (f > start_bins)) f = start_bins * powf(f / start_bins, 1.0f / lowering_ratio);
+	return f * pitch_ratio;
+}
+
+void PhaseVocoder::processFrame(void) {
+	if (map_is_identity) scaleFormants(); else shiftPeaks();
+}
+
+void PhaseVocoder::scaleFormants(void) {
+	if (!needsEnvelope()) {
+		for (int k = 0; k < n_bins; k++) s_mag[k] = a_mag[k];
+	} else {
+		const float inv_ratio = 1.0f / formant_ratio;
+		for (int k = 0; k < n_bins; k++) s_mag[k] = a_mag[k] * envelopeAt(k * inv_ratio) / env[k];
+	}
+	for (int k = 0; k < n_bins; k++) s_phase[k] = a_phase[k];
+}
+
+void PhaseVocoder::shiftPeaks(void) {
+	//the peaks: bins louder than the two bins on each side
+	int n_peaks = 0;
+	for (int k = 1; k < n_bins - 1; k++) {
+		const float m = a_mag[k];
+		if ((m > a_mag[k - 1]) && (m >= a_mag[k + 1]) && ((k < 2) || (m > a_mag[k - 2])) && ((k > n_bins - 3) || (m >= a_mag[k + 2]))) {
+			peak_bin[n_peaks++] = k;
+			k++;   //the next bin can't be a peak
+		}
+	}
+	for (int k = 0; k < n_bins; k++) s_mag[k] = 0.0f;
+	if (n_peaks == 0) return;
+
+	//each peak's region ends at the quietest bin before the next peak
+	for (int p = 0; p < n_peaks - 1; p++) {
+		int low = peak_bin[p];
+		for (int k = peak_bin[p] + 1; k < peak_bin[p + 1]; k++) if (a_mag[k] < a_mag[low]) low = k;
+		region_end[p] = low;
+	}
+	region_end[n_peaks - 1] = n_bins - 1;
+
+	//each peak's new phase: the accumulator of the bin that it moves to, plus a hop at its new frequency.
+	//(All of these first, before any region writes over the accumulators.)
+	const float bin_advance = PHASE_VOCODER_TWO_PI * hop / N;
+	for (int p = 0; p < n_peaks; p++) {
+		const float f_new = mapFreq_bins(a_freq[peak_bin[p]]);
+		const int j = peak_bin[p] + (int)floorf(f_new - a_freq[peak_bin[p]] + 0.5f);
+		peak_phase[p] = ((j >= 0) && (j < n_bins)) ? wrapPhase(s_phase[j] + bin_advance * f_new) : 0.0f;
+	}
+
+	//move each region, keeping its phases relative to its peak's
+	const bool formants = needsEnvelope();
+	const float inv_ratio = formants ? 1.0f / formant_ratio : 1.0f;
+	int start = 0;
+	for (int p = 0; p < n_peaks; p++) {
+		const int kp = peak_bin[p];
+		const int shift = (int)floorf(mapFreq_bins(a_freq[kp]) - a_freq[kp] + 0.5f);
+		const float phase_offset = peak_phase[p] - a_phase[kp];
+		for (int k = start; k <= region_end[p]; k++) {
+			const int j = k + shift;
+			if ((j < 0) || (j >= n_bins)) continue;
+			float m = a_mag[k];
+			if (formants) m *= envelopeAt(j * inv_ratio) / env[k];
+			if (m > s_mag[j]) {    //where regions land on each other, the louder one wins
+				s_mag[j] = m;
+				s_phase[j] = a_phase[k] + phase_offset;
+			}
+		}
+		start = region_end[p] + 1;
+	}
+}
@@ -0,0 +1,91 @@
+/*
+ * phase_vocoder
+ *
+ * Created: OpenAudio, Oct 2026
+ * Purpose: Phase vocoder for pitch shifting, frequency lowering, and formant shifting (peak shifting
+ *     with identity phase locking, after Laroche and Dolson).  See AudioEffectPhaseVocoder_F32 for the audio node.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _phase_vocoder_h
+#define _phase_vocoder_h
+
+#ifndef PHASE_VOCODER_MAX_FFT
+#define PHASE_VOCODER_MAX_FFT 1024
+#endif
+#define PHASE_VOCODER_MIN_FFT 64
+#define PHASE_VOCODER_MAX_BINS (PHASE_VOCODER_MAX_FFT / 2 + 1)
+
+class PhaseVocoder {
+	public:
+		PhaseVocoder(void) { }
+		virtual ~PhaseVocoder(void) { }
+
+		//N_FFT: a power of 2, from PHASE_VOCODER_MIN_FFT to PHASE_VOCODER_MAX_FFT.  overlap: 4 or 8.
+		//Clears the states.  Returns false (and then passes nothing) if the settings are no good.
+		bool setup(const float fs_Hz, const int N_FFT, const int overlap = 4);
+		void reset(void);
+
+		//any number of samples at a time.  x and y can be the same.
+		void process(const float *x, float *y, const int n);
+
+		//the frequency changes.  Setting these doesn't reset anything.
+		void setPitchRatio(const float ratio);                          //every frequency is multiplied by this (1 is none)
+		void setFreqLowering(const float start_Hz, const float ratio);  //above start_Hz, compress by ratio (1 is none)
+		void setFormantRatio(const float ratio) { formant_ratio = ratio; }   //move the formants by this.  0 or less: they move with the frequencies (no envelope).
+		void setEnvelopeQuefrency_msec(const float msec) { envelope_msec = msec; setLifter(); }   //the finest detail of the envelope
+		float getPitchRatio(void) { return pitch_ratio; }
+		float getFreqLoweringStart_Hz(void) { return lowering_start_Hz; }
+		float getFreqLoweringRatio(void) { return lowering_ratio; }
+		float getFormantRatio(void) { return formant_ratio; }
+		float getEnvelopeQuefrency_msec(void) { return envelope_msec; }
+
+		int getNFFT(void) { return N; }
+		int getHop(void) { return hop; }
+		int getLatency_samples(void) { return N; }
+		float getSampleRate_Hz(void) { return sample_rate_Hz; }
+
+		//where a frequency ends up (Hz), with the present settings
+		float getMappedFreq_Hz(const float f_Hz) { return (N > 0) ? mapFreq_bins(f_Hz * N / sample_rate_Hz) * sample_rate_Hz / N : f_Hz; }
+
+	protected:
+		float sample_rate_Hz = 24000.0f;
+		int N = 0, hop = 0, n_bins = 0, fill = 0, lifter = 0;
+		float pitch_ratio = 1.0f, lowering_start_Hz = 1000.0f, lowering_ratio = 1.0f;
+		float formant_ratio = 0.0f, envelope_msec = 1.5f;
+		bool map_is_identity = true;
+		float ola_gain = 0.0f;
+
+		//the audio in, the overlap-added audio out, and the window
+		float in_buf[PHASE_VOCODER_MAX_FFT], out_buf[PHASE_VOCODER_MAX_FFT], window[PHASE_VOCODER_MAX_FFT];
+		float spec[PHASE_VOCODER_MAX_FFT + 2];    //FFT workspace: interleaved re, im for bins 0 to N/2
+
+		//this frame's analysis: magnitude, phase, true frequency (in bins), and envelope
+		float a_mag[PHASE_VOCODER_MAX_BINS], a_phase[PHASE_VOCODER_MAX_BINS], a_freq[PHASE_VOCODER_MAX_BINS];
+		float env[PHASE_VOCODER_MAX_BINS];
+		float last_phase[PHASE_VOCODER_MAX_BINS];   //the last frame's analysis phase
+
+		//the new spectrum: magnitude and phase.  s_phase carries over from frame to frame (the accumulators).
+		float s_mag[PHASE_VOCODER_MAX_BINS], s_phase[PHASE_VOCODER_MAX_BINS];
+
+		//the peaks of this frame: their bins, the last bin of their regions, and their new phases
+		int peak_bin[PHASE_VOCODER_MAX_BINS / 2], region_end[PHASE_VOCODER_MAX_BINS / 2];
+		float peak_phase[PHASE_VOCODER_MAX_BINS / 2];
+
+		void frame(void);
+		void estimateEnvelope(void);
+		float envelopeAt(const float bin);
+		void setLifter(void);
+		void updateIdentity(void);
+
+		//from a_mag, a_phase, a_freq (and env), make s_mag and s_phase.  Override mapFreq_bins() for another
+		//mapping of the frequencies, or processFrame() to work on the spectrum directly.
+		virtual void processFrame(void);
+		virtual float mapFreq_bins(const float f_bins);
+		void scaleFormants(void);   //no frequency change: new magnitudes, old phases
+		void shiftPeaks(void);      //move each peak to mapFreq_bins(), phase locked
+		bool needsEnvelope(void) { return formant_ratio > 0.0f; }
+};
+
+#endif
@@ -0,0 +1,244 @@
+/*
+ * resample_async
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Asynchronous sample-rate converter.  See resample_async.h
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <math.h>
+#include <string.h>
+#include "resample_async.h"
+
+#define RESAMPLE_ASYNC_KAISER_BETA 8.0f
+#define RESAMPLE_ASYNC_DAMPING 0.9f       //damping of the fill-control loop
+#define RESAMPLE_ASYNC_LP_FACTOR 5.0f     //fill smoothing cutoff, relative to the loop bandwidth
+#define RESAMPLE_ASYNC_ACQUIRE_FACTOR 10.0f //the loop is this much faster while it first finds the drift...
+#define RESAMPLE_ASYNC_ACQUIRE_SEC 30.0f    //...for this long after (re)starting
+#ifndef RESAMPLE_ASYNC_REF_BLOCK
+#define RESAMPLE_ASYNC_REF_BLOCK 32.0f      //blocks (in input samples) bigger than this slow the loop down in proportion
+#endif
+
+//zeroth-order modified Bessel function of the first kind, for the Kaiser window
+static float bessel_i0(float x) {
+	float sum = 1.0f, term = 1.0f, half_x = 0.5f * x;
+	for (int k = 1; k < 32; k++) {
+		term *= (half_x / k) * (half_x / k);
+		sum += term;
+		if (term < 1.0e-9f * sum) break;
+	}
+	return sum;
+}
+
+// ///////////////////////////////////////// setup
+
+bool AudioResampleAsync::configure(float _fs_in_Hz, float _fs_out_Hz, int _block_out, int _n_chan, Mode _mode) {
+	bool ok = true;
+	if ((_fs_in_Hz <= 0.0f) || (_fs_out_Hz <= 0.0f)) { _fs_in_Hz = _fs_out_Hz = 44100.0f; ok = false; }
+	//one pull takes block_out*fs_in/fs_out input samples.  Several pulls' worth must fit in the FIFO.
+	float step = _fs_in_Hz / _fs_out_Hz;
+	if ((step < 0.25f) || (step > 2.0f)) { _fs_in_Hz = _fs_out_Hz; step = 1.0f; ok = false; }
+	if ((_block_out < 1) || (_block_out * step > RESAMPLE_ASYNC_FIFO_SAMPLES / 4)) { _block_out = (int)(RESAMPLE_ASYNC_FIFO_SAMPLES / 4 / step); ok = false; }
+	if ((_n_chan < 1) || (_n_chan > RESAMPLE_ASYNC_MAX_CHAN)) { _n_chan = (_n_chan < 1) ? 1 : RESAMPLE_ASYNC_MAX_CHAN; ok = false; }
+
+	fs_in_Hz = _fs_in_Hz;
+	fs_out_Hz = _fs_out_Hz;
+	nominal_step = step;
+	block_out = _block_out;
+	n_chan = _n_chan;
+	mode = _mode;
+	n_taps = (mode == CHEAP) ? 4 : RESAMPLE_ASYNC_TAPS;
+	if (mode == QUALITY) designFilter();
+
+	max_correction = 0.005f;  //5000 ppm, far more than any real crystal drift
+	block_in = 0;
+	target_is_auto = true;
+	loop_bw_Hz = 0.005f;   //slow, so that the fill's block-sized jumps barely move the ratio
+	reset();   //also sets the controller gains
+	resetCounts();
+	return ok;
+}
+
+void AudioResampleAsync::designFilter(void) {
+	//Windowed sinc.  Phase p interpolates at a fraction p/PHASES past the middle of the window.  When
+	//converting down in rate, the cutoff moves down with the output's Nyquist frequency.
+	const float fc = 0.45f * ((nominal_step > 1.0f) ? (1.0f / nominal_step) : 1.0f);  //cycles per input sample
+	const float half_len = 0.5f * RESAMPLE_ASYNC_TAPS;
+	const float i0_beta = bessel_i0(RESAMPLE_ASYNC_KAISER_BETA);
+	for (int p = 0; p <= RESAMPLE_ASYNC_PHASES; p++) {
+		const float center = half_len - 1.0f + ((float)p) / RESAMPLE_ASYNC_PHASES;
+		float sum = 0.0f;
+		for (int k = 0; k < RESAMPLE_ASYNC_TAPS; k++) {
+			float t = ((float)k) - center;
+			float arg = 2.0f * fc * t;
+			float sinc = (fabsf(arg) < 1.0e-6f) ? 1.0f : sinf(M_PI * arg) / (M_PI * arg);
+			float r = t / half_len;
+			float win = (fabsf(r) < 1.0f) ? bessel_i0(RESAMPLE_ASYNC_KAISER_BETA * sqrtf(1.0f - r*r)) / i0_beta : 0.0f;
+			coeff[p][k] = sinc * win;
+			sum += coeff[p][k];
+		}
+		for (int k = 0; k < RESAMPLE_ASYNC_TAPS; k++) coeff[p][k] /= sum;  //unity gain at DC for every phase
+	}
+}
+
+void AudioResampleAsync::setLoopBandwidth_Hz(float bw_Hz) {
+	if (bw_Hz <= 0.0f) return;
+	loop_bw_Hz = bw_Hz;
+	updateGains();
+}
+
+void AudioResampleAsync::updateGains(void) {
+	//The fill changes at fs_in*(drift - correction) samples per second.  Closing the loop with a PI controller
+	//gives a 2nd-order system, whose natural frequency is the loop bandwidth.  The fill only moves in steps of
+	//whole input blocks, so it is smoothed (two 1-pole low-pass filters) well above the loop bandwidth.  Near
+	//matched clocks, those steps alias down to slow wobbles that no smoothing removes, so for big blocks (the
+	//bigger of a push and a pull's worth of input) the loop is slowed in proportion to the block.
+	const float dt = ((float)block_out) / fs_out_Hz;
+	float block = (float)block_in;
+	if (block < block_out * nominal_step) block = block_out * nominal_step;
+	const float slow = (block > RESAMPLE_ASYNC_REF_BLOCK) ? (block / RESAMPLE_ASYNC_REF_BLOCK) : 1.0f;
+	const float bw_Hz = (acquiring ? (RESAMPLE_ASYNC_ACQUIRE_FACTOR * loop_bw_Hz) : loop_bw_Hz) / slow;
+	const float wn = 2.0f * M_PI * bw_Hz;
+	kp = 2.0f * RESAMPLE_ASYNC_DAMPING * wn / fs_in_Hz;
+	ki = wn * wn / fs_in_Hz * dt;
+	fill_alpha = 1.0f - expf(-2.0f * M_PI * RESAMPLE_ASYNC_LP_FACTOR * bw_Hz * dt);
+	acquire_updates = (int)(slow * RESAMPLE_ASYNC_ACQUIRE_SEC / dt);
+}
+
+void AudioResampleAsync::reset(void) {
+	memset(fifo, 0, sizeof(fifo));
+	write_idx = 0;
+	read_idx = 0;
+	n_stored = 0;
+	frac = 0.0f;
+	running = false;
+	integ = 0.0f;
+	correction = 0.0f;
+	step = nominal_step;
+	fill_lp = fill_lp2 = 0.0f;
+	if (target_is_auto) target_fill = autoTargetFill();
+	startAcquiring();
+}
+
+void AudioResampleAsync::startAcquiring(void) {
+	acquiring = true;
+	updateGains();
+	update_count = 0;
+}
+
+// ///////////////////////////////////////// producer
+
+void AudioResampleAsync::push(const float *p_in[], int n) {
+	if (n <= 0) return;
+	if (n > block_in) {
+		block_in = n;
+		if (target_is_auto) target_fill = autoTargetFill();
+		updateGains();
+	}
+	if (n_stored + n > RESAMPLE_ASYNC_FIFO_SAMPLES) {
+		//the consumer has stalled (or the producer is far faster than expected).  Start over.
+		n_overrun++;
+		float saved_integ = integ;
+		reset();
+		integ = saved_integ;  //but keep the learned drift
+		if (n > RESAMPLE_ASYNC_FIFO_SAMPLES) n = RESAMPLE_ASYNC_FIFO_SAMPLES;
+	}
+	const int n_end = (write_idx + n > RESAMPLE_ASYNC_FIFO_SAMPLES) ? (RESAMPLE_ASYNC_FIFO_SAMPLES - write_idx) : n;  //before the ring wraps
+	const bool wrote_start = (write_idx < RESAMPLE_ASYNC_TAPS - 1) || (n_end < n);
+	for (int Ichan = 0; Ichan < n_chan; Ichan++) {
+		memcpy(&fifo[Ichan][write_idx], p_in[Ichan], n_end * sizeof(float));
+		if (n_end < n) memcpy(&fifo[Ichan][0], p_in[Ichan] + n_end, (n - n_end) * sizeof(float));
+		//keep the copy past the end in step with the start of the ring
+		if (wrote_start) memcpy(&fifo[Ichan][RESAMPLE_ASYNC_FIFO_SAMPLES], &fifo[Ichan][0], (RESAMPLE_ASYNC_TAPS - 1) * sizeof(float));
+	}
+	write_idx += n;
+	if (write_idx >= RESAMPLE_ASYNC_FIFO_SAMPLES) write_idx -= RESAMPLE_ASYNC_FIFO_SAMPLES;
+	n_stored += n;
+}
+
+// ///////////////////////////////////////// consumer
+
+float AudioResampleAsync::getFill(void) {
+	return ((float)(n_stored - n_taps)) - frac;
+}
+
+void AudioResampleAsync::updateController(void) {
+	fill_lp += fill_alpha * (getFill() - fill_lp);
+	fill_lp2 += fill_alpha * (fill_lp - fill_lp2);
+	if (acquiring && (++update_count >= acquire_updates)) { acquiring = false; updateGains(); }
+
+	float e = fill_lp2 - target_fill;
+	integ += ki * e;
+	if (integ > max_correction) integ = max_correction;
+	if (integ < -max_correction) integ = -max_correction;
+	float c = integ + kp * e;
+	if (c > max_correction) c = max_correction;
+	if (c < -max_correction) c = -max_correction;
+	correction = c;
+}
+
+bool AudioResampleAsync::pull(float *p_out[]) {
+	if (!running) {
+		if (getFill() < target_fill) {
+			for (int Ichan = 0; Ichan < n_chan; Ichan++) memset(p_out[Ichan], 0, block_out * sizeof(float));
+			return false;
+		}
+		running = true;
+		fill_lp = fill_lp2 = target_fill;   //the fill just reached the target (a reading now can be a whole burst over it)
+		correction = integ;
+		step = nominal_step * (1.0f + correction);
+	} else {
+		updateController();
+	}
+
+	//glide from the last pull's ratio to the new one over the block, rather than jumping at the block's start
+	const float new_step = nominal_step * (1.0f + correction);
+	const float d_step = (new_step - step) / block_out;
+	for (int i = 0; i < block_out; i++) {
+		if (n_stored < n_taps) {
+			//ran dry.  Fill in with silence and wait to refill to the target.
+			n_underrun++;
+			running = false;
+			startAcquiring();
+			for (int Ichan = 0; Ichan < n_chan; Ichan++) memset(&p_out[Ichan][i], 0, (block_out - i) * sizeof(float));
+			break;
+		}
+		for (int Ichan = 0; Ichan < n_chan; Ichan++) {
+			const float *x = &fifo[Ichan][read_idx];
+			p_out[Ichan][i] = (mode == CHEAP) ? interpCheap(x, frac) : interpQuality(x, frac);
+		}
+		step += d_step;
+		frac += step;
+		int adv = (int)frac;
+		frac -= adv;
+		read_idx += adv;
+		if (read_idx >= RESAMPLE_ASYNC_FIFO_SAMPLES) read_idx -= RESAMPLE_ASYNC_FIFO_SAMPLES;
+		n_stored -= adv;
+	}
+	step = new_step;
+	return true;
+}
+
+// ///////////////////////////////////////// interpolators
+
+float AudioResampleAsync::interpQuality(const float *x, float mu) {
+	//blend the two nearest phases of the polyphase filter
+	float p = mu * RESAMPLE_ASYNC_PHASES;
+	int ip = (int)p;
+	float a = p - ip;
+	const float *h0 = coeff[ip], *h1 = coeff[ip+1];
+	float s0 = 0.0f, s1 = 0.0f;
+	for (int k = 0; k < RESAMPLE_ASYNC_TAPS; k++) {
+		s0 += h0[k] * x[k];
+		s1 += h1[k] * x[k];
+	}
+	return s0 + a * (s1 - s0);
+}
+
+float AudioResampleAsync::interpCheap(const float *x, float mu) {
+	//Catmull-Rom cubic between x[1] and x[2]
+	const float x0 = x[0], x1 = x[1], x2 = x[2], x3 = x[3];
+	return x1 + 0.5f * mu * (x2 - x0 + mu * (2.0f*x0 - 5.0f*x1 + 4.0f*x2 - x3 + mu * (3.0f*(x1 - x2) + x3 - x0)));
+}
@@ -0,0 +1,108 @@
+/*
+ * resample_async
+ *
+ * Created: OpenAudio, Oct 2026
+ * Purpose: Asynchronous sample-rate converter for joining two clock domains (such as USB and I2S).
+ *     A PI loop on the FIFO fill trims the ratio to follow the clocks' drift.  QUALITY is a polyphase
+ *     windowed sinc; CHEAP is a 4-point cubic.  See AudioResampleAsync_F32 for the audio node.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _resample_async_h
+#define _resample_async_h
+
+#include <stdint.h>
+
+#ifndef RESAMPLE_ASYNC_MAX_CHAN
+#define RESAMPLE_ASYNC_MAX_CHAN 2
+#endif
+#ifndef RESAMPLE_ASYNC_FIFO_SAMPLES
+#define RESAMPLE_ASYNC_FIFO_SAMPLES 1024  //per channel
+#endif
+#define RESAMPLE_ASYNC_TAPS 24      //FIR taps per phase (QUALITY mode)
+#define RESAMPLE_ASYNC_PHASES 64    //FIR phases (QUALITY mode)
+
+class AudioResampleAsync {
+	public:
+		enum Mode { QUALITY = 0, CHEAP = 1 };
+
+		AudioResampleAsync(void) { configure(44100.0f, 44100.0f, 128, 1, QUALITY); }
+
+		//Set the nominal rates, the number of samples per pull, and the number of channels.
+		//Designs the filter and clears the FIFO.  Returns false if a setting is out of range
+		//(the rates are then taken as equal).
+		bool configure(float fs_in_Hz, float fs_out_Hz, int block_out, int n_chan, Mode mode);
+		void reset(void);  //clear the FIFO and the controller
+
+		//Producer side: add n samples to each channel.  p_in[chan] points to each channel's samples.
+		//If the FIFO can't take them, it is cleared and restarted (counted as an overrun).
+		void push(const float *p_in[], int n);
+
+		//Consumer side: make block_out samples for each channel.  Until the FIFO first reaches its
+		//target fill (and after any underrun), this gives silence.  Returns true if it gave audio.
+		bool pull(float *p_out[]);
+
+		//The FIFO fill that the controller aims for, in input samples.  By default, this is set from the
+		//input and output block sizes (the input block size is learned from push()).  Give 0 to go back to that.
+		void setTargetFill(float samples) { target_is_auto = (samples <= 0.0f); target_fill = target_is_auto ? autoTargetFill() : samples; }
+		float getTargetFill(void) { return target_fill; }
+		float getFill(void);   //input samples waiting in the FIFO, beyond those the interpolator needs
+
+		//Controller tuning.  The loop bandwidth (default 0.005 Hz) sets how fast drift is tracked (smaller is
+		//smoother).  For the first 30 seconds after (re)starting, the loop runs 10x faster to find the drift quickly.
+		//Blocks bigger than 32 samples make the fill jumpier, so the loop is slowed, and the 30 seconds stretched,
+		//in proportion (4x for 128-sample blocks).  The correction is limited to +/- max_ppm around the nominal ratio.
+		void setLoopBandwidth_Hz(float bw_Hz);
+		void setMaxCorrection_ppm(float ppm) { max_correction = ppm * 1.0e-6f; }
+
+		float getNominalRatio(void) { return nominal_step; }   //fs_in / fs_out
+		float getRatio(void) { return nominal_step * (1.0f + correction); }
+		float getCorrection_ppm(void) { return correction * 1.0e6f; }   //the measured clock drift
+		bool isLocked(void) { return running; }
+
+		//problems seen since the last resetCounts()
+		unsigned long getUnderrunCount(void) { return n_underrun; }
+		unsigned long getOverrunCount(void) { return n_overrun; }
+		void resetCounts(void) { n_underrun = 0; n_overrun = 0; }
+
+		Mode getMode(void) { return mode; }
+		int getNumChannels(void) { return n_chan; }
+		int getBlockOut(void) { return block_out; }
+
+	protected:
+		Mode mode;
+		int n_chan, block_out, n_taps;
+		float fs_in_Hz, fs_out_Hz, nominal_step;
+		float coeff[RESAMPLE_ASYNC_PHASES+1][RESAMPLE_ASYNC_TAPS];
+		//a ring, with the first RESAMPLE_ASYNC_TAPS-1 samples copied again past its end so that the
+		//interpolator's window is always contiguous
+		float fifo[RESAMPLE_ASYNC_MAX_CHAN][RESAMPLE_ASYNC_FIFO_SAMPLES + RESAMPLE_ASYNC_TAPS - 1];
+		int write_idx;      //next sample to be written to the FIFO
+		int read_idx;       //first sample of the interpolator's window
+		int n_stored;       //samples from read_idx up to write_idx
+		float frac;         //position between read_idx (and its window) and the next sample, [0,1)
+		bool running;       //false while (re)filling to the target
+		int block_in;       //largest push() seen so far
+
+		//controller
+		float target_fill;
+		bool target_is_auto;
+		float loop_bw_Hz, fill_lp, fill_lp2, fill_alpha, kp, ki, integ, correction, max_correction;
+		float step;          //the ratio used for the last sample of the last pull
+		float max_slew;      //the most the correction can change in one pull
+		bool acquiring;      //using the faster loop, just after (re)starting
+		int update_count, acquire_updates;
+
+		unsigned long n_underrun, n_overrun;
+
+		float autoTargetFill(void) { return 1.5f * (block_in + block_out * nominal_step) + 8.0f; }
+		void designFilter(void);
+		void updateGains(void);
+		void startAcquiring(void);
+		void updateController(void);
+		float interpQuality(const float *x, float mu);
+		float interpCheap(const float *x, float mu);
+};
+
+#endif
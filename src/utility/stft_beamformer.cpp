@@ -0,0 +1,300 @@
+/*
+ * stft_beamformer
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: A delay-and-sum, superdirective, MVDR, or GSC beamformer in the STFT domain.  See stft_beamformer.h.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <stddef.h>
+#include <math.h>
+#include "stft_beamformer.h"
+#include "BTNRH_rfft.h"
+
+#define STFT_BEAMFORMER_TWO_PI 6.28318530717958647692f
+#define STFT_BEAMFORMER_TINY 1.0e-20f
+
+bool StftBeamformer::setup(const float fs_Hz, const int _n_chan, const int N_FFT, const int overlap) {
+	n_chan = 0;  N = 0;  hop = 0;  n_bins = 0;
+	if ((fs_Hz <= 0.0f) || (_n_chan < 1) || (_n_chan > STFT_BEAMFORMER_MAX_CHAN)) return false;
+	if ((N_FFT < STFT_BEAMFORMER_MIN_FFT) || (N_FFT > STFT_BEAMFORMER_MAX_FFT) || (N_FFT & (N_FFT - 1))) return false;
+	if ((overlap != 2) && (overlap != 4)) return false;
+	sample_rate_Hz = fs_Hz;
+	n_chan = _n_chan;  N = N_FFT;  hop = N_FFT / overlap;  n_bins = N_FFT / 2 + 1;
+
+	//sqrt-Hann (periodic), before the FFT and after the IFFT: the products, overlapped every N/overlap,
+	//add up to overlap/2
+	for (int i = 0; i < N; i++) window[i] = sqrtf(0.5f - 0.5f * cosf(STFT_BEAMFORMER_TWO_PI * i / N));
+	ola_gain = 2.0f / overlap;
+	setTimeConst_sec(tau_sec);
+	reset();
+	return true;
+}
+
+void StftBeamformer::reset(void) {
+	for (int c = 0; c < STFT_BEAMFORMER_MAX_CHAN; c++) for (int i = 0; i < STFT_BEAMFORMER_MAX_FFT; i++) in_buf[c][i] = 0.0f;
+	for (int i = 0; i < STFT_BEAMFORMER_MAX_FFT; i++) out_buf[i] = 0.0f;
+	for (int k = 0; k < STFT_BEAMFORMER_MAX_BINS; k++) {
+		for (int t = 0; t < STFT_BEAMFORMER_N_TRI; t++) { cov_re[k][t] = 0.0f; cov_im[k][t] = 0.0f; }
+		for (int c = 0; c < STFT_BEAMFORMER_MAX_CHAN; c++) { g_re[k][c] = 0.0f; g_im[k][c] = 0.0f; }
+		gsc_pow[k] = 0.0f;
+	}
+	fill = 0;
+	steer();
+}
+
+void StftBeamformer::setMode(const Mode m) {
+	mode = m;
+	steer();
+}
+
+void StftBeamformer::setMicPositions_m(const float *x_m, const float *y_m, const int n) {
+	for (int c = 0; c < STFT_BEAMFORMER_MAX_CHAN; c++) {
+		pos_x[c] = ((c < n) && x_m) ? x_m[c] : 0.0f;
+		pos_y[c] = ((c < n) && y_m) ? y_m[c] : 0.0f;
+	}
+	steer();
+}
+
+void StftBeamformer::setLinearArray_m(const float spacing_m, const int n) {
+	for (int c = 0; c < STFT_BEAMFORMER_MAX_CHAN; c++) { pos_x[c] = (c < n) ? c * spacing_m : 0.0f; pos_y[c] = 0.0f; }
+	steer();
+}
+
+void StftBeamformer::setLookDirection_deg(const float az_deg) {
+	look_deg = az_deg;
+	steer();
+}
+
+void StftBeamformer::setTimeConst_sec(const float _tau_sec) {
+	if (_tau_sec > 0.0f) tau_sec = _tau_sec;
+	smooth = (hop > 0) ? expf(-hop / (tau_sec * sample_rate_Hz)) : 0.0f;
+}
+
+void StftBeamformer::setDiagonalLoading(const float _loading) {
+	if (_loading >= 0.0f) loading = _loading;
+}
+
+void StftBeamformer::setSuperdirectiveLoading(const float _loading) {
+	if (_loading >= 0.0f) sd_loading = _loading;
+	if (mode == SUPERDIRECTIVE) steer();
+}
+
+// ///////////////////////////////////////// weights
+
+//a plane wave from az_deg reaches mic c earlier, by (its position along the direction) / c, than the origin
+void StftBeamformer::steeringVector(const float az_deg, const int k, float *d_re, float *d_im) {
+	const float az_rad = az_deg * (STFT_BEAMFORMER_TWO_PI / 360.0f);
+	const float ux = cosf(az_rad), uy = sinf(az_rad);
+	const float w = STFT_BEAMFORMER_TWO_PI * k * sample_rate_Hz / (N * STFT_BEAMFORMER_SPEED_OF_SOUND);   //rad per meter
+	for (int c = 0; c < n_chan; c++) {
+		const float phase = w * (pos_x[c] * ux + pos_y[c] * uy);
+		d_re[c] = cosf(phase);  d_im[c] = sinf(phase);
+	}
+}
+
+void StftBeamformer::steer(void) {
+	for (int k = 0; k < n_bins; k++) {
+		steeringVector(look_deg, k, steer_re[k], steer_im[k]);
+		switch (mode) {
+			case SUPERDIRECTIVE: superdirectiveWeights(k); break;
+			case GSC:            gscWeights(k); break;
+			case MVDR:           if (!mvdrWeights(k, cov_re[k], cov_im[k], loading)) delayAndSumWeights(k); break;
+			default:             delayAndSumWeights(k); break;
+		}
+	}
+}
+
+void StftBeamformer::delayAndSumWeights(const int k) {
+	const float g = 1.0f / n_chan;
+	for (int c = 0; c < n_chan; c++) { w_re[k][c] = g * steer_re[k][c]; w_im[k][c] = g * steer_im[k][c]; }
+}
+
+//diffuse noise: the coherence between two mics is sinc(w * distance / c)
+void StftBeamformer::superdirectiveWeights(const int k) {
+	float A_re[STFT_BEAMFORMER_N_TRI], A_im[STFT_BEAMFORMER_N_TRI];
+	const float w = STFT_BEAMFORMER_TWO_PI * k * sample_rate_Hz / (N * STFT_BEAMFORMER_SPEED_OF_SOUND);
+	for (int i = 0; i < n_chan; i++) {
+		for (int j = i; j < n_chan; j++) {
+			const float dx = pos_x[i] - pos_x[j], dy = pos_y[i] - pos_y[j];
+			const float arg = w * sqrtf(dx * dx + dy * dy);
+			A_re[tri(i, j, n_chan)] = (arg > 1.0e-6f) ? sinf(arg) / arg : 1.0f;
+			A_im[tri(i, j, n_chan)] = 0.0f;
+		}
+	}
+	if (!mvdrWeights(k, A_re, A_im, sd_loading)) delayAndSumWeights(k);
+}
+
+//Cholesky (A + load_rel * the average diagonal * I = L L^H), then solve L z = d and L^H u = z, and
+//w = u / (d^H u).  A is Hermitian, given as its upper triangle.  Returns false if A is no good.
+bool StftBeamformer::mvdrWeights(const int k, const float *A_re, const float *A_im, const float load_rel) {
+	const int M = n_chan;
+	float L_re[STFT_BEAMFORMER_MAX_CHAN][STFT_BEAMFORMER_MAX_CHAN], L_im[STFT_BEAMFORMER_MAX_CHAN][STFT_BEAMFORMER_MAX_CHAN];
+	float trace = 0.0f;
+	for (int i = 0; i < M; i++) trace += A_re[tri(i, i, M)];
+	const float load = load_rel * trace / M + STFT_BEAMFORMER_TINY;
+
+	for (int j = 0; j < M; j++) {
+		float diag = A_re[tri(j, j, M)] + load;
+		for (int m = 0; m < j; m++) diag -= L_re[j][m] * L_re[j][m] + L_im[j][m] * L_im[j][m];
+		if (!(diag > 0.0f)) return false;
+		const float Ljj = sqrtf(diag), inv = 1.0f / Ljj;
+		L_re[j][j] = Ljj;  L_im[j][j] = 0.0f;
+		for (int i = j + 1; i < M; i++) {
+			//A[i][j] = conj(A[j][i]), and subtract sum over m < j of L[i][m] * conj(L[j][m])
+			float re = A_re[tri(j, i, M)], im = -A_im[tri(j, i, M)];
+			for (int m = 0; m < j; m++) {
+				re -= L_re[i][m] * L_re[j][m] + L_im[i][m] * L_im[j][m];
+				im -= L_im[i][m] * L_re[j][m] - L_re[i][m] * L_im[j][m];
+			}
+			L_re[i][j] = re * inv;  L_im[i][j] = im * inv;
+		}
+	}
+
+	const float *d_re = steer_re[k], *d_im = steer_im[k];
+	float z_re[STFT_BEAMFORMER_MAX_CHAN], z_im[STFT_BEAMFORMER_MAX_CHAN];
+	for (int i = 0; i < M; i++) {
+		float re = d_re[i], im = d_im[i];
+		for (int m = 0; m < i; m++) {
+			re -= L_re[i][m] * z_re[m] - L_im[i][m] * z_im[m];
+			im -= L_re[i][m] * z_im[m] + L_im[i][m] * z_re[m];
+		}
+		z_re[i] = re / L_re[i][i];  z_im[i] = im / L_re[i][i];
+	}
+	float u_re[STFT_BEAMFORMER_MAX_CHAN], u_im[STFT_BEAMFORMER_MAX_CHAN];
+	for (int i = M - 1; i >= 0; i--) {
+		float re = z_re[i], im = z_im[i];
+		for (int m = i + 1; m < M; m++) {   //conj(L[m][i]) * u[m]
+			re -= L_re[m][i] * u_re[m] + L_im[m][i] * u_im[m];
+			im -= L_re[m][i] * u_im[m] - L_im[m][i] * u_re[m];
+		}
+		u_re[i] = re / L_re[i][i];  u_im[i] = im / L_re[i][i];
+	}
+	float den = 0.0f;   //d^H u, which is real (and positive)
+	for (int i = 0; i < M; i++) den += d_re[i] * u_re[i] + d_im[i] * u_im[i];
+	if (!(den > 0.0f)) return false;
+	const float inv_den = 1.0f / den;
+	for (int i = 0; i < M; i++) { w_re[k][i] = u_re[i] * inv_den; w_im[k][i] = u_im[i] * inv_den; }
+	return true;
+}
+
+//y = d^H x / M - sum of conj(g[i]) * u[i], with u[i] = conj(d[i+1]) x[i+1] - conj(d[i]) x[i].  As one
+//set of weights: w[c] = d[c] * (1/M - g[c-1] + g[c]), with g[-1] = g[M-1] = 0.
+void StftBeamformer::gscWeights(const int k) {
+	const float inv_M = 1.0f / n_chan;
+	for (int c = 0; c < n_chan; c++) {
+		float a_re = inv_M, a_im = 0.0f;
+		if (c > 0) { a_re -= g_re[k][c - 1]; a_im -= g_im[k][c - 1]; }
+		if (c < n_chan - 1) { a_re += g_re[k][c]; a_im += g_im[k][c]; }
+		const float d_re = steer_re[k][c], d_im = steer_im[k][c];
+		w_re[k][c] = d_re * a_re - d_im * a_im;
+		w_im[k][c] = d_re * a_im + d_im * a_re;
+	}
+}
+
+//NLMS: g[i] += mu * u[i] * conj(y) / (the blocked channels' power)
+void StftBeamformer::gscAdapt(const int k, const float *x_re, const float *x_im, const float y_re, const float y_im) {
+	const int n_blocked = n_chan - 1;
+	if (n_blocked < 1) return;
+	float u_re[STFT_BEAMFORMER_MAX_CHAN], u_im[STFT_BEAMFORMER_MAX_CHAN];
+	float prev_re = steer_re[k][0] * x_re[0] + steer_im[k][0] * x_im[0];   //conj(d) x: lined up
+	float prev_im = steer_re[k][0] * x_im[0] - steer_im[k][0] * x_re[0];
+	float pow = 0.0f;
+	for (int i = 0; i < n_blocked; i++) {
+		const float re = steer_re[k][i + 1] * x_re[i + 1] + steer_im[k][i + 1] * x_im[i + 1];
+		const float im = steer_re[k][i + 1] * x_im[i + 1] - steer_im[k][i + 1] * x_re[i + 1];
+		u_re[i] = re - prev_re;  u_im[i] = im - prev_im;
+		pow += u_re[i] * u_re[i] + u_im[i] * u_im[i];
+		prev_re = re;  prev_im = im;
+	}
+	gsc_pow[k] = smooth * gsc_pow[k] + (1.0f - smooth) * pow;
+	const float step = gsc_mu / (gsc_pow[k] + STFT_BEAMFORMER_TINY);
+	float norm = 0.0f;
+	for (int i = 0; i < n_blocked; i++) {
+		g_re[k][i] += step * (u_re[i] * y_re + u_im[i] * y_im);
+		g_im[k][i] += step * (u_im[i] * y_re - u_re[i] * y_im);
+		norm += g_re[k][i] * g_re[k][i] + g_im[k][i] * g_im[k][i];
+	}
+	if (norm > STFT_BEAMFORMER_GSC_MAX_NORM) {
+		const float scale = sqrtf(STFT_BEAMFORMER_GSC_MAX_NORM / norm);
+		for (int i = 0; i < n_blocked; i++) { g_re[k][i] *= scale; g_im[k][i] *= scale; }
+	}
+	gscWeights(k);
+}
+
+float StftBeamformer::getResponse_dB(const float az_deg, const float f_Hz) {
+	if (N == 0) return -200.0f;
+	int k = (int)(f_Hz * N / sample_rate_Hz + 0.5f);
+	if (k < 0) k = 0;
+	if (k > n_bins - 1) k = n_bins - 1;
+	float d_re[STFT_BEAMFORMER_MAX_CHAN], d_im[STFT_BEAMFORMER_MAX_CHAN];
+	steeringVector(az_deg, k, d_re, d_im);
+	float re = 0.0f, im = 0.0f;   //w^H d
+	for (int c = 0; c < n_chan; c++) {
+		re += w_re[k][c] * d_re[c] + w_im[k][c] * d_im[c];
+		im += w_re[k][c] * d_im[c] - w_im[k][c] * d_re[c];
+	}
+	return 10.0f * log10f(re * re + im * im + STFT_BEAMFORMER_TINY);
+}
+
+// ///////////////////////////////////////// streaming
+
+void StftBeamformer::process(const float * const *x, float *y, const int n) {
+	if (N == 0) { for (int i = 0; i < n; i++) y[i] = 0.0f; return; }
+	const int in_start = N - hop;
+	for (int i = 0; i < n; i++) {
+		for (int c = 0; c < n_chan; c++) in_buf[c][in_start + fill] = x[c] ? x[c][i] : 0.0f;
+		y[i] = out_buf[fill];
+		if (++fill == hop) {
+			fill = 0;
+			frame();
+		}
+	}
+}
+
+void StftBeamformer::frame(void) {
+	const int M = n_chan;
+	for (int c = 0; c < M; c++) {
+		for (int i = 0; i < N; i++) spec[c][i] = in_buf[c][i] * window[i];
+		BTNRH_FFT::cha_fft_rc(spec[c], N);
+	}
+
+	const bool adapt_mvdr = (mode == MVDR) && adapting, adapt_gsc = (mode == GSC) && adapting;
+	const float a = smooth, b = 1.0f - smooth;
+	float x_re[STFT_BEAMFORMER_MAX_CHAN], x_im[STFT_BEAMFORMER_MAX_CHAN];
+	for (int k = 0; k < n_bins; k++) {
+		for (int c = 0; c < M; c++) { x_re[c] = spec[c][2 * k]; x_im[c] = spec[c][2 * k + 1]; }
+
+		if (adapt_mvdr) {
+			//R[i][j] = E{ x[i] conj(x[j]) }
+			float *R_re = cov_re[k], *R_im = cov_im[k];
+			for (int i = 0; i < M; i++) {
+				for (int j = i; j < M; j++) {
+					const int t = tri(i, j, M);
+					R_re[t] = a * R_re[t] + b * (x_re[i] * x_re[j] + x_im[i] * x_im[j]);
+					R_im[t] = a * R_im[t] + b * (x_im[i] * x_re[j] - x_re[i] * x_im[j]);
+				}
+			}
+			if (!mvdrWeights(k, R_re, R_im, loading)) delayAndSumWeights(k);
+		}
+
+		//y = w^H x
+		float y_re = 0.0f, y_im = 0.0f;
+		for (int c = 0; c < M; c++) {
+			y_re += w_re[k][c] * x_re[c] + w_im[k][c] * x_im[c];
+			y_im += w_re[k][c] * x_im[c] - w_im[k][c] * x_re[c];
+		}
+		if (adapt_gsc) gscAdapt(k, x_re, x_im, y_re, y_im);
+
+		//the beam goes into the first channel's spectrum, which is done with
+		spec[0][2 * k] = y_re;  spec[0][2 * k + 1] = y_im;
+	}
+
+	BTNRH_FFT::cha_fft_cr(spec[0], N);
+	const int keep = N - hop;
+	for (int i = 0; i < keep; i++) out_buf[i] = out_buf[i + hop] + spec[0][i] * window[i] * ola_gain;
+	for (int i = keep; i < N; i++) out_buf[i] = spec[0][i] * window[i] * ola_gain;
+	for (int c = 0; c < M; c++) for (int i = 0; i < keep; i++) in_buf[c][i] = in_buf[c][i + hop];
+}
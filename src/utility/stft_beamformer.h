@@ -0,0 +1,103 @@
+/*
+ * stft_beamformer
+ *
+ * Created: OpenAudio, Oct 2026
+ * Purpose: STFT-domain beamformer for a small microphone array: delay-and-sum, superdirective,
+ *     MVDR, or GSC.  See AudioEffectBeamformerN_F32 for the audio node.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _stft_beamformer_h
+#define _stft_beamformer_h
+
+#ifndef STFT_BEAMFORMER_MAX_CHAN
+#define STFT_BEAMFORMER_MAX_CHAN 4
+#endif
+#ifndef STFT_BEAMFORMER_MAX_FFT
+#define STFT_BEAMFORMER_MAX_FFT 256
+#endif
+#define STFT_BEAMFORMER_MIN_FFT 32
+#define STFT_BEAMFORMER_MAX_BINS (STFT_BEAMFORMER_MAX_FFT / 2 + 1)
+#define STFT_BEAMFORMER_N_TRI ((STFT_BEAMFORMER_MAX_CHAN * (STFT_BEAMFORMER_MAX_CHAN + 1)) / 2)
+#define STFT_BEAMFORMER_SPEED_OF_SOUND 343.0f   //m/s
+#define STFT_BEAMFORMER_GSC_MAX_NORM 0.1f        //the most that a GSC bin's adaptive weights can add up to (squared), so a target between bins isn't cancelled
+
+class StftBeamformer {
+	public:
+		//fixed: DELAY_AND_SUM (wide arrays), SUPERDIRECTIVE (small arrays).  adaptive: MVDR (per-bin covariance,
+		//loaded; it adapts on the target too, so hold it with enableAdaptation(false) while the target talks), GSC (NLMS)
+		enum Mode { DELAY_AND_SUM = 0, SUPERDIRECTIVE, MVDR, GSC };
+
+		StftBeamformer(void) { setLinearArray_m(0.012f, STFT_BEAMFORMER_MAX_CHAN); }
+
+		//N_FFT: a power of 2, from STFT_BEAMFORMER_MIN_FFT to STFT_BEAMFORMER_MAX_FFT.  overlap: 2 or 4.
+		//Clears the states.  Returns false (and then gives silence) if the settings are no good.
+		bool setup(const float fs_Hz, const int n_chan, const int N_FFT, const int overlap = 2);
+		void reset(void);      //the covariances and the adaptive weights start over
+
+		//x[c] (n samples each) is channel c, or NULL for silence.  y gets the beam.
+		void process(const float * const *x, float *y, const int n);
+
+		void setMode(const Mode m);
+		Mode getMode(void) { return mode; }
+
+		//The array, in meters.  y_m can be NULL (a line of mics along x).  Mics past n_chan are ignored.
+		void setMicPositions_m(const float *x_m, const float *y_m, const int n);
+		void setLinearArray_m(const float spacing_m, const int n);   //along x, starting at 0
+		//The look direction: 0 deg is along +x (endfire, for a line of mics front to back), 90 deg is along +y.
+		void setLookDirection_deg(const float az_deg);
+		float getLookDirection_deg(void) { return look_deg; }
+
+		void setTimeConst_sec(const float tau_sec);                 //MVDR covariance and GSC power averaging
+		void setDiagonalLoading(const float loading);               //MVDR, re: the average channel power (less cancels more of the target)
+		void setSuperdirectiveLoading(const float loading);         //SUPERDIRECTIVE, likewise (less is more directive, but boosts mic noise)
+		void setAdaptRate(const float mu) { if (mu > 0.0f) gsc_mu = mu; }   //GSC step size (0 to 1)
+		void enableAdaptation(const bool enable) { adapting = enable; }    //MVDR and GSC: false holds the present weights
+		float getTimeConst_sec(void) { return tau_sec; }
+		float getDiagonalLoading(void) { return loading; }
+		float getSuperdirectiveLoading(void) { return sd_loading; }
+		float getAdaptRate(void) { return gsc_mu; }
+		bool getAdaptation(void) { return adapting; }
+
+		int getNumChannels(void) { return n_chan; }
+		int getNFFT(void) { return N; }
+		int getLatency_samples(void) { return N; }
+
+		//the beam's response (present weights) to sound from az_deg, at the bin nearest f_Hz
+		float getResponse_dB(const float az_deg, const float f_Hz);
+
+	protected:
+		float sample_rate_Hz = 24000.0f;
+		int n_chan = 0, N = 0, hop = 0, n_bins = 0, fill = 0;
+		Mode mode = DELAY_AND_SUM;
+		float pos_x[STFT_BEAMFORMER_MAX_CHAN], pos_y[STFT_BEAMFORMER_MAX_CHAN];
+		float look_deg = 0.0f;
+		float tau_sec = 0.25f, loading = 1.0f, sd_loading = 0.05f, gsc_mu = 0.05f;
+		float smooth = 0.0f, ola_gain = 0.0f;
+		bool adapting = true;
+
+		float in_buf[STFT_BEAMFORMER_MAX_CHAN][STFT_BEAMFORMER_MAX_FFT], out_buf[STFT_BEAMFORMER_MAX_FFT];
+		float window[STFT_BEAMFORMER_MAX_FFT];
+		float spec[STFT_BEAMFORMER_MAX_CHAN][STFT_BEAMFORMER_MAX_FFT + 2];   //interleaved re, im for bins 0 to N/2
+
+		//per bin: the look direction's steering vector, the weights, and (MVDR) the covariance (upper
+		//triangle, row by row) or (GSC) the adaptive weights and the blocked channels' power
+		float steer_re[STFT_BEAMFORMER_MAX_BINS][STFT_BEAMFORMER_MAX_CHAN], steer_im[STFT_BEAMFORMER_MAX_BINS][STFT_BEAMFORMER_MAX_CHAN];
+		float w_re[STFT_BEAMFORMER_MAX_BINS][STFT_BEAMFORMER_MAX_CHAN], w_im[STFT_BEAMFORMER_MAX_BINS][STFT_BEAMFORMER_MAX_CHAN];
+		float cov_re[STFT_BEAMFORMER_MAX_BINS][STFT_BEAMFORMER_N_TRI], cov_im[STFT_BEAMFORMER_MAX_BINS][STFT_BEAMFORMER_N_TRI];
+		float g_re[STFT_BEAMFORMER_MAX_BINS][STFT_BEAMFORMER_MAX_CHAN], g_im[STFT_BEAMFORMER_MAX_BINS][STFT_BEAMFORMER_MAX_CHAN];
+		float gsc_pow[STFT_BEAMFORMER_MAX_BINS];
+
+		void frame(void);
+		void steer(void);                     //the steering vectors, and the fixed weights
+		void steeringVector(const float az_deg, const int k, float *d_re, float *d_im);
+		bool mvdrWeights(const int k, const float *A_re, const float *A_im, const float load_rel);   //w = A^-1 d / (d^H A^-1 d), A loaded
+		void gscWeights(const int k);         //the delay-and-sum weights, less the blocked channels' adaptive mix
+		void gscAdapt(const int k, const float *x_re, const float *x_im, const float y_re, const float y_im);
+		void delayAndSumWeights(const int k);
+		void superdirectiveWeights(const int k);
+		static int tri(const int i, const int j, const int M) { return i * M - (i * (i - 1)) / 2 + (j - i); }   //i <= j
+};
+
+#endif
@@ -0,0 +1,380 @@
+/*
+ * sweep_measure
+ *
+ * Created: OpenAudio, Oct 2026
+ *
+ * Purpose: Multitone and log-sweep measurement of gain vs frequency and level.  See sweep_measure.h
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#include <math.h>
+#include <string.h>
+#include "sweep_measure.h"
+#include "BTNRH_rfft.h"
+
+#define SWEEP_MEASURE_MIN_PERIOD 256
+#define SWEEP_MEASURE_MIN_SWEEP 1024
+#define SWEEP_MEASURE_MAX_PERIOD 65536
+#define SWEEP_MEASURE_CHUNK 64      //samples of DFT rotation made at a time (MULTITONE)
+#define SWEEP_MEASURE_TOP 0.45f     //LOG_SWEEP: highest frequency reported, relative to the sample rate...
+#define SWEEP_MEASURE_SWEEP_TOP 0.48f  //...and the top of the sweep
+
+static float to_dB(const double val) { return (float)(20.0 * log10((val > 1.0e-20) ? val : 1.0e-20)); }
+static float plus_dB(const float a_dB, const float b_dB) { return ((a_dB == SWEEP_MEASURE_NO_VALUE) || (b_dB == SWEEP_MEASURE_NO_VALUE)) ? SWEEP_MEASURE_NO_VALUE : (a_dB + b_dB); }
+
+// ///////////////////////////////////////// settings
+
+void SweepMeasure::setFreqRange_Hz(const float lo_Hz, const float hi_Hz) {
+	if ((lo_Hz <= 0.0f) || (hi_Hz < lo_Hz)) return;
+	freq_lo_Hz = lo_Hz;
+	freq_hi_Hz = hi_Hz;
+}
+
+void SweepMeasure::setNumFreqs(const int n) {
+	n_freqs = (n < 1) ? 1 : ((n > SWEEP_MEASURE_MAX_FREQS) ? SWEEP_MEASURE_MAX_FREQS : n);
+}
+
+void SweepMeasure::setLevels_dBFS(const float start_dB, const float end_dB, const float step_dB) {
+	level_start_dB = start_dB;
+	level_end_dB = end_dB;
+	level_step_dB = step_dB;
+}
+
+void SweepMeasure::setNumChannels(const int n) {
+	n_chan = (n < 1) ? 1 : ((n > SWEEP_MEASURE_MAX_CHAN) ? SWEEP_MEASURE_MAX_CHAN : n);
+}
+
+uint32_t SweepMeasure::sweepPeriodFor(const float sec) {
+	uint32_t N = SWEEP_MEASURE_MIN_SWEEP;
+	while ((N < SWEEP_MEASURE_MAX_PERIOD) && (N < sec * sample_rate_Hz)) N *= 2;
+	return N;
+}
+
+uint32_t SweepMeasure::floatsNeeded(void) {
+	if (stimulus != LOG_SWEEP) return 0;
+	return (n_chan + 1) * (sweepPeriodFor(measure_sec) + 2);
+}
+
+// ///////////////////////////////////////// planning
+
+bool SweepMeasure::start(void) {
+	running = false;
+	done = false;
+	const float fs = sample_rate_Hz;
+
+	//levels
+	int n = 1;
+	if ((level_step_dB != 0.0f) && ((level_end_dB - level_start_dB) / level_step_dB > 0.0f)) {
+		n = (int)((level_end_dB - level_start_dB) / level_step_dB + 0.5f) + 1;
+	}
+	n_levels = (n > SWEEP_MEASURE_MAX_LEVELS) ? SWEEP_MEASURE_MAX_LEVELS : n;
+	for (int L = 0; L < n_levels; L++) level_dBFS[L] = level_start_dB + L * level_step_dB;
+
+	//frequencies to report, log spaced
+	float hi_Hz = freq_hi_Hz;
+	if (stimulus == LOG_SWEEP) {
+		sweep_hi_Hz = SWEEP_MEASURE_SWEEP_TOP * fs;
+		if (hi_Hz > SWEEP_MEASURE_TOP * fs) hi_Hz = SWEEP_MEASURE_TOP * fs;
+	}
+	if (hi_Hz < freq_lo_Hz) return false;
+	const float ratio = (n_freqs > 1) ? powf(hi_Hz / freq_lo_Hz, 1.0f / (n_freqs - 1)) : 2.0f;
+	for (int f = 0; f < n_freqs; f++) freq_Hz[f] = freq_lo_Hz * powf(ratio, (float)f);
+
+	uint32_t n_settle = 1, n_measure = 1;   //in periods
+	if (stimulus == MULTITONE) {
+		//The period must be long enough that the closest tones (at the bottom) are two bins apart,
+		//so that each can go on an odd bin.
+		const float spacing_Hz = freq_lo_Hz * (ratio - 1.0f);
+		uint32_t N = SWEEP_MEASURE_MIN_PERIOD;
+		while ((N < SWEEP_MEASURE_MAX_PERIOD) && ((fs / N > 0.5f * spacing_Hz) || (N * freq_lo_Hz / fs < 3.0f))) N *= 2;
+		period = N;
+		for (int f = 0; f < n_freqs; f++) {
+			int b = 2 * (int)(0.5f * (freq_Hz[f] * N / fs - 1.0f) + 0.5f) + 1;   //the nearest odd bin
+			if ((f > 0) && (b <= bin[f-1])) b = bin[f-1] + 2;
+			if (b >= (int)N / 2) return false;
+			bin[f] = b;
+			freq_Hz[f] = b * fs / N;
+			step_re[f] = (float)cos(2.0 * M_PI * b / N);
+			step_im[f] = (float)(-sin(2.0 * M_PI * b / N));
+		}
+		n_measure = (uint32_t)ceilf(measure_sec * fs / N);
+
+		//the tones, with Schroeder's phases for a low crest factor.  Their amplitudes are set by each level.
+		bank.clear();
+		bank.setSampleRate_Hz(fs);
+		for (int f = 0; f < n_freqs; f++) bank.addTone(freq_Hz[f], 0.0f, -180.0f * f * (f - 1) / n_freqs);
+	} else {
+		//the sweep, and its memory
+		uint32_t N = sweepPeriodFor(measure_sec);
+		while ((N > SWEEP_MEASURE_MIN_SWEEP) && ((n_chan + 1) * (N + 2) > buffer_len)) N /= 2;
+		if ((buffer == NULL) || ((n_chan + 1) * (N + 2) > buffer_len)) return false;
+		period = N;
+		sweep_lo_Hz = 0.25f * freq_lo_Hz;   //an octave to fade in, and an octave to spare
+		if (sweep_lo_Hz < 4.0f * fs / N) sweep_lo_Hz = 4.0f * fs / N;
+		if (sweep_lo_Hz >= sweep_hi_Hz) return false;
+		sweep_L_samples = N / logf(sweep_hi_Hz / sweep_lo_Hz);
+		sweep_growth = exp(1.0 / sweep_L_samples);
+	}
+	n_settle = (uint32_t)ceilf(settle_sec * fs / period);
+	if (n_settle < 1) n_settle = 1;     //at least one period, so that the response is periodic
+	if (n_measure < 1) n_measure = 1;
+	settle_samples = n_settle * period;
+	samples_per_level = (n_settle + n_measure) * period;
+
+	clearResults();
+	gen_pos = 0;
+	gen_level = -1;
+	ana_pos = 0;
+	baseline_pow = 0.0;
+	running = true;
+	return true;
+}
+
+void SweepMeasure::clearResults(void) {
+	for (int L = 0; L < SWEEP_MEASURE_MAX_LEVELS; L++) {
+		for (int f = 0; f < SWEEP_MEASURE_MAX_FREQS; f++) {
+			in_dB[L][f] = SWEEP_MEASURE_NO_VALUE;
+			for (int c = 0; c <= SWEEP_MEASURE_MAX_CHAN; c++) out_dB[L][f][c] = SWEEP_MEASURE_NO_VALUE;
+			harm_dB[L][f][0] = harm_dB[L][f][1] = SWEEP_MEASURE_NO_VALUE;
+		}
+	}
+	memset(acc_re, 0, sizeof(acc_re));
+	memset(acc_im, 0, sizeof(acc_im));
+}
+
+// ///////////////////////////////////////// generator
+
+void SweepMeasure::startLevel(const int L) {
+	gen_level = L;
+	const float rms = powf(10.0f, 0.05f * level_dBFS[L]);
+	if (stimulus == MULTITONE) {
+		const float amp = sqrtf(2.0f / n_freqs) * rms;
+		for (int f = 0; f < n_freqs; f++) bank.setAmplitude(f, amp);
+	} else {
+		sweep_amp = sqrtf(2.0f) * rms;
+	}
+}
+
+void SweepMeasure::generate(float *out, const int n) {
+	if (!running) { memset(out, 0, n * sizeof(float)); return; }
+	const uint32_t total = getTotalSamples();
+	int k = 0;
+	while (k < n) {
+		//after the last level, keep playing it until the analysis (which may lag) is done
+		int L = gen_pos / samples_per_level;
+		if (L >= n_levels) L = n_levels - 1;
+		if (L != gen_level) startLevel(L);
+		int run = n - k;
+		if (gen_pos < total) {
+			const uint32_t left = samples_per_level - (gen_pos % samples_per_level);
+			if (left < (uint32_t)run) run = left;
+		}
+
+		if (stimulus == MULTITONE) {
+			bank.synthesize(out + k, run);
+		} else {
+			for (int i = 0; i < run; i++) {
+				if ((gen_pos + i) % period == 0) {
+					sweep_phase = 0.0;
+					sweep_w = 2.0 * M_PI * sweep_lo_Hz / sample_rate_Hz;
+				}
+				out[k+i] = sweep_amp * sinf((float)sweep_phase);
+				sweep_phase += sweep_w;
+				if (sweep_phase > M_PI) sweep_phase -= 2.0 * M_PI;
+				sweep_w *= sweep_growth;
+			}
+		}
+		gen_pos += run;
+		k += run;
+	}
+}
+
+// ///////////////////////////////////////// analyzer
+
+void SweepMeasure::analyze(const float *baseline, const float * const *outputs, const int n_outputs, const int n) {
+	if (!running) return;
+	const float *sig[SWEEP_MEASURE_MAX_CHAN+1];
+	sig[0] = baseline;
+	for (int c = 0; c < n_chan; c++) sig[1+c] = ((outputs != NULL) && (c < n_outputs)) ? outputs[c] : NULL;
+
+	int k = 0;
+	while ((k < n) && running) {
+		const int L = ana_pos / samples_per_level;
+		const uint32_t offset = ana_pos % samples_per_level;
+		int run = n - k;
+		if (samples_per_level - offset < (uint32_t)run) run = samples_per_level - offset;
+
+		if (offset + run > settle_samples) {
+			const int skip = (offset < settle_samples) ? (settle_samples - offset) : 0;
+			const uint32_t m0 = offset + skip - settle_samples;   //samples into the measurement
+			const int len = run - skip;
+			if (stimulus == MULTITONE) {
+				accumulateTones(sig, n_chan + 1, k + skip, m0, len);
+			} else {
+				for (int s = 0; s <= n_chan; s++) {
+					float *dest = buffer + s * (period + 2) + m0;
+					if (sig[s] != NULL) { memcpy(dest, sig[s] + k + skip, len * sizeof(float)); } else { memset(dest, 0, len * sizeof(float)); }
+				}
+				if (baseline != NULL) {
+					for (int i = 0; i < len; i++) baseline_pow += (double)baseline[k+skip+i] * baseline[k+skip+i];
+				}
+			}
+		}
+		ana_pos += run;
+		k += run;
+
+		if (ana_pos % samples_per_level == 0) {
+			if (stimulus == MULTITONE) { finishLevelMultitone(L); } else { finishLevelSweep(L); }
+			if (L >= n_levels - 1) { running = false; done = true; }
+		}
+	}
+}
+
+void SweepMeasure::accumulateTones(const float * const *sig, const int n_sig, const int offset, const uint32_t m0, const int n) {
+	//single-bin DFTs.  The rotation, exp(-j*2*pi*bin*m/N), is made a chunk at a time (starting each
+	//chunk from its exact phase, so that the float rotation can't drift) and shared by all the signals.
+	float rot_re[SWEEP_MEASURE_CHUNK], rot_im[SWEEP_MEASURE_CHUNK];
+	for (int j0 = 0; j0 < n; j0 += SWEEP_MEASURE_CHUNK) {
+		const int len = ((n - j0) < SWEEP_MEASURE_CHUNK) ? (n - j0) : SWEEP_MEASURE_CHUNK;
+		const uint32_t m = (m0 + j0) % period;
+		for (int f = 0; f < n_freqs; f++) {
+			const uint32_t idx = (uint32_t)(((uint64_t)bin[f] * m) % period);
+			const double ph = 2.0 * M_PI * idx / period;
+			float r = (float)cos(ph), i = (float)(-sin(ph));
+			for (int j = 0; j < len; j++) {
+				rot_re[j] = r;  rot_im[j] = i;
+				const float r_new = r * step_re[f] - i * step_im[f];
+				i = r * step_im[f] + i * step_re[f];
+				r = r_new;
+			}
+			for (int s = 0; s < n_sig; s++) {
+				if (sig[s] == NULL) continue;
+				const float *x = sig[s] + offset + j0;
+				float sum_re = 0.0f, sum_im = 0.0f;
+				for (int j = 0; j < len; j++) { sum_re += x[j] * rot_re[j];  sum_im += x[j] * rot_im[j]; }
+				acc_re[s][f] += sum_re;
+				acc_im[s][f] += sum_im;
+			}
+		}
+	}
+}
+
+void SweepMeasure::finishLevelMultitone(const int L) {
+	//a tone of amplitude A gives a DFT of magnitude A*M/2, so its RMS is |DFT|*sqrt(2)/M
+	const double scale = sqrt(2.0) / (samples_per_level - settle_samples);
+	for (int f = 0; f < n_freqs; f++) {
+		in_dB[L][f] = to_dB(scale * sqrt((double)acc_re[0][f] * acc_re[0][f] + (double)acc_im[0][f] * acc_im[0][f]));
+		double sum_re = 0.0, sum_im = 0.0;
+		for (int c = 0; c < n_chan; c++) {
+			out_dB[L][f][c] = to_dB(scale * sqrt((double)acc_re[1+c][f] * acc_re[1+c][f] + (double)acc_im[1+c][f] * acc_im[1+c][f]));
+			sum_re += acc_re[1+c][f];
+			sum_im += acc_im[1+c][f];
+		}
+		out_dB[L][f][n_chan] = to_dB(scale * sqrt(sum_re * sum_re + sum_im * sum_im));
+	}
+	memset(acc_re, 0, sizeof(acc_re));
+	memset(acc_im, 0, sizeof(acc_im));
+}
+
+// ///////////////////////////////////////// log sweep analysis
+
+void SweepMeasure::finishLevelSweep(const int L) {
+	const int N = period, stride = N + 2;
+	float *x = buffer;
+	const float level_dB = to_dB(sqrt(baseline_pow / N));
+	baseline_pow = 0.0;
+
+	//spectra (interleaved re, im for bins 0 to N/2)
+	for (int s = 0; s <= n_chan; s++) BTNRH_FFT::cha_fft_rc(buffer + s * stride, N);
+
+	//Deconvolve: H = Y/X across the sweep (and zero elsewhere).  Each output's response replaces its
+	//spectrum.  The sum of the responses (the response of the summed outputs) replaces the baseline's.
+	//H fades in and out at the ends of the sweep (over an octave at the bottom, and from the top
+	//reported frequency to the top of the sweep at the top).  Cut off sharply, its impulse response
+	//would ring for longer than the window that cleans out the harmonics, leaving ripple in the result.
+	const float bin_Hz = sample_rate_Hz / N;
+	const float fade_lo_Hz = 2.0f * sweep_lo_Hz, fade_hi_Hz = SWEEP_MEASURE_TOP * sample_rate_Hz;
+	for (int b = 0; b <= N / 2; b++) {
+		const float xr = x[2*b], xi = x[2*b+1], p = xr * xr + xi * xi;
+		const float f_Hz = b * bin_Hz;
+		float w = 0.0f;
+		if ((f_Hz > sweep_lo_Hz) && (f_Hz < sweep_hi_Hz) && (p > 0.0f)) {
+			if (f_Hz < fade_lo_Hz) { w = 0.5f * (1.0f - cosf((float)M_PI * (f_Hz - sweep_lo_Hz) / (fade_lo_Hz - sweep_lo_Hz))); }
+			else if (f_Hz > fade_hi_Hz) { w = 0.5f * (1.0f + cosf((float)M_PI * (f_Hz - fade_hi_Hz) / (sweep_hi_Hz - fade_hi_Hz))); }
+			else { w = 1.0f; }
+			w /= p;
+		}
+		float sum_re = 0.0f, sum_im = 0.0f;
+		for (int c = 0; c < n_chan; c++) {
+			float *y = buffer + (1 + c) * stride;
+			const float yr = y[2*b], yi = y[2*b+1];
+			const float hr = w * (yr * xr + yi * xi);
+			const float hi = w * (yi * xr - yr * xi);
+			y[2*b] = hr;  y[2*b+1] = hi;
+			sum_re += hr;  sum_im += hi;
+		}
+		x[2*b] = sum_re;  x[2*b+1] = sum_im;
+	}
+
+	//Impulse responses.  The linear one starts at 0.  The sweep rises by a factor of k in L*ln(k)
+	//samples, so the k-th harmonic's lands L*ln(k) samples earlier (wrapped to the end of the period).
+	//The fades above make the linear one ring before 0 too (for about 1/sweep_lo_Hz), so its window
+	//reaches back as far as it can without touching the 2nd harmonic's (which ends near -0.45*L).
+	const float Ls = sweep_L_samples;
+	const int pre_1 = (int)(0.35f * Ls) + 1, post_1 = N / 4;
+	for (int f = 0; f < n_freqs; f++) in_dB[L][f] = level_dB;
+
+	//each output's linear response
+	for (int c = 0; c < n_chan; c++) {
+		float *y = buffer + (1 + c) * stride;
+		BTNRH_FFT::cha_fft_cr(y, N);
+		windowImpulse(y, y, 0, pre_1, post_1);
+		BTNRH_FFT::cha_fft_rc(y, N);
+		for (int f = 0; f < n_freqs; f++) out_dB[L][f][c] = plus_dB(level_dB, responseAt_dB(y, freq_Hz[f]));
+	}
+
+	//the summed outputs: harmonics, and then the linear response (the first output's memory is the scratch)
+	float *scratch = buffer + stride;
+	BTNRH_FFT::cha_fft_cr(x, N);
+	float harm_raw_dB[2][SWEEP_MEASURE_MAX_FREQS];
+	for (int k = 2; k <= 3; k++) {
+		const float seg = Ls * logf((k + 1.0f) / k);     //the room before the next harmonic
+		const int center = N - (int)(Ls * logf((float)k) + 0.5f);
+		windowImpulse(x, scratch, center, (int)(0.1f * seg) + 1, (int)(0.6f * seg));
+		BTNRH_FFT::cha_fft_rc(scratch, N);
+		for (int f = 0; f < n_freqs; f++) {
+			harm_raw_dB[k-2][f] = (k * freq_Hz[f] <= fade_hi_Hz) ? responseAt_dB(scratch, k * freq_Hz[f]) : SWEEP_MEASURE_NO_VALUE;
+		}
+	}
+	windowImpulse(x, scratch, 0, pre_1, post_1);
+	BTNRH_FFT::cha_fft_rc(scratch, N);
+	for (int f = 0; f < n_freqs; f++) {
+		const float H1_dB = responseAt_dB(scratch, freq_Hz[f]);
+		out_dB[L][f][n_chan] = plus_dB(level_dB, H1_dB);
+		for (int k = 0; k < 2; k++) harm_dB[L][f][k] = difference(harm_raw_dB[k][f], H1_dB);
+	}
+}
+
+void SweepMeasure::windowImpulse(const float *h, float *out, const int center, const int pre, const int post) {
+	//keep from pre samples before the center to post samples after it (wrapping around the period),
+	//with raised-cosine tapers over the pre part and the last quarter of the post part
+	const int N = period, taper = (post / 4 > 1) ? post / 4 : 1;
+	for (int n = 0; n < N; n++) {
+		const int j = ((n - center + pre) % N + N) % N - pre;   //samples after the center, from -pre
+		float w = 0.0f;
+		if (j < 0) {
+			w = 0.5f * (1.0f - cosf((float)M_PI * (j + pre) / pre));
+		} else if (j < post) {
+			w = (j >= post - taper) ? 0.5f * (1.0f - cosf((float)M_PI * (post - j) / taper)) : 1.0f;
+		}
+		out[n] = w * h[n];
+	}
+	out[N] = out[N+1] = 0.0f;
+}
+
+float SweepMeasure::responseAt_dB(const float *H, const float f_Hz) {
+	const int b = (int)(f_Hz * period / sample_rate_Hz + 0.5f);
+	if (b > (int)period / 2) return SWEEP_MEASURE_NO_VALUE;
+	return to_dB(sqrt((double)H[2*b] * H[2*b] + (double)H[2*b+1] * H[2*b+1]));
+}
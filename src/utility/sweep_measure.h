@@ -0,0 +1,135 @@
+/*
+ * sweep_measure
+ *
+ * Created: OpenAudio, Oct 2026
+ * Purpose: Gain vs frequency and level, measured in one pass per level with a multitone or a
+ *     periodic log sweep (which also gives the 2nd and 3rd harmonics).  See AudioControlTestFastSweep_F32.
+ *
+ * MIT License.  Use at your own risk.
+*/
+
+#ifndef _sweep_measure_h
+#define _sweep_measure_h
+
+#include <stdint.h>
+#include "osc_bank.h"
+
+#ifndef SWEEP_MEASURE_MAX_LEVELS
+#define SWEEP_MEASURE_MAX_LEVELS 48
+#endif
+#ifndef SWEEP_MEASURE_MAX_FREQS
+#define SWEEP_MEASURE_MAX_FREQS 16    //no more than OSC_BANK_MAX_TONES
+#endif
+#ifndef SWEEP_MEASURE_MAX_CHAN
+#define SWEEP_MEASURE_MAX_CHAN 8
+#endif
+#define SWEEP_MEASURE_NO_VALUE (-999.0f)   //for results that weren't (or can't be) measured
+
+class SweepMeasure {
+	public:
+		enum Stimulus { MULTITONE = 0, LOG_SWEEP = 1 };
+
+		SweepMeasure(void) {}
+
+		//Settings.  These take effect at the next start().
+		void setSampleRate_Hz(const float fs_Hz) { if (fs_Hz > 0.0f) sample_rate_Hz = fs_Hz; }
+		void setStimulus(const Stimulus s) { stimulus = s; }
+		Stimulus getStimulus(void) { return stimulus; }
+		void setFreqRange_Hz(const float lo_Hz, const float hi_Hz);  //the lowest and highest frequencies to report
+		void setNumFreqs(const int n);       //how many frequencies to report (log spaced)
+		void setLevels_dBFS(const float start_dB, const float end_dB, const float step_dB);
+		void setSettle_sec(const float sec) { settle_sec = (sec > 0.0f) ? sec : 0.0f; }   //at each level, before measuring
+		void setMeasure_sec(const float sec) { measure_sec = (sec > 0.0f) ? sec : 0.0f; } //MULTITONE: averaging time.  LOG_SWEEP: sweep length.
+		void setNumChannels(const int n);    //the number of outputs to be measured
+
+		//Memory for LOG_SWEEP.  If the sweep (rounded up to a power of two) won't fit, start() shortens it.
+		void setBuffer(float *buf, const uint32_t n_floats) { buffer = buf; buffer_len = (buf == NULL) ? 0 : n_floats; }
+		uint32_t floatsNeeded(void);         //for LOG_SWEEP, with the present settings
+
+		//Plan the test and get ready to generate and analyze.  Returns false if it can't be done (and then
+		//does nothing).  stop() ends the test early.
+		bool start(void);
+		void stop(void) { running = false; }
+		bool isRunning(void) { return running; }
+		bool isDone(void) { return done; }
+
+		//The test signal, n samples at a time.  After the test, this gives silence.
+		void generate(float *out, const int n);
+		//n samples of the baseline and of each output.  Missing outputs (NULL) are taken as silent.
+		void analyze(const float *baseline, const float * const *outputs, const int n_outputs, const int n);
+
+		uint32_t getPeriod_samples(void) { return period; }          //N
+		uint32_t getSamplesPerLevel(void) { return samples_per_level; }
+		uint32_t getTotalSamples(void) { return samples_per_level * n_levels; }
+		uint32_t getSamplesAnalyzed(void) { return ana_pos; }
+
+		//Results, by level index (0 to getNumLevels()-1) and frequency index (0 to getNumFreqs()-1)
+		int getNumLevels(void) { return n_levels; }
+		int getNumFreqs(void) { return n_freqs; }
+		int getNumChannels(void) { return n_chan; }
+		float getLevel_dBFS(const int L) { return validLevel(L) ? level_dBFS[L] : SWEEP_MEASURE_NO_VALUE; }
+		float getFreq_Hz(const int f) { return ((f >= 0) && (f < n_freqs)) ? freq_Hz[f] : 0.0f; }
+		float getInput_dBFS(const int L, const int f) { return valid(L, f) ? in_dB[L][f] : SWEEP_MEASURE_NO_VALUE; }   //MULTITONE: this tone's RMS
+		float getOutput_dBFS(const int L, const int f, const int c) { return (valid(L, f) && (c >= 0) && (c < n_chan)) ? out_dB[L][f][c] : SWEEP_MEASURE_NO_VALUE; }
+		float getTotalOutput_dBFS(const int L, const int f) { return valid(L, f) ? out_dB[L][f][n_chan] : SWEEP_MEASURE_NO_VALUE; }  //the outputs summed (coherently)
+		float getGain_dB(const int L, const int f, const int c) { return difference(getOutput_dBFS(L, f, c), getInput_dBFS(L, f)); }
+		float getTotalGain_dB(const int L, const int f) { return difference(getTotalOutput_dBFS(L, f), getInput_dBFS(L, f)); }
+		//LOG_SWEEP only: the k-th harmonic (k = 2 or 3) of the summed outputs, in dB relative to the
+		//fundamental.  NO_VALUE if k times the frequency is beyond the sweep.
+		float getHarmonic_dB(const int L, const int f, const int k) { return (valid(L, f) && (k >= 2) && (k <= 3)) ? harm_dB[L][f][k-2] : SWEEP_MEASURE_NO_VALUE; }
+
+	protected:
+		//settings
+		float sample_rate_Hz = 24000.0f;
+		Stimulus stimulus = MULTITONE;
+		float freq_lo_Hz = 125.0f, freq_hi_Hz = 8000.0f;
+		int n_freqs = 16;
+		float level_start_dB = -80.0f, level_end_dB = 0.0f, level_step_dB = 10.0f;
+		float settle_sec = 0.5f, measure_sec = 0.1f;
+		int n_chan = 1;
+		float *buffer = NULL;
+		uint32_t buffer_len = 0;
+
+		//the plan
+		bool running = false, done = false;
+		int n_levels = 0;
+		uint32_t period = 0;              //N
+		uint32_t settle_samples = 0, samples_per_level = 0;
+		float level_dBFS[SWEEP_MEASURE_MAX_LEVELS];
+		float freq_Hz[SWEEP_MEASURE_MAX_FREQS];
+		int bin[SWEEP_MEASURE_MAX_FREQS];   //MULTITONE: each tone's bin...
+		float step_re[SWEEP_MEASURE_MAX_FREQS], step_im[SWEEP_MEASURE_MAX_FREQS];   //...and its DFT rotation per sample
+		float sweep_lo_Hz = 0.0f, sweep_hi_Hz = 0.0f, sweep_L_samples = 0.0f;   //LOG_SWEEP
+
+		//generator
+		uint32_t gen_pos = 0;
+		int gen_level = -1;
+		OscillatorBank bank;
+		double sweep_phase = 0.0, sweep_w = 0.0, sweep_growth = 1.0;
+		float sweep_amp = 0.0f;
+
+		//analyzer
+		uint32_t ana_pos = 0;
+		float acc_re[SWEEP_MEASURE_MAX_CHAN+1][SWEEP_MEASURE_MAX_FREQS];   //MULTITONE: the DFT of each tone, baseline first
+		float acc_im[SWEEP_MEASURE_MAX_CHAN+1][SWEEP_MEASURE_MAX_FREQS];
+		double baseline_pow = 0.0;   //LOG_SWEEP
+
+		//results
+		float in_dB[SWEEP_MEASURE_MAX_LEVELS][SWEEP_MEASURE_MAX_FREQS];
+		float out_dB[SWEEP_MEASURE_MAX_LEVELS][SWEEP_MEASURE_MAX_FREQS][SWEEP_MEASURE_MAX_CHAN+1];  //the last is the sum
+		float harm_dB[SWEEP_MEASURE_MAX_LEVELS][SWEEP_MEASURE_MAX_FREQS][2];
+
+		bool validLevel(const int L) { return (L >= 0) && (L < n_levels); }
+		bool valid(const int L, const int f) { return validLevel(L) && (f >= 0) && (f < n_freqs); }
+		static float difference(const float a, const float b) { return ((a == SWEEP_MEASURE_NO_VALUE) || (b == SWEEP_MEASURE_NO_VALUE)) ? SWEEP_MEASURE_NO_VALUE : (a - b); }
+		uint32_t sweepPeriodFor(const float sec);
+		void clearResults(void);
+		void startLevel(const int L);
+		void accumulateTones(const float * const *sig, const int n_sig, const int offset, const uint32_t m0, const int n);
+		void finishLevelMultitone(const int L);
+		void finishLevelSweep(const int L);
+		void windowImpulse(const float *h, float *out, const int center, const int pre, const int post);
+		float responseAt_dB(const float *H, const float f_Hz);
+};
+
+#endif